@@ -28,15 +28,17 @@
 //------------------------------------------------------
 // Select which sentence is sent *last* by your GPS device
 // in each update interval. For L76K, RMC is typically last.
-// Use NMEAorder.ino to verify if needed.
+// Only the starting guess: FixAssembler (src/utils/fix_assembler)
+// learns the real order from the sentence timestamps.
 
 #define LAST_SENTENCE_IN_INTERVAL NMEAGPS::NMEA_RMC
 
 //------------------------------------------------------
 // Choose how multiple sentences are merged into a fix:
-// EXPLICIT_MERGING provides complete merged fix after last sentence
+// NO_MERGING (neither defined) delivers one fix per sentence; FixAssembler
+// merges them per update interval, so any fix rate and sentence order work
 
-#define NMEAGPS_EXPLICIT_MERGING
+//#define NMEAGPS_EXPLICIT_MERGING
 //#define NMEAGPS_IMPLICIT_MERGING
 
 #ifdef NMEAGPS_IMPLICIT_MERGING
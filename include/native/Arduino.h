@@ -0,0 +1,225 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+/**
+ * Minimal host (Linux) stand-in for the Arduino core, used only by [env:native]
+ *
+ * Provides just enough of Print/Stream/String/Serial/millis() for NeoGPS,
+ * TimeLib, Timezone, JC_Sunrise and the GPS fix pipeline to compile and run
+ * on a PC. Nothing here is used by the ESP32 builds.
+ *
+ * millis()/micros() return a virtual clock that the host program drives with
+ * hostSetMillis(), so replays are deterministic and independent of wall time.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+using std::min;
+using std::max;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strcmp_P strcmp
+#define memcpy_P memcpy
+
+// newlib (ESP32) provides strlcpy; glibc only from 2.38
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = (len < size - 1) ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+#endif
+
+class __FlashStringHelper;
+class String;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+// Virtual clock
+inline uint32_t &hostMillisRef() { static uint32_t ms = 0; return ms; }
+inline void hostSetMillis(uint32_t ms) { hostMillisRef() = ms; }
+inline unsigned long millis() { return hostMillisRef(); }
+inline unsigned long micros() { return hostMillisRef() * 1000UL; }
+inline void delay(unsigned long ms) { hostMillisRef() += ms; }
+inline void yield() {}
+
+inline long random(long howbig) { return howbig > 0 ? (rand() % howbig) : 0; }
+inline long random(long howsmall, long howbig) { return howsmall + random(howbig - howsmall); }
+inline void randomSeed(unsigned long seed) { srand(seed); }
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buf, size_t len) {
+        size_t n = 0;
+        while (len--) n += write(*buf++);
+        return n;
+    }
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    size_t write(const char *buf, size_t len) { return write((const uint8_t *)buf, len); }
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+    size_t print(const char *s) { return write(s); }
+    size_t print(const String &s);
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(int v, int base = DEC) { return print((long)v, base); }
+    size_t print(unsigned int v, int base = DEC) { return print((unsigned long)v, base); }
+    size_t print(long v, int base = DEC) {
+        if (base == DEC) return printf("%ld", v);
+        return print((unsigned long)v, base);
+    }
+    size_t print(unsigned long v, int base = DEC) {
+        if (base == HEX) return printf("%lX", v);
+        if (base == OCT) return printf("%lo", v);
+        return printf("%lu", v);
+    }
+    size_t print(double v, int digits = 2) { return printf("%.*f", digits, v); }
+
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(T v, int fmt) { size_t n = print(v, fmt); return n + println(); }
+    size_t println() { return write("\r\n"); }
+
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char buf[256];
+        va_list ap;
+        va_start(ap, fmt);
+        int len = vsnprintf(buf, sizeof(buf), fmt, ap);
+        va_end(ap);
+        if (len < 0) return 0;
+        if ((size_t)len >= sizeof(buf)) len = sizeof(buf) - 1;
+        return write((const uint8_t *)buf, len);
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+};
+
+// Host serial port: prints to stdout, never has RX data.
+// Set 'quiet' to suppress firmware debug chatter during long replays.
+class HardwareSerial : public Stream {
+public:
+    bool quiet = false;
+
+    void begin(unsigned long baud, ...) {}
+    void end() {}
+    size_t write(uint8_t c) override { if (!quiet) fputc(c, stdout); return 1; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override { fflush(stdout); }
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+// Subset of the Arduino String API used by the application code
+class String {
+public:
+    String(const char *s = "") : str(s ? s : "") {}
+    String(const std::string &s) : str(s) {}
+    explicit String(char c) : str(1, c) {}
+    explicit String(int v, unsigned char base = DEC) : str(fmtLong(v, base)) {}
+    explicit String(unsigned int v, unsigned char base = DEC) : str(fmtULong(v, base)) {}
+    explicit String(long v, unsigned char base = DEC) : str(fmtLong(v, base)) {}
+    explicit String(unsigned long v, unsigned char base = DEC) : str(fmtULong(v, base)) {}
+    explicit String(unsigned char v, unsigned char base = DEC) : str(fmtULong(v, base)) {}
+    explicit String(float v, unsigned int decimals = 2) : str(fmtDouble(v, decimals)) {}
+    explicit String(double v, unsigned int decimals = 2) : str(fmtDouble(v, decimals)) {}
+
+    const char *c_str() const { return str.c_str(); }
+    unsigned int length() const { return str.length(); }
+    bool reserve(unsigned int size) { str.reserve(size); return true; }
+    char charAt(unsigned int i) const { return i < str.length() ? str[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+
+    String &operator+=(const String &rhs) { str += rhs.str; return *this; }
+    String &operator+=(const char *rhs) { str += rhs; return *this; }
+    String &operator+=(char c) { str += c; return *this; }
+    bool concat(const String &rhs) { str += rhs.str; return true; }
+
+    bool operator==(const String &rhs) const { return str == rhs.str; }
+    bool operator==(const char *rhs) const { return str == rhs; }
+    bool operator!=(const String &rhs) const { return str != rhs.str; }
+    bool operator!=(const char *rhs) const { return str != rhs; }
+    bool equals(const String &rhs) const { return str == rhs.str; }
+
+    int indexOf(char c, unsigned int from = 0) const {
+        size_t pos = str.find(c, from);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    String substring(unsigned int from) const { return from < str.length() ? String(str.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= str.length()) return String();
+        return String(str.substr(from, to - from));
+    }
+    void trim() {
+        size_t b = str.find_first_not_of(" \t\r\n");
+        size_t e = str.find_last_not_of(" \t\r\n");
+        str = (b == std::string::npos) ? std::string() : str.substr(b, e - b + 1);
+    }
+    long toInt() const { return atol(str.c_str()); }
+    float toFloat() const { return (float)atof(str.c_str()); }
+
+    friend String operator+(const String &a, const String &b) { return String(a.str + b.str); }
+    friend String operator+(const String &a, const char *b) { return String(a.str + b); }
+    friend String operator+(const char *a, const String &b) { return String(a + b.str); }
+    friend String operator+(const String &a, char b) { return String(a.str + b); }
+
+private:
+    std::string str;
+
+    static std::string fmtLong(long v, unsigned char base) {
+        if (base != DEC) return fmtULong((unsigned long)v, base);
+        char buf[24];
+        snprintf(buf, sizeof(buf), "%ld", v);
+        return buf;
+    }
+    static std::string fmtULong(unsigned long v, unsigned char base) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), base == HEX ? "%lx" : "%lu", v);
+        return buf;
+    }
+    static std::string fmtDouble(double v, unsigned int decimals) {
+        char buf[48];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        return buf;
+    }
+};
+
+inline size_t Print::print(const String &s) { return print(s.c_str()); }
+
+#endif // NATIVE_ARDUINO_H
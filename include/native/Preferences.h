@@ -0,0 +1,26 @@
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+// Host stand-in: NVS is not available, every read returns the default
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+    bool begin(const char *name, bool readOnly = false) { return true; }
+    void end() {}
+    bool clear() { return true; }
+    size_t freeEntries() { return 0; }
+    int32_t getInt(const char *key, int32_t defaultValue = 0) { return defaultValue; }
+    float getFloat(const char *key, float defaultValue = NAN) { return defaultValue; }
+    bool getBool(const char *key, bool defaultValue = false) { return defaultValue; }
+    String getString(const char *key, const String defaultValue = String()) { return defaultValue; }
+    uint64_t getULong64(const char *key, uint64_t defaultValue = 0) { return defaultValue; }
+    size_t putInt(const char *key, int32_t value) { return sizeof(value); }
+    size_t putFloat(const char *key, float value) { return sizeof(value); }
+    size_t putBool(const char *key, bool value) { return sizeof(value); }
+    size_t putString(const char *key, const String value) { return value.length(); }
+    size_t putULong64(const char *key, uint64_t value) { return sizeof(value); }
+};
+
+#endif // NATIVE_PREFERENCES_H
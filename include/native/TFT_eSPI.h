@@ -0,0 +1,6 @@
+#ifndef NATIVE_TFT_ESPI_H
+#define NATIVE_TFT_ESPI_H
+
+// Host stand-in: display.h includes this header but the GPS pipeline uses none of it
+
+#endif // NATIVE_TFT_ESPI_H
@@ -0,0 +1,20 @@
+#ifndef NATIVE_XPT2046_TOUCHSCREEN_H
+#define NATIVE_XPT2046_TOUCHSCREEN_H
+
+// Host stand-in: only the types referenced by globals.h
+
+#include <Arduino.h>
+
+#define VSPI 3
+
+class SPIClass {
+public:
+    explicit SPIClass(uint8_t bus = VSPI) {}
+};
+
+class XPT2046_Touchscreen {
+public:
+    XPT2046_Touchscreen(uint8_t cs, uint8_t irq = 255) {}
+};
+
+#endif // NATIVE_XPT2046_TOUCHSCREEN_H
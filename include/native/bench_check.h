@@ -0,0 +1,65 @@
+#ifndef NATIVE_BENCH_CHECK_H
+#define NATIVE_BENCH_CHECK_H
+
+// Host only: checks and heap counting shared by the native bench and replay mains.
+// Include from the bench main alone - it defines the global operator new/delete.
+
+#include <malloc.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <new>
+
+/*****************************
+ *           CHECKS           *
+ *****************************/
+
+// Atomic because some benches fail from a second thread (the fake radio)
+static std::atomic<uint32_t> benchFailures{0};
+
+// Count a failed check; the first ten are printed
+static inline void fail(const char* what, uint32_t i) {
+    if (benchFailures.fetch_add(1) < 10) printf("  FAIL: %s (%u)\n", what, i);
+}
+
+// Print the closing result line; returns the process exit code
+static inline int benchResult() {
+    uint32_t failures = benchFailures.load();
+    printf("Result:    %s (%u failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
+
+/*****************************
+ *    HEAP ALLOCATION COUNT   *
+ *****************************/
+
+// Heap traffic made while benchCountAllocs is set on the calling thread. The host
+// String shim is std::string based, whose 15-char small-string buffer matches the
+// ESP32 core's String SSO, so counts are representative of the device.
+static thread_local bool benchCountAllocs = false;
+static uint64_t benchAllocs = 0;
+static int64_t benchHeapBytes = 0;  // Net bytes allocated minus freed while counting
+
+void* operator new(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (p == NULL) throw std::bad_alloc();
+    if (benchCountAllocs) {
+        benchAllocs++;
+        benchHeapBytes += malloc_usable_size(p);
+    }
+    return p;
+}
+
+// Not inlined: GCC then pairs the free() with the caller's new and warns of a mismatch
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (p != NULL && benchCountAllocs) benchHeapBytes -= malloc_usable_size(p);
+    free(p);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* p) noexcept { operator delete(p); }
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+void operator delete[](void* p, size_t) noexcept { operator delete(p); }
+
+#endif // NATIVE_BENCH_CHECK_H
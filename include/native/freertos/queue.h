@@ -0,0 +1,12 @@
+#ifndef NATIVE_FREERTOS_QUEUE_H
+#define NATIVE_FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *QueueHandle_t;
+
+// Host builds have no consumer tasks - queued items are accepted and discarded
+inline BaseType_t xQueueSend(QueueHandle_t, const void *, TickType_t) { return pdTRUE; }
+inline BaseType_t xQueueReceive(QueueHandle_t, void *, TickType_t) { return pdFALSE; }
+
+#endif // NATIVE_FREERTOS_QUEUE_H
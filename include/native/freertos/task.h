@@ -0,0 +1,10 @@
+#ifndef NATIVE_FREERTOS_TASK_H
+#define NATIVE_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+#include <Arduino.h>
+
+inline void vTaskDelay(TickType_t ticks) { delay(ticks); }
+inline TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+
+#endif // NATIVE_FREERTOS_TASK_H
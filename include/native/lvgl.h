@@ -0,0 +1,19 @@
+#ifndef NATIVE_LVGL_H
+#define NATIVE_LVGL_H
+
+// Host stand-in: opaque LVGL types referenced by application headers.
+// No LVGL code runs in [env:native].
+
+#include <stdint.h>
+
+#define LV_USE_LOG 0
+
+typedef struct _lv_obj_t lv_obj_t;
+typedef struct _lv_event_t lv_event_t;
+typedef struct _lv_display_t lv_display_t;
+typedef struct _lv_indev_t lv_indev_t;
+typedef struct _lv_indev_data_t lv_indev_data_t;
+typedef struct _lv_area_t lv_area_t;
+typedef struct { uint8_t blue, green, red; } lv_color_t;
+
+#endif // NATIVE_LVGL_H
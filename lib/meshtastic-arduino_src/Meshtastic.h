@@ -5,6 +5,7 @@
 #include "meshtastic/mesh.pb.h"
 #include "pb_encode.h"
 #include "pb_decode.h"
+#include "mt_packet_codec.h"
 
 // Some sane limits on a few strings that the protocol would otherwise allow to be unlimited length
 #define MAX_USER_ID_LEN (sizeof(meshtastic_User().id) - 1)
@@ -49,6 +50,10 @@ void mt_serial_init(int8_t rx_pin, int8_t tx_pin, uint32_t baud = BAUD_DEFAULT);
 
 void mt_serial_end();
 
+// Sleep until the radio has sent bytes or timeout_ms passes (instead of polling mt_loop()).
+// Returns true if bytes are waiting.
+bool mt_serial_wait_for_data(uint32_t timeout_ms);
+
 // Call this once per loop() and pass the current millis(). Returns bool indicating whether the connection is ready.
 bool mt_loop(uint32_t now);
 
@@ -76,6 +81,24 @@ typedef enum {
 // even do that.
 bool mt_request_node_report(void (*callback)(mt_node_t *, mt_nr_progress_t));
 
+// FromRadio variants the fast handshake steps over unparsed: the radio's settings, which
+// nothing here reads, and which make up most of its config dump
+#define MT_FAST_HANDSHAKE_SKIP (MT_VARIANT_BIT(meshtastic_FromRadio_config_tag) | \
+                                MT_VARIANT_BIT(meshtastic_FromRadio_moduleConfig_tag) | \
+                                MT_VARIANT_BIT(meshtastic_FromRadio_channel_tag) | \
+                                MT_VARIANT_BIT(meshtastic_FromRadio_metadata_tag) | \
+                                MT_VARIANT_BIT(meshtastic_FromRadio_fileInfo_tag) | \
+                                MT_VARIANT_BIT(meshtastic_FromRadio_deviceuiConfig_tag))
+
+// Fast handshake (off by default, as upstream): mt_request_node_report() asks for the radio's
+// config and own node without its node database, skipping MT_FAST_HANDSHAKE_SKIP variants in
+// the stream. The radio holds mesh packets until a dump's config_complete_id, so they flow
+// sooner. The callback sees the radio's own node, then MT_NR_DONE; once the line has been
+// quiet for a moment mt_loop() asks for the node database alone, and the callback sees those
+// nodes as MT_NR_IN_PROGRESS with no second MT_NR_DONE. Skipped variants are never handled
+// (or printed with MT_DEBUGGING).
+void mt_set_fast_handshake(bool on);
+
 // Set the callback function that gets called when the node receives a text message.
 void set_text_message_callback(void (*callback)(uint32_t from, uint32_t to, uint8_t channel, const char * text));
 
@@ -85,7 +108,40 @@ void set_portnum_callback(void (*callback)(uint32_t from, uint32_t to,  uint8_t
 // Set the callback function that gets called when the node receives an encrypted payload
 void set_encrypted_callback(void (*callback)(uint32_t from, uint32_t to,  uint8_t channel, meshtastic_MeshPacket_public_key_t pubKey, meshtastic_MeshPacket_encrypted_t *payload));
 
+// Stream received packets instead of using the three callbacks above. reserve() is called as a
+// payload starts (see mt_payload_reserve_t in mt_packet_codec.h) and returns room for it, so it
+// is read straight into its final home; deliver() follows once the whole frame has decoded, with
+// the packet header and that buffer (NULL if there was no payload or reserve() declined it).
+// Both run in the task calling mt_loop().
+void set_packet_sink(mt_payload_reserve_t reserve, void (*deliver)(const mt_packet_t *packet, uint8_t *payload));
+
 // Send a text message with *text* as payload, to a destination node (optional), on a certain channel (optional).
 bool mt_send_text(const char * text, uint32_t dest = BROADCAST_ADDR, uint8_t channel_index = 0);
 
+// Send packet->size bytes of payload on packet->port to packet->to. A zero packet->id is
+// replaced by a random one, so the caller learns the id the radio will use.
+bool mt_send_packet(mt_packet_t *packet, const uint8_t *payload);
+
+// Receive counters since boot
+typedef struct {
+  uint32_t bytes;             // Read from the radio
+  uint32_t frames;            // Complete frames found in the serial stream
+  uint32_t decode_errors;     // ... that did not decode
+  uint32_t skipped_bytes;     // Garbage skipped between frames
+  uint32_t decode_us_total;   // Time spent decoding (divide by frames)
+  uint32_t decode_us_max;
+  uint32_t config_completes;  // config_complete_id replies (node reports and probes)
+  uint32_t skipped_variants;  // Frames stepped over unparsed (fast handshake)
+  uint32_t handshake_ms;      // mt_request_node_report() to its config_complete_id, when packets flow (0 until then)
+  uint32_t first_packet_ms;   // ... to the first mesh packet forwarded after it (0 until then)
+  uint32_t node_db_ms;        // ... to the end of the fast handshake's node db dump (0 until then)
+} mt_rx_stats_t;
+
+void mt_get_rx_stats(mt_rx_stats_t *stats);
+
+// Liveness probe: ask the radio for a config-only dump (no node db), which it ends with a
+// config_complete_id counted in mt_rx_stats_t. Sends nothing while a node report is in
+// progress - its own config_complete_id answers instead.
+bool mt_send_config_probe();
+
 #endif
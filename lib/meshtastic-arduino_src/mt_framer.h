@@ -0,0 +1,195 @@
+#ifndef MT_FRAMER_H
+#define MT_FRAMER_H
+
+/*
+* mt_framer.h
+* Ring-buffer stream framer for the Meshtastic serial protocol
+* Golf Cart Project Customization
+*
+* Frames are 0x94 0xC3, a 16-bit big-endian payload length, then a FromRadio
+* protobuf. Received bytes go straight into a ring; next() scans for the magic
+* (skipping any garbage in front of it) and reports a frame once all of it is
+* there, and payloadStream() lets pb_decode() read it from there - nothing is
+* shifted. A frame that fails to decode gives up only its magic, so
+* the scan resumes inside it and a good frame hidden behind a corrupted header
+* is still found. A header whose frame never completes (a corrupted length) is
+* abandoned after MT_PARTIAL_FRAME_TIMEOUT_MS in the same way.
+*
+* Owned by one task (the meshtastic task). Header-only and free of Arduino
+* dependencies so the native_mtframe host test builds it as-is.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "pb_decode.h"
+
+#define MT_MAGIC_0 0x94
+#define MT_MAGIC_1 0xc3
+#define MT_HEADER_SIZE 4                  // Magic plus the 16-bit payload length
+#define MT_MAX_PAYLOAD 512                // Longer lengths are corrupt headers
+#define MT_RX_RING_SIZE 1024              // Power of two, holds a whole maximum frame plus the next one's start
+#define MT_PARTIAL_FRAME_TIMEOUT_MS 2000  // A maximum frame takes ~540 ms at 9600 baud
+
+class MtFramer {
+public:
+    // Counters since boot
+    struct Stats {
+        uint32_t frames;         // Complete frames handed out
+        uint32_t decodeErrors;   // ... that failed to decode (their magic was skipped)
+        uint32_t skippedBytes;   // Garbage scanned past while looking for a magic
+        uint32_t badLengths;     // Headers claiming more than MT_MAX_PAYLOAD
+        uint32_t timeouts;       // Headers abandoned because the frame never completed
+    };
+
+    // Contiguous free space at the write position (the rest follows once it is committed)
+    uint8_t* writePtr(size_t& contiguous) {
+        uint32_t used = head - tail;
+        uint32_t offset = head & MASK;
+        contiguous = MT_RX_RING_SIZE - used;
+        if (contiguous > MT_RX_RING_SIZE - offset) contiguous = MT_RX_RING_SIZE - offset;
+        return &ring[offset];
+    }
+
+    void commit(size_t n) {
+        head += n;
+    }
+
+    // Copy in as much of data as fits; returns the bytes taken
+    size_t write(const uint8_t* data, size_t len) {
+        size_t taken = 0;
+        while (taken < len) {
+            size_t room;
+            uint8_t* p = writePtr(room);
+            if (room == 0) break;
+            if (room > len - taken) room = len - taken;
+            memcpy(p, data + taken, room);
+            commit(room);
+            taken += room;
+        }
+        return taken;
+    }
+
+    size_t available() const {
+        return head - tail;
+    }
+
+    /**
+     * Find the next complete frame; now is millis() for the partial frame timeout.
+     * Returns false until one is in. Call consume() before the next call.
+     */
+    bool next(uint32_t now, size_t& payloadLen) {
+        while (true) {
+            // Skip to a magic
+            while (head != tail && at(0) != MT_MAGIC_0) {
+                tail++;
+                stats.skippedBytes++;
+            }
+            if (available() < 2) return false;
+            if (at(1) != MT_MAGIC_1) {
+                skipMagic();
+                stats.skippedBytes++;
+                continue;
+            }
+            if (available() < MT_HEADER_SIZE) return false;
+
+            uint16_t len = (uint16_t)(at(2) << 8 | at(3));
+            if (len > MT_MAX_PAYLOAD) {
+                stats.badLengths++;
+                skipMagic();
+                continue;
+            }
+
+            if (available() < MT_HEADER_SIZE + (size_t)len) {
+                // Partial frame: wait for the rest, but not for ever
+                if (!waiting || waitingTail != tail) {
+                    waiting = true;
+                    waitingTail = tail;
+                    waitingSince = now;
+                } else if (now - waitingSince >= MT_PARTIAL_FRAME_TIMEOUT_MS) {
+                    stats.timeouts++;
+                    waiting = false;
+                    skipMagic();
+                    continue;
+                }
+                return false;
+            }
+
+            waiting = false;
+            frameLen = len;
+            readPos = tail + MT_HEADER_SIZE;
+            stats.frames++;
+            payloadLen = len;
+            return true;
+        }
+    }
+
+    // Stream over the frame from next(), read straight out of the ring (wrapping at its end)
+    pb_istream_t payloadStream() {
+        readPos = tail + MT_HEADER_SIZE;
+        pb_istream_t stream = {};  // errmsg is compiled out under PB_NO_ERRMSG
+        stream.callback = ringRead;
+        stream.state = this;
+        stream.bytes_left = frameLen;
+        return stream;
+    }
+
+    // Done with the frame from next(); one that did not decode gives up only its magic
+    void consume(bool decoded) {
+        if (decoded) {
+            tail += MT_HEADER_SIZE + frameLen;
+        } else {
+            stats.decodeErrors++;
+            skipMagic();
+        }
+        frameLen = 0;
+    }
+
+    // Drop everything buffered (link restarted)
+    void reset() {
+        tail = head;
+        waiting = false;
+        frameLen = 0;
+    }
+
+    const Stats& statistics() const {
+        return stats;
+    }
+
+private:
+    static const uint32_t MASK = MT_RX_RING_SIZE - 1;
+    static_assert((MT_RX_RING_SIZE & (MT_RX_RING_SIZE - 1)) == 0, "MT_RX_RING_SIZE must be a power of two");
+    static_assert(MT_RX_RING_SIZE >= MT_HEADER_SIZE + MT_MAX_PAYLOAD, "MT_RX_RING_SIZE must hold a whole frame");
+
+    uint8_t at(uint32_t i) const {
+        return ring[(tail + i) & MASK];
+    }
+
+    void skipMagic() {
+        tail++;
+    }
+
+    // pb_istream_t callback; nanopb checks bytes_left before calling
+    static bool ringRead(pb_istream_t* stream, pb_byte_t* buf, size_t count) {
+        MtFramer* self = (MtFramer*)stream->state;
+        uint32_t offset = self->readPos & MASK;
+        size_t first = MT_RX_RING_SIZE - offset;
+        if (first > count) first = count;
+        memcpy(buf, &self->ring[offset], first);
+        memcpy(buf + first, &self->ring[0], count - first);
+        self->readPos += count;
+        return true;
+    }
+
+    uint8_t ring[MT_RX_RING_SIZE];
+    uint32_t head = 0;          // Free-running; index with & MASK
+    uint32_t tail = 0;
+    uint32_t readPos = 0;       // payloadStream() read position
+    uint16_t frameLen = 0;      // Payload length of the frame from next()
+    bool waiting = false;       // A header at waitingTail is waiting for the rest of its frame
+    uint32_t waitingTail = 0;
+    uint32_t waitingSince = 0;
+    Stats stats = {};
+};
+
+#endif // MT_FRAMER_H
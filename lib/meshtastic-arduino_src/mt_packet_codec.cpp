@@ -0,0 +1,253 @@
+/*
+* mt_packet_codec.cpp
+* Streaming FromRadio/ToRadio coding (see mt_packet_codec.h)
+* Golf Cart Project Customization
+*/
+
+#include <string.h>
+#include "mt_packet_codec.h"
+#include "pb_common.h"
+
+/*****************************
+ *         DECODING           *
+ *****************************/
+
+// Read a length-delimited payload into a reserved buffer, or skip it if there is none.
+// Longer than max is malformed, as pb_decode() would find it.
+static bool read_payload(pb_istream_t *stream, mt_packet_t *packet, size_t max,
+                         mt_payload_reserve_t reserve, uint8_t **payload) {
+    pb_istream_t sub;
+    if (!pb_make_string_substream(stream, &sub)) return false;
+
+    size_t size = sub.bytes_left;
+    bool ok = size <= max;
+    uint8_t *dest = (ok && reserve != NULL) ? reserve(packet->port, size) : NULL;
+    if (dest != NULL) {
+        ok = pb_read(&sub, dest, size);
+        dest[size] = '\0';
+        packet->size = (pb_size_t)size;
+    } else {
+        ok = ok && pb_read(&sub, NULL, size);  // NULL skips
+        packet->size = 0;
+    }
+    *payload = dest;
+    return pb_close_string_substream(stream, &sub) && ok;
+}
+
+static bool decode_data(pb_istream_t *stream, mt_packet_t *packet, mt_payload_reserve_t reserve,
+                        uint8_t **payload) {
+    while (stream->bytes_left > 0) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) return eof;
+
+        if (tag == meshtastic_Data_portnum_tag && wire_type == PB_WT_VARINT) {
+            uint32_t port;
+            if (!pb_decode_varint32(stream, &port)) return false;
+            packet->port = (meshtastic_PortNum)port;
+        } else if (tag == meshtastic_Data_payload_tag && wire_type == PB_WT_STRING) {
+            if (!read_payload(stream, packet, sizeof(meshtastic_Data_payload_t().bytes), reserve, payload)) {
+                return false;
+            }
+        } else if (tag == meshtastic_Data_request_id_tag && wire_type == PB_WT_32BIT) {
+            if (!pb_decode_fixed32(stream, &packet->request_id)) return false;
+        } else if (!pb_skip_field(stream, wire_type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool decode_mesh_packet(pb_istream_t *stream, mt_packet_t *packet, mt_payload_reserve_t reserve,
+                               uint8_t **payload) {
+    memset(packet, 0, sizeof(*packet));
+    *payload = NULL;
+
+    while (stream->bytes_left > 0) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) return eof;
+
+        bool ok;
+        if (tag == meshtastic_MeshPacket_from_tag && wire_type == PB_WT_32BIT) {
+            ok = pb_decode_fixed32(stream, &packet->from);
+        } else if (tag == meshtastic_MeshPacket_to_tag && wire_type == PB_WT_32BIT) {
+            ok = pb_decode_fixed32(stream, &packet->to);
+        } else if (tag == meshtastic_MeshPacket_id_tag && wire_type == PB_WT_32BIT) {
+            ok = pb_decode_fixed32(stream, &packet->id);
+        } else if (tag == meshtastic_MeshPacket_channel_tag && wire_type == PB_WT_VARINT) {
+            uint32_t channel;
+            ok = pb_decode_varint32(stream, &channel);
+            packet->channel = (uint8_t)channel;
+        } else if (tag == meshtastic_MeshPacket_want_ack_tag && wire_type == PB_WT_VARINT) {
+            ok = pb_decode_bool(stream, &packet->want_ack);
+        } else if (tag == meshtastic_MeshPacket_decoded_tag && wire_type == PB_WT_STRING) {
+            pb_istream_t sub;
+            if (!pb_make_string_substream(stream, &sub)) return false;
+            // Switching oneof members starts it over, as in pb_decode()
+            packet->encrypted = false;
+            packet->size = 0;
+            *payload = NULL;
+            ok = decode_data(&sub, packet, reserve, payload);
+            ok = pb_close_string_substream(stream, &sub) && ok;
+        } else if (tag == meshtastic_MeshPacket_encrypted_tag && wire_type == PB_WT_STRING) {
+            packet->encrypted = true;
+            ok = read_payload(stream, packet, sizeof(meshtastic_MeshPacket_encrypted_t().bytes), reserve, payload);
+        } else if (tag == meshtastic_MeshPacket_public_key_tag && wire_type == PB_WT_STRING) {
+            pb_istream_t sub;
+            if (!pb_make_string_substream(stream, &sub)) return false;
+            size_t size = sub.bytes_left;
+            ok = size <= sizeof(packet->public_key.bytes) && pb_read(&sub, packet->public_key.bytes, size);
+            packet->public_key.size = ok ? (pb_size_t)size : 0;
+            ok = pb_close_string_substream(stream, &sub) && ok;
+        } else {
+            ok = pb_skip_field(stream, wire_type);
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+bool mt_decode_from_radio(pb_istream_t *stream, meshtastic_FromRadio *msg, mt_packet_t *packet,
+                          mt_payload_reserve_t reserve, uint8_t **payload, uint32_t skip) {
+    msg->id = 0;
+    msg->which_payload_variant = 0;
+    *payload = NULL;
+
+    pb_field_iter_t iter;
+    if (!pb_field_iter_begin(&iter, meshtastic_FromRadio_fields, msg)) return false;
+
+    while (stream->bytes_left > 0) {
+        pb_wire_type_t wire_type;
+        uint32_t tag;
+        bool eof;
+        if (!pb_decode_tag(stream, &wire_type, &tag, &eof)) return eof;
+
+        if (tag == meshtastic_FromRadio_packet_tag) {
+            // The hot path: never built as a meshtastic_MeshPacket
+            if (wire_type != PB_WT_STRING) return false;
+            pb_istream_t sub;
+            if (!pb_make_string_substream(stream, &sub)) return false;
+            bool ok = decode_mesh_packet(&sub, packet, reserve, payload);
+            if (!pb_close_string_substream(stream, &sub) || !ok) return false;
+            msg->which_payload_variant = meshtastic_FromRadio_packet_tag;
+        } else if (tag < 32 && (skip & MT_VARIANT_BIT(tag))) {
+            // Unwanted (handshake config dump): no pb_decode() of a struct nobody reads
+            if (!pb_skip_field(stream, wire_type)) return false;
+            msg->which_payload_variant = (pb_size_t)tag;
+        } else if (pb_field_iter_find(&iter, tag)) {
+            // Anything else lands where pb_decode() would have put it
+            if (PB_LTYPE_IS_SUBMSG(iter.type)) {
+                if (wire_type != PB_WT_STRING) return false;
+                pb_istream_t sub;
+                if (!pb_make_string_substream(stream, &sub)) return false;
+                bool ok = pb_decode(&sub, iter.submsg_desc, iter.pData);
+                if (!pb_close_string_substream(stream, &sub) || !ok) return false;
+            } else {
+                // id, config_complete_id (uint32) and rebooted (bool)
+                uint32_t value;
+                if (wire_type != PB_WT_VARINT || !pb_decode_varint32(stream, &value)) return false;
+                if (iter.data_size == sizeof(bool)) {
+                    *(bool *)iter.pData = value != 0;
+                } else if (iter.data_size == sizeof(uint32_t)) {
+                    *(uint32_t *)iter.pData = value;
+                } else {
+                    return false;
+                }
+            }
+            if (PB_HTYPE(iter.type) == PB_HTYPE_ONEOF) {
+                *(pb_size_t *)iter.pSize = (pb_size_t)tag;
+            }
+        } else if (!pb_skip_field(stream, wire_type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*****************************
+ *         ENCODING           *
+ *****************************/
+
+// Fields in tag order, zero values left out - as pb_encode() writes proto3
+static bool encode_data(pb_ostream_t *stream, const mt_packet_t *packet, const uint8_t *payload) {
+    if (packet->port != 0) {
+        if (!pb_encode_tag(stream, PB_WT_VARINT, meshtastic_Data_portnum_tag) ||
+            !pb_encode_varint(stream, (uint32_t)packet->port)) {
+            return false;
+        }
+    }
+    if (packet->size > 0) {
+        if (!pb_encode_tag(stream, PB_WT_STRING, meshtastic_Data_payload_tag) ||
+            !pb_encode_string(stream, payload, packet->size)) {
+            return false;
+        }
+    }
+    if (packet->request_id != 0) {
+        if (!pb_encode_tag(stream, PB_WT_32BIT, meshtastic_Data_request_id_tag) ||
+            !pb_encode_fixed32(stream, &packet->request_id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool encode_mesh_packet(pb_ostream_t *stream, const mt_packet_t *packet, const uint8_t *payload) {
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+    if (!encode_data(&sizing, packet, payload)) return false;
+
+    if (packet->to != 0) {
+        if (!pb_encode_tag(stream, PB_WT_32BIT, meshtastic_MeshPacket_to_tag) ||
+            !pb_encode_fixed32(stream, &packet->to)) {
+            return false;
+        }
+    }
+    if (packet->channel != 0) {
+        if (!pb_encode_tag(stream, PB_WT_VARINT, meshtastic_MeshPacket_channel_tag) ||
+            !pb_encode_varint(stream, (uint32_t)packet->channel)) {
+            return false;
+        }
+    }
+    // A oneof member is written even when empty
+    if (!pb_encode_tag(stream, PB_WT_STRING, meshtastic_MeshPacket_decoded_tag) ||
+        !pb_encode_varint(stream, (uint32_t)sizing.bytes_written) ||
+        !encode_data(stream, packet, payload)) {
+        return false;
+    }
+    if (packet->id != 0) {
+        if (!pb_encode_tag(stream, PB_WT_32BIT, meshtastic_MeshPacket_id_tag) ||
+            !pb_encode_fixed32(stream, &packet->id)) {
+            return false;
+        }
+    }
+    if (packet->want_ack) {
+        if (!pb_encode_tag(stream, PB_WT_VARINT, meshtastic_MeshPacket_want_ack_tag) ||
+            !pb_encode_varint(stream, (uint32_t)1)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool mt_encode_to_radio_packet(pb_ostream_t *stream, const mt_packet_t *packet, const uint8_t *payload) {
+    if (packet->size > sizeof(meshtastic_Data_payload_t().bytes)) return false;
+
+    pb_ostream_t sizing = PB_OSTREAM_SIZING;
+    if (!encode_mesh_packet(&sizing, packet, payload)) return false;
+
+    return pb_encode_tag(stream, PB_WT_STRING, meshtastic_ToRadio_packet_tag) &&
+           pb_encode_varint(stream, (uint32_t)sizing.bytes_written) &&
+           encode_mesh_packet(stream, packet, payload);
+}
+
+bool mt_encode_to_radio_want_config(pb_ostream_t *stream, uint32_t want_config_id) {
+    return pb_encode_tag(stream, PB_WT_VARINT, meshtastic_ToRadio_want_config_id_tag) &&
+           pb_encode_varint(stream, want_config_id);
+}
+
+bool mt_encode_to_radio_heartbeat(pb_ostream_t *stream) {
+    return pb_encode_tag(stream, PB_WT_STRING, meshtastic_ToRadio_heartbeat_tag) &&
+           pb_encode_varint(stream, (uint32_t)0);
+}
@@ -0,0 +1,67 @@
+#ifndef MT_PACKET_CODEC_H
+#define MT_PACKET_CODEC_H
+
+/*
+* mt_packet_codec.h
+* Streaming FromRadio/ToRadio coding for the packets that matter
+* Golf Cart Project Customization
+*
+* The generated meshtastic_FromRadio is a 512-byte union and a ToRadio
+* carrying a packet another 508, so decoding or sending one on the stack
+* costs over a kilobyte. Here a received MeshPacket is walked field by field:
+* the header lands in a small mt_packet_t and the payload is read straight
+* into a buffer its consumer hands out (a message pool record) - the full
+* union is never built. Other FromRadio variants are decoded with pb_decode()
+* into a caller-owned FromRadio, so handlers that take generated structs keep
+* working. Outgoing data packets are written by hand into the nanopb output
+* stream, byte-for-byte what pb_encode() makes of the same ToRadio.
+*
+* The generated structs have fixed arrays rather than pb_callback_t fields
+* and are copied from upstream unchanged, so the streaming lives here instead
+* of in the .pb.h options. Free of Arduino dependencies (host-compiled by the
+* native_mtcodec bench).
+*/
+
+#include "meshtastic/mesh.pb.h"
+#include "pb_encode.h"
+#include "pb_decode.h"
+
+// The parts of a MeshPacket this project uses; the payload is held by whoever reserved it
+typedef struct {
+    uint32_t from;
+    uint32_t to;
+    uint32_t id;
+    uint32_t request_id;        // Data.request_id: the packet a routing reply answers
+    uint8_t channel;
+    bool want_ack;
+    bool encrypted;             // Payload is MeshPacket.encrypted rather than Data.payload
+    meshtastic_PortNum port;
+    pb_size_t size;             // Payload bytes (0 if there was none or it was not reserved)
+    meshtastic_MeshPacket_public_key_t public_key;
+} mt_packet_t;
+
+// Called as a payload starts, with the port seen so far (Data.portnum comes
+// first from any nanopb encoder) and its size. Returns room for size + 1 bytes
+// - the payload is NUL-terminated so text can be used as-is - or NULL to skip it.
+typedef uint8_t *(*mt_payload_reserve_t)(meshtastic_PortNum port, size_t size);
+
+// Bit for a FromRadio variant (by tag) in a skip mask
+#define MT_VARIANT_BIT(tag) (1UL << (tag))
+
+// Decode a FromRadio. A packet is streamed into *packet and a reserved buffer
+// (returned in *payload, NULL if none); any other variant goes to msg->payload_variant.
+// msg->which_payload_variant says which arrived (0: none we know). Returns false if malformed.
+// Variants whose bit is set in skip are stepped over in the stream without being parsed:
+// their tag is reported and msg->payload_variant is left as it was.
+bool mt_decode_from_radio(pb_istream_t *stream, meshtastic_FromRadio *msg, mt_packet_t *packet,
+                          mt_payload_reserve_t reserve, uint8_t **payload, uint32_t skip = 0);
+
+// Encode a ToRadio carrying a decoded MeshPacket (from, to, channel, id, want_ack, port,
+// request_id) with payload. from and encrypted are ignored (the radio fills them in).
+bool mt_encode_to_radio_packet(pb_ostream_t *stream, const mt_packet_t *packet, const uint8_t *payload);
+
+// ToRadio with want_config_id, and with an (empty) heartbeat
+bool mt_encode_to_radio_want_config(pb_ostream_t *stream, uint32_t want_config_id);
+bool mt_encode_to_radio_heartbeat(pb_ostream_t *stream);
+
+#endif // MT_PACKET_CODEC_H
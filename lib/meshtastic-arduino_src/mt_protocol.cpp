@@ -1,25 +1,39 @@
 #include "mt_internals.h"
+#include "mt_framer.h"
+#include "mt_packet_codec.h"
 #include "../meshtastic_customizations/config_callback.h"
 #include "../../src/config.h"  // For DEBUG_MESHTASTIC_CONNECTION
 
-// Magic number at the start of all MT packets
-#define MT_MAGIC_0 0x94
-#define MT_MAGIC_1 0xc3
-
-// The header is the magic number plus a 16-bit payload-length field
-#define MT_HEADER_SIZE 4
-
-// The buffer used for protobuf encoding/decoding. Since there's only one, and it's global, we
-// have to make sure we're only ever doing one encoding or decoding at a time.
+// The buffer used for protobuf encoding. Received bytes go to mt_rx instead, so a send
+// never disturbs a frame that is still arriving. (Magic and header: mt_framer.h)
 #define PB_BUFSIZE 512
 pb_byte_t pb_buf[PB_BUFSIZE+4];
-size_t pb_size = 0; // Number of bytes currently in the buffer
+
+// Received bytes, framed and decoded in place
+static MtFramer mt_rx;
+
+// Decode targets, owned by the task calling mt_loop() rather than its stack: FromRadio
+// variants other than packets, and the header of the last packet (its payload went
+// wherever the sink reserved room for it)
+static meshtastic_FromRadio rx_msg;
+static mt_packet_t rx_packet;
+static uint8_t *rx_payload;
+static mt_rx_stats_t rx_stats;
 
 // Nonce to request only my nodeinfo and skip other nodes in the db
 #define SPECIAL_NONCE 69420
-
-// Wait this many msec if there's nothing new on the channel
-#define NO_NEWS_PAUSE 25
+// Nonce to request only the node db, without config (the fast handshake's second dump)
+#define NODES_ONLY_NONCE 69421
+// Quiet line after the fast handshake before the node db is asked for
+#define MT_NODE_DB_IDLE_MS 250
+
+// FromRadio variants stepped over unparsed (MT_FAST_HANDSHAKE_SKIP with the fast handshake)
+static uint32_t skip_variants = 0;
+static uint32_t handshake_started_at = 0;
+static bool first_packet_pending = false;
+// The fast handshake's node callback, kept for its nodes-only dump once the link is idle
+static void (*node_db_callback)(mt_node_t *, mt_nr_progress_t) = NULL;
+static uint32_t last_rx_at = 0;
 
 // Serial connections require at least one ping every 15 minutes
 // Otherwise the connection is closed, and packets will no longer be received
@@ -38,6 +52,17 @@ void (*text_message_callback)(uint32_t from, uint32_t to,  uint8_t channel, cons
 void (*portnum_callback)(uint32_t from, uint32_t to,  uint8_t channel, meshtastic_PortNum port, meshtastic_Data_payload_t *payload) = NULL;
 void (*encrypted_callback)(uint32_t from, uint32_t to,  uint8_t channel, meshtastic_MeshPacket_public_key_t pubKey, meshtastic_MeshPacket_encrypted_t *enc_payload) = NULL;
 
+// Streamed packets (set_packet_sink); without a sink, packets go to the callbacks above
+mt_payload_reserve_t packet_reserve = NULL;
+void (*packet_deliver)(const mt_packet_t *packet, uint8_t *payload) = NULL;
+
+// Payload for the callbacks above. Both members are a size followed by the bytes, so a
+// payload read into encrypted.bytes is also in decoded.bytes.
+static union {
+  meshtastic_Data_payload_t decoded;
+  meshtastic_MeshPacket_encrypted_t encrypted;  // The larger, with room for the NUL after a full Data payload
+} rx_callback_payload;
+
 void (*node_report_callback)(mt_node_t *, mt_nr_progress_t) = NULL;
 mt_node_t node;
 
@@ -69,79 +94,129 @@ bool mt_send_radio(const char * buf, size_t len) {
   }
 }
 
-bool _mt_send_toRadio(meshtastic_ToRadio toRadio) {
+// Send the ToRadio already encoded into pb_buf + 4
+static bool mt_send_frame(size_t payload_len) {
   pb_buf[0] = MT_MAGIC_0;
   pb_buf[1] = MT_MAGIC_1;
 
+  // Store the payload length in the header
+  pb_buf[2] = payload_len / 256;
+  pb_buf[3] = payload_len % 256;
+
+  return mt_send_radio((const char *)pb_buf, 4 + payload_len);
+}
+
+bool _mt_send_toRadio(const meshtastic_ToRadio *toRadio) {
   pb_ostream_t stream = pb_ostream_from_buffer(pb_buf + 4, PB_BUFSIZE);
-  bool status = pb_encode(&stream, meshtastic_ToRadio_fields, &toRadio);
+  bool status = pb_encode(&stream, meshtastic_ToRadio_fields, toRadio);
   if (!status) {
     d("Couldn't encode toRadio");
     return false;
   }
+  return mt_send_frame(stream.bytes_written);
+}
 
-  // Store the payload length in the header
-  pb_buf[2] = stream.bytes_written / 256;
-  pb_buf[3] = stream.bytes_written % 256;
-
-  bool rv = mt_send_radio((const char *)pb_buf, 4 + stream.bytes_written);
+static bool mt_send_want_config(uint32_t id) {
+  pb_ostream_t stream = pb_ostream_from_buffer(pb_buf + 4, PB_BUFSIZE);
+  if (!mt_encode_to_radio_want_config(&stream, id)) {
+    d("Couldn't encode want_config_id");
+    return false;
+  }
+  return mt_send_frame(stream.bytes_written);
+}
 
-  // Clear the buffer so it can be used to hold reply packets
-  pb_size = 0;
+bool mt_send_config_probe() {
+  if (want_config_id != 0) return true;
+  return mt_send_want_config(SPECIAL_NONCE);
+}
 
-  return rv;
+void mt_set_fast_handshake(bool on) {
+  skip_variants = on ? MT_FAST_HANDSHAKE_SKIP : 0;
 }
 
 // Request a node report from our MT
 bool mt_request_node_report(void (*callback)(mt_node_t *, mt_nr_progress_t)) {
-  meshtastic_ToRadio toRadio = meshtastic_ToRadio_init_default;
-  toRadio.which_payload_variant = meshtastic_ToRadio_want_config_id_tag;
-  want_config_id = random(0x7FffFFff);  // random() can't handle anything bigger
-  toRadio.want_config_id = want_config_id;
+  if (skip_variants != 0) {
+    want_config_id = SPECIAL_NONCE;  // Fast handshake: config and our own node, no node db
+  } else {
+    want_config_id = random(0x7FffFFff);  // random() can't handle anything bigger
+  }
+  handshake_started_at = millis();
+  rx_stats.handshake_ms = 0;
+  rx_stats.first_packet_ms = 0;
+  rx_stats.node_db_ms = 0;
+  first_packet_pending = true;
+  node_db_callback = NULL;
 
 #ifdef MT_DEBUGGING
-  Serial.print("Requesting node report with random ID ");
+  Serial.print("Requesting node report with ID ");
   Serial.println(want_config_id);
 #endif
 
-  bool rv = _mt_send_toRadio(toRadio);
+  bool rv = mt_send_want_config(want_config_id);
 
   if (rv) node_report_callback = callback;
+  if (rv && skip_variants != 0) node_db_callback = callback;
   return rv;
 }
 
+// The fast handshake's node db: asked for once its dump and the packets the radio held
+// meanwhile are through, so the radio holds mesh traffic again only for the nodes
+static void mt_request_node_db(uint32_t now) {
+  if (node_db_callback == NULL || rx_stats.handshake_ms == 0 || want_config_id != 0) return;
+  if (now - last_rx_at < MT_NODE_DB_IDLE_MS) return;
+  want_config_id = NODES_ONLY_NONCE;
+  if (mt_send_want_config(want_config_id)) {
+    node_report_callback = node_db_callback;
+  } else {
+    want_config_id = 0;
+  }
+  node_db_callback = NULL;
+}
+
+bool mt_send_packet(mt_packet_t *packet, const uint8_t *payload) {
+  if (packet->id == 0) packet->id = random(0x7FFFFFFF);
+
+  // Straight from the caller's payload into pb_buf - no MeshPacket or ToRadio struct
+  pb_ostream_t stream = pb_ostream_from_buffer(pb_buf + 4, PB_BUFSIZE);
+  if (!mt_encode_to_radio_packet(&stream, packet, payload)) {
+    d("Couldn't encode packet");
+    return false;
+  }
+  return mt_send_frame(stream.bytes_written);
+}
+
 bool mt_send_text(const char * text, uint32_t dest, uint8_t channel_index) {
-  meshtastic_MeshPacket meshPacket = meshtastic_MeshPacket_init_default;
-  meshPacket.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
-  meshPacket.id = random(0x7FFFFFFF);
-  meshPacket.decoded.portnum = meshtastic_PortNum_TEXT_MESSAGE_APP;
-  meshPacket.to = dest;
-  meshPacket.channel = channel_index;
-  meshPacket.want_ack = true;
-  meshPacket.decoded.payload.size = strlen(text);
-  memcpy(meshPacket.decoded.payload.bytes, text, meshPacket.decoded.payload.size);
-
-  meshtastic_ToRadio toRadio = meshtastic_ToRadio_init_default;
-  toRadio.which_payload_variant = meshtastic_ToRadio_packet_tag;
-  toRadio.packet = meshPacket;
-  
+  size_t len = strlen(text);
+  if (len > sizeof(meshtastic_Data_payload_t().bytes)) {
+    d("Text message too long");
+    return false;
+  }
+
+  mt_packet_t packet = {};
+  packet.to = dest;
+  packet.channel = channel_index;
+  packet.want_ack = true;
+  packet.port = meshtastic_PortNum_TEXT_MESSAGE_APP;
+  packet.size = len;
+
   Serial.print("\nSending text message '");
   Serial.print(text);
   Serial.print("' to ");
   Serial.print(dest);
   Serial.println();
-  return _mt_send_toRadio(toRadio);
+  return mt_send_packet(&packet, (const uint8_t *)text);
 }
 
 bool mt_send_heartbeat() {
 
   d("Sending heartbeat");
 
-  meshtastic_ToRadio toRadio = meshtastic_ToRadio_init_default;
-  toRadio.which_payload_variant = meshtastic_ToRadio_heartbeat_tag;
-  toRadio.heartbeat = meshtastic_Heartbeat_init_default;
-
-  return _mt_send_toRadio(toRadio);
+  pb_ostream_t stream = pb_ostream_from_buffer(pb_buf + 4, PB_BUFSIZE);
+  if (!mt_encode_to_radio_heartbeat(&stream)) {
+    return false;
+  }
+  return mt_send_frame(stream.bytes_written);
 
 }
 
@@ -157,6 +232,19 @@ void set_text_message_callback(void (*callback)(uint32_t from, uint32_t to,  uin
   text_message_callback = callback;
 }
 
+void set_packet_sink(mt_payload_reserve_t reserve, void (*deliver)(const mt_packet_t *packet, uint8_t *payload)) {
+  packet_reserve = reserve;
+  packet_deliver = deliver;
+}
+
+void mt_get_rx_stats(mt_rx_stats_t *stats) {
+  const MtFramer::Stats &framer = mt_rx.statistics();
+  *stats = rx_stats;
+  stats->frames = framer.frames;
+  stats->decode_errors = framer.decodeErrors;
+  stats->skipped_bytes = framer.skippedBytes;
+}
+
 bool handle_id_tag(uint32_t id) {
   d("id_tag: ID: %d\r\n", id);
   return true;
@@ -570,14 +658,20 @@ bool handle_node_info(meshtastic_NodeInfo *nodeInfo) {
 }
 
 bool handle_config_complete_id(uint32_t now, uint32_t config_complete_id) {
+  rx_stats.config_completes++;
   if (config_complete_id == want_config_id) {
     #ifdef MT_WIFI_SUPPORTED
     mt_wifi_reset_idle_timeout(now);  // It's fine if we're actually in serial mode
     #endif
-    want_config_id = 0;
-    if (node_report_callback != NULL) {
-      node_report_callback(NULL, MT_NR_DONE);
+    if (want_config_id == NODES_ONLY_NONCE) {
+      rx_stats.node_db_ms = now - handshake_started_at;  // MT_NR_DONE went with the first dump
+    } else {
+      rx_stats.handshake_ms = now - handshake_started_at;  // The radio forwards mesh packets from here
+      if (node_report_callback != NULL) {
+        node_report_callback(NULL, MT_NR_DONE);
+      }
     }
+    want_config_id = 0;
     node_report_callback = NULL;
   } else {
     if (node_report_callback != NULL) {
@@ -587,129 +681,112 @@ bool handle_config_complete_id(uint32_t now, uint32_t config_complete_id) {
   return true;
 }
 
-bool handle_mesh_packet(meshtastic_MeshPacket *meshPacket) {
-  if (meshPacket->which_payload_variant == meshtastic_MeshPacket_decoded_tag) {
-    switch (meshPacket->decoded.portnum) {
-        case meshtastic_PortNum_TEXT_MESSAGE_APP:
-            if (text_message_callback != NULL) {
-              text_message_callback(meshPacket->from, meshPacket->to, meshPacket->channel, (const char*)meshPacket->decoded.payload.bytes);
-          } else {
-        }
-        break;
-      case meshtastic_PortNum_ADMIN_APP:
-      case meshtastic_PortNum_ATAK_FORWARDER:
-      case meshtastic_PortNum_ATAK_PLUGIN:
-      case meshtastic_PortNum_AUDIO_APP: 
-      case meshtastic_PortNum_DETECTION_SENSOR_APP: 
-      case meshtastic_PortNum_IP_TUNNEL_APP: 
-      case meshtastic_PortNum_MAP_REPORT_APP:
-      case meshtastic_PortNum_MAX: 
-      case meshtastic_PortNum_NEIGHBORINFO_APP: 
-      case meshtastic_PortNum_NODEINFO_APP: 
-      case meshtastic_PortNum_PAXCOUNTER_APP:
-      case meshtastic_PortNum_POSITION_APP: 
-      case meshtastic_PortNum_POWERSTRESS_APP: 
-      case meshtastic_PortNum_PRIVATE_APP: 
-      case meshtastic_PortNum_RANGE_TEST_APP:
-      case meshtastic_PortNum_REMOTE_HARDWARE_APP: 
-      case meshtastic_PortNum_REPLY_APP: 
-      case meshtastic_PortNum_ROUTING_APP:
-      case meshtastic_PortNum_SERIAL_APP:
-      case meshtastic_PortNum_SIMULATOR_APP:
-      case meshtastic_PortNum_STORE_FORWARD_APP:
-      case meshtastic_PortNum_TELEMETRY_APP: 
-      case meshtastic_PortNum_TEXT_MESSAGE_COMPRESSED_APP:
-      case meshtastic_PortNum_TRACEROUTE_APP: 
-      case meshtastic_PortNum_UNKNOWN_APP: 
-      case meshtastic_PortNum_WAYPOINT_APP: 
-      case meshtastic_PortNum_ZPS_APP:
-        if (portnum_callback != NULL)
-          portnum_callback(meshPacket->from, meshPacket->to, meshPacket->channel, meshPacket->decoded.portnum, &meshPacket->decoded.payload);
-        break;
+// Room for a payload when no packet sink is set
+static uint8_t *callback_payload_reserve(meshtastic_PortNum port, size_t size) {
+  return size < sizeof(rx_callback_payload.encrypted.bytes) ? rx_callback_payload.encrypted.bytes : NULL;
+}
 
-      default:
-          d("Unknown portnum %d\r\n", meshPacket->decoded.portnum);
-            return false;
-    }
-  } else if  (meshPacket -> which_payload_variant == meshtastic_MeshPacket_encrypted_tag ) {
-      d("encoded packet From: %x To: %x\r\n", meshPacket->from, meshPacket->to);
+bool handle_mesh_packet(const mt_packet_t *packet, uint8_t *payload) {
+  if (packet_deliver != NULL) {
+    packet_deliver(packet, payload);
+    return true;
+  }
+
+  if (packet->encrypted) {
+      d("encoded packet From: %x To: %x\r\n", packet->from, packet->to);
       if (encrypted_callback != NULL) {
-          encrypted_callback(meshPacket->from, meshPacket->to, meshPacket->channel, meshPacket->public_key, &meshPacket->encrypted);
-    	    return true;
+          rx_callback_payload.encrypted.size = packet->size;
+          encrypted_callback(packet->from, packet->to, packet->channel, packet->public_key, &rx_callback_payload.encrypted);
+          return true;
       }
-    	return false;
+      return false;
+  }
+
+  if (packet->port == meshtastic_PortNum_TEXT_MESSAGE_APP) {
+    if (text_message_callback != NULL) {
+      text_message_callback(packet->from, packet->to, packet->channel, payload != NULL ? (const char *)payload : "");
+    }
+  } else if (portnum_callback != NULL) {
+    rx_callback_payload.decoded.size = packet->size;
+    portnum_callback(packet->from, packet->to, packet->channel, packet->port, &rx_callback_payload.decoded);
   }
   return true;
 }
 
-// Parse a packet that came in, and handle it. Return true if we were able to parse it.
-bool handle_packet(uint32_t now, size_t payload_len) {
-  meshtastic_FromRadio fromRadio = meshtastic_FromRadio_init_zero;
-
-  // Decode the protobuf and shift forward any remaining bytes in the buffer (which, if
-  // present, belong to the packet that we're going to process on the next loop)
-  pb_istream_t stream = pb_istream_from_buffer(pb_buf + 4, payload_len);
-  bool status = pb_decode(&stream, meshtastic_FromRadio_fields, &fromRadio);
-  memmove(pb_buf, pb_buf+4+payload_len, PB_BUFSIZE-4-payload_len);
-  pb_size -= 4 + payload_len;
-
-  // Be prepared to request a node report to re-establish flow after an MT reboot
-  meshtastic_ToRadio toRadio = meshtastic_ToRadio_init_default;
-  toRadio.which_payload_variant = meshtastic_ToRadio_want_config_id_tag;
-  toRadio.want_config_id = SPECIAL_NONCE;
+// Decode a frame straight out of the RX ring and handle it. Return true if we were able to
+// handle it; *decoded says whether the protobuf itself was valid.
+bool handle_packet(uint32_t now, pb_istream_t *stream, bool *decoded) {
+  // Packets stream into the sink's buffer; everything else lands in rx_msg
+  uint32_t started = micros();
+  bool status = mt_decode_from_radio(stream, &rx_msg, &rx_packet,
+                                     packet_reserve != NULL ? packet_reserve : callback_payload_reserve, &rx_payload,
+                                     skip_variants);
+  uint32_t elapsed = micros() - started;
+  rx_stats.decode_us_total += elapsed;
+  if (elapsed > rx_stats.decode_us_max) rx_stats.decode_us_max = elapsed;
+  *decoded = status;
 
   if (!status) {
     d("Decoding failed");
     return false;
   }
 
+  if (rx_msg.which_payload_variant < 32 && (skip_variants & MT_VARIANT_BIT(rx_msg.which_payload_variant))) {
+    rx_stats.skipped_variants++;  // Stepped over in the stream; there is nothing to handle
+    return true;
+  }
+
 #if DEBUG_MESHTASTIC_CONNECTION
-  Serial.printf("FromRadio tag: %d\n", fromRadio.which_payload_variant);
+  Serial.printf("FromRadio tag: %d\n", rx_msg.which_payload_variant);
 #endif
 
-  switch (fromRadio.which_payload_variant) {
+  switch (rx_msg.which_payload_variant) {
     case meshtastic_FromRadio_id_tag: // 1
-      return handle_id_tag(fromRadio.id);
+      return handle_id_tag(rx_msg.id);
     case meshtastic_FromRadio_packet_tag: //2
-      return handle_mesh_packet(&fromRadio.packet);
+      if (first_packet_pending) {
+        rx_stats.first_packet_ms = now - handshake_started_at;
+        first_packet_pending = false;
+      }
+      return handle_mesh_packet(&rx_packet, rx_payload);
     case meshtastic_FromRadio_my_info_tag: // 3
 #if DEBUG_MESHTASTIC_CONNECTION
       Serial.println("*** Received my_info_tag! ***");
 #endif
-      return handle_my_info(&fromRadio.my_info);
+      return handle_my_info(&rx_msg.my_info);
     case meshtastic_FromRadio_node_info_tag: // 4
-      return handle_node_info(&fromRadio.node_info);
+      return handle_node_info(&rx_msg.node_info);
     case meshtastic_FromRadio_config_tag : // 5
-      return handle_config_tag(&fromRadio.config);
+      return handle_config_tag(&rx_msg.config);
     case meshtastic_FromRadio_log_record_tag: // 6
-      return handle_FromRadio_log_record_tag(&fromRadio.log_record);
+      return handle_FromRadio_log_record_tag(&rx_msg.log_record);
     case meshtastic_FromRadio_config_complete_id_tag: // 7
-      return handle_config_complete_id(now, fromRadio.config_complete_id);
+      return handle_config_complete_id(now, rx_msg.config_complete_id);
     case meshtastic_FromRadio_rebooted_tag: // 8
 #if DEBUG_MESHTASTIC_CONNECTION
       Serial.println("*** Received rebooted_tag! ***");
 #endif
       handleGcmRebooted();  // Notify callback that GCM has rebooted
-      _mt_send_toRadio(toRadio);
+      mt_send_want_config(SPECIAL_NONCE);  // Request a node report to re-establish flow after an MT reboot
       return true;  // Fix upstream bug: prevent fall-through to moduleConfig_tag
 
     case  meshtastic_FromRadio_moduleConfig_tag: // 9
-      return handle_moduleConfig_tag(&fromRadio.moduleConfig);
+      return handle_moduleConfig_tag(&rx_msg.moduleConfig);
     case meshtastic_FromRadio_channel_tag: // 10
-      return handle_channel_tag(&fromRadio.channel);
+      return handle_channel_tag(&rx_msg.channel);
     case meshtastic_FromRadio_queueStatus_tag: // 11
-      return handle_queueStatus_tag(&fromRadio.queueStatus);
+      return handle_queueStatus_tag(&rx_msg.queueStatus);
     case  meshtastic_FromRadio_xmodemPacket_tag: // 12
-      return handle_xmodemPacket_tag(&fromRadio.xmodemPacket);
+      return handle_xmodemPacket_tag(&rx_msg.xmodemPacket);
     case meshtastic_FromRadio_metadata_tag: //        13
 #if DEBUG_MESHTASTIC_CONNECTION
       Serial.println("*** Received metadata_tag! ***");
 #endif
-      return handle_metatag_data(&fromRadio.metadata);
+      return handle_metatag_data(&rx_msg.metadata);
     case meshtastic_FromRadio_mqttClientProxyMessage_tag: // 14
-      return handle_mqttClientProxyMessage_tag(&fromRadio.mqttClientProxyMessage);
+      return handle_mqttClientProxyMessage_tag(&rx_msg.mqttClientProxyMessage);
     case meshtastic_FromRadio_fileInfo_tag :  // 15
-      return handle_fileInfo_tag(&fromRadio.fileInfo); 
+      return handle_fileInfo_tag(&rx_msg.fileInfo); 
 
     default:
 #ifdef MT_DEBUGGING
@@ -721,7 +798,7 @@ bool handle_packet(uint32_t now, size_t payload_len) {
         if (now - lastLog > limitMs) {
             lastLog = now;
             Serial.print("Got a payloadVariant we don't recognize: ");
-            Serial.println(fromRadio.which_payload_variant);
+            Serial.println(rx_msg.which_payload_variant);
         }
 #endif
       return false;
@@ -730,64 +807,46 @@ bool handle_packet(uint32_t now, size_t payload_len) {
   d("Handled a packet");
 }
 
+// Handle every complete frame in the RX ring. Garbage and partial frames are left to
+// mt_rx (see mt_framer.h); the caller waits for more bytes instead of sleeping here.
 void mt_protocol_check_packet(uint32_t now) {
-  if (pb_size < MT_HEADER_SIZE) {
-    // We don't even have a header yet
-    delay(NO_NEWS_PAUSE);
-    return;
-  }
-
-  if (pb_buf[0] != MT_MAGIC_0 || pb_buf[1] != MT_MAGIC_1) {
-    d("Got bad magic");
-    memset(pb_buf, 0, PB_BUFSIZE);
-    pb_size = 0;
-    return;
-  }
-
-  uint16_t payload_len = pb_buf[2] << 8 | pb_buf[3];
-  if (payload_len > PB_BUFSIZE) {
-    d("Got packet claiming to be ridiculous length");
-    return;
+  size_t payload_len;
+  while (mt_rx.next(now, payload_len)) {
+    pb_istream_t stream = mt_rx.payloadStream();
+    bool decoded = false;
+    handle_packet(now, &stream, &decoded);
+    mt_rx.consume(decoded);
   }
+}
 
-  if ((size_t)(payload_len + 4) > pb_size) {
-    // d("Partial packet");
-    delay(NO_NEWS_PAUSE);
-    return;
+// Read what the radio has sent into the RX ring (two reads when it wraps)
+static void mt_fill_rx(uint32_t now, size_t (*check_radio)(char *, size_t)) {
+  for (int i = 0; i < 2; i++) {
+    size_t space_left;
+    uint8_t *p = mt_rx.writePtr(space_left);
+    if (space_left == 0) return;
+    size_t bytes_read = check_radio((char *)p, space_left);
+    mt_rx.commit(bytes_read);
+    rx_stats.bytes += bytes_read;
+    if (bytes_read > 0) last_rx_at = now;
+    if (bytes_read < space_left) return;
   }
-
-  /*
-#ifdef MT_DEBUGGING
-    Serial.print("Got a full packet! ");
-    for (int i = 0 ; i < pb_size ; i++) {
-      Serial.print(pb_buf[i], HEX);
-      Serial.print(" ");
-    }
-    Serial.println();
-#endif
-  */
-
-  handle_packet(now, payload_len);
 }
 
 bool mt_loop(uint32_t now) {
   bool rv;
-  size_t bytes_read = 0;
 
-  // See if there are any more bytes to add to our buffer.
-  size_t space_left = PB_BUFSIZE - pb_size;
- 
   if (mt_wifi_mode) {
 #ifdef MT_WIFI_SUPPORTED
     rv = mt_wifi_loop(now);
-    if (rv) bytes_read = mt_wifi_check_radio((char *)pb_buf + pb_size, space_left);
+    if (rv) mt_fill_rx(now, mt_wifi_check_radio);
 #else
     return false;
 #endif
   } else if (mt_serial_mode) {
 
     rv = mt_serial_loop();
-    if (rv) bytes_read = mt_serial_check_radio((char *)pb_buf + pb_size, space_left);
+    if (rv) mt_fill_rx(now, mt_serial_check_radio);
 
     // if heartbeat interval has passed, send a heartbeat to keep serial connection alive
     if(now >= (last_heartbeat_at + HEARTBEAT_INTERVAL_MS)){
@@ -800,7 +859,7 @@ bool mt_loop(uint32_t now) {
     while(1);
   }
 
-  pb_size += bytes_read;
-  mt_protocol_check_packet(now); 
+  mt_protocol_check_packet(now);
+  mt_request_node_db(now);
   return rv;
 }
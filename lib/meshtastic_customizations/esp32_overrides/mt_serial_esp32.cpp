@@ -11,10 +11,21 @@
 
 HardwareSerial meshSerial(2);  // Use UART2 on ESP32
 
+// Task blocked in mt_serial_wait_for_data(), woken by the UART driver's RX event
+static TaskHandle_t waitingTask = NULL;
+
 void mt_serial_init(int8_t rx_pin, int8_t tx_pin, uint32_t baud) {
     // ESP32-specific serial initialization using UART2
     meshSerial.begin(baud, SERIAL_8N1, rx_pin, tx_pin);
 
+    // Called when the RX FIFO threshold is reached or the line goes idle after a burst
+    meshSerial.onReceive([]() {
+        TaskHandle_t task = waitingTask;
+        if (task != NULL) {
+            xTaskNotifyGive(task);
+        }
+    });
+
     // Configure mode flags for other modules
     mt_wifi_mode = false;
     mt_serial_mode = true;
@@ -38,6 +49,15 @@ bool mt_serial_send_radio(const char * buf, size_t len) {
     return false;
 }
 
+bool mt_serial_wait_for_data(uint32_t timeout_ms) {
+    waitingTask = xTaskGetCurrentTaskHandle();
+    if (meshSerial.available() > 0) {
+        return true;  // Bytes left over from a burst that arrived during processing
+    }
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+    return meshSerial.available() > 0;
+}
+
 bool mt_serial_loop() {
     return true;  // Serial interface requires no maintenance
 }
@@ -7,10 +7,12 @@ that are needed for the Golf Cart project to function properly.
 """
 
 import os
+import subprocess
 from pathlib import Path
 
 PROJECT_ROOT = Path(__file__).parent.parent.parent.parent
 MESHTASTIC_LIB = PROJECT_ROOT / "lib" / "meshtastic-arduino_src"
+PATCHES_DIR = Path(__file__).parent
 
 def apply_rebooted_tag_fix():
     """
@@ -155,6 +157,88 @@ def apply_node_report_callback_null_check():
         print("  ℹ️  Manual patch may be required - see mt_protocol_node_report_callback_null_check.patch")
         return False
 
+def apply_file_patch(name, applied_marker, marker_file="mt_protocol.cpp"):
+    """
+    Apply a unified diff from this directory to the library with patch(1)
+
+    Used for customizations too large for string replacement. Patches made
+    against the library after the fixes above, in the order main() lists them.
+    """
+    print(f"🔧 Applying {name}...")
+
+    target = MESHTASTIC_LIB / marker_file
+    if not target.exists():
+        print(f"  ❌ File not found: {target}")
+        return False
+
+    with open(target, 'r') as f:
+        if applied_marker in f.read():
+            print("  ✅ Patch already applied")
+            return True
+
+    result = subprocess.run(["patch", "-p1", "--forward", "-i", str(PATCHES_DIR / name)],
+                            cwd=MESHTASTIC_LIB, capture_output=True, text=True)
+    if result.returncode == 0:
+        print(f"  ✅ Successfully applied {name}")
+        return True
+
+    print(result.stdout)
+    print(f"  ⚠️  {name} did not apply cleanly - upstream may have changed")
+    print(f"  ℹ️  Reapply by hand (see patches/README.md) and regenerate {name}")
+    return False
+
+def apply_ring_framing():
+    """
+    Replace the linear receive buffer with the MtFramer ring (mt_framer.h)
+
+    Not an upstream bug fix: frames are decoded in place, garbage is skipped
+    by magic-byte resync, sends no longer discard a frame that is arriving,
+    and mt_serial_wait_for_data() replaces polling.
+
+    Reference: mt_protocol_ring_framing.patch
+    """
+    return apply_file_patch("mt_protocol_ring_framing.patch", '#include "mt_framer.h"')
+
+def apply_streaming_codec():
+    """
+    Decode and send packets with the streaming codec (mt_packet_codec.*)
+
+    Not an upstream bug fix: received packets go field by field into an
+    mt_packet_t and a buffer the sink reserves (set_packet_sink()), and
+    packets are encoded straight into pb_buf, so no FromRadio or ToRadio
+    is built on the meshtastic task's stack. Applies on top of the ring
+    framing patch.
+
+    Reference: mt_protocol_streaming_codec.patch
+    """
+    return apply_file_patch("mt_protocol_streaming_codec.patch", '#include "mt_packet_codec.h"')
+
+def apply_link_probe():
+    """
+    Count received bytes and config_complete_id replies, add mt_send_config_probe()
+
+    Not an upstream bug fix: gives the GCM link monitor (src/utils/gcm_link_monitor.*)
+    the activity counters it watches and a request the radio always answers.
+    Applies on top of the streaming codec patch.
+
+    Reference: mt_protocol_link_probe.patch
+    """
+    return apply_file_patch("mt_protocol_link_probe.patch", "bool mt_send_config_probe() {")
+
+def apply_fast_handshake():
+    """
+    Add mt_set_fast_handshake(): config-only dump with unused variants skipped
+
+    Not an upstream bug fix: the radio holds mesh packets until its dump ends,
+    so leaving out its node database lets them flow sooner; other nodes are
+    learned from their traffic. Settings variants are stepped over in the
+    stream rather than decoded. Records when packets flow and the first one.
+    Applies on top of the link probe patch.
+
+    Reference: mt_protocol_fast_handshake.patch
+    """
+    return apply_file_patch("mt_protocol_fast_handshake.patch", "void mt_set_fast_handshake(bool on) {")
+
 def main():
     """Apply all required patches"""
     print("🚀 Applying Meshtastic patches for Golf Cart Project")
@@ -169,6 +253,18 @@ def main():
     if not apply_node_report_callback_null_check():
         success = False
 
+    if not apply_ring_framing():
+        success = False
+
+    if not apply_streaming_codec():
+        success = False
+
+    if not apply_link_probe():
+        success = False
+
+    if not apply_fast_handshake():
+        success = False
+
     print("=" * 60)
 
     if success:
@@ -0,0 +1,112 @@
+#include "geofence_parser.h"
+#include "config.h"
+#include "hot_packet_schema.h"
+
+#define GEOFENCE_MAX_RADIUS_M 100000
+
+static constexpr hpField_t GEOFENCE_HEADER_FIELDS[] = {
+    HP_TEXT("name", GeofenceFrame, name),
+    HP_NUMBER("radius_m", HP_FIELD_INT, GeofenceFrame, radius_m, 0, GEOFENCE_MAX_RADIUS_M),
+};
+
+static constexpr hpField_t GEOFENCE_POINT_FIELDS[] = {
+    HP_TEXT("lat", GeofencePacketPoint, lat),
+    HP_TEXT("lon", GeofencePacketPoint, lon),
+};
+
+static constexpr hpRecord_t GEOFENCE_RECORDS[] = {
+    {GEOFENCE_HEADER_FIELDS, HP_COUNT(GEOFENCE_HEADER_FIELDS), 0, sizeof(GeofenceFrame), 1, 1, -1, false},
+    {GEOFENCE_POINT_FIELDS, HP_COUNT(GEOFENCE_POINT_FIELDS), offsetof(GeofenceFrame, points),
+     sizeof(GeofencePacketPoint), 0, GEOFENCE_PACKET_MAX_POINTS, offsetof(GeofenceFrame, count), false},
+};
+
+static constexpr hpSchema_t GEOFENCE_SCHEMA = {"Geofence", GEOFENCE_RECORDS, HP_COUNT(GEOFENCE_RECORDS)};
+
+bool parseGeofenceFrame(const char* text, GeofenceFrame& frame) {
+    if (!parseHotPacketFrame<GeofenceFrame, GEOFENCE_SCHEMA>(text, frame)) return false;
+
+    if (frame.name[0] == '\0') {
+        Serial.println("Geofence packet: name is empty");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Parse "[+|-]degrees[.decimals]" as 1e-7 degrees (decimals past 7 truncated)
+ * Returns false if it is not a number or lies outside +/-limitDeg
+ */
+static bool parseCoordE7(const char* s, int32_t limitDeg, int32_t& out) {
+    bool negative = false;
+    if (*s == '-' || *s == '+') negative = (*s++ == '-');
+
+    int64_t value = 0;
+    uint8_t digits = 0, fracDigits = 0;
+    for (; *s >= '0' && *s <= '9'; s++, digits++) {
+        if (value <= (int64_t)limitDeg) value = value * 10 + (*s - '0');
+    }
+    value *= 10000000;
+    if (*s == '.') {
+        int64_t scale = 1000000;
+        for (s++; *s >= '0' && *s <= '9'; s++, digits++) {
+            if (fracDigits++ < 7) {
+                value += (*s - '0') * scale;
+                scale /= 10;
+            }
+        }
+    }
+    if (digits == 0 || *s != '\0' || value > (int64_t)limitDeg * 10000000) return false;
+
+    out = (int32_t)(negative ? -value : value);
+    return true;
+}
+
+bool applyGeofenceFrame(const GeofenceFrame& frame, GeofenceEngine& engine) {
+    geoPoint_t points[GEOFENCE_PACKET_MAX_POINTS];
+    for (uint8_t i = 0; i < frame.count; i++) {
+        if (!parseCoordE7(frame.points[i].lat, 90, points[i].lat) ||
+            !parseCoordE7(frame.points[i].lon, 180, points[i].lon)) {
+            Serial.print("Geofence packet: bad coordinate ");
+            Serial.println(i + 1);
+            return false;
+        }
+    }
+
+    bool circle = frame.radius_m > 0 && frame.count == 1;
+    bool polygon = frame.radius_m == 0 && frame.count >= 3;
+    bool erase = frame.radius_m == 0 && frame.count == 0;
+    if (!circle && !polygon && !erase) {
+        Serial.println("Geofence packet: need one point and a radius, or 3+ points");
+        return false;
+    }
+
+    if (erase && strcmp(frame.name, "*") == 0) {
+        engine.clear();
+        Serial.println("Geofences cleared");
+        return true;
+    }
+
+    // Same name replaces; removing first also frees its vertices for the new shape
+    int existing = engine.find(frame.name);
+    if (existing >= 0) {
+        engine.remove(existing);
+    } else if (erase) {
+        Serial.print("Geofence packet: no fence named ");
+        Serial.println(frame.name);
+        return false;
+    }
+
+    if (!erase) {
+        int index = circle ? engine.addCircle(frame.name, points[0].lat, points[0].lon, frame.radius_m)
+                           : engine.addPolygon(frame.name, points, frame.count);
+        if (index < 0) {
+            // An existing fence was already removed, so the table still changed
+            Serial.println("Geofence packet: table full");
+            return existing >= 0;
+        }
+    }
+
+    Serial.print(erase ? "Geofence deleted: " : "Geofence stored: ");
+    Serial.println(frame.name);
+    return true;
+}
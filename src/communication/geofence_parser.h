@@ -0,0 +1,32 @@
+#ifndef GEOFENCE_PARSER_H
+#define GEOFENCE_PARSER_H
+
+#include <Arduino.h>
+#include "types.h"
+#include "utils/geofence.h"
+
+/**
+ * Geofence hot packet parser - adds, replaces and deletes stored geofences
+ *
+ * Format: |#03#name,radius_m#lat,lon#lat,lon#...#   (decimal degrees, up to 7 decimals)
+ * e.g.    |#03#Clubhouse,150#28.9123456,-81.9654321#                     circle
+ *         |#03#Range,0#28.91,-81.96#28.91,-81.95#28.90,-81.95#            polygon
+ *         |#03#Range,0#                                                   delete "Range"
+ *         |#03#*,0#                                                       delete all
+ *
+ * One point and a radius is a circle, three or more points with radius 0 a
+ * polygon (up to GEOFENCE_PACKET_MAX_POINTS). A fence with the same name is
+ * replaced. A fence named GEOFENCE_HOME_NAME decides at_home. Declared as a
+ * hot packet schema (hot_packet_schema.h); coordinates are kept as text by
+ * the schema and converted to 1e-7 degrees here, as the schema's numbers
+ * stop at hundredths.
+ */
+bool parseGeofenceFrame(const char* text, GeofenceFrame& frame);
+
+/**
+ * Apply a parsed packet to the engine (caller holds gpsMutex)
+ * Returns true if the table changed and should be saved
+ */
+bool applyGeofenceFrame(const GeofenceFrame& frame, GeofenceEngine& engine);
+
+#endif // GEOFENCE_PARSER_H
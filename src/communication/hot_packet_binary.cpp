@@ -0,0 +1,479 @@
+#include "hot_packet_binary.h"
+#include "config.h"
+#include "venue_parser.h"
+
+#define HOT_BIN_VARINT_MAX_BYTES 3  // Enough for every 16-bit field
+#define WX_DELTA_MASK_ALL ((1u << (WX_FORECAST_HOURS + 1)) - 1)
+
+static_assert(WX_HOUR_STR_SIZE >= 5 && WX_GLYPH_STR_SIZE >= 3, "WeatherFrame too small for decoded hours/glyphs");
+static_assert(WX_FORECAST_HOURS < 8, "Weather delta mask is one byte");
+static_assert(VENUE_MAX_EVENTS <= 7 * HOT_BIN_VARINT_MAX_BYTES, "Venue delta mask must fit a varint");
+static_assert(VENUE_NAME_STR_SIZE <= 256 && VENUE_EVENT_STR_SIZE <= 256, "Venue strings have a 1-byte length");
+
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+/*****************************
+ *         DECODING          *
+ *****************************/
+
+// Bounds-checked reader; any failure sticks so callers check once at the end
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    bool ok;
+} binReader_t;
+
+static uint8_t readByte(binReader_t& r) {
+    if (r.p >= r.end) {
+        r.ok = false;
+        return 0;
+    }
+    return *r.p++;
+}
+
+static uint32_t readVarint(binReader_t& r) {
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < HOT_BIN_VARINT_MAX_BYTES; i++) {
+        uint8_t b = readByte(r);
+        v |= (uint32_t)(b & 0x7F) << (7 * i);
+        if ((b & 0x80) == 0) return v;
+    }
+    r.ok = false;  // Too long for any field
+    return 0;
+}
+
+// Length-prefixed string into a char[size]; false if it would not fit or holds a NUL
+static bool readString(binReader_t& r, char* dest, size_t size) {
+    uint8_t len = readByte(r);
+    if ((size_t)(r.end - r.p) < len) {
+        r.ok = false;
+        return false;
+    }
+    if (len >= size || memchr(r.p, '\0', len) != NULL) return false;
+    memcpy(dest, r.p, len);
+    dest[len] = '\0';
+    r.p += len;
+    return true;
+}
+
+static bool readVenueRow(binReader_t& r, VenueEvent& row) {
+    memset(&row, 0, sizeof(row));
+    return readString(r, row.venue, sizeof(row.venue)) && readString(r, row.event, sizeof(row.event));
+}
+
+// Sequence number a full frame may end with (0 if the sender has none)
+static uint16_t readTrailingSeq(binReader_t& r, bool& inRange) {
+    if (r.p >= r.end) return 0;
+    uint32_t seq = readVarint(r);
+    inRange = inRange && seq <= 65535;
+    return (uint16_t)seq;
+}
+
+static bool binaryError(const char* what, const char* problem) {
+    Serial.print("Binary ");
+    Serial.print(what);
+    Serial.print(" packet: ");
+    Serial.println(problem);
+    return false;
+}
+
+int parseBinaryHotPacketType(const uint8_t* data, size_t size) {
+    if (data == NULL || size < HOT_BIN_HEADER_SIZE) return -1;
+    if (data[0] != HOT_BIN_MAGIC || data[1] != HOT_BIN_VERSION) return -1;
+    return data[2];
+}
+
+// 0-99 without a leading zero; returns the characters written (buf needs 3 bytes)
+static uint8_t formatSmallNumber(uint8_t v, char* buf) {
+    uint8_t n = 0;
+    if (v >= 10) buf[n++] = '0' + v / 10;
+    buf[n++] = '0' + v % 10;
+    buf[n] = '\0';
+    return n;
+}
+
+// "10am" / "12pm" for an hour of day, as the text packets write it (buf needs 5 bytes)
+static void formatHour(uint8_t hour, char* buf) {
+    uint8_t h12 = hour % 12;
+    uint8_t n = formatSmallNumber(h12 == 0 ? 12 : h12, buf);
+    buf[n++] = hour < 12 ? 'a' : 'p';
+    buf[n++] = 'm';
+    buf[n] = '\0';
+}
+
+static bool tempInRange(int32_t temp) {
+    return temp >= -99 && temp <= 999;
+}
+
+// Current temperature: zigzag tenths shifted left one, bit 0 set if it was sent with a decimal
+static bool unpackCurTemp(uint32_t v, WeatherFrame& frame) {
+    int32_t tenths = unzigzag(v >> 1);
+    if (tenths < -990 || tenths > 9990) return false;
+    frame.curTemp = (int16_t)tenths;
+    frame.curTempDecimal = (v & 1) != 0;
+    return true;
+}
+
+// Range-check one forecast hour and store it as the text parser would; false (frame untouched) if out of range
+static bool storeForecastHour(WeatherForecastHour& fh, uint32_t hour, uint32_t glyph, int32_t temp, uint32_t precip) {
+    if (hour >= 24 || glyph >= 100 || !tempInRange(temp) || precip > 65535) return false;
+    memset(&fh, 0, sizeof(fh));
+    formatHour((uint8_t)hour, fh.hour);
+    formatSmallNumber((uint8_t)glyph, fh.glyph);
+    fh.temp = (int16_t)temp;
+    fh.precip = (uint16_t)precip;
+    return true;
+}
+
+bool decodeWeatherBinary(const uint8_t* data, size_t size, WeatherFrame& frame) {
+    if (parseBinaryHotPacketType(data, size) != HOT_PACKET_WEATHER) return binaryError("weather", "bad header");
+
+    WeatherFrame decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    binReader_t r = {data + HOT_BIN_HEADER_SIZE, data + size, true};
+
+    bool inRange = unpackCurTemp(readVarint(r), decoded);
+    int32_t temp = decoded.curTemp / 10;
+
+    uint32_t hour = readByte(r);
+    for (int h = 0; h < WX_FORECAST_HOURS && r.ok && inRange; h++) {
+        if (h > 0) {
+            uint8_t offset = readByte(r);
+            inRange = offset < 24;
+            hour = (hour + offset) % 24;
+        }
+        uint8_t glyph = readByte(r);
+        temp += unzigzag(readVarint(r));
+        uint32_t precip = readVarint(r);
+        inRange = inRange && storeForecastHour(decoded.hours[h], hour, glyph, temp, precip);
+    }
+    decoded.seq = readTrailingSeq(r, inRange);
+
+    if (!r.ok) return binaryError("weather", "truncated");
+    if (!inRange) return binaryError("weather", "value out of range");
+
+    decoded.valid = true;
+    frame = decoded;
+    return true;
+}
+
+bool decodeVenueBinary(const uint8_t* data, size_t size, VenueFrame& frame) {
+    if (parseBinaryHotPacketType(data, size) != HOT_PACKET_VENUE_EVENT) return binaryError("venue", "bad header");
+
+    VenueFrame decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    binReader_t r = {data + HOT_BIN_HEADER_SIZE, data + size, true};
+
+    uint8_t count = readByte(r);
+    bool inRange = count <= VENUE_MAX_EVENTS;
+    decoded.count = inRange ? count : 0;
+    for (uint8_t i = 0; i < decoded.count && r.ok && inRange; i++) {
+        inRange = readVenueRow(r, decoded.events[i]);
+    }
+    decoded.seq = readTrailingSeq(r, inRange);
+
+    if (!r.ok) return binaryError("venue", "truncated");
+    if (!inRange) return binaryError("venue", "value out of range");
+
+    decoded.hash = hashVenueEvents(decoded);
+    frame = decoded;
+    return true;
+}
+
+// Check a delta's sequence numbers against the frame it would apply to
+static hotBinDelta_t readDeltaSeq(const char* what, binReader_t& r, uint16_t current, uint16_t& seq) {
+    uint32_t baseSeq = readVarint(r);
+    uint32_t newSeq = readVarint(r);
+    if (!r.ok || baseSeq == 0 || baseSeq > 65535 || newSeq == 0 || newSeq > 65535 || newSeq == baseSeq) {
+        binaryError(what, "bad delta sequence numbers");
+        return HOT_BIN_DELTA_MALFORMED;
+    }
+    if (newSeq == current) {
+        binaryError(what, "delta already applied");
+        return HOT_BIN_DELTA_DUPLICATE;
+    }
+    if (baseSeq != current) {
+        Serial.print("Binary ");
+        Serial.print(what);
+        Serial.print(" packet: sequence gap (have ");
+        Serial.print(current);
+        Serial.print(", delta from ");
+        Serial.print(baseSeq);
+        Serial.println(") - waiting for a full frame");
+        return HOT_BIN_DELTA_GAP;
+    }
+    seq = (uint16_t)newSeq;
+    return HOT_BIN_DELTA_APPLIED;
+}
+
+hotBinDelta_t applyWeatherDelta(const uint8_t* data, size_t size, const WeatherFrame& base, WeatherFrame& frame) {
+    if (parseBinaryHotPacketType(data, size) != (HOT_BIN_DELTA | HOT_PACKET_WEATHER)) {
+        binaryError("weather", "bad delta header");
+        return HOT_BIN_DELTA_MALFORMED;
+    }
+
+    binReader_t r = {data + HOT_BIN_HEADER_SIZE, data + size, true};
+    uint16_t seq = 0;
+    hotBinDelta_t status = readDeltaSeq("weather", r, base.seq, seq);
+    if (status != HOT_BIN_DELTA_APPLIED) return status;
+
+    WeatherFrame updated = base;
+    uint8_t mask = readByte(r);
+    bool inRange = (mask & ~WX_DELTA_MASK_ALL) == 0;
+
+    if (mask & 1) {
+        inRange = unpackCurTemp(readVarint(r), updated) && inRange;
+    }
+    for (int h = 0; h < WX_FORECAST_HOURS && r.ok && inRange; h++) {
+        if ((mask & (2u << h)) == 0) continue;
+        uint8_t hour = readByte(r);
+        uint8_t glyph = readByte(r);
+        int32_t temp = unzigzag(readVarint(r));
+        uint32_t precip = readVarint(r);
+        inRange = storeForecastHour(updated.hours[h], hour, glyph, temp, precip);
+    }
+
+    if (!r.ok) {
+        binaryError("weather", "delta truncated");
+        return HOT_BIN_DELTA_MALFORMED;
+    }
+    if (!inRange) {
+        binaryError("weather", "delta value out of range");
+        return HOT_BIN_DELTA_MALFORMED;
+    }
+
+    updated.seq = seq;
+    frame = updated;
+    return HOT_BIN_DELTA_APPLIED;
+}
+
+hotBinDelta_t applyVenueDelta(const uint8_t* data, size_t size, const VenueFrame& base, VenueFrame& frame) {
+    if (parseBinaryHotPacketType(data, size) != (HOT_BIN_DELTA | HOT_PACKET_VENUE_EVENT)) {
+        binaryError("venue", "bad delta header");
+        return HOT_BIN_DELTA_MALFORMED;
+    }
+
+    binReader_t r = {data + HOT_BIN_HEADER_SIZE, data + size, true};
+    uint16_t seq = 0;
+    hotBinDelta_t status = readDeltaSeq("venue", r, base.seq, seq);
+    if (status != HOT_BIN_DELTA_APPLIED) return status;
+
+    VenueFrame updated = base;
+    uint8_t count = readByte(r);
+    uint32_t mask = readVarint(r);
+
+    // Rows past the old count have no old value, so they must all be sent
+    bool inRange = count <= VENUE_MAX_EVENTS && (mask >> count) == 0;
+    if (inRange) {
+        uint8_t kept = base.count < count ? base.count : count;
+        uint32_t added = ((1u << count) - 1) & ~((1u << kept) - 1);
+        inRange = (mask & added) == added;
+    }
+
+    for (uint8_t i = 0; i < VENUE_MAX_EVENTS && r.ok && inRange; i++) {
+        if (mask & (1u << i)) {
+            inRange = readVenueRow(r, updated.events[i]);
+        } else if (i >= count) {
+            memset(&updated.events[i], 0, sizeof(updated.events[i]));
+        }
+    }
+
+    if (!r.ok) {
+        binaryError("venue", "delta truncated");
+        return HOT_BIN_DELTA_MALFORMED;
+    }
+    if (!inRange) {
+        binaryError("venue", "delta value out of range");
+        return HOT_BIN_DELTA_MALFORMED;
+    }
+
+    updated.count = count;
+    updated.seq = seq;
+    updated.hash = hashVenueEvents(updated);
+    frame = updated;
+    return HOT_BIN_DELTA_APPLIED;
+}
+
+/*****************************
+ *         ENCODING          *
+ *****************************/
+
+// Bounds-checked writer, the mirror of binReader_t
+typedef struct {
+    uint8_t* p;
+    uint8_t* end;
+    bool ok;
+} binWriter_t;
+
+static void writeByte(binWriter_t& w, uint8_t b) {
+    if (w.p >= w.end) {
+        w.ok = false;
+        return;
+    }
+    *w.p++ = b;
+}
+
+static void writeVarint(binWriter_t& w, uint32_t v) {
+    while (v >= 0x80) {
+        writeByte(w, (uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    writeByte(w, (uint8_t)v);
+}
+
+static void writeString(binWriter_t& w, const char* s, size_t size) {
+    size_t len = strnlen(s, size);
+    if (len >= size) {
+        w.ok = false;
+        return;
+    }
+    writeByte(w, (uint8_t)len);
+    for (size_t i = 0; i < len; i++) writeByte(w, (uint8_t)s[i]);
+}
+
+static void writeVenueRow(binWriter_t& w, const VenueEvent& row) {
+    writeString(w, row.venue, sizeof(row.venue));
+    writeString(w, row.event, sizeof(row.event));
+}
+
+static bool writeHeader(binWriter_t& w, uint8_t* buf, size_t len, uint8_t type) {
+    w.p = buf;
+    w.end = buf + (buf ? len : 0);
+    w.ok = true;
+    writeByte(w, HOT_BIN_MAGIC);
+    writeByte(w, HOT_BIN_VERSION);
+    writeByte(w, type);
+    return w.ok;
+}
+
+static size_t finish(const binWriter_t& w, const uint8_t* buf) {
+    return w.ok ? (size_t)(w.p - buf) : 0;
+}
+
+// Digits only, no leading zero, at most maxDigits; returns -1 otherwise
+static int parseSmallNumber(const char* s, size_t maxDigits) {
+    size_t len = strlen(s);
+    if (len == 0 || len > maxDigits || (len > 1 && s[0] == '0')) return -1;
+    int v = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] < '0' || s[i] > '9') return -1;
+        v = v * 10 + (s[i] - '0');
+    }
+    return v;
+}
+
+// Hour of day for "1am".."12pm", or -1 if formatHour() would not give the same text back
+static int parseHour(const char* s) {
+    size_t len = strlen(s);
+    if (len < 3 || s[len - 1] != 'm' || (s[len - 2] != 'a' && s[len - 2] != 'p')) return -1;
+
+    char digits[3];
+    if (len - 2 > 2) return -1;
+    memcpy(digits, s, len - 2);
+    digits[len - 2] = '\0';
+
+    int h12 = parseSmallNumber(digits, 2);
+    if (h12 < 1 || h12 > 12) return -1;
+    return (h12 % 12) + (s[len - 2] == 'p' ? 12 : 0);
+}
+
+// The mirror of unpackCurTemp(), so "72.5", "72.0" and "72" all display as sent
+static uint32_t packCurTemp(const WeatherFrame& frame) {
+    return (zigzag(frame.curTemp) << 1) | (frame.curTempDecimal ? 1 : 0);
+}
+
+size_t encodeWeatherBinary(const WeatherFrame& frame, uint8_t* buf, size_t len) {
+    binWriter_t w;
+    if (!writeHeader(w, buf, len, HOT_PACKET_WEATHER)) return 0;
+
+    writeVarint(w, packCurTemp(frame));
+
+    int prevHour = -1;
+    int32_t prevTemp = frame.curTemp / 10;
+    for (int h = 0; h < WX_FORECAST_HOURS; h++) {
+        const WeatherForecastHour& fh = frame.hours[h];
+        int hour = parseHour(fh.hour);
+        int glyph = parseSmallNumber(fh.glyph, 2);
+        if (hour < 0 || glyph < 0) return 0;
+
+        writeByte(w, (uint8_t)(prevHour < 0 ? hour : (hour - prevHour + 24) % 24));
+        prevHour = hour;
+        writeByte(w, (uint8_t)glyph);
+        writeVarint(w, zigzag(fh.temp - prevTemp));
+        prevTemp = fh.temp;
+        writeVarint(w, fh.precip);
+    }
+    if (frame.seq != 0) writeVarint(w, frame.seq);
+    return finish(w, buf);
+}
+
+size_t encodeVenueBinary(const VenueFrame& frame, uint8_t* buf, size_t len) {
+    binWriter_t w;
+    if (frame.count > VENUE_MAX_EVENTS || !writeHeader(w, buf, len, HOT_PACKET_VENUE_EVENT)) return 0;
+
+    writeByte(w, frame.count);
+    for (uint8_t i = 0; i < frame.count; i++) writeVenueRow(w, frame.events[i]);
+    if (frame.seq != 0) writeVarint(w, frame.seq);
+    return finish(w, buf);
+}
+
+static bool writeDeltaSeq(binWriter_t& w, uint16_t baseSeq, uint16_t seq) {
+    if (baseSeq == 0 || seq == 0 || baseSeq == seq) return false;
+    writeVarint(w, baseSeq);
+    writeVarint(w, seq);
+    return true;
+}
+
+size_t encodeWeatherDelta(const WeatherFrame& base, const WeatherFrame& frame, uint8_t* buf, size_t len) {
+    binWriter_t w;
+    if (!writeHeader(w, buf, len, HOT_BIN_DELTA | HOT_PACKET_WEATHER)) return 0;
+    if (!writeDeltaSeq(w, base.seq, frame.seq)) return 0;
+
+    uint8_t mask = (frame.curTemp != base.curTemp || frame.curTempDecimal != base.curTempDecimal) ? 1 : 0;
+    for (int h = 0; h < WX_FORECAST_HOURS; h++) {
+        if (memcmp(&frame.hours[h], &base.hours[h], sizeof(frame.hours[h])) != 0) mask |= 2u << h;
+    }
+    writeByte(w, mask);
+
+    if (mask & 1) writeVarint(w, packCurTemp(frame));
+    for (int h = 0; h < WX_FORECAST_HOURS; h++) {
+        if ((mask & (2u << h)) == 0) continue;
+        const WeatherForecastHour& fh = frame.hours[h];
+        int hour = parseHour(fh.hour);
+        int glyph = parseSmallNumber(fh.glyph, 2);
+        if (hour < 0 || glyph < 0) return 0;
+
+        writeByte(w, (uint8_t)hour);
+        writeByte(w, (uint8_t)glyph);
+        writeVarint(w, zigzag(fh.temp));
+        writeVarint(w, fh.precip);
+    }
+    return finish(w, buf);
+}
+
+size_t encodeVenueDelta(const VenueFrame& base, const VenueFrame& frame, uint8_t* buf, size_t len) {
+    binWriter_t w;
+    if (frame.count > VENUE_MAX_EVENTS || !writeHeader(w, buf, len, HOT_BIN_DELTA | HOT_PACKET_VENUE_EVENT)) return 0;
+    if (!writeDeltaSeq(w, base.seq, frame.seq)) return 0;
+
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < frame.count; i++) {
+        const VenueEvent& row = frame.events[i];
+        const VenueEvent& old = base.events[i];
+        if (i >= base.count || strcmp(row.venue, old.venue) != 0 || strcmp(row.event, old.event) != 0) {
+            mask |= 1u << i;
+        }
+    }
+    writeByte(w, frame.count);
+    writeVarint(w, mask);
+    for (uint8_t i = 0; i < frame.count; i++) {
+        if (mask & (1u << i)) writeVenueRow(w, frame.events[i]);
+    }
+    return finish(w, buf);
+}
@@ -0,0 +1,86 @@
+#ifndef HOT_PACKET_BINARY_H
+#define HOT_PACKET_BINARY_H
+
+#include <Arduino.h>
+#include "types.h"
+
+/**
+ * Binary hot packets (PRIVATE_APP)
+ *
+ * The same data as the text hot packets in about a third of the LoRa airtime.
+ * Every packet opens with a 3-byte header:
+ *   [0] HOT_BIN_MAGIC    PRIVATE_APP is shared with other apps
+ *   [1] HOT_BIN_VERSION  bumped only for incompatible changes; fields may be
+ *                        appended within a version (decoders ignore extra bytes)
+ *   [2] HotPacketType    same numbering as the text "|#NN#" header, with
+ *                        HOT_BIN_DELTA set for a delta (below)
+ *
+ * LEB128 varints throughout, signed values zigzag coded. Every full frame may
+ * end in a varint sequence number (1-65535, absent = 0 = unsequenced) that
+ * deltas refer to.
+ *
+ * Weather (HOT_PACKET_WEATHER):
+ *   curTemp           varint, zigzag tenths << 1 | 1 if sent with a decimal
+ *                     ("72.5", "72.0" and "72" all display as sent)
+ *   first hour        1 byte, hour of day 0-23
+ *   per forecast hour [1 byte hours after the previous one, not for the first]
+ *                     1 byte glyph code 0-99
+ *                     varint temp - previous temp (curTemp's whole degrees,
+ *                     truncated, for the first hour)
+ *                     varint precipitation, hundredths
+ * A typical forecast is 21 bytes against 66 as text. Hours are shown as
+ * "10am" / "12pm", exactly as the text packets send them.
+ *
+ * Venue/event (HOT_PACKET_VENUE_EVENT):
+ *   count             1 byte, 0-VENUE_MAX_EVENTS rows
+ *   per row           1 byte length + venue, 1 byte length + event (no NULs,
+ *                     shorter than the VenueEvent fields)
+ *
+ * Deltas (HOT_BIN_DELTA | type) change only some fields of the last frame:
+ *   base seq          varint, the frame the delta applies to
+ *   seq               varint, the frame it produces (neither 0, not equal)
+ *   weather           1 byte mask: bit 0 curTemp, bit 1+h forecast hour h;
+ *                     then curTemp (as above) and each hour in full (hour of
+ *                     day byte, glyph byte, temp varint, precip varint)
+ *   venue/event       1 byte new count, varint mask of replaced rows (must
+ *                     include every row past the old count), then those rows
+ * A delta only applies on top of the frame with the base sequence number. On a
+ * gap (a lost packet, or text/unsequenced data since) it is dropped and the
+ * display keeps the last frame until the gateway's next full frame, which it
+ * sends periodically; the radio link has no way to ask for one.
+ *
+ * Decoding is strict and all-or-nothing like the text parser: on error the
+ * frame is left untouched; on success everything but rcvTime (left empty, or
+ * the base frame's for a delta) is replaced. Host-compiled by the hot packet
+ * benchmark, which also encodes.
+ */
+
+typedef enum {
+    HOT_BIN_DELTA_APPLIED,
+    HOT_BIN_DELTA_DUPLICATE,  // Already at the delta's sequence number - nothing to do
+    HOT_BIN_DELTA_GAP,        // Base sequence number is not the current frame's - wait for a full frame
+    HOT_BIN_DELTA_MALFORMED
+} hotBinDelta_t;
+
+// Packet type of a binary hot packet (HOT_BIN_DELTA included), or -1 if the magic or version is not ours
+int parseBinaryHotPacketType(const uint8_t* data, size_t size);
+
+bool decodeWeatherBinary(const uint8_t* data, size_t size, WeatherFrame& frame);
+bool decodeVenueBinary(const uint8_t* data, size_t size, VenueFrame& frame);
+
+// Apply a delta to base into frame (may be the same object); frame is only written when applied
+hotBinDelta_t applyWeatherDelta(const uint8_t* data, size_t size, const WeatherFrame& base, WeatherFrame& frame);
+hotBinDelta_t applyVenueDelta(const uint8_t* data, size_t size, const VenueFrame& base, VenueFrame& frame);
+
+// Encoders return the encoded size, or 0 if it does not fit or the frame has an
+// hour or glyph the binary form cannot express (send it as text). The frame's
+// seq is appended when set.
+size_t encodeWeatherBinary(const WeatherFrame& frame, uint8_t* buf, size_t len);
+size_t encodeVenueBinary(const VenueFrame& frame, uint8_t* buf, size_t len);
+
+// Delta from base to frame, carrying only what differs; both need a sequence
+// number and they must differ. Returns 0 as the encoders above do.
+size_t encodeWeatherDelta(const WeatherFrame& base, const WeatherFrame& frame, uint8_t* buf, size_t len);
+size_t encodeVenueDelta(const VenueFrame& base, const VenueFrame& frame, uint8_t* buf, size_t len);
+
+#endif // HOT_PACKET_BINARY_H
@@ -2,11 +2,15 @@
 #define HOT_PACKET_PARSER_H
 
 #include <Arduino.h>
+#include "types.h"
 
 bool isHotPacket(const char* text);
 int parseHotPacketType(const char* text);
+
+// Parse a hot packet with its registered parser and publish it to the GUI (meshtastic callback task)
 void processHotPacket(const char* text);
-int parseWeatherData(char* input, const String& timestamp);
-void parseVenueEventData(const char* input);
+
+// The same for a binary hot packet received on PRIVATE_APP (hot_packet_binary.h)
+void processBinaryHotPacket(const uint8_t* data, size_t size);
 
 #endif // HOT_PACKET_PARSER_H
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "hot_packet_schema.h"
+#include "config.h"
+
+static void fieldError(const hpSchema_t& schema, const hpRecord_t& record, uint8_t repeat,
+                       const hpField_t& field, const char* problem) {
+    Serial.print(schema.name);
+    Serial.print(" packet: ");
+    Serial.print(field.name);
+    if (record.maxRepeat > 1) Serial.print(repeat + 1);
+    Serial.print(" ");
+    Serial.println(problem);
+}
+
+/**
+ * Parse "[+|-]digits[.digits]" as hundredths (extra decimals truncated)
+ * Returns false if there are no digits or any other character
+ */
+static bool parseHundredths(const char* s, size_t len, int32_t& out) {
+    size_t i = 0;
+    bool negative = false;
+    if (i < len && (s[i] == '-' || s[i] == '+')) negative = (s[i++] == '-');
+
+    int32_t whole = 0, frac = 0;
+    uint8_t digits = 0, fracDigits = 0;
+    for (; i < len && s[i] >= '0' && s[i] <= '9'; i++, digits++) {
+        if (whole < 1000000) whole = whole * 10 + (s[i] - '0');  // Saturates; fields clamp far lower
+    }
+    if (i < len && s[i] == '.') {
+        for (i++; i < len && s[i] >= '0' && s[i] <= '9'; i++, digits++) {
+            if (fracDigits < 2) {
+                frac = frac * 10 + (s[i] - '0');
+                fracDigits++;
+            }
+        }
+    }
+    if (digits == 0 || i != len) return false;
+
+    while (fracDigits < 2) {
+        frac *= 10;
+        fracDigits++;
+    }
+    out = whole * 100 + frac;
+    if (negative) out = -out;
+    return true;
+}
+
+static void storeNumber(uint8_t* dest, uint8_t size, int32_t value) {
+    // Range already clamped to the field, so the low bytes are the value for either signedness
+    switch (size) {
+        case 1: { uint8_t v = (uint8_t)value; memcpy(dest, &v, 1); break; }
+        case 2: { uint16_t v = (uint16_t)value; memcpy(dest, &v, 2); break; }
+        default: { uint32_t v = (uint32_t)value; memcpy(dest, &v, 4); break; }
+    }
+}
+
+/**
+ * Convert and store one field of len characters at p into dest
+ * Returns false with a Serial message if it is not a number its field accepts
+ */
+static bool storeField(const hpSchema_t& schema, const hpRecord_t& record, uint8_t repeat,
+                       const hpField_t& field, const char* p, size_t len, uint8_t* dest) {
+    if (field.kind == HP_FIELD_TEXT) {
+        if (len >= field.size) {
+            fieldError(schema, record, repeat, field, "too long, truncating");
+            len = field.size - 1;
+        }
+        memcpy(dest, p, len);
+        dest[len] = '\0';
+        return true;
+    }
+
+    int32_t value;
+    if (len > HOT_PKT_NUMBER_MAX_LEN || !parseHundredths(p, len, value)) {
+        fieldError(schema, record, repeat, field, "is not a number");
+        return false;
+    }
+    if (value < 0 && !field.isSigned) {
+        fieldError(schema, record, repeat, field, "is negative");
+        return false;
+    }
+    if (field.kind == HP_FIELD_INT) value /= 100;  // Truncated like String::toInt()
+    if (field.kind == HP_FIELD_TENTHS) value /= 10;
+    if (value < field.min) value = field.min;
+    if (value > field.max) value = field.max;
+    storeNumber(dest, field.size, value);
+    return true;
+}
+
+/**
+ * Store one row of a loose record, p..end (end is its '#'); the last field
+ * takes the rest of the row. Returns false, with the row zeroed, if it has
+ * too few fields or a bad number.
+ */
+static bool storeLooseRow(const hpSchema_t& schema, const hpRecord_t& record, uint8_t repeat,
+                          const char* p, const char* end, uint8_t* base) {
+    for (uint8_t f = 0; f < record.fieldCount; f++) {
+        const hpField_t& field = record.fields[f];
+        const char* fieldEnd = end;
+        if (f + 1 < record.fieldCount) {
+            fieldEnd = (const char*)memchr(p, ',', end - p);
+            if (fieldEnd == NULL) {
+                fieldError(schema, record, repeat, field, "missing, row skipped");
+                memset(base, 0, record.stride);
+                return false;
+            }
+        }
+        bool empty = fieldEnd == p;
+        if ((empty && field.kind != HP_FIELD_TEXT) ||
+            !storeField(schema, record, repeat, field, p, fieldEnd - p, base + field.offset)) {
+            if (empty) fieldError(schema, record, repeat, field, "is empty, row skipped");
+            memset(base, 0, record.stride);
+            return false;
+        }
+        p = fieldEnd + 1;
+    }
+    return true;
+}
+
+// Rows of a loose last record up to its maxRepeat; returns how many were stored
+static uint8_t parseLooseRows(const hpSchema_t& schema, const hpRecord_t& record, const char* p, uint8_t* frame) {
+    uint8_t stored = 0;
+    bool overflow = false;
+    for (const char* end = strchr(p, '#'); end != NULL; p = end + 1, end = strchr(p, '#')) {
+        if (stored == record.maxRepeat) {
+            overflow = true;
+            break;
+        }
+        if (storeLooseRow(schema, record, stored, p, end, frame + record.offset + (size_t)stored * record.stride)) {
+            stored++;
+        }
+    }
+    if (overflow) {
+        Serial.print(schema.name);
+        Serial.print(" packet: more than ");
+        Serial.print(record.maxRepeat);
+        Serial.println(" rows, extras ignored");
+    }
+    return stored;
+}
+
+// True if nothing after p looks like another field (only the last record can run out early)
+static bool noMoreFields(const char* p) {
+    return strpbrk(p, "#,") == NULL;
+}
+
+bool parseHotPacketFields(const hpSchema_t& schema, const char* text, uint8_t* frame) {
+    if (!text) {
+        Serial.print(schema.name);
+        Serial.println(" packet: NULL input");
+        return false;
+    }
+    if (text[0] != '|' || text[1] != '#' || text[2] == '\0' || text[3] == '\0' || text[4] != '#') {
+        Serial.print(schema.name);
+        Serial.println(" packet: bad header");
+        return false;
+    }
+
+    const char* p = text + HOT_PKT_HEADER_OFFSET;
+
+    for (uint8_t r = 0; r < schema.recordCount; r++) {
+        const hpRecord_t& record = schema.records[r];
+        uint8_t repeat = 0;
+
+        if (record.loose) {
+            repeat = parseLooseRows(schema, record, p, frame);
+            if (repeat < record.minRepeat) {
+                Serial.print(schema.name);
+                Serial.println(" packet: too few rows");
+                return false;
+            }
+            frame[record.countOffset] = repeat;
+            return true;  // Always the last record; trailing text is ignored
+        }
+
+        for (; repeat < record.maxRepeat; repeat++) {
+            if (repeat >= record.minRepeat && noMoreFields(p)) break;
+            uint8_t* base = frame + record.offset + (size_t)repeat * record.stride;
+
+            for (uint8_t f = 0; f < record.fieldCount; f++) {
+                const hpField_t& field = record.fields[f];
+                char terminator = (f + 1 == record.fieldCount) ? '#' : ',';
+
+                // Scan to the next delimiter; it must be the one this field expects
+                const char* end = p;
+                while (*end != '\0' && *end != '#' && *end != ',') end++;
+                if (*end == '\0') {
+                    fieldError(schema, record, repeat, field, "missing (unexpected end)");
+                    return false;
+                }
+                if (*end != terminator) {
+                    fieldError(schema, record, repeat, field, "followed by the wrong delimiter");
+                    return false;
+                }
+
+                size_t len = end - p;
+                if (len == 0) {
+                    fieldError(schema, record, repeat, field, "is empty");
+                    return false;
+                }
+
+                if (!storeField(schema, record, repeat, field, p, len, base + field.offset)) return false;
+
+                p = end + 1;
+            }
+        }
+
+        if (record.countOffset >= 0) frame[record.countOffset] = repeat;
+    }
+
+    // Anything after the last field must not look like another field
+    if (!noMoreFields(p)) {
+        Serial.print(schema.name);
+        Serial.println(" packet malformed - extra fields");
+        return false;
+    }
+    return true;
+}
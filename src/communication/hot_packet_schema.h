@@ -0,0 +1,130 @@
+#ifndef HOT_PACKET_SCHEMA_H
+#define HOT_PACKET_SCHEMA_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+
+/**
+ * Declarative hot packet schemas
+ *
+ * A hot packet is "|#NN#" followed by records; a record is one or more fields
+ * separated by ',' and ends in '#'. A schema lists the records of one packet
+ * type and, for each field, where it lands in a POD frame (offsetof), how big
+ * it may be and the range numbers are clamped to. A record may repeat (four
+ * forecast hours); only the last record may repeat a variable number of
+ * times, and then stores how many it got in the frame.
+ *
+ * The last record may also be loose, for free text where a bad row shouldn't
+ * cost the whole packet (the venue table). Its last field runs to the '#',
+ * commas included, and text fields may be empty. A row that does not fit is
+ * skipped, and rows past maxRepeat are ignored, as is anything after the last
+ * '#'.
+ *
+ * parseHotPacketFrame<Frame, SCHEMA>() runs a schema in one pass with no
+ * allocation or copy, straight into the caller's frame, so on error the frame
+ * holds a partial parse and must not be used (the TripleBuffer writer slot is
+ * simply not published). The schema is
+ * checked against its frame at compile time, so adding a packet type is a
+ * frame struct, a schema and a registry line in hot_packet_parser.cpp.
+ * Host-compiled by the hot packet benchmark.
+ */
+
+typedef enum {
+    HP_FIELD_TEXT,        // char[], truncated with a warning
+    HP_FIELD_INT,         // Whole number (decimals truncated), clamped to min..max
+    HP_FIELD_TENTHS,      // Fixed point x10 (further decimals truncated), clamped to min..max
+    HP_FIELD_HUNDREDTHS   // Fixed point x100, clamped to min..max
+} hpFieldKind_t;
+
+typedef struct {
+    const char* name;     // For error messages (repeats get their number appended)
+    hpFieldKind_t kind;
+    uint16_t offset;      // Within the record
+    uint8_t size;         // Text buffer bytes, or integer width (1, 2 or 4)
+    bool isSigned;        // Numbers: an unsigned field rejects negative values
+    int32_t min;
+    int32_t max;
+} hpField_t;
+
+typedef struct {
+    const hpField_t* fields;
+    uint8_t fieldCount;
+    uint16_t offset;      // Frame offset of the first repeat
+    uint16_t stride;      // Bytes between repeats (the record size)
+    uint8_t minRepeat;
+    uint8_t maxRepeat;
+    int16_t countOffset;  // uint8_t in the frame that receives the repeat count, -1 for none
+    bool loose;           // Last record only: skip bad rows instead of failing (see above)
+} hpRecord_t;
+
+typedef struct {
+    const char* name;     // Error message prefix, e.g. "Weather"
+    const hpRecord_t* records;
+    uint8_t recordCount;
+} hpSchema_t;
+
+// Field declarations - the size and signedness come from the frame member itself
+#define HP_TEXT(name, type, member) \
+    {name, HP_FIELD_TEXT, offsetof(type, member), sizeof(type::member), false, 0, 0}
+#define HP_NUMBER(name, kind, type, member, lo, hi) \
+    {name, kind, offsetof(type, member), sizeof(type::member), \
+     std::is_signed<decltype(type::member)>::value, lo, hi}
+
+#define HP_COUNT(array) (uint8_t)(sizeof(array) / sizeof(array[0]))
+
+// Compile-time schema checks (C++11 constexpr, hence the recursion)
+constexpr bool hpRangeFits(const hpField_t& f) {
+    return f.isSigned
+        ? (f.min >= -(int64_t(1) << (8 * f.size - 1)) && f.max < (int64_t(1) << (8 * f.size - 1)))
+        : (f.min >= 0 && f.max < (int64_t(1) << (8 * f.size)));
+}
+
+constexpr bool hpFieldValid(const hpField_t& f, uint16_t recordSize) {
+    return f.name != nullptr && f.offset + f.size <= recordSize &&
+           (f.kind == HP_FIELD_TEXT
+                ? f.size >= 2
+                : (f.size == 1 || f.size == 2 || f.size == 4) && f.min <= f.max && hpRangeFits(f));
+}
+
+constexpr bool hpFieldsValid(const hpField_t* fields, uint8_t count, uint16_t recordSize) {
+    return count == 0 || (hpFieldValid(fields[0], recordSize) && hpFieldsValid(fields + 1, count - 1, recordSize));
+}
+
+constexpr bool hpRecordValid(const hpRecord_t& r, size_t frameSize, bool last) {
+    return r.fieldCount > 0 && r.stride > 0 && r.maxRepeat > 0 && r.minRepeat <= r.maxRepeat &&
+           r.offset + (size_t)r.maxRepeat * r.stride <= frameSize &&
+           (r.minRepeat == r.maxRepeat || (last && r.countOffset >= 0)) &&
+           (!r.loose || (last && r.countOffset >= 0)) &&
+           r.countOffset < (int32_t)frameSize &&
+           hpFieldsValid(r.fields, r.fieldCount, r.stride);
+}
+
+constexpr bool hpRecordsValid(const hpRecord_t* records, uint8_t count, size_t frameSize) {
+    return count == 0 ||
+           (hpRecordValid(records[0], frameSize, count == 1) && hpRecordsValid(records + 1, count - 1, frameSize));
+}
+
+constexpr bool hpSchemaValid(const hpSchema_t& schema, size_t frameSize) {
+    return schema.name != nullptr && schema.recordCount > 0 &&
+           hpRecordsValid(schema.records, schema.recordCount, frameSize);
+}
+
+/**
+ * Run a schema over a hot packet into a zeroed frame (use parseHotPacketFrame)
+ * Returns false with a Serial message on the first error
+ */
+bool parseHotPacketFields(const hpSchema_t& schema, const char* text, uint8_t* frame);
+
+// Parse a hot packet in place into frame (zeroed first); on error its contents are undefined
+template <typename T, const hpSchema_t& schema>
+bool parseHotPacketFrame(const char* text, T& frame) {
+    static_assert(std::is_trivially_copyable<T>::value, "Hot packet frame must be trivially copyable");
+    static_assert(hpSchemaValid(schema, sizeof(T)), "Hot packet schema does not fit its frame");
+
+    memset(&frame, 0, sizeof(frame));
+    return parseHotPacketFields(schema, text, (uint8_t*)&frame);
+}
+
+#endif // HOT_PACKET_SCHEMA_H
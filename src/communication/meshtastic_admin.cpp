@@ -7,13 +7,11 @@
 #include "pb_encode.h"
 #include "pb_decode.h"
 #include "globals.h"
+#include "meshtastic_tx.h"
 
 // External declarations from mt_protocol.cpp in meshtastic library
 extern uint32_t my_node_num;
 
-// Forward declaration - this function exists in mt_protocol.cpp
-extern bool _mt_send_toRadio(meshtastic_ToRadio toRadio);
-
 // Desired GPS configuration settings
 static const GpsConfigSettings desiredGpsConfig = {
     .gps_mode = meshtastic_Config_PositionConfig_GpsMode_ENABLED,
@@ -30,7 +28,7 @@ static bool gpsConfigSentSuccessfully = false;  // Track if config was sent (wil
 // Helper function to send admin messages
 static bool sendAdminMessage(meshtastic_AdminMessage *adminMsg) {
     // Encode the admin message into a temporary buffer
-    pb_byte_t admin_buf[256];
+    pb_byte_t admin_buf[sizeof(meshtastic_Data_payload_t().bytes)];
     pb_ostream_t admin_stream = pb_ostream_from_buffer(admin_buf, sizeof(admin_buf));
 
     if (!pb_encode(&admin_stream, meshtastic_AdminMessage_fields, adminMsg)) {
@@ -38,22 +36,14 @@ static bool sendAdminMessage(meshtastic_AdminMessage *adminMsg) {
         return false;
     }
 
-    // Create a MeshPacket with the admin message as payload
-    meshtastic_MeshPacket meshPacket = meshtastic_MeshPacket_init_default;
-    meshPacket.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
-    meshPacket.id = random(0x7FFFFFFF);
-    meshPacket.decoded.portnum = meshtastic_PortNum_ADMIN_APP;
-    meshPacket.to = my_node_num;  // Send to the connected radio
-    meshPacket.channel = 0;
-    meshPacket.decoded.payload.size = admin_stream.bytes_written;
-    memcpy(meshPacket.decoded.payload.bytes, admin_buf, admin_stream.bytes_written);
-
-    // Wrap in ToRadio and send
-    meshtastic_ToRadio toRadio = meshtastic_ToRadio_init_default;
-    toRadio.which_payload_variant = meshtastic_ToRadio_packet_tag;
-    toRadio.packet = meshPacket;
-
-    return _mt_send_toRadio(toRadio);
+    // Queued as the payload of a packet to the connected radio, ahead of anything going over the air
+    mt_packet_t packet = {};
+    packet.to = my_node_num;
+    packet.channel = 0;
+    packet.port = meshtastic_PortNum_ADMIN_APP;
+    packet.size = admin_stream.bytes_written;
+
+    return meshQueuePacket(MESH_TX_ADMIN, &packet, admin_buf);
 }
 
 bool mt_send_admin_reboot(int32_t seconds) {
@@ -80,7 +70,7 @@ bool mt_set_position_config(const meshtastic_Config_PositionConfig *config) {
 // Admin portnum callback to handle ADMIN_APP messages
 // Currently a placeholder - kept for potential future admin message handling
 void admin_portnum_callback(uint32_t from, uint32_t to, uint8_t channel,
-                           meshtastic_PortNum port, meshtastic_Data_payload_t *payload) {
+                           meshtastic_PortNum port, const uint8_t *payload, size_t size) {
     // Only process actual ADMIN_APP messages (port 6)
     if (port != meshtastic_PortNum_ADMIN_APP) {
         return;
@@ -92,12 +82,15 @@ void admin_portnum_callback(uint32_t from, uint32_t to, uint8_t channel,
         return;
     }
 
-    // If we ever receive an ADMIN_APP message, log it for debugging
-    meshtastic_AdminMessage adminMsg = meshtastic_AdminMessage_init_default;
-    pb_istream_t stream = pb_istream_from_buffer(payload->bytes, payload->size);
+    // If we ever receive an ADMIN_APP message, log it for debugging. The variant is the tag
+    // of its first field - no need to decode a whole AdminMessage onto the stack.
+    pb_istream_t stream = pb_istream_from_buffer(payload, size);
+    pb_wire_type_t wireType;
+    uint32_t variant;
+    bool eof;
 
-    if (pb_decode(&stream, meshtastic_AdminMessage_fields, &adminMsg)) {
-        Serial.printf("*** Received ADMIN_APP message, variant=%d ***\n", adminMsg.which_payload_variant);
+    if (pb_decode_tag(&stream, &wireType, &variant, &eof)) {
+        Serial.printf("*** Received ADMIN_APP message, variant=%lu ***\n", variant);
     }
 }
 
@@ -9,12 +9,12 @@
 
 // Send an admin command to reboot the Meshtastic radio
 // seconds: number of seconds until reboot (0 = immediate, <0 = cancel reboot)
-// Returns true if the command was sent successfully, false otherwise
+// Returns true if the command was queued for meshtasticTask to send (see meshtastic_tx.h), false otherwise
 bool mt_send_admin_reboot(int32_t seconds = 0);
 
 // Set the position configuration on the Meshtastic radio
 // config: the position configuration to set
-// Returns true if the command was sent successfully, false otherwise
+// Returns true if the command was queued for meshtasticTask to send (see meshtastic_tx.h), false otherwise
 bool mt_set_position_config(const meshtastic_Config_PositionConfig *config);
 
 // GPS configuration settings that we want to enforce
@@ -38,14 +38,14 @@ void requestMetadataOnce();
 // Reset GPS update interval to default before entering sleep mode
 // Sets gps_update_interval to 0 (which resets to default 2 minute interval)
 // Should be called after SLEEP_PIN goes HIGH, before entering deep sleep
-// Returns true if the command was sent successfully, false otherwise
+// Returns true if the command was queued for meshtasticTask to send (see meshtastic_tx.h), false otherwise
 bool resetGpsIntervalBeforeSleep();
 
 // Admin portnum callback to handle ADMIN_APP messages
 // Note: Currently a placeholder - kept for future admin message handling
-// Must be registered with set_portnum_callback() in setup
+// Called by mesh_packet_deliver() with the encoded AdminMessage
 void admin_portnum_callback(uint32_t from, uint32_t to, uint8_t channel,
-                           meshtastic_PortNum port, meshtastic_Data_payload_t *payload);
+                           meshtastic_PortNum port, const uint8_t *payload, size_t size);
 
 // Callback from mt_protocol.cpp when FromRadio.config (position) is received
 // Called by mt_protocol.cpp line 195 when position config is received from radio
@@ -0,0 +1,66 @@
+#include "meshtastic_nodes.h"
+#include <math.h>
+#include "pb_decode.h"
+#include "meshtastic/telemetry.pb.h"
+#include "globals.h"
+#include "tasks/gps_task.h"
+
+void meshNodeReport(const mt_node_t *node, uint32_t now) {
+    // The report is the radio's node DB, not something we heard: its age comes
+    // from last_heard against GPS time, and nothing here marks the node fresh
+    GpsSnapshot snap;
+    gpsSnapshot.read(snap);
+    meshNodes.reported(node->node_num, node->last_heard_from, gpsUtcNow(snap), now);
+
+    if (!isnan(node->latitude) && !isnan(node->longitude)) {
+        meshNodes.position(node->node_num, (int32_t)lround(node->latitude * 1e7),
+                           (int32_t)lround(node->longitude * 1e7), now, false);
+    }
+    meshNodes.metrics(node->node_num, node->battery_level, node->channel_utilization, node->air_util_tx, now,
+                      false);
+}
+
+bool meshNodePacket(const mt_packet_t *packet, const uint8_t *payload, uint32_t now) {
+    // Decoded one at a time in meshtasticTask; static keeps them (~150 and ~270 bytes) off its stack
+    static meshtastic_Position position;
+    static meshtastic_Telemetry telemetry;
+    pb_istream_t stream = pb_istream_from_buffer(payload, packet->size);
+
+    switch (packet->port) {
+        case meshtastic_PortNum_NODEINFO_APP:
+            // User (names, hardware) only - nothing the table keeps but the time
+            meshNodes.heard(packet->from, now);
+            return true;
+
+        case meshtastic_PortNum_POSITION_APP:
+            position = meshtastic_Position_init_zero;
+            if (!pb_decode(&stream, meshtastic_Position_fields, &position)) {
+                return true;
+            }
+            if (position.has_latitude_i && position.has_longitude_i &&
+                (position.latitude_i != 0 || position.longitude_i != 0)) {
+                meshNodes.position(packet->from, position.latitude_i, position.longitude_i, now);
+            } else {
+                meshNodes.heard(packet->from, now);  // No fix yet
+            }
+            return true;
+
+        case meshtastic_PortNum_TELEMETRY_APP:
+            telemetry = meshtastic_Telemetry_init_zero;
+            if (!pb_decode(&stream, meshtastic_Telemetry_fields, &telemetry)) {
+                return true;
+            }
+            if (telemetry.which_variant == meshtastic_Telemetry_device_metrics_tag) {
+                const meshtastic_DeviceMetrics &m = telemetry.variant.device_metrics;
+                meshNodes.metrics(packet->from, m.has_battery_level ? (uint8_t)(m.battery_level > 255 ? 255 : m.battery_level) : 0,
+                                  m.has_channel_utilization ? m.channel_utilization : NAN,
+                                  m.has_air_util_tx ? m.air_util_tx : NAN, now);
+            } else {
+                meshNodes.heard(packet->from, now);
+            }
+            return true;
+
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef MESHTASTIC_NODES_H
+#define MESHTASTIC_NODES_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "Meshtastic.h"
+
+// Feeding meshNodes (NodeTable) from what the radio tells us. Both run in meshtasticTask.
+
+// A node from the radio's node report (connected_callback)
+void meshNodeReport(const mt_node_t *node, uint32_t now);
+
+// A NODEINFO_APP, POSITION_APP or TELEMETRY_APP packet; false for other ports
+bool meshNodePacket(const mt_packet_t *packet, const uint8_t *payload, uint32_t now);
+
+#endif // MESHTASTIC_NODES_H
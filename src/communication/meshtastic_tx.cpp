@@ -0,0 +1,92 @@
+#include "meshtastic_tx.h"
+#include <atomic>
+#include "Meshtastic.h"
+#include "pb_decode.h"
+#include "globals.h"
+
+// Packet being sent - meshtasticTask's, kept off its stack
+static MeshTxItem txItem;
+
+// Set while meshTxService() holds a packet it has taken from the queue but not yet written
+static std::atomic<bool> txBusy{false};
+
+bool meshQueuePacket(MeshTxPriority priority, const mt_packet_t *packet, const uint8_t *payload,
+                     uint8_t retries) {
+    if (!meshTxQueue.push(priority, *packet, payload, retries)) {
+        return false;
+    }
+    // Wakes meshtasticTask from mt_serial_wait_for_data()
+    if (meshtasticTaskHandle != NULL) {
+        xTaskNotifyGive(meshtasticTaskHandle);
+    }
+    return true;
+}
+
+bool meshQueueText(const char *text, uint32_t dest, uint8_t channel, MeshTxPriority priority,
+                   uint8_t retries) {
+    size_t len = strlen(text);
+    if (len > sizeof(txItem.payload)) {
+        Serial.println("Text message too long");
+        return false;
+    }
+
+    mt_packet_t packet = {};
+    packet.to = dest;
+    packet.channel = channel;
+    packet.want_ack = true;
+    packet.port = meshtastic_PortNum_TEXT_MESSAGE_APP;
+    packet.size = len;
+
+    Serial.printf("\nQueueing text message '%s' to %lu\n", text, dest);
+    return meshQueuePacket(priority, &packet, (const uint8_t *)text, retries);
+}
+
+void meshTxService(uint32_t now) {
+    txBusy.store(true);
+
+    // Nakked or timed out with retries left: back into their lane under a new id
+    while (meshAckTracker.due(now, txItem)) {
+        Serial.printf("Meshtastic packet to %lu not delivered, resending (%d retries left)\n",
+                      txItem.packet.to, txItem.retries);
+        if (!meshTxQueue.push(txItem.priority, txItem.packet, txItem.payload, txItem.retries, txItem.attempt)) {
+            Serial.println("Warning: Meshtastic TX lane full, resend dropped");
+        }
+    }
+
+    while (meshTxQueue.pop(now, txItem)) {
+        if (!mt_send_packet(&txItem.packet, txItem.payload)) {
+            Serial.printf("Warning: Meshtastic send failed, port %d packet dropped\n", txItem.packet.port);
+        } else if (txItem.packet.want_ack) {
+            meshAckTracker.sent(txItem, now);  // mt_send_packet() filled in its id
+        }
+    }
+    txBusy.store(false);
+}
+
+void meshAckRouted(uint32_t requestId, const uint8_t *payload, size_t size, uint32_t now) {
+    static meshtastic_Routing routing;  // Route discovery arrays make it large; kept off the stack
+    routing = meshtastic_Routing_init_zero;
+    pb_istream_t stream = pb_istream_from_buffer(payload, size);
+    if (!pb_decode(&stream, meshtastic_Routing_fields, &routing) ||
+        routing.which_variant != meshtastic_Routing_error_reason_tag) {
+        return;  // Route discovery traffic, not an ack or nak
+    }
+
+    if (!meshAckTracker.routed(requestId, routing.error_reason, now)) {
+        return;  // Not ours, or already resolved
+    }
+    if (routing.error_reason != meshtastic_Routing_Error_NONE) {
+        Serial.printf("Meshtastic packet %lu nakked (routing error %d)\n", requestId, routing.error_reason);
+    }
+}
+
+bool meshTxFlush(uint32_t timeoutMs) {
+    uint32_t start = millis();
+    while (!meshTxQueue.empty() || txBusy.load()) {
+        if (millis() - start >= timeoutMs) {
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    return true;
+}
@@ -0,0 +1,33 @@
+#ifndef MESHTASTIC_TX_H
+#define MESHTASTIC_TX_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "utils/mesh_tx_queue.h"
+
+// Sending to the Meshtastic radio. Every packet goes through meshTxQueue and is
+// encoded and written by meshtasticTask alone, so the TX encode buffer has one
+// owner and a send never waits on (or interleaves with) another task's.
+
+// Queue a packet for meshtasticTask to send and wake it. A want_ack packet that is
+// nakked or never acked is queued again up to retries times (meshAckTracker).
+// Returns false if that priority's lane is full (retry later)
+bool meshQueuePacket(MeshTxPriority priority, const mt_packet_t *packet, const uint8_t *payload,
+                     uint8_t retries = 0);
+
+// Queue a text message (TEXT_MESSAGE_APP, want_ack); false if too long or the lane is full
+bool meshQueueText(const char *text, uint32_t dest, uint8_t channel, MeshTxPriority priority,
+                   uint8_t retries = 0);
+
+// meshtasticTask: queue resends that are due, then send everything the queue lets
+// out now (priority order, rate limit)
+void meshTxService(uint32_t now);
+
+// meshtasticTask: a ROUTING_APP reply to requestId arrived (encoded Routing payload)
+void meshAckRouted(uint32_t requestId, const uint8_t *payload, size_t size, uint32_t now);
+
+// Wait up to timeoutMs until everything queued has been written to the radio
+// Returns false on timeout
+bool meshTxFlush(uint32_t timeoutMs);
+
+#endif // MESHTASTIC_TX_H
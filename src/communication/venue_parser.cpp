@@ -0,0 +1,54 @@
+#include "venue_parser.h"
+#include "config.h"
+#include "hot_packet_schema.h"
+
+static constexpr hpField_t VENUE_EVENT_FIELDS[] = {
+    HP_TEXT("venue", VenueEvent, venue),
+    HP_TEXT("event", VenueEvent, event),
+};
+
+static constexpr hpRecord_t VENUE_RECORDS[] = {
+    {VENUE_EVENT_FIELDS, HP_COUNT(VENUE_EVENT_FIELDS), offsetof(VenueFrame, events), sizeof(VenueEvent),
+     0, VENUE_MAX_EVENTS, offsetof(VenueFrame, count), true},
+};
+
+static constexpr hpSchema_t VENUE_SCHEMA = {"Venue/Event", VENUE_RECORDS, HP_COUNT(VENUE_RECORDS)};
+
+static void trimInPlace(char* s) {
+    size_t start = 0;
+    while (s[start] == ' ' || s[start] == '\t') start++;
+    size_t end = start + strlen(s + start);
+    size_t len = end - start;
+    while (len > 0 && (s[start + len - 1] == ' ' || s[start + len - 1] == '\t')) len--;
+    memmove(s, s + start, len);
+    memset(s + len, 0, end - len);  // Zero the tail so equal rows are equal bytes (binary deltas)
+}
+
+static uint32_t fnv1a(uint32_t hash, const char* s) {
+    // Include the terminator so "ab","c" and "a","bc" differ
+    do {
+        hash ^= (uint8_t)*s;
+        hash *= 16777619u;
+    } while (*s++ != '\0');
+    return hash;
+}
+
+uint32_t hashVenueEvents(const VenueFrame& frame) {
+    uint32_t hash = 2166136261u;
+    for (uint8_t i = 0; i < frame.count; i++) {
+        hash = fnv1a(hash, frame.events[i].venue);
+        hash = fnv1a(hash, frame.events[i].event);
+    }
+    return hash;
+}
+
+bool parseVenueFrame(const char* text, VenueFrame& frame) {
+    if (!parseHotPacketFrame<VenueFrame, VENUE_SCHEMA>(text, frame)) return false;
+
+    for (uint8_t i = 0; i < frame.count; i++) {
+        trimInPlace(frame.events[i].venue);
+        trimInPlace(frame.events[i].event);
+    }
+    frame.hash = hashVenueEvents(frame);
+    return true;
+}
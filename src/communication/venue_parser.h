@@ -0,0 +1,27 @@
+#ifndef VENUE_PARSER_H
+#define VENUE_PARSER_H
+
+#include <Arduino.h>
+#include "types.h"
+
+/**
+ * Venue/event hot packet parser
+ *
+ * Format: |#02#venue,event#venue,event#...#
+ * e.g.    |#02#Sawgrass,Jazz Trio#Spanish Springs,Country Night#
+ *
+ * Declared as a hot packet schema (hot_packet_schema.h) and parsed once, in
+ * the callback task, into VenueEvent rows with surrounding spaces trimmed.
+ * The frame's hash lets the GUI skip rebuilding the table when the same
+ * lineup is sent again. The record is loose, as the table used to be: the
+ * event is everything after the first comma, a pair without a comma is
+ * skipped and only the first VENUE_MAX_EVENTS pairs are kept. Only a bad
+ * header rejects the packet (the frame is then not to be published). rcvTime
+ * is left empty for the caller. Host-compiled.
+ */
+bool parseVenueFrame(const char* text, VenueFrame& frame);
+
+// FNV-1a over the rows, as stored in VenueFrame::hash
+uint32_t hashVenueEvents(const VenueFrame& frame);
+
+#endif // VENUE_PARSER_H
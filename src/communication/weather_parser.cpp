@@ -0,0 +1,56 @@
+#include "weather_parser.h"
+#include "config.h"
+#include "hot_packet_schema.h"
+
+static constexpr hpField_t WX_CURRENT_FIELDS[] = {
+    HP_NUMBER("cur_temp", HP_FIELD_TENTHS, WeatherFrame, curTemp, -990, 9990),
+};
+
+static constexpr hpField_t WX_HOUR_FIELDS[] = {
+    HP_TEXT("fcast_hr", WeatherForecastHour, hour),
+    HP_TEXT("fcast_glyph", WeatherForecastHour, glyph),
+    HP_NUMBER("fcast_temp", HP_FIELD_INT, WeatherForecastHour, temp, -99, 999),
+    HP_NUMBER("fcast_precip", HP_FIELD_HUNDREDTHS, WeatherForecastHour, precip, 0, 65535),
+};
+
+static constexpr hpRecord_t WX_RECORDS[] = {
+    {WX_CURRENT_FIELDS, HP_COUNT(WX_CURRENT_FIELDS), 0, sizeof(WeatherFrame), 1, 1, -1, false},
+    {WX_HOUR_FIELDS, HP_COUNT(WX_HOUR_FIELDS), offsetof(WeatherFrame, hours), sizeof(WeatherForecastHour),
+     WX_FORECAST_HOURS, WX_FORECAST_HOURS, -1, false},
+};
+
+static constexpr hpSchema_t WEATHER_SCHEMA = {"Weather", WX_RECORDS, HP_COUNT(WX_RECORDS)};
+
+bool parseWeatherFrame(const char* text, WeatherFrame& frame) {
+    if (!parseHotPacketFrame<WeatherFrame, WEATHER_SCHEMA>(text, frame)) return false;
+
+    // The current temperature is the first field; shown as sent, with or without its decimal
+    const char* curTemp = text + HOT_PKT_HEADER_OFFSET;
+    const char* end = strchr(curTemp, '#');
+    frame.curTempDecimal = memchr(curTemp, '.', end - curTemp) != NULL;
+    frame.valid = true;
+    return true;
+}
+
+void formatWeatherCurTemp(const WeatherFrame& frame, char* buf, size_t len) {
+    if (!frame.curTempDecimal) {
+        snprintf(buf, len, "%d", frame.curTemp / 10);
+        return;
+    }
+    int tenths = frame.curTemp < 0 ? -frame.curTemp : frame.curTemp;
+    snprintf(buf, len, "%s%d.%d", frame.curTemp < 0 ? "-" : "", tenths / 10, tenths % 10);
+}
+
+void formatWeatherTemp(int16_t temp, char* buf, size_t len) {
+    snprintf(buf, len, "%d", temp);
+}
+
+void formatWeatherPrecip(uint16_t precip, char* buf, size_t len) {
+    if (precip == 0) {
+        buf[0] = '\0';  // No precipitation is shown blank
+    } else if (precip % 10 == 0) {
+        snprintf(buf, len, "%u.%u", precip / 100, (precip / 10) % 10);
+    } else {
+        snprintf(buf, len, "%u.%02u", precip / 100, precip % 100);
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef WEATHER_PARSER_H
+#define WEATHER_PARSER_H
+
+#include <Arduino.h>
+#include "types.h"
+
+/**
+ * Weather hot packet parser
+ *
+ * Format: |#01#temp#hr,glyph,temp,precip#hr,glyph,temp,precip#hr,glyph,temp,precip#hr,glyph,temp,precip#
+ * e.g.    |#01#77#10am,4,77,1.2#11am,4,78,0.0#12pm,7,79,0.03#1pm,7,80,0.01#
+ *
+ * Declared as a hot packet schema (hot_packet_schema.h): temperatures and
+ * precipitation are converted straight into the WeatherFrame as numbers. The
+ * current temperature keeps one decimal and whether it was sent with one, so
+ * "72.5", "100.0" and "77" display as sent; forecast temperatures are whole
+ * degrees. Precipitation displays in its shortest form ("1.20" as "1.2").
+ * Nothing is allocated and the input is not modified. Parsed in place: on any
+ * error the frame holds a partial parse and must not be published; on success
+ * every field except rcvTime (left empty for the caller) is replaced.
+ * Host-compiled by the hot packet benchmark.
+ */
+bool parseWeatherFrame(const char* text, WeatherFrame& frame);
+
+// Display text for WeatherFrame numbers (zero precipitation is blank)
+void formatWeatherCurTemp(const WeatherFrame& frame, char* buf, size_t len);
+void formatWeatherTemp(int16_t temp, char* buf, size_t len);
+void formatWeatherPrecip(uint16_t precip, char* buf, size_t len);
+
+#endif // WEATHER_PARSER_H
@@ -11,6 +11,7 @@
 #define DEBUG_ESP32_SLEEP 0
 #define DEBUG_ESPNOW 0
 #define DEBUG_MESHTASTIC_CONNECTION 0  // GCM connection/reconnection events
+#define DEBUG_MESHTASTIC_STATS 0       // Meshtastic frame decode time and task stack high-water marks, once a minute
 
 // Speaker pin & default settings
 #define SPEAKER_PIN 26
@@ -61,16 +62,109 @@
 #define MT_SERIAL_TX_PIN 22
 #define MT_SERIAL_RX_PIN 27
 #define MT_DEV_BAUD_RATE 9600
+#define MT_FAST_HANDSHAKE 1           // Node db in a second dump once packets flow, skipping unused variants (mt_set_fast_handshake)
+#define MT_RX_WAIT_MS 100             // meshtasticTask sleeps until UART2 RX or this long (timers, UI flags)
+#define MESHTASTIC_STATS_INTERVAL_MS 60000  // DEBUG_MESHTASTIC_STATS report period
 #define MAX_MESHTASTIC_PAYLOAD 237
+#define MESH_RX_POOL_BYTES 4096       // Received packets waiting for meshtasticCallbackTask (utils/mesh_rx_pool; power of two)
 #define HOT_PKT_HEADER_OFFSET 5
+#define HOT_PKT_RCV_TIME_STR_SIZE 32  // formatGpsTimestamp() text stored with each hot packet frame
+#define HOT_PKT_NUMBER_MAX_LEN 10     // Longest accepted numeric hot packet field
+#define HOT_BIN_MAGIC 0xC7            // First byte of a binary hot packet on PRIVATE_APP (communication/hot_packet_binary)
+#define HOT_BIN_VERSION 2             // 2: weather curTemp in tenths with a decimal flag
+#define HOT_BIN_HEADER_SIZE 3         // Magic, version, HotPacketType
+#define HOT_BIN_DELTA 0x80            // Type byte flag: update to the last sequenced frame of that type
 #define SEND_PERIOD 300
+#define MESH_DEDUP_ENTRIES 16         // Recent packets remembered to drop rebroadcast copies (utils/packet_dedup)
+#define MESH_DEDUP_WINDOW_MS 60000    // A copy of a packet id within this long of the first is a duplicate
+#define MESH_TX_QUEUE_DEPTH 4         // Outbound packets waiting per priority lane (utils/mesh_tx_queue; power of two)
+#define MESH_TX_INTERVAL_MS 1000      // Over-the-air sends earn one token per interval...
+#define MESH_TX_BURST 4               // ...banking up to this many (admin messages are exempt)
+#define MESH_TX_FLUSH_TIMEOUT_MS 500  // Sleep waits this long for queued packets to reach the radio
+#define MESH_ACK_PENDING 6            // want_ack packets awaiting a routing ack/nak (utils/mesh_ack_tracker)
+#define MESH_ACK_TIMEOUT_MS 60000     // No ack or nak by then is a timeout (the radio retransmits on its own first)
+#define MESH_ACK_RETRIES 2            // Times the AWAKE notification is queued again if not acked
+#define MESH_ACK_DESTINATIONS 4       // Destinations with delivery counters and RTT histograms
+#define MESH_ACK_RTT_BUCKETS 8        // RTT histogram: under 250 ms, 500, 1 s ... 16 s, then longer
+#define MESH_ACK_RTT_FIRST_MS 250
+#define NODE_TABLE_SLOTS 64           // Mesh node table (utils/node_table), power of two
+#define NODE_TABLE_MAX_NODES 48       // Nodes kept before the least recently heard is replaced (75% load)
+#define NODE_NEAREST_MAX 8            // Most results one nearest() query returns
+#define NODE_NEAREST_MAX_AGE_MS (30UL * 60 * 1000)  // Nodes not heard for this long aren't "nearby"
+#define NODE_REPORT_MAX_AGE_MS (24UL * 60 * 60 * 1000)  // Age given a reported node whose last_heard is unknown (and the cap)
+#define GCM_LINK_SILENCE_MS 60000     // No frame from the GCM this long: send it a config probe (utils/gcm_link_monitor)
+#define GCM_LINK_PROBE_TIMEOUT_MS 15000  // Probe unanswered by then (the config dump takes ~2 s at 9600 baud)
+#define GCM_LINK_SLOW_MS 5000         // Probe answered slower than this: link degraded
+#define GCM_LINK_DOWN_AFTER 3         // Unanswered probes in a row, with nothing received, before the link is down
+#define GCM_LINK_DOWN_PROBE_MS 60000  // Probe period once the link is down
 
 // GPS configuration
 #define GPS_RX_PIN 03
 #define GPS_TX_PIN 01
 #define GPS_BAUD 9600
 #define MAX_GPS_TIME_STALENESS_SECS 60  // Show "NO GPS" if no time update for this many seconds
-#define MIN_SPEED_FILTER_MPH 2.5        // Speeds below this are treated as 0 to filter GPS dither
+#define MIN_SPEED_FILTER_MPH 2.5        // Odometer only accumulates above this Doppler speed (filters GPS dither)
+#define GPS_EVENT_DRIVEN_RX 1           // 1 = gpsTask wakes on UART RX events, 0 = legacy 100 ms polling
+#define GPS_RX_BUFFER_SIZE 1024         // UART RX ring size (core default 256) - holds ~1 s of NMEA at 9600 baud
+#define GPS_RX_WAIT_TIMEOUT_MS 1000     // Longest gpsTask sleeps without an RX event before re-checking
+#define GPS_MAX_FIX_GAP_MS 10000        // Longer gaps between fixes (signal loss, reboot) are not integrated over
+#define GPS_ORDER_LEARN_INTERVALS 3     // Intervals in a row that must end on a new sentence type before it is adopted
+
+// GPS health diagnostics (utils/gps_health) - shown by the GPS health dialog
+#define GPS_HEALTH_WINDOW_SECS 60       // Rolling window for rates and error counts
+#define GPS_HEALTH_LOG_SECS 0           // >0 = also print the record to the debug port this often
+
+// GPS speed filter (utils/speed_filter) - retune noise values if the receiver or fix rate changes
+#define GPS_FIX_RATE_HZ 1               // Receiver navigation rate; only used when fix timestamps are missing
+#define ODOMETER_SAMPLE_MS 1000         // Odometer segments span at least this much fix time (gates tuned on 1 s segments)
+#define SPEED_KF_ACCEL_MPHPS 3.0        // Expected acceleration (mph per second) - higher tracks faster, smooths less
+#define SPEED_KF_DOPPLER_MPH 0.5        // Doppler speed noise (1 sigma)
+#define SPEED_KF_POSITION_M 2.5         // Horizontal position noise (1 sigma) for position-delta speed
+#define STATIONARY_ENTER_MPH 2.5        // Measured speed below this ...
+#define STATIONARY_ENTER_MS 400         // ... for this long (fix time) shows 0 mph
+#define STATIONARY_EXIT_MPH 3.0         // Measured speed above this ...
+#define STATIONARY_EXIT_MS 600          // ... for this long leaves the stopped state
+#define SPEED_HOLD_MS 3000              // Fix time with no speed or position before the display drops to 0
+
+// Geofences (utils/geofence) - stored in LittleFS on the spiffs partition
+#define GEOFENCE_MAX_FENCES 256            // Table grows to this as fences are added (RAM: ~48 bytes each)
+#define GEOFENCE_MAX_VERTICES 2048         // Shared polygon vertex pool limit, 8 bytes each
+#define GEOFENCE_NAME_LEN 20               // Including terminator
+#define GEOFENCE_HOME_NAME "home"          // A fence with this name replaces the home radius for at_home
+#define GEOFENCE_PACKET_MAX_POINTS 16      // Vertices per geofence hot packet
+#define GEOFENCE_COORD_STR_SIZE 13         // Packet coordinate in degrees, e.g. "-180.1234567"
+#define GEOFENCE_TOAST_MS 4000             // How long an enter/exit notice stays on screen
+#define GEOFENCE_CELL_E7 50000             // Grid cell size in 1e-7 degrees (0.005 deg, ~550 m N-S)
+#define GEOFENCE_HASH_BUCKETS 256          // Grid cells hash into this many buckets (power of 2)
+#define GEOFENCE_MAX_CELLS_PER_FENCE 64    // Larger fences skip the grid and are tested on every fix
+
+// Track logger (utils/track_codec, storage/track_log) - raw "track" partition in partitions_gcd.csv
+#define TRACK_PAGE_SIZE 256             // Flash program page; the log is written one page at a time
+#define TRACK_QUEUE_PAGES 4             // Pages buffered between gpsTask and the track task (~1 KB RAM)
+#define TRACK_MIN_INTERVAL_MS 1000      // At most one point per this much fix time, at any fix rate
+#define TRACK_IDLE_INTERVAL_MS 60000    // While stopped, one point per this long
+#define TRACK_TRIP_GAP_MS 600000        // No point for this long (or a reboot) starts a new trip
+#define TRACK_COORD_DIV 10              // Stored lat/lon resolution in 1e-7 degrees (10 = ~11 cm)
+#define TRACK_PARTITION_SUBTYPE 0x40    // Must match partitions_gcd.csv
+#define TRACK_PARTITION_SIZE 0xC0000    // Must match partitions_gcd.csv (host capacity/wear estimates)
+
+// GPS display buffer sizes (fixed so gpsTask formats them without heap allocation)
+#define GPS_DATE_STR_SIZE 16       // "Wed, Sep 30" or "NO GPS"
+#define GPS_TIME_STR_SIZE 12       // "12:59" (hhmm_str) or "12:5959" (hhmmss_str)
+#define GPS_AM_PM_STR_SIZE 4       // "AM" / "PM"
+#define GPS_HEADING_STR_SIZE 8     // "NNE" or "DEMO"
+#define GPS_SATS_HDOP_STR_SIZE 16  // "12/99.00"
+#define GPS_COORD_STR_SIZE 16      // "-179.123456" or altitude "-12345.67"
+
+// Weather hot packet (communication/weather_parser) - WeatherFrame field sizes
+#define WX_FORECAST_HOURS 4
+#define WX_HOUR_STR_SIZE 7         // "12pm" (up to 6 chars) + terminator
+#define WX_GLYPH_STR_SIZE 3        // Glyph code, up to 2 chars
+
+// Venue/event hot packet (communication/venue_parser) - VenueFrame field sizes
+#define VENUE_MAX_EVENTS 12        // Rows in the Now Playing table
+#define VENUE_NAME_STR_SIZE 24
+#define VENUE_EVENT_STR_SIZE 40
 
 // ESP-NOW configuration
 #define ESPNOW_CHANNEL 1
@@ -100,11 +194,15 @@
 // Task Stack Sizes (in bytes)
 #define GPS_TASK_STACK_SIZE 4096
 #define GUI_TASK_STACK_SIZE 8192
-#define MESHTASTIC_TASK_STACK_SIZE 4096
-#define MESHTASTIC_CALLBACK_TASK_STACK_SIZE 6144
+// The streaming codec peaks at ~1.3 KB (native_mtcodec: receive 1240, admin send 1256 bytes,
+// down from 2264/3112); the rest is Serial.printf and margin. The callback task also writes
+// geofences to LittleFS. Check the high-water marks with DEBUG_MESHTASTIC_STATS.
+#define MESHTASTIC_TASK_STACK_SIZE 3072
+#define MESHTASTIC_CALLBACK_TASK_STACK_SIZE 4096
 #define EEPROM_TASK_STACK_SIZE 2048
 #define SYSTEM_TASK_STACK_SIZE 4096  // Increased for GPS config init with debug output
 #define ESPNOW_TASK_STACK_SIZE 4096
+#define TRACK_TASK_STACK_SIZE 3072
 
 // Task Priorities
 #define GUI_TASK_PRIORITY 3
@@ -114,5 +212,6 @@
 #define ESPNOW_TASK_PRIORITY 2
 #define EEPROM_TASK_PRIORITY 1
 #define SYSTEM_TASK_PRIORITY 1
+#define TRACK_TASK_PRIORITY 1
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -0,0 +1,337 @@
+/********************************************************************************************
+*    GCD GCM Link Test - host-side (Linux) test of the GCM link monitor on a pty            *
+*                                                                                           *
+*    A fake radio thread holds the master side of a pseudo-terminal and follows a script:   *
+*    mesh traffic, a quiet mesh (answers probes), a slow radio, a dead one, line noise,     *
+*    and back. The main thread plays meshtasticTask on the slave side as mt_loop() does:    *
+*    bytes into MtFramer, frames through the streaming codec (mt_packet_codec.cpp), the     *
+*    counters into GcmLinkMonitor (utils/gcm_link_monitor.cpp, the firmware source), and    *
+*    the probes it asks for written back as want_config_id 69420 frames. Real time, with    *
+*    the monitor's timeouts scaled down to fractions of a second.                           *
+*                                                                                           *
+*    Usage:                                                                                 *
+*    1. pio run -e native_gcmlink                                                           *
+*    2. .pio/build/native_gcmlink/program [-v]                                              *
+*         -v  print every state change                                                      *
+*                                                                                           *
+*    Checks: no probe is sent while frames arrive; a quiet mesh is probed and stays up;     *
+*    a slow reply makes the link degraded; a dead radio goes down within silence plus       *
+*    downAfter probe timeouts, and only once; bytes that never make a frame keep it         *
+*    degraded rather than down; an answered probe or traffic brings it back up; and the     *
+*    measured probe RTTs match the radio's scripted reply delays. Exits 1 on failure.       *
+*                                                                                           *
+********************************************************************************************/
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "bench_check.h"
+#include "mt_framer.h"
+#include "mt_packet_codec.h"
+#include "utils/gcm_link_monitor.h"
+
+#define PROBE_NONCE 69420                // SPECIAL_NONCE in mt_protocol.cpp
+#define LOOP_MS 5                        // meshtasticTask wakes on RX or every MT_RX_WAIT_MS
+#define TRAFFIC_PERIOD_MS 40
+#define NOISE_PERIOD_MS 30
+#define FAST_REPLY_MS 20
+#define SLOW_REPLY_MS 180
+#define CONFIG_FRAMES 4                  // Channels sent ahead of config_complete_id
+
+
+static bool verbose = false;
+
+static uint32_t nowMs() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+/*****************************
+ *       FAKE RADIO           *
+ *****************************/
+
+enum RadioMode {
+    RADIO_TRAFFIC,   // Mesh packets every TRAFFIC_PERIOD_MS, probes answered quickly
+    RADIO_QUIET,     // Nothing unsolicited, probes answered after FAST_REPLY_MS
+    RADIO_SLOW,      // ... after SLOW_REPLY_MS
+    RADIO_DEAD,      // Reads and drops everything
+    RADIO_NOISE,     // Garbage bytes with no magic, probes ignored
+    RADIO_STOP,
+};
+
+static std::atomic<int> radioMode{RADIO_TRAFFIC};
+static std::atomic<uint32_t> probesHeard{0};
+
+static void writeFrame(int fd, const meshtastic_FromRadio& msg) {
+    uint8_t buf[MT_HEADER_SIZE + MT_MAX_PAYLOAD];
+    pb_ostream_t stream = pb_ostream_from_buffer(buf + MT_HEADER_SIZE, MT_MAX_PAYLOAD);
+    if (!pb_encode(&stream, meshtastic_FromRadio_fields, &msg)) {
+        fail("radio could not encode a frame", msg.which_payload_variant);
+        return;
+    }
+    buf[0] = MT_MAGIC_0;
+    buf[1] = MT_MAGIC_1;
+    buf[2] = stream.bytes_written >> 8;
+    buf[3] = stream.bytes_written & 0xFF;
+    if (write(fd, buf, MT_HEADER_SIZE + stream.bytes_written) < 0) fail("radio write failed", 0);
+}
+
+static void writeConfigReply(int fd, uint32_t id) {
+    meshtastic_FromRadio msg = meshtastic_FromRadio_init_zero;
+    msg.which_payload_variant = meshtastic_FromRadio_my_info_tag;
+    msg.my_info.my_node_num = 0xDA0C0FFE;
+    writeFrame(fd, msg);
+    for (int i = 0; i < CONFIG_FRAMES; i++) {
+        msg = meshtastic_FromRadio_init_zero;
+        msg.which_payload_variant = meshtastic_FromRadio_channel_tag;
+        msg.channel.index = i;
+        msg.channel.has_settings = true;
+        snprintf(msg.channel.settings.name, sizeof(msg.channel.settings.name), "course%d", i);
+        writeFrame(fd, msg);
+    }
+    msg = meshtastic_FromRadio_init_zero;
+    msg.which_payload_variant = meshtastic_FromRadio_config_complete_id_tag;
+    msg.config_complete_id = id;
+    writeFrame(fd, msg);
+}
+
+static void runRadio(int fd) {
+    static MtFramer rx;
+    uint32_t nextTraffic = 0;
+    uint32_t nextNoise = 0;
+    uint32_t replyAt = 0;
+    uint32_t replyId = 0;
+    bool replying = false;
+    uint32_t packetId = 1;
+
+    while (radioMode.load() != RADIO_STOP) {
+        struct pollfd p = {fd, POLLIN, 0};
+        poll(&p, 1, 2);
+        uint32_t now = nowMs();
+        int mode = radioMode.load();
+
+        size_t space;
+        uint8_t* at = rx.writePtr(space);
+        ssize_t n = (p.revents & POLLIN) && space ? read(fd, at, space) : 0;
+        if (n > 0) rx.commit(n);
+        size_t len;
+        while (rx.next(now, len)) {
+            pb_istream_t stream = rx.payloadStream();
+            meshtastic_ToRadio msg = meshtastic_ToRadio_init_zero;
+            bool ok = pb_decode(&stream, meshtastic_ToRadio_fields, &msg);
+            rx.consume(ok);
+            if (!ok || msg.which_payload_variant != meshtastic_ToRadio_want_config_id_tag) continue;
+            probesHeard++;
+            if (mode == RADIO_DEAD || mode == RADIO_NOISE) continue;
+            replying = true;
+            replyId = msg.want_config_id;
+            replyAt = now + (mode == RADIO_SLOW ? SLOW_REPLY_MS : FAST_REPLY_MS);
+        }
+
+        if (replying && (int32_t)(now - replyAt) >= 0) {
+            replying = false;
+            if (mode != RADIO_DEAD && mode != RADIO_NOISE) writeConfigReply(fd, replyId);
+        }
+        if (mode == RADIO_TRAFFIC && (int32_t)(now - nextTraffic) >= 0) {
+            nextTraffic = now + TRAFFIC_PERIOD_MS;
+            meshtastic_FromRadio msg = meshtastic_FromRadio_init_zero;
+            msg.which_payload_variant = meshtastic_FromRadio_packet_tag;
+            msg.packet.from = 0xDA000000 | (packetId % 7);
+            msg.packet.id = packetId++;
+            msg.packet.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
+            msg.packet.decoded.portnum = meshtastic_PortNum_TEXT_MESSAGE_APP;
+            msg.packet.decoded.payload.size = snprintf((char*)msg.packet.decoded.payload.bytes,
+                                                       sizeof(msg.packet.decoded.payload.bytes), "~#01#GC#%u#", packetId);
+            writeFrame(fd, msg);
+        }
+        if (mode == RADIO_NOISE && (int32_t)(now - nextNoise) >= 0) {
+            nextNoise = now + NOISE_PERIOD_MS;
+            uint8_t junk[16];
+            for (uint8_t& b : junk) b = 0x20 + rand() % 0x50;  // Never a magic byte
+            if (write(fd, junk, sizeof(junk)) < 0) fail("radio write failed", 1);
+        }
+    }
+}
+
+/*****************************
+ *       CLIENT               *
+ *****************************/
+
+static uint8_t* discardReserve(meshtastic_PortNum, size_t) {
+    return NULL;
+}
+
+struct Client {
+    int fd;
+    MtFramer rx;
+    GcmLinkMonitor::Activity activity;
+};
+
+// One meshtasticTask loop: mt_fill_rx(), mt_protocol_check_packet(), then the link monitor
+static void clientLoop(Client& c, GcmLinkMonitor& link, uint32_t now) {
+    while (true) {
+        size_t space;
+        uint8_t* at = c.rx.writePtr(space);
+        if (space == 0) break;
+        ssize_t n = read(c.fd, at, space);
+        if (n <= 0) break;
+        c.rx.commit(n);
+        c.activity.bytes += n;
+    }
+    size_t len;
+    while (c.rx.next(now, len)) {
+        static meshtastic_FromRadio msg;
+        static mt_packet_t packet;
+        uint8_t* payload;
+        pb_istream_t stream = c.rx.payloadStream();
+        bool ok = mt_decode_from_radio(&stream, &msg, &packet, discardReserve, &payload);
+        c.rx.consume(ok);
+        if (ok && msg.which_payload_variant == meshtastic_FromRadio_config_complete_id_tag) {
+            c.activity.configCompletes++;
+            if (msg.config_complete_id != PROBE_NONCE) fail("reply to the wrong want_config_id", msg.config_complete_id);
+        }
+    }
+    c.activity.frames = c.rx.statistics().frames;
+
+    if (link.poll(now, c.activity)) {
+        uint8_t buf[MT_HEADER_SIZE + 16];
+        pb_ostream_t stream = pb_ostream_from_buffer(buf + MT_HEADER_SIZE, sizeof(buf) - MT_HEADER_SIZE);
+        if (!mt_encode_to_radio_want_config(&stream, PROBE_NONCE)) fail("could not encode a probe", 0);
+        buf[0] = MT_MAGIC_0;
+        buf[1] = MT_MAGIC_1;
+        buf[2] = 0;
+        buf[3] = stream.bytes_written;
+        if (write(c.fd, buf, MT_HEADER_SIZE + stream.bytes_written) < 0) fail("probe write failed", 0);
+        link.probeSent(now);
+    }
+}
+
+/*****************************
+ *       SCRIPT               *
+ *****************************/
+
+struct Phase {
+    const char* name;
+    RadioMode mode;
+    uint32_t durationMs;
+    GcmLinkState expectEnd;
+    bool upThroughout;
+};
+
+static const Phase SCRIPT[] = {
+    {"traffic", RADIO_TRAFFIC, 1000, GCM_LINK_UP, true},
+    {"quiet mesh", RADIO_QUIET, 1500, GCM_LINK_UP, true},
+    {"slow radio", RADIO_SLOW, 800, GCM_LINK_DEGRADED, false},
+    {"dead radio", RADIO_DEAD, 1800, GCM_LINK_DOWN, false},
+    {"line noise", RADIO_NOISE, 1200, GCM_LINK_DEGRADED, false},
+    {"answers again", RADIO_QUIET, 1000, GCM_LINK_UP, false},
+    {"traffic again", RADIO_TRAFFIC, 600, GCM_LINK_UP, false},
+};
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else {
+            fprintf(stderr, "usage: %s [-v]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("pty");
+        return 1;
+    }
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (slave < 0) {
+        perror("pty slave");
+        return 1;
+    }
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);  // A UART: no echo, no line editing, all 256 byte values
+    tcsetattr(slave, TCSANOW, &tio);
+
+    GcmLinkMonitor::Config cfg;
+    cfg.silenceMs = 300;
+    cfg.probeTimeoutMs = 250;
+    cfg.slowMs = 120;
+    cfg.downAfter = 3;
+    cfg.downProbeMs = 400;
+    GcmLinkMonitor link(cfg);
+
+    printf("\n=== GCM link test (%s; silence %u ms, probe timeout %u ms, slow %u ms, down after %u) ===\n",
+           ptsname(master), cfg.silenceMs, cfg.probeTimeoutMs, cfg.slowMs, cfg.downAfter);
+
+    std::thread radio(runRadio, master);
+    static Client client;
+    client.fd = slave;
+    client.activity = {};
+
+    GcmLinkState last = link.state();
+    for (size_t p = 0; p < sizeof(SCRIPT) / sizeof(SCRIPT[0]); p++) {
+        const Phase& phase = SCRIPT[p];
+        radioMode.store(phase.mode);
+        uint32_t start = nowMs();
+        uint32_t probesBefore = link.stats().probes;
+        uint32_t downAt = 0;
+        bool leftUp = false;
+
+        while (nowMs() - start < phase.durationMs) {
+            uint32_t now = nowMs();
+            clientLoop(client, link, now);
+            GcmLinkState s = link.state();
+            if (s != GCM_LINK_UP) leftUp = true;
+            if (s == GCM_LINK_DOWN && downAt == 0) downAt = now - start;
+            if (s != last) {
+                if (verbose) printf("  %6u ms  %-14s %s -> %s\n", now, phase.name, GcmLinkMonitor::stateName(last),
+                                    GcmLinkMonitor::stateName(s));
+                last = s;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(LOOP_MS));
+        }
+
+        uint32_t probes = link.stats().probes - probesBefore;
+        printf("%-14s %5u ms  %-8s  %u probes\n", phase.name, phase.durationMs, GcmLinkMonitor::stateName(last), probes);
+        if (last != phase.expectEnd) fail("wrong state at the end of a phase", p);
+        if (phase.upThroughout && leftUp) fail("link left up during a healthy phase", p);
+        if (phase.mode == RADIO_TRAFFIC && p == 0 && probes != 0) fail("probed while frames were arriving", probes);
+        if (phase.mode == RADIO_QUIET && probes == 0) fail("quiet mesh never probed", p);
+        if (phase.mode == RADIO_DEAD &&
+            (downAt == 0 || downAt > cfg.silenceMs + cfg.downAfter * cfg.probeTimeoutMs + 200)) {
+            fail("dead radio not down in time", downAt);
+        }
+    }
+
+    radioMode.store(RADIO_STOP);
+    radio.join();
+
+    const GcmLinkMonitor::Stats& s = link.stats();
+    printf("Probes:    %u sent (%u reached the radio), %u answered (%u slow), %u unanswered, down %u times\n", s.probes,
+           probesHeard.load(), s.answered, s.slow, s.timedOut, s.downs);
+    printf("RTT:       last %u / min %u / avg %u / max %u ms (radio replies after %d or %d ms)\n", s.rttLastMs,
+           s.rttMinMs, s.answered ? s.rttTotalMs / s.answered : 0, s.rttMaxMs, FAST_REPLY_MS, SLOW_REPLY_MS);
+    printf("RX:        %u bytes, %u frames, %u config_complete\n", client.activity.bytes, client.activity.frames,
+           client.activity.configCompletes);
+
+    if (s.downs != 1) fail("link went down other than once", s.downs);
+    if (s.slow == 0) fail("slow reply not seen", 0);
+    if (s.answered != client.activity.configCompletes) fail("answers differ from config_complete frames", s.answered);
+    if (s.rttMinMs < FAST_REPLY_MS || s.rttMinMs > FAST_REPLY_MS + 60) fail("fast RTT implausible", s.rttMinMs);
+    if (s.rttMaxMs < SLOW_REPLY_MS || s.rttMaxMs > cfg.probeTimeoutMs) fail("slow RTT implausible", s.rttMaxMs);
+    if (probesHeard.load() != s.probes) fail("probes lost on the wire", s.probes - probesHeard.load());
+
+    close(slave);
+    close(master);
+    return benchResult();
+}
@@ -3,37 +3,23 @@
 #include "storage/preferences_manager.h"
 #include "hardware/display.h"
 #include "communication/espnow_handler.h"
+#include "communication/weather_parser.h"
 #include "globals.h"
 
+// GPS display buffers
+char cur_date[GPS_DATE_STR_SIZE];
+char heading[GPS_HEADING_STR_SIZE];
+char hhmmss_str[GPS_TIME_STR_SIZE];
+char hhmm_str[GPS_TIME_STR_SIZE];
+char am_pm_str[GPS_AM_PM_STR_SIZE];
+char sats_hdop[GPS_SATS_HDOP_STR_SIZE];
+char cur_lat[GPS_COORD_STR_SIZE];
+char cur_long[GPS_COORD_STR_SIZE];
+
 // String variable definitions
-String cur_date;
-String heading;
-String hhmmss_str;
-String hhmm_str;
-String am_pm_str;
-String sats_hdop;
 String version;
 String cyd_mac_addr;
 String espnow_gci_mac_addr;
-String wx_rcv_time;
-String cur_temp;
-String fcast_hr1;
-String fcast_glyph1;
-String fcast_temp1;
-String fcast_precip1;
-String fcast_hr2;
-String fcast_glyph2;
-String fcast_temp2;
-String fcast_precip2;
-String fcast_hr3;
-String fcast_glyph3;
-String fcast_temp3;
-String fcast_precip3;
-String fcast_hr4;
-String fcast_glyph4;
-String fcast_temp4;
-String fcast_precip4;
-String np_rcv_time;
 String espnow_status;
 String espnow_last_received;
 String gcm_node_id;
@@ -63,8 +49,6 @@ bool reboot_meshtastic = false;
 bool set_home_loc = false;
 int32_t home_gps_fence_radius_m = 500;  // Default 500 meter radius
 bool at_home = false;
-String cur_lat;
-String cur_long;
 
 // Static buffers for C string returns
 static char temp_buffer[256];
@@ -73,51 +57,51 @@ static char temp_buffer[256];
 extern "C" {
 
 const char* get_var_cur_date() {
-    return cur_date.c_str();
+    return cur_date;
 }
 
 void set_var_cur_date(const char* value) {
-    cur_date = String(value);
+    strlcpy(cur_date, value, sizeof(cur_date));
 }
 
 const char* get_var_heading() {
-    return heading.c_str();
+    return heading;
 }
 
 void set_var_heading(const char* value) {
-    heading = String(value);
+    strlcpy(heading, value, sizeof(heading));
 }
 
 const char* get_var_hhmmss_str() {
-    return hhmmss_str.c_str();
+    return hhmmss_str;
 }
 
 void set_var_hhmmss_str(const char* value) {
-    hhmmss_str = String(value);
+    strlcpy(hhmmss_str, value, sizeof(hhmmss_str));
 }
 
 const char* get_var_hhmm_str() {
-    return hhmm_str.c_str();
+    return hhmm_str;
 }
 
 void set_var_hhmm_str(const char* value) {
-    hhmm_str = String(value);
+    strlcpy(hhmm_str, value, sizeof(hhmm_str));
 }
 
 const char* get_var_am_pm_str() {
-    return am_pm_str.c_str();
+    return am_pm_str;
 }
 
 void set_var_am_pm_str(const char* value) {
-    am_pm_str = String(value);
+    strlcpy(am_pm_str, value, sizeof(am_pm_str));
 }
 
 const char* get_var_sats_hdop() {
-    return sats_hdop.c_str();
+    return sats_hdop;
 }
 
 void set_var_sats_hdop(const char* value) {
-    sats_hdop = String(value);
+    strlcpy(sats_hdop, value, sizeof(sats_hdop));
 }
 
 int32_t get_var_avg_speed() {
@@ -230,173 +214,198 @@ void set_var_espnow_connected(bool value) {
     espnow_connected = value;
 }
 
+// Weather getters read the GUI task's hot packet frame (see globals.h); numbers are
+// formatted into a static buffer per field, called only from the LVGL task.
+// Setters are no-ops: frames are only written by the hot packet parser, and the
+// callback task may be reading the current one to apply a delta.
+static const WeatherFrame& frontWeather() {
+    return hotPacketWeather.readBuffer();
+}
+
 const char* get_var_wx_rcv_time() {
-    // Note: wx_rcv_time is protected by hotPacketMutex
-    // For UI getter, we skip mutex to avoid blocking LVGL refresh
-    // Data race is acceptable here as String reads are atomic enough for display
-    return wx_rcv_time.c_str();
+    const WeatherFrame& wx = frontWeather();
+    return wx.valid ? wx.rcvTime : "        NO DATA YET";
 }
 
 void set_var_wx_rcv_time(const char* value) {
-    wx_rcv_time = String(value);
+    (void)value;
 }
 
 const char* get_var_cur_temp() {
     // Prefer ESP-NOW air temperature if available, fallback to Meshtastic weather data
-    static String tempStr;
+    static char tempStr[8];
 
     if (airTemperature != -99) {
         // ESP-NOW temperature is available (has real-time data)
-        tempStr = String((int)round(airTemperature));
-        return tempStr.c_str();
-    } else {
-        // Fallback to Meshtastic weather data
-        // Note: cur_temp is protected by hotPacketMutex in parseWeatherData
-        // For UI getter, we skip mutex to avoid blocking LVGL refresh
-        return cur_temp.c_str();
+        snprintf(tempStr, sizeof(tempStr), "%d", (int)round(airTemperature));
+        return tempStr;
     }
+
+    const WeatherFrame& wx = frontWeather();
+    if (!wx.valid) return "--";
+    formatWeatherCurTemp(wx, tempStr, sizeof(tempStr));
+    return tempStr;
 }
 
 void set_var_cur_temp(const char* value) {
-    cur_temp = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_hr1() {
-    return fcast_hr1.c_str();
+    return frontWeather().hours[0].hour;
 }
 
 void set_var_fcast_hr1(const char* value) {
-    fcast_hr1 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_glyph1() {
-    return fcast_glyph1.c_str();
+    return frontWeather().hours[0].glyph;
 }
 
 void set_var_fcast_glyph1(const char* value) {
-    fcast_glyph1 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_temp1() {
-    return fcast_temp1.c_str();
+    static char buf[8];
+    if (!frontWeather().valid) return "";
+    formatWeatherTemp(frontWeather().hours[0].temp, buf, sizeof(buf));
+    return buf;
 }
 
 void set_var_fcast_temp1(const char* value) {
-    fcast_temp1 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_precip1() {
-    return fcast_precip1.c_str();
+    static char buf[8];
+    formatWeatherPrecip(frontWeather().hours[0].precip, buf, sizeof(buf));
+    return buf;
 }
 
 void set_var_fcast_precip1(const char* value) {
-    fcast_precip1 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_hr2() {
-    return fcast_hr2.c_str();
+    return frontWeather().hours[1].hour;
 }
 
 void set_var_fcast_hr2(const char* value) {
-    fcast_hr2 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_glyph2() {
-    return fcast_glyph2.c_str();
+    return frontWeather().hours[1].glyph;
 }
 
 void set_var_fcast_glyph2(const char* value) {
-    fcast_glyph2 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_temp2() {
-    return fcast_temp2.c_str();
+    static char buf[8];
+    if (!frontWeather().valid) return "";
+    formatWeatherTemp(frontWeather().hours[1].temp, buf, sizeof(buf));
+    return buf;
 }
 
 void set_var_fcast_temp2(const char* value) {
-    fcast_temp2 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_precip2() {
-    return fcast_precip2.c_str();
+    static char buf[8];
+    formatWeatherPrecip(frontWeather().hours[1].precip, buf, sizeof(buf));
+    return buf;
 }
 
 void set_var_fcast_precip2(const char* value) {
-    fcast_precip2 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_hr3() {
-    return fcast_hr3.c_str();
+    return frontWeather().hours[2].hour;
 }
 
 void set_var_fcast_hr3(const char* value) {
-    fcast_hr3 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_glyph3() {
-    return fcast_glyph3.c_str();
+    return frontWeather().hours[2].glyph;
 }
 
 void set_var_fcast_glyph3(const char* value) {
-    fcast_glyph3 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_temp3() {
-    return fcast_temp3.c_str();
+    static char buf[8];
+    if (!frontWeather().valid) return "";
+    formatWeatherTemp(frontWeather().hours[2].temp, buf, sizeof(buf));
+    return buf;
 }
 
 void set_var_fcast_temp3(const char* value) {
-    fcast_temp3 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_precip3() {
-    return fcast_precip3.c_str();
+    static char buf[8];
+    formatWeatherPrecip(frontWeather().hours[2].precip, buf, sizeof(buf));
+    return buf;
 }
 
 void set_var_fcast_precip3(const char* value) {
-    fcast_precip3 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_hr4() {
-    return fcast_hr4.c_str();
+    return frontWeather().hours[3].hour;
 }
 
 void set_var_fcast_hr4(const char* value) {
-    fcast_hr4 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_glyph4() {
-    return fcast_glyph4.c_str();
+    return frontWeather().hours[3].glyph;
 }
 
 void set_var_fcast_glyph4(const char* value) {
-    fcast_glyph4 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_temp4() {
-    return fcast_temp4.c_str();
+    static char buf[8];
+    if (!frontWeather().valid) return "";
+    formatWeatherTemp(frontWeather().hours[3].temp, buf, sizeof(buf));
+    return buf;
 }
 
 void set_var_fcast_temp4(const char* value) {
-    fcast_temp4 = String(value);
+    (void)value;
 }
 
 const char* get_var_fcast_precip4() {
-    return fcast_precip4.c_str();
+    static char buf[8];
+    formatWeatherPrecip(frontWeather().hours[3].precip, buf, sizeof(buf));
+    return buf;
 }
 
 void set_var_fcast_precip4(const char* value) {
-    fcast_precip4 = String(value);
+    (void)value;
 }
 
 const char* get_var_np_rcv_time() {
-    // Note: np_rcv_time is protected by hotPacketMutex
-    // For UI getter, we skip mutex to avoid blocking LVGL refresh
-    return np_rcv_time.c_str();
+    if (hotPacketVenue.readGeneration() == 0) return "        NO DATA YET";
+    return hotPacketVenue.readBuffer().rcvTime;
 }
 
 void set_var_np_rcv_time(const char* value) {
-    np_rcv_time = String(value);
+    (void)value;
 }
 
 
@@ -618,19 +627,19 @@ void set_var_at_home(bool value) {
 }
 
 const char* get_var_cur_lat() {
-    return cur_lat.c_str();
+    return cur_lat;
 }
 
 void set_var_cur_lat(const char* value) {
-    cur_lat = String(value);
+    strlcpy(cur_lat, value, sizeof(cur_lat));
 }
 
 const char* get_var_cur_long() {
-    return cur_long.c_str();
+    return cur_long;
 }
 
 void set_var_cur_long(const char* value) {
-    cur_long = String(value);
+    strlcpy(cur_long, value, sizeof(cur_long));
 }
 
 } // extern "C"
\ No newline at end of file
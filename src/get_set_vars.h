@@ -3,6 +3,7 @@
 
 #ifdef __cplusplus
 #include <Arduino.h>
+#include "config.h"
 #else
 #include <stdint.h>
 #include <stdbool.h>
@@ -192,35 +193,20 @@ void set_var_cur_long(const char* value);
 // Variable declarations for C++ only
 #ifdef __cplusplus
 
+// GPS display buffers (written in place by gpsTask, sizes in config.h)
+extern char cur_date[GPS_DATE_STR_SIZE];
+extern char heading[GPS_HEADING_STR_SIZE];
+extern char hhmmss_str[GPS_TIME_STR_SIZE];
+extern char hhmm_str[GPS_TIME_STR_SIZE];
+extern char am_pm_str[GPS_AM_PM_STR_SIZE];
+extern char sats_hdop[GPS_SATS_HDOP_STR_SIZE];
+extern char cur_lat[GPS_COORD_STR_SIZE];
+extern char cur_long[GPS_COORD_STR_SIZE];
+
 // String variables
-extern String cur_date;
-extern String heading;
-extern String hhmmss_str;
-extern String hhmm_str;
-extern String am_pm_str;
-extern String sats_hdop;
 extern String version;
 extern String cyd_mac_addr;
 extern String espnow_gci_mac_addr;
-extern String wx_rcv_time;
-extern String cur_temp;
-extern String fcast_hr1;
-extern String fcast_glyph1;
-extern String fcast_temp1;
-extern String fcast_precip1;
-extern String fcast_hr2;
-extern String fcast_glyph2;
-extern String fcast_temp2;
-extern String fcast_precip2;
-extern String fcast_hr3;
-extern String fcast_glyph3;
-extern String fcast_temp3;
-extern String fcast_precip3;
-extern String fcast_hr4;
-extern String fcast_glyph4;
-extern String fcast_temp4;
-extern String fcast_precip4;
-extern String np_rcv_time;
 extern String espnow_status;
 extern String espnow_last_received;
 extern String text_message;
@@ -249,8 +235,6 @@ extern bool reboot_meshtastic;
 extern bool set_home_loc;
 extern int32_t home_gps_fence_radius_m;
 extern bool at_home;
-extern String cur_lat;
-extern String cur_long;
 
 
 #endif // __cplusplus
@@ -1,5 +1,6 @@
 #include "globals.h"
 #include "config.h"
+#include "tasks/track_task.h"
 
 // FreeRTOS handles
 TaskHandle_t gpsTaskHandle = NULL;
@@ -9,39 +10,44 @@ TaskHandle_t meshtasticCallbackTaskHandle = NULL;
 TaskHandle_t eepromTaskHandle = NULL;
 TaskHandle_t systemTaskHandle = NULL;
 TaskHandle_t espnowTaskHandle = NULL;
+TaskHandle_t trackTaskHandle = NULL;
 
 // Synchronization objects
 SemaphoreHandle_t gpsMutex;
 SemaphoreHandle_t eepromMutex;
 SemaphoreHandle_t displayMutex;
-SemaphoreHandle_t hotPacketMutex;  // Protects hot packet buffer swapping (not data reads)
 QueueHandle_t eepromWriteQueue;
-QueueHandle_t meshtasticCallbackQueue;
 QueueHandle_t espnowRecvQueue;
 QueueHandle_t gpsConfigCallbackQueue;
+QueueHandle_t trackPageQueue;
 
-// Double buffering for hot packet data (eliminates blocking reads)
-volatile int hotPacketActiveBuffer = 0;  // 0 or 1
-String hotPacketBuffer_wx_rcv_time[2];
-String hotPacketBuffer_cur_temp[2];
-String hotPacketBuffer_fcast_hr1[2];
-String hotPacketBuffer_fcast_glyph1[2];
-String hotPacketBuffer_fcast_temp1[2];
-String hotPacketBuffer_fcast_precip1[2];
-String hotPacketBuffer_fcast_hr2[2];
-String hotPacketBuffer_fcast_glyph2[2];
-String hotPacketBuffer_fcast_temp2[2];
-String hotPacketBuffer_fcast_precip2[2];
-String hotPacketBuffer_fcast_hr3[2];
-String hotPacketBuffer_fcast_glyph3[2];
-String hotPacketBuffer_fcast_temp3[2];
-String hotPacketBuffer_fcast_precip3[2];
-String hotPacketBuffer_fcast_hr4[2];
-String hotPacketBuffer_fcast_glyph4[2];
-String hotPacketBuffer_fcast_temp4[2];
-String hotPacketBuffer_fcast_precip4[2];
-String hotPacketBuffer_np_rcv_time[2];
-String hotPacketBuffer_live_venue_event_data[2];
+// Latest GPS fix for other tasks (see GpsSnapshot in types.h)
+SeqLock<GpsSnapshot> gpsSnapshot;
+
+// Latest hot packet data (see TripleBuffer)
+TripleBuffer<WeatherFrame> hotPacketWeather;
+TripleBuffer<VenueFrame> hotPacketVenue;
+
+// Latest geofence enter/exit (gpsTask -> GUI)
+TripleBuffer<GeofenceEvent> geofenceEvents;
+
+// Duplicate suppression for queued mesh packets (see PacketDedup)
+PacketDedup meshPacketDedup;
+
+// Variable-length received packet pool (replaces a 30 x 252 byte queue)
+MeshRxPool meshRxPool;
+
+// Prioritized outbound packets (see MeshTxQueue)
+MeshTxQueue meshTxQueue;
+
+// Delivery tracking for want_ack packets (see MeshAckTracker)
+MeshAckTracker meshAckTracker;
+
+// Bounded mesh node table (see NodeTable)
+NodeTable meshNodes;
+
+// GCM link liveness (see GcmLinkMonitor)
+GcmLinkMonitor gcmLink;
 
 // Display objects
 SPIClass touchscreenSpi = SPIClass(VSPI);
@@ -66,6 +72,8 @@ bool use_touch_calibration = false;  // Set to true when coefficients loaded fro
 // GPS objects
 HardwareSerial &gpsSerial = Serial;
 NMEAGPS gps;
+FixAssembler gpsAssembler;
+TrackRecorder trackRecorder(queueTrackPage);
 gps_fix fix;
 
 // Time zone definitions
@@ -85,9 +93,9 @@ Preferences prefs;
 // GPS and time variables (NOT in get_set_vars.h)
 int localYear, localMonth, localDay = 0, old_localDay = 0;
 int localHour, localMinute, localSecond, localDayOfWeek;
-String latitude;
-String longitude;
-String altitude;
+char latitude[GPS_COORD_STR_SIZE];
+char longitude[GPS_COORD_STR_SIZE];
+char altitude[GPS_COORD_STR_SIZE];
 float hdop;
 int old_day_backlight, old_night_backlight;
 unsigned long lastGpsTimeUpdate = 0;  // Tracks when GPS time was last received
@@ -105,9 +113,6 @@ int32_t old_speaker_volume = 10;
 int32_t old_svc_interval_hrs = 100;
 float old_temperature_adj = 0.0;
 
-// Now playing variables
-String live_venue_event_data = "";
-
 // Meshtastic variables
 uint32_t next_send_time = 0;
 bool not_yet_connected = true;
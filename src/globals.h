@@ -12,6 +12,16 @@
 #include <JC_Sunrise.h>
 #include <lvgl.h>
 #include "types.h"
+#include "utils/seqlock.h"
+#include "utils/triple_buffer.h"
+#include "utils/packet_dedup.h"
+#include "utils/mesh_tx_queue.h"
+#include "utils/mesh_ack_tracker.h"
+#include "utils/node_table.h"
+#include "utils/gcm_link_monitor.h"
+#include "utils/mesh_rx_pool.h"
+#include "utils/fix_assembler.h"
+#include "utils/track_codec.h"
 
 // FreeRTOS handles
 extern TaskHandle_t gpsTaskHandle;
@@ -21,43 +31,45 @@ extern TaskHandle_t meshtasticCallbackTaskHandle;
 extern TaskHandle_t eepromTaskHandle;
 extern TaskHandle_t systemTaskHandle;
 extern TaskHandle_t espnowTaskHandle;
+extern TaskHandle_t trackTaskHandle;
 
 // Synchronization objects
 extern SemaphoreHandle_t gpsMutex;
 extern SemaphoreHandle_t eepromMutex;
 extern SemaphoreHandle_t displayMutex;
-extern SemaphoreHandle_t hotPacketMutex;  // Protects hot packet buffer swapping (not data reads)
 extern QueueHandle_t eepromWriteQueue;
-extern QueueHandle_t meshtasticCallbackQueue;
 extern QueueHandle_t espnowRecvQueue;
 extern QueueHandle_t gpsConfigCallbackQueue;
+extern QueueHandle_t trackPageQueue;  // Encoded track pages, gpsTask -> track task
 
-// Double buffering for hot packet data (eliminates blocking reads)
-// Parser writes to back buffer, swaps atomically, GUI reads from front buffer
-// Front buffer = hotPacketBuffer_xxx[hotPacketActiveBuffer] (current data for GUI reads)
-// Back buffer = hotPacketBuffer_xxx[1 - hotPacketActiveBuffer] (next data being written by parser)
-// Only the buffer pointer swap is protected by mutex (~10ms), not the data reads/writes
-extern volatile int hotPacketActiveBuffer;  // 0 or 1, atomic swap under mutex
-extern String hotPacketBuffer_wx_rcv_time[2];
-extern String hotPacketBuffer_cur_temp[2];
-extern String hotPacketBuffer_fcast_hr1[2];
-extern String hotPacketBuffer_fcast_glyph1[2];
-extern String hotPacketBuffer_fcast_temp1[2];
-extern String hotPacketBuffer_fcast_precip1[2];
-extern String hotPacketBuffer_fcast_hr2[2];
-extern String hotPacketBuffer_fcast_glyph2[2];
-extern String hotPacketBuffer_fcast_temp2[2];
-extern String hotPacketBuffer_fcast_precip2[2];
-extern String hotPacketBuffer_fcast_hr3[2];
-extern String hotPacketBuffer_fcast_glyph3[2];
-extern String hotPacketBuffer_fcast_temp3[2];
-extern String hotPacketBuffer_fcast_precip3[2];
-extern String hotPacketBuffer_fcast_hr4[2];
-extern String hotPacketBuffer_fcast_glyph4[2];
-extern String hotPacketBuffer_fcast_temp4[2];
-extern String hotPacketBuffer_fcast_precip4[2];
-extern String hotPacketBuffer_np_rcv_time[2];
-extern String hotPacketBuffer_live_venue_event_data[2];
+// Latest GPS fix for other tasks - written only by gpsTask, read without gpsMutex
+extern SeqLock<GpsSnapshot> gpsSnapshot;
+
+// Latest hot packet data - parsed in place by the meshtastic callback task, read by the GUI task
+// The GUI acquire()s once per loop; readGeneration() changes when a new packet has been picked up
+extern TripleBuffer<WeatherFrame> hotPacketWeather;
+extern TripleBuffer<VenueFrame> hotPacketVenue;
+
+// Latest geofence enter/exit - published by gpsTask, shown by the GUI task
+extern TripleBuffer<GeofenceEvent> geofenceEvents;
+
+// Received packets, meshtasticTask -> meshtasticCallbackTask (see MeshRxPool)
+extern MeshRxPool meshRxPool;
+
+// Rebroadcast copies dropped before meshRxPool - hits()/misses() readable from any task
+extern PacketDedup meshPacketDedup;
+
+// Outbound Meshtastic packets - pushed from any task, sent by meshtasticTask only (see meshtastic_tx.h)
+extern MeshTxQueue meshTxQueue;
+
+// Acks, naks and round-trip times of want_ack packets - meshtasticTask only
+extern MeshAckTracker meshAckTracker;
+
+// Mesh nodes heard of (position, battery, airtime) - updated by meshtasticTask, readable from any task
+extern NodeTable meshNodes;
+
+// Serial link to the GCM: up / degraded / down from activity and probes - polled by meshtasticTask, state() from any task
+extern GcmLinkMonitor gcmLink;
 
 // Display objects
 extern SPIClass touchscreenSpi;
@@ -76,6 +88,8 @@ extern bool use_touch_calibration;  // true if calibration coefficients loaded f
 // GPS objects
 extern HardwareSerial &gpsSerial;
 extern NMEAGPS gps;
+extern FixAssembler gpsAssembler;  // Per-sentence fixes -> one fix per update interval
+extern TrackRecorder trackRecorder; // Breadcrumb track, fed by gpsTask (guarded by gpsMutex)
 extern gps_fix fix;
 
 // Time objects
@@ -90,7 +104,7 @@ extern Preferences prefs;
 // GPS and time variables (NOT in get_set_vars.h)
 extern int localYear, localMonth, localDay, old_localDay;
 extern int localHour, localMinute, localSecond, localDayOfWeek;
-extern String latitude, longitude, altitude;
+extern char latitude[GPS_COORD_STR_SIZE], longitude[GPS_COORD_STR_SIZE], altitude[GPS_COORD_STR_SIZE];
 extern float hdop;
 extern int old_day_backlight, old_night_backlight;
 extern unsigned long lastGpsTimeUpdate;  // Tracks when GPS time was last received
@@ -106,9 +120,6 @@ extern String old_espnow_gci_mac_addr;
 extern bool old_flip_screen;
 extern float old_temperature_adj;
 
-// Now playing variables (NOT in get_set_vars.h)
-extern String live_venue_event_data;
-
 // Meshtastic variables (NOT in get_set_vars.h)
 extern uint32_t next_send_time;
 extern bool not_yet_connected;
@@ -0,0 +1,1063 @@
+/********************************************************************************************
+*    GCD GPS Replay - host-side (Linux) replay of recorded NMEA logs                        *
+*                                                                                           *
+*    Runs recorded NMEA through NeoGPS and the real per-fix pipeline in gps_task.cpp        *
+*    (speed, heading, time display, location/odometer/hours meter, home geo-fence) and      *
+*    reports per-fix CPU time, heap allocations, odometer drift and hours-meter totals.     *
+*                                                                                           *
+*    Usage:                                                                                 *
+*    1. pio run -e native                                                                   *
+*    2. .pio/build/native/program [-v] [-o start_miles] [-g [n]] [-t] log1.nmea [...]       *
+*       .pio/build/native/program [-v] [-o start_miles] -p /tmp/gps                         *
+*       .pio/build/native/program -d capture.txt > track.csv                                *
+*         -v  show firmware debug output (quiet by default)                                 *
+*         -o  seed accum_distance, e.g. -o 90000 to exercise high-mileage float precision   *
+*         -p  read a live tty/pty through the gpsTask ingestion loop (GpsTransport) until   *
+*             the writer hangs up or the line is idle for 3 s - see gps_transport_host.h    *
+*         -c  contention benchmark: a writer thread replays the logs flat out while this    *
+*             thread reads GPS state, first under a mutex held per NMEA burst (as gpsTask   *
+*             holds gpsMutex) then via gpsSnapshot, and reports reader latency for each     *
+*         -b  throughput test, repeatable (e.g. -b 9600 -b 38400): send the logs at each    *
+*             baud as the receiver would and run gpsTask's RX-event loop on a simulated     *
+*             clock; reports line load, RX ring peak, drops and fix latency. Exits 2 if     *
+*             any baud drops data. -x sets ESP32 CPU time per host CPU time (default 30)    *
+*         -g  geofence benchmark: scatter N (default 1000) circles and polygons around the  *
+*             track and time GeofenceEngine::update() per fix against a brute-force scan    *
+*         -t  track log benchmark: compression (bytes/point vs a raw record), flash write   *
+*             amplification, erases and partition capacity; each log is one round (the      *
+*             recorder is flushed at its end, as at power-down), decode is verified         *
+*         -d  decode a debug-port capture of the Track export (TRK lines) to CSV on stdout  *
+*                                                                                           *
+*    Logs are raw receiver output (e.g. captured from GPS_RX_PIN with a USB-serial          *
+*    adapter). millis() follows the fix timestamps so results are deterministic.            *
+*                                                                                           *
+*    Motion labels: if <log>.labels exists, each line "hhmmss[.ss] stop|move" (UTC,         *
+*    '#' comments) marks when the cart actually stopped/started. The report then gives      *
+*    stop/start detection latency and false-motion/false-stop rates of the displayed        *
+*    speed for SpeedFilter and for the previous threshold heuristic, with fixes that had    *
+*    neither speed nor location (dropouts) also scored on their own.                        *
+*    test/gps_replay/barn_dropout.nmea is a labelled synthetic log of a lost fix.           *
+*                                                                                           *
+********************************************************************************************/
+
+#include <Arduino.h>
+#include <ctype.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_check.h"
+#include "config.h"
+#include "globals.h"
+#include "tasks/gps_task.h"
+#include "utils/odometer.h"
+#include "utils/geofence.h"
+#include "utils/gps_health.h"
+#include "hardware/gps_transport_host.h"
+#include "storage/preferences_manager.h"
+
+/*****************************
+ *   FIRMWARE GLOBALS (HOST)  *
+ *****************************/
+
+// Only the state touched by gps_task.cpp - see globals.cpp / get_set_vars.cpp for the device copies
+HardwareSerial Serial;
+HardwareSerial &gpsSerial = Serial;
+NMEAGPS gps;
+FixAssembler gpsAssembler;
+gps_fix fix;
+SemaphoreHandle_t gpsMutex = NULL;
+SeqLock<GpsSnapshot> gpsSnapshot;
+TripleBuffer<GeofenceEvent> geofenceEvents;
+
+TimeChangeRule mySTD = {"EST", First, Sun, Nov, 2, -300};
+TimeChangeRule myDST = {"EDT", Second, Sun, Mar, 2, -240};
+TimeChangeRule *tcr;
+Timezone myTZ(myDST, mySTD);
+JC_Sunrise sun{MY_LATITUDE, MY_LONGITUDE, JC_Sunrise::officialZenith};
+time_t localTime, utcTime;
+
+int localYear, localMonth, localDay = 0, old_localDay = 0;
+int localHour, localMinute, localSecond, localDayOfWeek;
+char latitude[GPS_COORD_STR_SIZE], longitude[GPS_COORD_STR_SIZE], altitude[GPS_COORD_STR_SIZE];
+float hdop;
+unsigned long lastGpsTimeUpdate = 0;
+float avg_speed_calc = 0.0;
+
+float homeLatitude = 0.0;
+float homeLongitude = 0.0;
+bool homeLocationSet = false;
+
+char cur_date[GPS_DATE_STR_SIZE], heading[GPS_HEADING_STR_SIZE];
+char hhmmss_str[GPS_TIME_STR_SIZE], hhmm_str[GPS_TIME_STR_SIZE], am_pm_str[GPS_AM_PM_STR_SIZE];
+char sats_hdop[GPS_SATS_HDOP_STR_SIZE], cur_lat[GPS_COORD_STR_SIZE], cur_long[GPS_COORD_STR_SIZE];
+int32_t avg_speed = 0;
+int32_t day_backlight = 10;
+int32_t night_backlight = 5;
+String odometer = "0.0";
+String trip_odometer = "0.0";
+int32_t hrs_since_svc = 0;
+float accum_distance = 0.0;
+float trip_distance = 0.0;
+bool set_home_loc = false;
+int32_t home_gps_fence_radius_m = 500;
+bool at_home = false;
+
+static uint32_t eepromWrites = 0;
+
+// Pages the track task would write (see TRACK BENCHMARK)
+static void benchTrackPage(const trackPage_t& page);
+TrackRecorder trackRecorder(benchTrackPage);
+
+void setBacklight(uint32_t value) {}
+
+void queuePreferenceWrite(const char* key, float value) { eepromWrites++; }
+void queuePreferenceWrite(const char* key, int value) { eepromWrites++; }
+void queuePreferenceWrite(const char* key, const String& value) { eepromWrites++; }
+void queuePreferenceWrite(const char* key, bool value) { eepromWrites++; }
+void queuePreferenceWrite(const char* key, uint64_t value) { eepromWrites++; }
+
+/*****************************
+ *     REPLAY STATISTICS      *
+ *****************************/
+
+static const double EARTH_RADIUS_MILES = 6371.0088 * 0.621371;
+
+// Double-precision haversine reference for odometer drift
+static double haversineMiles(const NeoGPS::Location_t& a, const NeoGPS::Location_t& b) {
+    const double toRad = M_PI / 180.0 / 1e7;
+    double lat1 = a.lat() * toRad, lat2 = b.lat() * toRad;
+    double dLat = lat2 - lat1;
+    double dLon = (b.lon() - a.lon()) * toRad;
+    double h = sin(dLat / 2) * sin(dLat / 2) + cos(lat1) * cos(lat2) * sin(dLon / 2) * sin(dLon / 2);
+    return 2.0 * EARTH_RADIUS_MILES * asin(sqrt(h));
+}
+
+// Same acceptance gate as odometerUpdate(), evaluated in double precision over a segment of segmentMs
+static double referenceSegmentMiles(const gps_fix& f, const NeoGPS::Location_t& prev, uint32_t segmentMs) {
+    double d = haversineMiles(f.location, prev);
+    double posSpeed = d * 3600000.0 / segmentMs;
+    if (f.valid.speed) {
+        if (f.speed_mph() > MIN_SPEED_FILTER_MPH && posSpeed < 30.0 && d > 0.0005) return d;
+    } else if (d > 0.002 && posSpeed < 30.0) {
+        return d;
+    }
+    return 0.0;
+}
+
+static double percentile(std::vector<double>& v, double p) {
+    if (v.empty()) return 0.0;
+    size_t idx = (size_t)(p * (v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + idx, v.end());
+    return v[idx];
+}
+
+/*****************************
+ *   MOTION LABEL SCORING     *
+ *****************************/
+
+struct MotionLabel {
+    double secs;  // UTC seconds of day
+    bool moving;
+};
+static std::vector<MotionLabel> labels;
+
+// Load <log>.labels if present (replaces labels from the previous log)
+static void loadLabels(const char* logPath) {
+    labels.clear();
+    std::string path = std::string(logPath) + ".labels";
+    FILE* f = fopen(path.c_str(), "r");
+    if (!f) return;
+
+    char line[64];
+    while (fgets(line, sizeof(line), f)) {
+        double hhmmss;
+        char state[16];
+        if (line[0] == '#' || sscanf(line, "%lf %15s", &hhmmss, state) != 2) continue;
+        int whole = (int)hhmmss;
+        double secs = (whole / 10000) * 3600 + ((whole / 100) % 100) * 60 + (hhmmss - (whole / 100) * 100);
+        labels.push_back(MotionLabel{secs, strcmp(state, "move") == 0});
+    }
+    fclose(f);
+}
+
+// Scores one speed display (whole mph, as on screen) against the labels
+struct MotionScore {
+    const char* name;
+    double transitionSecs = -1.0;
+    bool awaiting = false;
+    std::vector<double> stopLatency, startLatency;
+    uint32_t stoppedFixes = 0, falseMotion = 0;
+    uint32_t movingFixes = 0, falseStop = 0;
+    uint32_t dropoutFixes = 0, dropoutWrong = 0;  // Labelled fixes with neither speed nor location
+
+    explicit MotionScore(const char* n) : name(n) {}
+
+    void add(double secs, const MotionLabel& label, int32_t shownMph, bool dropout) {
+        if (label.secs != transitionSecs) {
+            transitionSecs = label.secs;
+            awaiting = true;
+        }
+
+        bool agrees = label.moving ? (shownMph > 0) : (shownMph == 0);
+        if (dropout) {
+            dropoutFixes++;
+            if (!agrees) dropoutWrong++;
+        }
+        if (awaiting) {
+            if (agrees) {
+                (label.moving ? startLatency : stopLatency).push_back(secs - transitionSecs);
+                awaiting = false;
+            }
+            return;  // Fixes before detection count toward latency, not error rates
+        }
+
+        if (label.moving) {
+            movingFixes++;
+            if (!agrees) falseStop++;
+        } else {
+            stoppedFixes++;
+            if (!agrees) falseMotion++;
+        }
+    }
+
+    void print() const {
+        double stopMean = 0.0, stopMax = 0.0, startMean = 0.0, startMax = 0.0;
+        for (double l : stopLatency) { stopMean += l; stopMax = std::max(stopMax, l); }
+        for (double l : startLatency) { startMean += l; startMax = std::max(startMax, l); }
+        if (!stopLatency.empty()) stopMean /= stopLatency.size();
+        if (!startLatency.empty()) startMean /= startLatency.size();
+
+        printf("  %-13s stop latency mean %.2f s max %.2f s (%zu)  start mean %.2f s max %.2f s (%zu)\n", name,
+               stopMean, stopMax, stopLatency.size(), startMean, startMax, startLatency.size());
+        printf("  %-13s false motion %.2f%% of %lu stopped fixes, false stop %.2f%% of %lu moving fixes\n", "",
+               stoppedFixes ? 100.0 * falseMotion / stoppedFixes : 0.0, (unsigned long)stoppedFixes,
+               movingFixes ? 100.0 * falseStop / movingFixes : 0.0, (unsigned long)movingFixes);
+        if (dropoutFixes > 0) {
+            printf("  %-13s dropouts: wrong %.2f%% of %lu fixes with neither speed nor location\n", "",
+                   100.0 * dropoutWrong / dropoutFixes, (unsigned long)dropoutFixes);
+        }
+    }
+};
+
+static MotionScore filterScore("SpeedFilter");
+static MotionScore legacyScore("legacy");
+static bool haveLabelledFixes = false;
+
+// The threshold heuristic SpeedFilter replaced, kept here as the comparison baseline
+static int32_t legacySpeed(const gps_fix& f) {
+    static float previousSpeed = 0.0;
+    static float speedCalc = 0.0;
+
+    if (f.valid.speed) {
+        float speedMph = f.speed_mph();
+        if (speedMph < MIN_SPEED_FILTER_MPH) {
+            speedMph = 0.0;
+        } else if (speedMph < 4.0 && speedMph < previousSpeed) {
+            speedMph = 0.0;
+        }
+        previousSpeed = f.speed_mph();
+        speedCalc = speedMph;
+    } else if (f.valid.location && speedCalc < 5.0) {
+        speedCalc = 0.0;
+        previousSpeed = 0.0;
+    }
+    return (int32_t)speedCalc;
+}
+
+static void scoreMotion(const gps_fix& f) {
+    int32_t legacyMph = legacySpeed(f);
+    if (labels.empty() || !f.valid.time) return;
+
+    double secs = f.dateTime.hours * 3600 + f.dateTime.minutes * 60 + f.dateTime.seconds + f.dateTime_cs / 100.0;
+    std::vector<MotionLabel>::const_iterator it = std::upper_bound(labels.begin(), labels.end(), secs,
+        [](double t, const MotionLabel& l) { return t < l.secs; });
+    if (it == labels.begin()) return;  // Before the first label
+    --it;
+
+    bool dropout = !f.valid.speed && !f.valid.location;
+    filterScore.add(secs, *it, avg_speed, dropout);
+    legacyScore.add(secs, *it, legacyMph, dropout);
+    haveLabelledFixes = true;
+}
+
+// Per-fix bookkeeping shared by file and pty modes
+static std::vector<double> fixMicros;
+static double refMiles = 0.0;
+static uint32_t fixCount = 0;
+static NeoGPS::clock_t firstClock = 0, lastClock = 0;
+static bool haveClock = false;
+static uint32_t virtualMillis = 10000;  // Boot offset so millis()-based fallbacks see non-zero references
+static NeoGPS::Location_t prevLocation;
+static bool havePrev = false;
+static NeoGPS::Location_t refAnchor;  // Reference odometer segment start (resampled like odometerUpdate)
+static bool haveRefAnchor = false;
+static uint32_t refSegmentMs = 0;
+
+// Every point the track recorder accepted, in order (round trip reference)
+static std::vector<TrackPoint> trackPoints;
+
+// Consecutive fix pairs, for the segment distance accuracy/speed comparison
+struct Segment {
+    NeoGPS::Location_t from;
+    NeoGPS::Location_t to;
+};
+static std::vector<Segment> segments;
+
+// Per log-hour heap activity, to show allocations and held bytes stay flat over a long replay
+struct HourStats {
+    uint32_t fixes;
+    uint64_t allocs;
+    int64_t heapBytes;  // benchHeapBytes at the last fix of the hour
+};
+static std::vector<HourStats> hours;
+
+static void replayFix() {
+    typedef std::chrono::steady_clock clk;
+
+    fix = gpsAssembler.fix();
+    uint32_t intervalMs = gpsAssembler.intervalMs();
+
+    // Drive the virtual clock from the fix timestamp (nominal step if untimed)
+    if (fix.valid.date && fix.valid.time) {
+        NeoGPS::clock_t secs = fix.dateTime;
+        if (!haveClock) {
+            firstClock = secs;
+            haveClock = true;
+        }
+        lastClock = secs;
+        virtualMillis = 10000 + (uint32_t)(secs - firstClock) * 1000 + fix.dateTime_cs * 10;
+    } else {
+        virtualMillis += 1000 / GPS_FIX_RATE_HZ;
+    }
+    hostSetMillis(virtualMillis);
+
+    if (fix.valid.location) {
+        if (havePrev) {
+            segments.push_back(Segment{prevLocation, fix.location});
+        }
+        prevLocation = fix.location;
+        havePrev = true;
+
+        if (intervalMs == 0) haveRefAnchor = false;
+        if (haveRefAnchor) {
+            refSegmentMs += intervalMs;
+            if (refSegmentMs >= ODOMETER_SAMPLE_MS) {
+                refMiles += referenceSegmentMiles(fix, refAnchor, refSegmentMs);
+                refAnchor = fix.location;
+                refSegmentMs = 0;
+            }
+        } else {
+            refAnchor = fix.location;
+            haveRefAnchor = true;
+            refSegmentMs = 0;
+        }
+    }
+
+    uint64_t allocsBefore = benchAllocs;
+    clk::time_point t0 = clk::now();
+    benchCountAllocs = true;
+    processGpsFix(fix, intervalMs);
+    benchCountAllocs = false;
+    fixMicros.push_back(std::chrono::duration<double, std::micro>(clk::now() - t0).count());
+    fixCount++;
+    if (trackRecorder.pointsRecorded() != trackPoints.size()) {
+        trackPoints.push_back(trackRecorder.lastPoint());
+    }
+
+    scoreMotion(fix);
+
+    size_t hour = haveClock ? (size_t)((lastClock - firstClock) / 3600) : 0;
+    if (hours.size() <= hour) hours.resize(hour + 1, HourStats{0, 0, benchHeapBytes});
+    hours[hour].fixes++;
+    hours[hour].allocs += benchAllocs - allocsBefore;
+    hours[hour].heapBytes = benchHeapBytes;
+}
+
+/**
+ * Pass the sentence NeoGPS just parsed through the firmware's FixAssembler,
+ * as gpsTask does; returns true if it completed a fix (replayFix() has run)
+ */
+static bool replaySentence() {
+    if (!gpsAssembler.add(gps.read(), gps.nmeaMessage)) return false;
+    replayFix();
+    gpsHealthOnFix(fix);
+    gpsHealthUpdate();  // Samples once per second of fix time
+    return true;
+}
+
+/**
+ * Time the odometer's equirectangular segment distance and NeoGPS' haversine
+ * over every recorded segment, and report each one's worst error against the
+ * double-precision reference
+ */
+static void printSegmentBench() {
+    typedef std::chrono::steady_clock clk;
+    if (segments.empty()) return;
+
+    const double MM_PER_MILE = 1609344.0;
+    double equirectMaxErr = 0.0, neogpsMaxErr = 0.0;
+    for (const Segment& seg : segments) {
+        double refMm = haversineMiles(seg.to, seg.from) * MM_PER_MILE;
+        equirectMaxErr = std::max(equirectMaxErr, fabs(segmentDistanceMm(seg.to, seg.from) - refMm));
+        neogpsMaxErr = std::max(neogpsMaxErr, fabs(seg.to.DistanceMiles(seg.from) * MM_PER_MILE - refMm));
+    }
+
+    const int passes = 20;
+    volatile uint64_t sinkMm = 0;
+    volatile float sinkMiles = 0.0;
+
+    clk::time_point t0 = clk::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (const Segment& seg : segments) sinkMm += segmentDistanceMm(seg.to, seg.from);
+    }
+    double equirectNs = std::chrono::duration<double, std::nano>(clk::now() - t0).count() / (passes * segments.size());
+
+    t0 = clk::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (const Segment& seg : segments) sinkMiles += seg.to.DistanceMiles(seg.from);
+    }
+    double neogpsNs = std::chrono::duration<double, std::nano>(clk::now() - t0).count() / (passes * segments.size());
+
+    printf("Segments:     %zu  equirect mm %.1f ns, max err %.2f mm  |  NeoGPS haversine %.1f ns, max err %.2f mm\n",
+           segments.size(), equirectNs, equirectMaxErr, neogpsNs, neogpsMaxErr);
+}
+
+/*****************************
+ *   GEOFENCE BENCHMARK       *
+ *****************************/
+
+static int32_t randomRange(int32_t lo, int32_t hi) {
+    return lo + (int32_t)(((uint64_t)rand() * ((int64_t)hi - lo)) / RAND_MAX);
+}
+
+/**
+ * Scatter fenceCount fences over the track's bounding box (plus a margin), then
+ * replay every recorded fix through a private GeofenceEngine. Each update() is
+ * timed, and its inside/outside state is checked against testing every fence.
+ */
+static void printGeofenceBench(uint16_t fenceCount) {
+    typedef std::chrono::steady_clock clk;
+    if (segments.empty()) return;
+
+    int32_t minLat = INT32_MAX, maxLat = INT32_MIN, minLon = INT32_MAX, maxLon = INT32_MIN;
+    for (const Segment& seg : segments) {
+        minLat = std::min(minLat, seg.to.lat());
+        maxLat = std::max(maxLat, seg.to.lat());
+        minLon = std::min(minLon, seg.to.lon());
+        maxLon = std::max(maxLon, seg.to.lon());
+    }
+    const int32_t margin = 20000;  // ~220 m
+    minLat -= margin; maxLat += margin; minLon -= margin; maxLon += margin;
+
+    GeofenceEngine bench;
+    if (!bench.reserve(fenceCount, fenceCount * 8)) return;  // Past the device limits
+
+    srand(1);
+    char name[GEOFENCE_NAME_LEN];
+    for (uint16_t i = 0; i < fenceCount; i++) {
+        int32_t lat = randomRange(minLat, maxLat);
+        int32_t lon = randomRange(minLon, maxLon);
+        snprintf(name, sizeof(name), "fence%u", i);
+
+        if (i % 100 == 99) {
+            bench.addCircle(name, lat, lon, randomRange(2000, 8000));  // Oversize: skips the grid
+        } else if (i % 2 == 0) {
+            bench.addCircle(name, lat, lon, randomRange(15, 300));
+        } else {
+            // Irregular star polygon, 4-8 vertices
+            geoPoint_t points[8];
+            uint8_t n = randomRange(4, 9);
+            for (uint8_t k = 0; k < n; k++) {
+                double angle = 2.0 * M_PI * k / n;
+                int32_t r = randomRange(300, 3000);  // 1e-7 degrees, ~30-330 m
+                points[k].lat = lat + (int32_t)(r * sin(angle));
+                points[k].lon = lon + (int32_t)(r * cos(angle));
+            }
+            bench.addPolygon(name, points, n);
+        }
+    }
+
+    std::vector<double> updateMicros, bruteMicros;
+    uint64_t candidates = 0, insideFixes = 0, mismatches = 0;
+    volatile uint32_t sink = 0;
+
+    for (const Segment& seg : segments) {
+        clk::time_point t0 = clk::now();
+        bench.update(seg.to);
+        updateMicros.push_back(std::chrono::duration<double, std::micro>(clk::now() - t0).count());
+        candidates += bench.lastCandidateCount();
+
+        bool anyInside = false;
+        t0 = clk::now();
+        for (uint16_t i = 0; i < bench.count(); i++) {
+            bool inside = bench.isInside(seg.to, i);
+            sink += inside;
+            if (inside != bench.isInside(i)) mismatches++;
+            anyInside |= inside;
+        }
+        bruteMicros.push_back(std::chrono::duration<double, std::micro>(clk::now() - t0).count());
+        insideFixes += anyInside;
+    }
+
+    printf("Geofences:    %u fences, %zu fixes (%llu inside one), %.1f candidates/fix, %llu mismatches vs brute force\n",
+           (unsigned)bench.count(), segments.size(), (unsigned long long)insideFixes,
+           (double)candidates / segments.size(), (unsigned long long)mismatches);
+    printf("              update() p50 %.2f  p99 %.2f  max %.2f us  |  brute force p50 %.2f us\n",
+           percentile(updateMicros, 0.50), percentile(updateMicros, 0.99), percentile(updateMicros, 1.0),
+           percentile(bruteMicros, 0.50));
+}
+
+/*****************************
+ *     TRACK BENCHMARK        *
+ *****************************/
+
+// A point as a plain fixed-size record would store it: int32 lat/lon, uint32 time, uint16 speed
+static const size_t RAW_TRACK_POINT_BYTES = 14;
+static const uint32_t FLASH_SECTOR_BYTES = 4096;
+static const uint32_t FLASH_ERASE_CYCLES = 100000;  // Typical SPI NOR endurance per sector
+
+static std::vector<trackPage_t> trackPages;
+
+static void benchTrackPage(const trackPage_t& page) {
+    bool counting = benchCountAllocs;
+    benchCountAllocs = false;  // Harness bookkeeping, not a firmware allocation
+    trackPages.push_back(page);
+    benchCountAllocs = counting;
+}
+
+/**
+ * Report what the recorded points cost on flash. Write amplification is
+ * flash consumed (whole pages, as the log never reuses a partly written page)
+ * per encoded payload byte; program operations are pages, against one per
+ * point for a log that wrote each point as it was recorded.
+ */
+static void printTrackBench(double logSecs, size_t rounds) {
+    typedef std::chrono::steady_clock clk;
+    if (trackPoints.empty()) {
+        printf("Track:        no points recorded\n");
+        return;
+    }
+
+    uint64_t payloadBytes = 0;
+    for (const trackPage_t& page : trackPages) payloadBytes += page.length;
+
+    // Decode every page and compare with what was recorded
+    size_t decoded = 0, exact = 0, trips = 0;
+    clk::time_point t0 = clk::now();
+    for (const trackPage_t& page : trackPages) {
+        TrackPageDecoder decoder;
+        decoder.begin(page.payload, page.length);
+        TrackPoint p;
+        bool tripStart;
+        while (decoder.next(p, tripStart)) {
+            if (decoded < trackPoints.size()) {
+                const TrackPoint& want = trackPoints[decoded];
+                if (p.timeCs == want.timeCs && p.lat == want.lat && p.lon == want.lon && p.speed == want.speed) exact++;
+            }
+            decoded++;
+            if (tripStart) trips++;
+        }
+    }
+    double decodeNs = std::chrono::duration<double, std::nano>(clk::now() - t0).count() / std::max<size_t>(decoded, 1);
+
+    size_t points = trackPoints.size();
+    size_t pages = trackPages.size();
+    uint64_t flashBytes = (uint64_t)pages * TRACK_PAGE_SIZE;
+    double bytesPerPoint = (double)payloadBytes / points;
+    double sectors = (double)flashBytes / FLASH_SECTOR_BYTES;
+
+    printf("Track:        %zu points, %zu trip(s), %zu round(s): %.2f bytes/point vs %zu raw (%.2fx)\n",
+           points, trips, rounds, bytesPerPoint, RAW_TRACK_POINT_BYTES, RAW_TRACK_POINT_BYTES / bytesPerPoint);
+    printf("              %zu pages, %llu payload bytes -> %llu flash bytes, write amplification %.2fx\n",
+           pages, (unsigned long long)payloadBytes, (unsigned long long)flashBytes,
+           payloadBytes ? (double)flashBytes / payloadBytes : 0.0);
+    printf("              %zu page programs (vs %zu writing each point), %.2f sector erases\n",
+           pages, points, sectors);
+    if (logSecs > 0 && pages > 0) {
+        double pagesPerHour = pages / (logSecs / 3600.0);
+        double lapHours = (TRACK_PARTITION_SIZE / TRACK_PAGE_SIZE) / pagesPerHour;
+        printf("              %.1f pages/h: partition holds %.0f h of log, %.0f h to %lu erases per sector\n",
+               pagesPerHour, lapHours, lapHours * FLASH_ERASE_CYCLES, (unsigned long)FLASH_ERASE_CYCLES);
+    }
+    printf("              round trip %zu/%zu points exact, decode %.1f ns/point\n", exact, points, decodeNs);
+}
+
+/**
+ * Decode a capture of the device's track export (TRK,<seq>,<hex> lines,
+ * possibly mixed with other debug output) and print it as CSV
+ */
+static int decodeTrackExport(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+
+    std::vector<std::pair<uint32_t, trackPage_t>> pages;
+    char line[TRACK_PAGE_SIZE * 2 + 64];
+    while (fgets(line, sizeof(line), f)) {
+        char* start = strstr(line, "TRK,");
+        if (start == NULL || !isdigit((unsigned char)start[4])) continue;  // BEGIN/END or not ours
+        char* hex;
+        uint32_t seq = strtoul(start + 4, &hex, 10);
+        if (*hex++ != ',') continue;
+
+        trackPage_t page;
+        page.length = 0;
+        unsigned int byte;
+        while (page.length < TRACK_PAGE_PAYLOAD && isxdigit((unsigned char)hex[0]) &&
+               isxdigit((unsigned char)hex[1]) && sscanf(hex, "%2x", &byte) == 1) {
+            page.payload[page.length++] = (uint8_t)byte;
+            hex += 2;
+        }
+        pages.push_back(std::make_pair(seq, page));
+    }
+    fclose(f);
+
+    // Export order is oldest first, but a capture may be stitched from several
+    std::sort(pages.begin(), pages.end(),
+        [](const std::pair<uint32_t, trackPage_t>& a, const std::pair<uint32_t, trackPage_t>& b) { return a.first < b.first; });
+
+    const ::time_t NEOGPS_EPOCH_UNIX = 946684800;  // 2000-01-01 00:00 UTC
+    size_t points = 0, trip = 0;
+    printf("utc,lat,lon,mph,trip\n");
+    for (const std::pair<uint32_t, trackPage_t>& entry : pages) {
+        TrackPageDecoder decoder;
+        decoder.begin(entry.second.payload, entry.second.length);
+        TrackPoint p;
+        bool tripStart;
+        while (decoder.next(p, tripStart)) {
+            if (tripStart || trip == 0) trip++;
+            ::time_t secs = (::time_t)(p.timeCs / 100) + NEOGPS_EPOCH_UNIX;
+            struct tm utc;
+            gmtime_r(&secs, &utc);
+            printf("%04d-%02d-%02dT%02d:%02d:%02d.%02uZ,%.7f,%.7f,%.1f,%zu\n",
+                   utc.tm_year + 1900, utc.tm_mon + 1, utc.tm_mday, utc.tm_hour, utc.tm_min, utc.tm_sec,
+                   (unsigned)(p.timeCs % 100), p.lat * 1e-7, p.lon * 1e-7, p.speed / 10.0, trip);
+            points++;
+        }
+    }
+    fprintf(stderr, "%zu pages, %zu points, %zu trip(s)\n", pages.size(), points, trip);
+    return 0;
+}
+
+/*****************************
+ *   THROUGHPUT SIMULATION    *
+ *****************************/
+
+// ESP32 UART driver defaults: RX event once this many bytes are in the FIFO, or after this many idle symbols
+static const size_t UART_RX_FULL_THRESHOLD = 120;
+static const uint32_t UART_RX_TIMEOUT_SYMBOLS = 2;
+
+/**
+ * Replay 'data' as a receiver would send it on a baud-limited 8N1 line and
+ * run it through gpsTask's wait/drain loop on a simulated clock
+ *
+ * Each update interval's sentences leave the receiver at that interval's
+ * fix time (back to back, or queued behind the previous interval if the line
+ * is still busy). gpsTask sleeps until the UART driver posts an RX event
+ * (FIFO threshold or idle timeout), then drains the ring buffer; each byte
+ * costs its measured host parse/pipeline time times 'slowdown'. Bytes that
+ * arrive with GPS_RX_BUFFER_SIZE already queued are dropped, as the driver does.
+ *
+ * Returns true if nothing was dropped on the line, in the ring or by the parser.
+ */
+static bool runThroughput(const std::string& data, uint32_t baud, double slowdown) {
+    typedef std::chrono::steady_clock clk;
+    const double byteSecs = 10.0 / baud;
+
+    // Pass 1: bytes and fix time of each update interval, using a private parser/assembler
+    NMEAGPS scanGps;
+    FixAssembler scanAssembler;
+    std::vector<size_t> burstEnd;     // One past the byte that completed each fix
+    std::vector<double> burstEpoch;   // Fix time, seconds from the first fix
+    double epoch = 0.0;
+    for (size_t i = 0; i < data.size(); i++) {
+        scanGps.handle((uint8_t)data[i]);
+        while (scanGps.available()) {
+            if (scanAssembler.add(scanGps.read(), scanGps.nmeaMessage)) {
+                uint32_t dtMs = scanAssembler.intervalMs();
+                if (!burstEnd.empty()) epoch += (dtMs > 0 ? dtMs : 1000 / GPS_FIX_RATE_HZ) / 1000.0;
+                burstEnd.push_back(i + 1);
+                burstEpoch.push_back(epoch);
+            }
+        }
+    }
+    if (burstEnd.size() < 2) {
+        fprintf(stderr, "throughput: need at least two fixes\n");
+        return false;
+    }
+    const size_t n = burstEnd.back();
+    std::vector<double> spacing;
+    for (size_t k = 1; k < burstEpoch.size(); k++) spacing.push_back(burstEpoch[k] - burstEpoch[k - 1]);
+    double fixHz = 1.0 / percentile(spacing, 0.50);
+
+    // Line schedule: arrival time of every byte
+    std::vector<double> arrival(n);
+    double lineFree = 0.0, maxBacklog = 0.0;
+    uint32_t overranIntervals = 0;
+    for (size_t k = 0, begin = 0; k < burstEnd.size(); begin = burstEnd[k++]) {
+        double start = std::max(burstEpoch[k], lineFree);
+        double backlog = start - burstEpoch[k];
+        maxBacklog = std::max(maxBacklog, backlog);
+        if (k + 1 < burstEpoch.size() && backlog > burstEpoch[k + 1] - burstEpoch[k]) overranIntervals++;
+        for (size_t i = begin; i < burstEnd[k]; i++) arrival[i] = start + (i - begin + 1) * byteSecs;
+        lineFree = arrival[burstEnd[k] - 1];
+    }
+    double spanSecs = lineFree;
+
+    // Last byte of the run each byte belongs to (the UART idle timeout fires after it)
+    std::vector<size_t> runEnd(n);
+    for (size_t i = n; i-- > 0;) {
+        bool gapAfter = (i + 1 == n) || (arrival[i + 1] - arrival[i] > UART_RX_TIMEOUT_SYMBOLS * byteSecs);
+        runEnd[i] = gapAfter ? i : runEnd[i + 1];
+    }
+
+    // Pass 2: gpsTask on the simulated clock, through the real parser and pipeline
+    uint32_t okBefore = gps.statistics.ok, errorsBefore = gps.statistics.errors, fixesBefore = fixCount;
+    std::deque<size_t> ring;
+    size_t arrived = 0, peak = 0;
+    uint32_t droppedBytes = 0, wakeups = 0;
+    double t = 0.0, busySecs = 0.0;
+    std::vector<double> latencyMs;
+
+    auto receive = [&](double until) {
+        while (arrived < n && arrival[arrived] <= until) {
+            if (ring.size() < GPS_RX_BUFFER_SIZE) {
+                ring.push_back(arrived);
+            } else {
+                droppedBytes++;
+            }
+            arrived++;
+        }
+        peak = std::max(peak, ring.size());
+    };
+
+    while (arrived < n || !ring.empty()) {
+        // Sleep until the FIFO threshold or the idle timeout posts an RX event
+        if (ring.size() < UART_RX_FULL_THRESHOLD) {
+            size_t need = UART_RX_FULL_THRESHOLD - ring.size();
+            double full = (arrived + need - 1 < n) ? arrival[arrived + need - 1] : INFINITY;
+            size_t last = ring.empty() ? arrived : arrived - 1;
+            double idle = arrival[runEnd[last]] + UART_RX_TIMEOUT_SYMBOLS * byteSecs;
+            t = std::max(t, std::min(full, idle));
+        }
+        receive(t);
+        wakeups++;
+
+        // Drain: gps.available(stream) keeps reading while bytes are queued
+        while (!ring.empty()) {
+            size_t i = ring.front();
+            ring.pop_front();
+
+            uint32_t fixesAt = fixCount;
+            clk::time_point t0 = clk::now();
+            gps.handle((uint8_t)data[i]);
+            while (gps.available()) {
+                replaySentence();
+            }
+            double cost = std::chrono::duration<double>(clk::now() - t0).count() * slowdown;
+            t += cost;
+            busySecs += cost;
+
+            size_t k = fixCount - fixesBefore - 1;
+            if (fixCount != fixesAt && k < burstEpoch.size()) latencyMs.push_back((t - burstEpoch[k]) * 1000.0);
+            receive(t);
+        }
+    }
+
+    uint32_t fixes = fixCount - fixesBefore;
+    uint32_t sentenceErrors = gps.statistics.errors - errorsBefore;
+    bool keptUp = overranIntervals == 0 && droppedBytes == 0 && sentenceErrors == 0 && fixes == burstEnd.size();
+
+    printf("\n=== GPS throughput (%lu baud, %.1f Hz fixes, ESP32 CPU = host x %.0f) ===\n",
+           (unsigned long)baud, fixHz, slowdown);
+    printf("Line:         %zu bytes in %.1f s, %.1f%% busy, max backlog %.1f ms, %lu intervals overran the line\n",
+           n, spanSecs, 100.0 * n * byteSecs / spanSecs, maxBacklog * 1000.0, (unsigned long)overranIntervals);
+    printf("Task:         %lu wakeups, %.2f%% busy, RX ring peak %zu/%d bytes, %lu bytes dropped\n",
+           (unsigned long)wakeups, 100.0 * busySecs / spanSecs, peak, GPS_RX_BUFFER_SIZE, (unsigned long)droppedBytes);
+    printf("Parser:       %lu/%zu fixes, %lu sentences ok, %lu errors\n", (unsigned long)fixes, burstEnd.size(),
+           (unsigned long)(gps.statistics.ok - okBefore), (unsigned long)sentenceErrors);
+    printf("Latency (ms): fix time to processGpsFix() done  p50 %.1f  p99 %.1f  max %.1f\n",
+           percentile(latencyMs, 0.50), percentile(latencyMs, 0.99), percentile(latencyMs, 1.0));
+    printf("Result:       %s\n", keptUp ? "keeps up" : (overranIntervals ? "line too slow for this fix rate" : "DROPPED DATA"));
+    return keptUp;
+}
+
+/*****************************
+ *   CONTENTION BENCHMARK     *
+ *****************************/
+
+// FreeRTOS semaphores are no-ops on the host, so a std::mutex stands in for gpsMutex
+static std::mutex benchMutex;
+
+/**
+ * Replay 'data' in a writer thread, one NMEA burst (up to the fix-completing RMC)
+ * per lock hold, while the calling thread reads GPS state as fast as it can.
+ * useSnapshot = false: old readers - take the mutex and build the hot packet timestamp Strings
+ * useSnapshot = true:  new readers - gpsSnapshot.read() + formatGpsTimestamp()
+ */
+static void runContention(const std::string& data, bool useSnapshot, std::vector<double>& readMicros) {
+    typedef std::chrono::steady_clock clk;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&]() {
+        size_t pos = 0;
+        while (pos < data.size()) {
+            std::unique_lock<std::mutex> lock(benchMutex, std::defer_lock);
+            if (!useSnapshot) lock.lock();
+
+            // Feed bytes until a merged fix completes (end of burst)
+            bool gotFix = false;
+            while (pos < data.size() && !gotFix) {
+                gps.handle((uint8_t)data[pos++]);
+                while (gps.available()) {
+                    if (replaySentence()) gotFix = true;
+                }
+            }
+
+            if (lock.owns_lock()) lock.unlock();
+            std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    size_t sink = 0;
+    while (!done) {
+        clk::time_point t0 = clk::now();
+        if (useSnapshot) {
+            GpsSnapshot snap;
+            char timestamp[32];
+            gpsSnapshot.read(snap);
+            formatGpsTimestamp(snap, timestamp, sizeof(timestamp));
+            sink += timestamp[0];
+        } else {
+            std::lock_guard<std::mutex> lock(benchMutex);
+            String timestamp = String(cur_date) + "  " + hhmm_str + am_pm_str;
+            sink += timestamp.length();
+        }
+        readMicros.push_back(std::chrono::duration<double, std::micro>(clk::now() - t0).count());
+    }
+    writer.join();
+
+    if (sink == 0) printf(" ");  // Keep the reads from being optimized away
+}
+
+static void printContention(const char* label, std::vector<double>& readMicros) {
+    printf("%-22s %9zu reads  p50 %8.2f  p99 %8.2f  p99.9 %8.2f  max %9.2f us\n", label, readMicros.size(),
+           percentile(readMicros, 0.50), percentile(readMicros, 0.99), percentile(readMicros, 0.999),
+           percentile(readMicros, 1.0));
+}
+
+/*****************
+ *     MAIN      *
+ *****************/
+
+// Concatenate the logs for the in-memory benchmarks
+static bool loadLogs(const std::vector<const char*>& files, std::string& data) {
+    for (const char* path : files) {
+        FILE* f = fopen(path, "rb");
+        if (!f) {
+            fprintf(stderr, "cannot open %s\n", path);
+            return false;
+        }
+        int c;
+        while ((c = fgetc(f)) != EOF) data += (char)c;
+        fclose(f);
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    typedef std::chrono::steady_clock clk;
+
+    bool verbose = false;
+    float startMiles = 0.0;
+    const char* ttyPath = NULL;
+    bool contention = false;
+    int geofenceCount = 0;
+    bool trackBench = false;
+    const char* trackCapture = NULL;
+    std::vector<uint32_t> bauds;
+    double slowdown = 30.0;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            startMiles = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-c") == 0) {
+            contention = true;
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            bauds.push_back(strtoul(argv[++i], NULL, 10));
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            slowdown = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-g") == 0) {
+            geofenceCount = 1000;
+            if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) geofenceCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0) {
+            trackBench = true;
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            trackCapture = argv[++i];
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            ttyPath = argv[++i];
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (trackCapture != NULL) {
+        return decodeTrackExport(trackCapture);
+    }
+
+    if (files.empty() && ttyPath == NULL) {
+        fprintf(stderr, "usage: %s [-v] [-o start_miles] [-c] [-g [fences]] [-t] [-b baud [-b baud] [-x slowdown]] (-p tty | log.nmea [...])\n"
+                        "       %s -d track_capture.txt\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    Serial.quiet = !verbose;
+    accum_distance = startMiles;
+
+    if (!bauds.empty()) {
+        std::string data;
+        if (!loadLogs(files, data)) return 1;
+
+        bool keptUp = true;
+        for (uint32_t baud : bauds) {
+            keptUp &= runThroughput(data, baud, slowdown);
+        }
+        return keptUp ? 0 : 2;
+    }
+
+    if (contention) {
+        std::string data;
+        if (!loadLogs(files, data)) return 1;
+
+        std::vector<double> mutexMicros, snapshotMicros;
+        runContention(data, false, mutexMicros);
+        runContention(data, true, snapshotMicros);
+
+        printf("\n=== GPS reader contention (%zu bytes, %lu fixes per pass) ===\n", data.size(),
+               (unsigned long)(fixCount / 2));
+        printContention("gpsMutex + Strings:", mutexMicros);
+        printContention("gpsSnapshot (seqlock):", snapshotMicros);
+        return 0;
+    }
+
+    double parseMicros = 0.0;
+    uint64_t bytes = 0;
+
+    clk::time_point wallStart = clk::now();
+
+    if (ttyPath != NULL) {
+        if (!gpsPtyTransport.open(ttyPath) || !gpsTransport.begin()) {
+            fprintf(stderr, "cannot open %s\n", ttyPath);
+            return 1;
+        }
+
+        // Same wait/drain loop as gpsTask(); parse and fix time are not separable here
+        while (!gpsPtyTransport.isHungUp()) {
+            if (!gpsTransport.waitForData(3000)) {
+                if (fixCount > 0) break;  // Idle after traffic - writer is done
+                continue;
+            }
+            while (gps.available(gpsTransport.stream())) {
+                replaySentence();
+            }
+        }
+        bytes = gps.statistics.chars;
+    }
+
+    for (const char* path : files) {
+        FILE* f = fopen(path, "rb");
+        if (!f) {
+            fprintf(stderr, "cannot open %s\n", path);
+            return 1;
+        }
+        loadLabels(path);
+
+        int c;
+        while ((c = fgetc(f)) != EOF) {
+            bytes++;
+
+            clk::time_point t0 = clk::now();
+            gps.handle((uint8_t)c);
+            parseMicros += std::chrono::duration<double, std::micro>(clk::now() - t0).count();
+
+            while (gps.available()) {
+                replaySentence();
+            }
+        }
+        fclose(f);
+        trackRecorder.flush();  // Each log is a round; the cart powers down at its end
+    }
+    double wallSecs = std::chrono::duration<double>(clk::now() - wallStart).count();
+    double logSecs = haveClock ? (double)(lastClock - firstClock) : 0.0;
+    double meanMicros = 0.0;
+    for (double us : fixMicros) meanMicros += us;
+    if (!fixMicros.empty()) meanMicros /= fixMicros.size();
+
+    double odoMiles = odometerTotalMiles() - startMiles;
+
+    printf("\n=== GPS replay report ===\n");
+    if (ttyPath != NULL) {
+        printf("Input:        %s, %llu bytes, %lu RX overruns\n", ttyPath, (unsigned long long)bytes,
+               (unsigned long)gpsTransport.getOverrunCount());
+    } else {
+        printf("Input:        %zu file(s), %llu bytes\n", files.size(), (unsigned long long)bytes);
+    }
+    printf("Sentences:    %lu ok, %lu errors\n",
+           (unsigned long)gps.statistics.ok, (unsigned long)gps.statistics.errors);
+    printf("Fixes:        %lu over %.0f s of log time (%.1f h)\n", (unsigned long)fixCount, logSecs, logSecs / 3600.0);
+    printf("Replay:       %.3f s wall (%.0fx real time)\n", wallSecs, wallSecs > 0 ? logSecs / wallSecs : 0.0);
+    printf("Parse CPU:    %.3f ms total, %.2f us/fix\n", parseMicros / 1000.0, fixCount ? parseMicros / fixCount : 0.0);
+    printf("Fix CPU (us): mean %.2f  p50 %.2f  p99 %.2f  max %.2f\n", meanMicros,
+           percentile(fixMicros, 0.50), percentile(fixMicros, 0.99), percentile(fixMicros, 1.0));
+    printf("Odometer:     %.4f mi firmware, %.4f mi reference, drift %+.4f mi (%+.3f%%)\n",
+           odoMiles, refMiles, odoMiles - refMiles, refMiles > 0 ? 100.0 * (odoMiles - refMiles) / refMiles : 0.0);
+    printf("              accum_distance %.3f (start %.3f), trip_distance %.3f\n", accum_distance, startMiles, trip_distance);
+    printSegmentBench();
+    if (geofenceCount > 0) {
+        printGeofenceBench((uint16_t)std::min(geofenceCount, 8000));
+    }
+    if (trackBench) {
+        printTrackBench(logSecs, files.size());
+    }
+    if (haveLabelledFixes) {
+        printf("Motion:       displayed speed vs labels\n");
+        filterScore.print();
+        legacyScore.print();
+    }
+    printf("Hours meter:  %ld tenths (%.1f h driving)\n", (long)hrs_since_svc, hrs_since_svc / 10.0);
+    printf("EEPROM:       %lu queued writes\n", (unsigned long)eepromWrites);
+    printf("Heap:         %llu allocations in processGpsFix (%.2f per fix), net %+lld bytes held\n",
+           (unsigned long long)benchAllocs, fixCount ? (double)benchAllocs / fixCount : 0.0,
+           (long long)benchHeapBytes);
+    if (hours.size() > 1) {
+        printf("              hour   fixes   allocs   net bytes\n");
+        for (size_t h = 0; h < hours.size(); h++) {
+            printf("              %4zu  %6lu  %7llu  %+10lld\n", h, (unsigned long)hours[h].fixes,
+                   (unsigned long long)hours[h].allocs, (long long)hours[h].heapBytes);
+        }
+    }
+    GpsHealth health;
+    if (readGpsHealth(health)) {
+        char text[256];
+        formatGpsHealth(health, text, sizeof(text));
+        printf("GPS health:   (last window, as on the device's GPS Health dialog)\n");
+        for (char* line = strtok(text, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+            printf("              %s\n", line);
+        }
+    }
+    printf("Display:      %s  %s%s  %s  sats/hdop %s  %s, %s\n", cur_date, hhmm_str, am_pm_str,
+           heading, sats_hdop, cur_lat, cur_long);
+
+    return 0;
+}
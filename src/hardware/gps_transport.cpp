@@ -0,0 +1,66 @@
+#include "gps_transport.h"
+#include "config.h"
+#include "globals.h"
+
+/**
+ * UART0 RX transport (GPS on GPS_RX_PIN, debug TX shares the port)
+ *
+ * In event-driven mode the HardwareSerial event task calls onReceive() when
+ * the RX FIFO threshold is reached or the line goes idle after a burst, which
+ * for NMEA is right after each sentence group. That callback notifies the
+ * waiting task, so fixes are processed as soon as they arrive instead of up
+ * to 100 ms later. The RX ring is enlarged in setup() (GPS_RX_BUFFER_SIZE)
+ * so a burst survives while gpsMutex is held by a reader.
+ */
+class UartGpsTransport : public GpsTransport {
+public:
+    bool begin() override {
+        waitingTask = xTaskGetCurrentTaskHandle();
+
+        // Count lost bytes in either mode
+        gpsSerial.onReceiveError([this](hardwareSerial_error_t err) {
+            if (err == UART_BUFFER_FULL_ERROR || err == UART_FIFO_OVF_ERROR) {
+                overrunCount++;
+            }
+        });
+
+#if GPS_EVENT_DRIVEN_RX == 1
+        gpsSerial.onReceive([this]() {
+            if (waitingTask != NULL) {
+                xTaskNotifyGive(waitingTask);
+            }
+        });
+        Serial.println("GPS RX: event-driven");
+#else
+        Serial.println("GPS RX: polling");
+#endif
+        return true;
+    }
+
+    bool waitForData(uint32_t timeoutMs) override {
+#if GPS_EVENT_DRIVEN_RX == 1
+        if (gpsSerial.available() > 0) {
+            return true;  // Leftover bytes from a burst that arrived during processing
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs));
+#else
+        vTaskDelay(pdMS_TO_TICKS(100));
+#endif
+        return gpsSerial.available() > 0;
+    }
+
+    Stream& stream() override {
+        return gpsSerial;
+    }
+
+    uint32_t getOverrunCount() const override {
+        return overrunCount;
+    }
+
+private:
+    TaskHandle_t waitingTask = NULL;
+    volatile uint32_t overrunCount = 0;
+};
+
+static UartGpsTransport uartGpsTransport;
+GpsTransport& gpsTransport = uartGpsTransport;
@@ -0,0 +1,33 @@
+#ifndef GPS_TRANSPORT_H
+#define GPS_TRANSPORT_H
+
+#include <Arduino.h>
+
+/**
+ * Byte source feeding NeoGPS in gpsTask
+ *
+ * The ESP32 build reads UART0 RX and sleeps until the UART driver reports new
+ * bytes (or polls every 100 ms when GPS_EVENT_DRIVEN_RX is 0). The native build
+ * reads a Linux tty/pty so the same ingestion loop can be exercised on a PC.
+ */
+class GpsTransport {
+public:
+    virtual ~GpsTransport() {}
+
+    // Prepare the transport; call from the task that will wait on it
+    virtual bool begin() = 0;
+
+    // Block until RX bytes are ready or timeoutMs elapses. Returns true if bytes are ready.
+    virtual bool waitForData(uint32_t timeoutMs) = 0;
+
+    // Stream handed to gps.available()
+    virtual Stream& stream() = 0;
+
+    // Number of RX FIFO/ring-buffer overruns since boot (bytes were lost)
+    virtual uint32_t getOverrunCount() const = 0;
+};
+
+// Global instance used by gpsTask
+extern GpsTransport& gpsTransport;
+
+#endif // GPS_TRANSPORT_H
@@ -0,0 +1,59 @@
+#include "gps_transport_host.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+PtyGpsTransport gpsPtyTransport;
+GpsTransport& gpsTransport = gpsPtyTransport;
+
+bool PtyGpsTransport::open(const char* path) {
+    rx.fd = ::open(path, O_RDONLY | O_NOCTTY | O_NONBLOCK);
+    if (rx.fd < 0) {
+        return false;
+    }
+
+    struct termios tio;
+    if (tcgetattr(rx.fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(rx.fd, TCSANOW, &tio);
+    }
+    return true;
+}
+
+bool PtyGpsTransport::begin() {
+    return rx.fd >= 0;
+}
+
+bool PtyGpsTransport::waitForData(uint32_t timeoutMs) {
+    if (rx.available() > 0) {
+        return true;
+    }
+
+    struct pollfd pfd = { rx.fd, POLLIN, 0 };
+    int rc = poll(&pfd, 1, (int)timeoutMs);
+    if (rc > 0 && (pfd.revents & POLLIN)) {
+        return rx.available() > 0;
+    }
+    if (rc > 0 && (pfd.revents & (POLLHUP | POLLERR))) {
+        hungUp = true;
+    }
+    return false;
+}
+
+int PtyGpsTransport::FdStream::available() {
+    if (head == tail && fd >= 0) {
+        ssize_t n = ::read(fd, buf, sizeof(buf));
+        head = 0;
+        tail = (n > 0) ? (size_t)n : 0;
+    }
+    return (int)(tail - head);
+}
+
+int PtyGpsTransport::FdStream::read() {
+    return available() > 0 ? buf[head++] : -1;
+}
+
+int PtyGpsTransport::FdStream::peek() {
+    return available() > 0 ? buf[head] : -1;
+}
@@ -0,0 +1,44 @@
+#ifndef GPS_TRANSPORT_HOST_H
+#define GPS_TRANSPORT_HOST_H
+
+#include "gps_transport.h"
+
+/**
+ * Linux tty/pty transport for [env:native]
+ *
+ * Lets the replay harness run the gpsTask ingestion loop against a live byte
+ * stream, e.g.:
+ *   socat -d -d pty,raw,echo=0,link=/tmp/gps pty,raw,echo=0,link=/tmp/gps_in
+ *   pv -qL 960 round.nmea > /tmp/gps_in      # 9600 baud pacing
+ */
+class PtyGpsTransport : public GpsTransport {
+public:
+    bool open(const char* path);
+    bool isHungUp() const { return hungUp; }
+
+    bool begin() override;
+    bool waitForData(uint32_t timeoutMs) override;
+    Stream& stream() override { return rx; }
+    uint32_t getOverrunCount() const override { return 0; }  // Kernel tty buffering, nothing to count
+
+private:
+    class FdStream : public Stream {
+    public:
+        int fd = -1;
+        int available() override;
+        int read() override;
+        int peek() override;
+        size_t write(uint8_t c) override { return 0; }
+    private:
+        uint8_t buf[256];
+        size_t head = 0;
+        size_t tail = 0;
+    };
+
+    FdStream rx;
+    bool hungUp = false;
+};
+
+extern PtyGpsTransport gpsPtyTransport;
+
+#endif // GPS_TRANSPORT_HOST_H
@@ -0,0 +1,1049 @@
+/********************************************************************************************
+*    GCD Hot Packet Bench - host-side (Linux) fuzzing and timing of the hot packet parsers  *
+*                                                                                           *
+*    Runs parseWeatherFrame() (communication/weather_parser.cpp, the firmware source) over  *
+*    a corpus of weather hot packets, then over random mutations of them, and times it      *
+*    against the String-based parser it replaced. Then stress tests the hot packet          *
+*    TripleBuffer (utils/triple_buffer.h) with a writer and a reader thread.                *
+*    Binary frames and deltas (communication/hot_packet_binary.cpp) are round tripped,      *
+*    fuzzed, and run as a lossy update stream against a full-frame resync. The rebroadcast  *
+*    duplicate cache (utils/packet_dedup.cpp) is checked with synthetic timestamps. The     *
+*    received packet pool (utils/mesh_rx_pool.cpp) is filled with corpus-sized messages     *
+*    to compare its capacity with the old 30-slot queue, then stress tested with a          *
+*    producer and a consumer thread.                                                        *
+*                                                                                           *
+*    Usage:                                                                                 *
+*    1. pio run -e native_hotpacket                                                         *
+*    2. .pio/build/native_hotpacket/program [-v] [-n N] [-s seed] [-m ms] corpus.txt [...]  *
+*         -v  show firmware debug output (quiet by default)                                 *
+*         -n  fuzz mutations (default 200000), -s random seed (default 1)                   *
+*         -m  milliseconds per stress run (default 1000, 0 skips it)                        *
+*       For memory errors, add -fsanitize=address,undefined to the env's build_flags.       *
+*                                                                                           *
+*    Corpus: one packet per line, prefixed '+' (must parse) or '-' (must be rejected);      *
+*    lines starting with ';' and blank lines are ignored. See test/hot_packet_corpus/.      *
+*    Venue/event packets ("|#02#") go to the venue parser, the rest to the weather one.     *
+*    A '=' line after a '+' packet is what the display shows for it (see displayText()).    *
+*                                                                                           *
+*    Checks: corpus expectations and display text; for every mutation, an accepted packet   *
+*    is in range, terminated, and parses to the same frame after being written back out     *
+*    (a rejected one parses in place and is never published). Stress: every frame the       *
+*    reader acquires is whole and generations only increase (the old two-slot swap is run   *
+*    alongside for comparison, its torn reads are reported but not failures); every pool    *
+*    message arrives once, in order and intact, and the pool holds more binary hot packets  *
+*    than the old queue.                                                                    *
+*    Exits 1 on any failure.                                                                *
+*                                                                                           *
+********************************************************************************************/
+
+#include <Arduino.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_check.h"
+#include "config.h"
+#include "types.h"
+#include "communication/weather_parser.h"
+#include "communication/venue_parser.h"
+#include "communication/hot_packet_binary.h"
+#include "utils/triple_buffer.h"
+#include "utils/packet_dedup.h"
+#include "utils/mesh_rx_pool.h"
+
+HardwareSerial Serial;
+
+/*****************************
+ *     LEGACY BASELINE        *
+ *****************************/
+
+// The per-packet String work of the parser WeatherFrame replaced: delimiter count,
+// null-patching a copy, a validated String per field, then copies into the back
+// buffer and the legacy globals
+static String legacyBuffer[18], legacyGlobals[18];
+
+static String legacyValidateField(const char* field, int maxLength) {
+    String fieldStr = String(field);
+    if (fieldStr.length() == 0) return "";
+    if ((int)fieldStr.length() > maxLength) fieldStr = fieldStr.substring(0, maxLength);
+    return fieldStr;
+}
+
+static bool legacyParse(const char* text) {
+    char input[MAX_MESHTASTIC_PAYLOAD + 1];
+    strlcpy(input, text, sizeof(input));
+    int len = strlen(input);
+
+    int hashCount = 0, commaCount = 0;
+    for (int i = 0; i < len; i++) {
+        if (input[i] == '#') hashCount++;
+        if (input[i] == ',') commaCount++;
+    }
+    if (hashCount != 7 || commaCount != 12) return false;
+    for (int i = 0; i < len; i++) {
+        if (input[i] == '#' || input[i] == ',') input[i] = '\0';
+    }
+
+    static const int maxLen[17] = {10, 6, 2, 10, 6, 6, 2, 10, 6, 6, 2, 10, 6, 6, 2, 10, 6};
+    String tmp[17];
+    int ptr = HOT_PKT_HEADER_OFFSET;
+    for (int f = 0; f < 17; f++) {
+        if (ptr >= len) return false;
+        tmp[f] = legacyValidateField(&input[ptr], maxLen[f]);
+        if (tmp[f].length() == 0) return false;
+        if (f % 4 == 3) tmp[f] = String((int)tmp[f].toInt());          // validateTemperature
+        if (f % 4 == 0 && f > 0 && tmp[f] == "0.0") tmp[f] = "";        // Blank zero precipitation
+        ptr += strlen(&input[ptr]) + 1;
+    }
+
+    legacyBuffer[0] = "Mon, Jan 5  3:07PM";
+    for (int f = 0; f < 17; f++) legacyBuffer[f + 1] = tmp[f];
+    for (int f = 0; f < 18; f++) legacyGlobals[f] = legacyBuffer[f];
+    return true;
+}
+
+/*****************************
+ *          CHECKS            *
+ *****************************/
+
+struct CorpusEntry {
+    std::string text;
+    bool expectValid;
+    bool venue;         // "|#02#" venue/event packet, otherwise weather
+    bool hasDisplay;      // A '=' line followed the packet
+    std::string display;  // ... giving its expected displayText()
+};
+
+static bool frameSane(const WeatherFrame& f) {
+    if (!f.valid || f.rcvTime[0] != '\0') return false;
+    if (f.curTemp < -990 || f.curTemp > 9990) return false;
+    for (int h = 0; h < WX_FORECAST_HOURS; h++) {
+        const WeatherForecastHour& hr = f.hours[h];
+        if (memchr(hr.hour, '\0', sizeof(hr.hour)) == NULL || hr.hour[0] == '\0') return false;
+        if (memchr(hr.glyph, '\0', sizeof(hr.glyph)) == NULL || hr.glyph[0] == '\0') return false;
+        if (hr.temp < -99 || hr.temp > 999) return false;
+    }
+    return true;
+}
+
+// Binary frames carry their strings as sent, only text is trimmed
+static bool venueSane(const VenueFrame& f, bool trimmed = true) {
+    if (f.rcvTime[0] != '\0' || f.count > VENUE_MAX_EVENTS) return false;
+    for (int i = 0; i < f.count; i++) {
+        const VenueEvent& e = f.events[i];
+        if (memchr(e.venue, '\0', sizeof(e.venue)) == NULL || memchr(e.event, '\0', sizeof(e.event)) == NULL) return false;
+        if (trimmed && (e.venue[0] == ' ' || e.event[0] == ' ')) return false;
+    }
+    return f.hash == hashVenueEvents(f);
+}
+
+// What the weather screen shows: current temperature, then each hour's precipitation ("-" for blank)
+static std::string displayText(const WeatherFrame& f) {
+    char buf[16];
+    formatWeatherCurTemp(f, buf, sizeof(buf));
+    std::string out = buf;
+    for (int h = 0; h < WX_FORECAST_HOURS; h++) {
+        formatWeatherPrecip(f.hours[h].precip, buf, sizeof(buf));
+        out += ' ';
+        out += buf[0] ? buf : "-";
+    }
+    return out;
+}
+
+// The Now Playing rows: "venue|event", '#' between rows
+static std::string displayText(const VenueFrame& f) {
+    std::string out;
+    for (int i = 0; i < f.count; i++) {
+        if (i > 0) out += '#';
+        out += f.events[i].venue;
+        out += '|';
+        out += f.events[i].event;
+    }
+    return out;
+}
+
+// Write a frame back out as a packet (zero precipitation as "0")
+static std::string serializeFrame(const WeatherFrame& f) {
+    char buf[16];
+    std::string out = "|#01#";
+    formatWeatherCurTemp(f, buf, sizeof(buf));
+    out += buf;
+    out += '#';
+    for (int h = 0; h < WX_FORECAST_HOURS; h++) {
+        const WeatherForecastHour& hr = f.hours[h];
+        out += hr.hour;
+        out += ',';
+        out += hr.glyph;
+        out += ',';
+        formatWeatherTemp(hr.temp, buf, sizeof(buf));
+        out += buf;
+        out += ',';
+        formatWeatherPrecip(hr.precip, buf, sizeof(buf));
+        out += buf[0] ? buf : "0";
+        out += '#';
+    }
+    return out;
+}
+
+static size_t weatherTextSize(const WeatherFrame& f) {
+    return serializeFrame(f).size();
+}
+
+static size_t venueTextSize(const VenueFrame& f) {
+    size_t n = HOT_PKT_HEADER_OFFSET;
+    for (int i = 0; i < f.count; i++) n += strlen(f.events[i].venue) + strlen(f.events[i].event) + 2;
+    return n;
+}
+
+// Random edit biased toward the characters the tokenizer cares about
+static void mutate(std::string& s) {
+    static const char ALPHABET[] = "#,.-+|0123456789amp \x7f\xff";
+    int edits = 1 + rand() % 3;
+    for (int e = 0; e < edits; e++) {
+        size_t pos = s.empty() ? 0 : rand() % (s.size() + 1);
+        char c = ALPHABET[rand() % (sizeof(ALPHABET) - 1)];
+        switch (rand() % 5) {
+            case 0: if (pos < s.size()) s[pos] = c; break;
+            case 1: s.insert(pos, 1, c); break;
+            case 2: if (pos < s.size()) s.erase(pos, 1 + rand() % 4); break;
+            case 3: s.resize(pos); break;
+            case 4: if (pos < s.size()) s.insert(pos, s.substr(pos, 1 + rand() % 12)); break;
+        }
+    }
+    if (s.size() > MAX_MESHTASTIC_PAYLOAD) s.resize(MAX_MESHTASTIC_PAYLOAD);
+}
+
+// Random byte edits to an encoded binary packet
+static void mutateBinary(std::vector<uint8_t>& b) {
+    int edits = 1 + rand() % 3;
+    for (int e = 0; e < edits; e++) {
+        size_t pos = b.empty() ? 0 : rand() % (b.size() + 1);
+        uint8_t v = (rand() % 4 == 0) ? (uint8_t)(0x80 | rand()) : (uint8_t)(rand() % 32);
+        switch (rand() % 4) {
+            case 0: if (pos < b.size()) b[pos] = v; break;
+            case 1: if (pos < b.size()) b[pos] ^= (uint8_t)(1 << (rand() % 8)); break;
+            case 2: b.insert(b.begin() + pos, v); break;
+            case 3: b.resize(pos); break;
+        }
+    }
+}
+
+static bool loadCorpus(const char* path, std::vector<CorpusEntry>& corpus) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    char line[1024];
+    while (fgets(line, sizeof(line), f)) {
+        size_t len = strcspn(line, "\r\n");
+        line[len] = '\0';
+        if (line[0] == '=' && !corpus.empty()) {
+            corpus.back().hasDisplay = true;
+            corpus.back().display = line + 1;
+            continue;
+        }
+        if (line[0] != '+' && line[0] != '-') continue;  // Comment or blank
+        corpus.push_back(CorpusEntry{std::string(line + 1), line[0] == '+', strncmp(line + 1, "|#02#", 5) == 0, false, ""});
+    }
+    fclose(f);
+    return true;
+}
+
+/*****************************
+ *      DELTA STREAMS         *
+ *****************************/
+
+#define DELTA_STREAM_STEPS 5000
+#define DELTA_FULL_EVERY 10      // Gateway resends a full frame every N updates
+#define DELTA_LOSS_ONE_IN 20     // Mesh drops one packet in N
+#define DELTA_FUZZ_BASES 256
+
+static std::vector<VenueEvent> venuePool;  // Rows seen in the corpus, for venue updates
+
+static uint16_t nextSeq(uint16_t seq) {
+    return seq % 65535 + 1;  // 0 means unsequenced
+}
+
+static int16_t clampTemp(int v) {
+    return (int16_t)(v < -99 ? -99 : (v > 999 ? 999 : v));
+}
+
+static void randomHour(WeatherForecastHour& hr, int hourOfDay) {
+    memset(&hr, 0, sizeof(hr));
+    snprintf(hr.hour, sizeof(hr.hour), "%d%s", hourOfDay % 12 == 0 ? 12 : hourOfDay % 12, hourOfDay < 12 ? "am" : "pm");
+    snprintf(hr.glyph, sizeof(hr.glyph), "%u", (unsigned)rand() % 100);
+    hr.temp = clampTemp(60 + rand() % 40);
+    hr.precip = (rand() % 3 == 0) ? rand() % 300 : 0;
+}
+
+// Next refresh from the gateway: usually a field or two moves, now and then the hours roll over
+static void evolveWeather(WeatherFrame& f) {
+    if (rand() % 10 == 0) {
+        memmove(&f.hours[0], &f.hours[1], sizeof(f.hours[0]) * (WX_FORECAST_HOURS - 1));
+        randomHour(f.hours[WX_FORECAST_HOURS - 1], rand() % 24);
+    }
+    for (int c = rand() % 3; c > 0; c--) {
+        int which = rand() % (WX_FORECAST_HOURS + 1);
+        if (which == 0) {
+            // Gateways send either form; the binary carries both as sent
+            f.curTempDecimal = rand() % 2 == 0;
+            int tenths = f.curTemp + rand() % 41 - 20;
+            if (!f.curTempDecimal) tenths -= tenths % 10;
+            f.curTemp = (int16_t)(tenths < -990 ? -990 : (tenths > 9990 ? 9990 : tenths));
+            continue;
+        }
+        WeatherForecastHour& hr = f.hours[which - 1];
+        hr.temp = clampTemp(hr.temp + rand() % 5 - 2);
+        if (rand() % 3 == 0) hr.precip = rand() % 300;
+        if (rand() % 4 == 0) {
+            memset(hr.glyph, 0, sizeof(hr.glyph));
+            snprintf(hr.glyph, sizeof(hr.glyph), "%u", (unsigned)rand() % 100);
+        }
+    }
+    f.seq = nextSeq(f.seq);
+}
+
+// Usually one act changes; sometimes a row is added or dropped
+static void evolveVenue(VenueFrame& f) {
+    int what = rand() % 10;
+    if (what == 0 && f.count < 6) {  // Six short rows keep a full frame within one packet
+        f.events[f.count++] = venuePool[rand() % venuePool.size()];
+    } else if (what == 1 && f.count > 0) {
+        memset(&f.events[--f.count], 0, sizeof(f.events[0]));
+    } else if (f.count > 0) {
+        VenueEvent& e = f.events[rand() % f.count];
+        memcpy(e.event, venuePool[rand() % venuePool.size()].event, sizeof(e.event));
+    }
+    f.hash = hashVenueEvents(f);
+    f.seq = nextSeq(f.seq);
+}
+
+template <typename T>
+struct DeltaCodec {
+    const char* name;
+    void (*evolve)(T&);
+    bool (*sane)(const T&);
+    size_t (*textSize)(const T&);
+    size_t (*encodeFull)(const T&, uint8_t*, size_t);
+    bool (*decodeFull)(const uint8_t*, size_t, T&);
+    size_t (*encodeDelta)(const T&, const T&, uint8_t*, size_t);
+    hotBinDelta_t (*apply)(const uint8_t*, size_t, const T&, T&);
+};
+
+struct DeltaStats {
+    uint64_t updates;
+    uint64_t textBytes;     // Every update as a text packet
+    uint64_t fullBytes;     // Every update as a full binary frame
+    uint64_t sentBytes;     // Deltas plus the periodic full frames
+    uint64_t lost;
+    uint64_t gaps;          // Deltas refused after a loss
+    uint64_t resyncs;       // Full frames that ended a gap
+    uint32_t fuzzAccepted;
+};
+
+struct DeltaSample {
+    std::vector<uint8_t> base;  // Frame bytes the delta applies to
+    std::vector<uint8_t> delta;
+};
+
+static bool weatherSaneSeq(const WeatherFrame& f) {
+    return frameSane(f) && f.seq != 0;
+}
+
+static bool venueSaneSeq(const VenueFrame& f) {
+    return venueSane(f, false) && f.seq != 0;
+}
+
+/**
+ * Gateway/display pair: the sender evolves a frame and sends deltas with a full
+ * frame every DELTA_FULL_EVERY updates; the mesh drops some packets. The display
+ * must match the sender after every packet it applies, refuse every delta after
+ * a loss without touching its frame, and match again after the next full frame.
+ * Deltas are replayed as duplicates now and then. Then the deltas are fuzzed
+ * against their bases: a refused one writes nothing, an applied one is sane.
+ */
+template <typename T>
+static DeltaStats runDeltaStream(const DeltaCodec<T>& codec, const T& start, long fuzzIterations, uint32_t& failures) {
+    DeltaStats st = {};
+    std::vector<DeltaSample> samples;
+    uint8_t buf[MAX_MESHTASTIC_PAYLOAD];
+
+    T sent = start, shown, before;
+    sent.seq = 1;
+    memset(&shown, 0, sizeof(shown));
+    size_t n = codec.encodeFull(sent, buf, sizeof(buf));
+    if (n == 0 || !codec.decodeFull(buf, n, shown) || memcmp(&shown, &sent, sizeof(sent)) != 0) {
+        printf("FAIL %s delta stream: first full frame\n", codec.name);
+        failures++;
+        return st;
+    }
+
+    bool gapped = false;
+    for (int step = 1; step <= DELTA_STREAM_STEPS && failures <= 20; step++) {
+        T prev = sent;
+        codec.evolve(sent);
+        st.updates++;
+        st.textBytes += codec.textSize(sent);
+        size_t full = codec.encodeFull(sent, buf, sizeof(buf));
+        st.fullBytes += full;
+
+        size_t delta = (step % DELTA_FULL_EVERY == 0) ? 0 : codec.encodeDelta(prev, sent, buf, sizeof(buf));
+        if (delta == 0) {
+            // Periodic (or delta too big) full frame
+            n = codec.encodeFull(sent, buf, sizeof(buf));
+            st.sentBytes += n;
+            if (rand() % DELTA_LOSS_ONE_IN == 0) {
+                st.lost++;
+                gapped = true;
+                continue;
+            }
+            if (n == 0 || !codec.decodeFull(buf, n, shown) || memcmp(&shown, &sent, sizeof(sent)) != 0) {
+                printf("FAIL %s delta stream: full frame at step %d\n", codec.name, step);
+                failures++;
+            }
+            if (gapped) st.resyncs++;
+            gapped = false;
+            continue;
+        }
+
+        st.sentBytes += delta;
+        if (samples.size() < DELTA_FUZZ_BASES) {
+            samples.push_back(DeltaSample{std::vector<uint8_t>((uint8_t*)&prev, (uint8_t*)&prev + sizeof(prev)),
+                                          std::vector<uint8_t>(buf, buf + delta)});
+        }
+        if (rand() % DELTA_LOSS_ONE_IN == 0) {
+            st.lost++;
+            gapped = true;
+            continue;
+        }
+
+        before = shown;
+        hotBinDelta_t result = codec.apply(buf, delta, shown, shown);
+        if (gapped) {
+            st.gaps++;
+            if (result != HOT_BIN_DELTA_GAP || memcmp(&shown, &before, sizeof(shown)) != 0) {
+                printf("FAIL %s delta stream: delta after a loss not refused at step %d\n", codec.name, step);
+                failures++;
+            }
+            continue;
+        }
+        if (result != HOT_BIN_DELTA_APPLIED || memcmp(&shown, &sent, sizeof(sent)) != 0) {
+            printf("FAIL %s delta stream: delta not applied at step %d\n", codec.name, step);
+            failures++;
+        }
+        if (rand() % 10 == 0) {
+            before = shown;
+            if (codec.apply(buf, delta, shown, shown) != HOT_BIN_DELTA_DUPLICATE ||
+                memcmp(&shown, &before, sizeof(shown)) != 0) {
+                printf("FAIL %s delta stream: duplicate delta not ignored at step %d\n", codec.name, step);
+                failures++;
+            }
+        }
+    }
+
+    // Delta mutation fuzzing
+    T base, out, sentinel;
+    memset(&sentinel, 0xA5, sizeof(sentinel));
+    for (long i = 0; i < fuzzIterations && !samples.empty() && failures <= 20; i++) {
+        const DeltaSample& sample = samples[rand() % samples.size()];
+        std::vector<uint8_t> b = sample.delta;
+        mutateBinary(b);
+        memcpy(&base, sample.base.data(), sizeof(base));
+
+        out = sentinel;
+        if (codec.apply(b.data(), b.size(), base, out) != HOT_BIN_DELTA_APPLIED) {
+            if (memcmp(&out, &sentinel, sizeof(out)) != 0) {
+                printf("FAIL %s refused delta modified the frame\n", codec.name);
+                failures++;
+            }
+            continue;
+        }
+        st.fuzzAccepted++;
+        if (!codec.sane(out)) {
+            printf("FAIL %s delta fuzz: applied delta gave a bad frame\n", codec.name);
+            failures++;
+        }
+    }
+    return st;
+}
+
+static void printDeltaStats(const char* label, const DeltaStats& st) {
+    if (st.updates == 0) return;
+    printf("%-14s%llu updates: %.1f bytes/update sent vs %.1f full binary vs %.1f text, "
+           "%llu lost, %llu deltas refused until %llu resyncs, fuzz %u accepted\n",
+           label, (unsigned long long)st.updates, (double)st.sentBytes / st.updates,
+           (double)st.fullBytes / st.updates, (double)st.textBytes / st.updates, (unsigned long long)st.lost,
+           (unsigned long long)st.gaps, (unsigned long long)st.resyncs, st.fuzzAccepted);
+}
+
+/*****************************
+ *     DUPLICATE CACHE        *
+ *****************************/
+
+// Rebroadcast copies (same sender and id) within the window are hits; the same data
+// sent again under a new id, another sender, a packet without an id, an expired or
+// evicted entry are not, and the window holds across the millis() wrap
+static bool checkDedup(PacketDedup& dedup) {
+    bool ok = true;
+    ok &= !dedup.seen(1, 7, 0);
+    ok &= dedup.seen(1, 7, 1000);                                  // Rebroadcast
+    ok &= dedup.seen(1, 7, MESH_DEDUP_WINDOW_MS - 1);
+    ok &= !dedup.seen(2, 7, 2000);                                 // Other sender, same id
+    ok &= !dedup.seen(1, 8, 2000);                                 // Same data sent again: new id
+    ok &= !dedup.seen(1, 0, 2000) && !dedup.seen(1, 0, 2001);      // No id, never a duplicate
+    ok &= !dedup.seen(1, 7, MESH_DEDUP_WINDOW_MS);                 // Window over
+    for (uint32_t i = 0; i < MESH_DEDUP_ENTRIES; i++) {
+        dedup.seen(100 + i, 1, MESH_DEDUP_WINDOW_MS + 1);          // Push it out
+    }
+    ok &= !dedup.seen(1, 7, MESH_DEDUP_WINDOW_MS + 2);             // Evicted
+    ok &= !dedup.seen(3, 9, 0xFFFFF000u);
+    ok &= dedup.seen(3, 9, 0x00000100u);                           // Across the wrap
+    ok &= dedup.hits() == 3 && dedup.misses() == 6 + MESH_DEDUP_ENTRIES;
+    return ok;
+}
+
+/*****************************
+ *     TWO-CORE STRESS        *
+ *****************************/
+
+// Every byte of a stress frame is derived from its stamp, so a mix of two frames is detectable
+static void fillVenue(VenueFrame& f, uint32_t stamp) {
+    memcpy(f.rcvTime, &stamp, sizeof(stamp));
+    memset(f.rcvTime + sizeof(stamp), (uint8_t)stamp, sizeof(f.rcvTime) - sizeof(stamp));
+    memset(f.events, (uint8_t)(stamp * 7 + 1), sizeof(f.events));
+}
+
+static bool venueIntact(const VenueFrame& f, uint32_t& stamp) {
+    memcpy(&stamp, f.rcvTime, sizeof(stamp));
+    for (size_t i = sizeof(stamp); i < sizeof(f.rcvTime); i++) {
+        if ((uint8_t)f.rcvTime[i] != (uint8_t)stamp) return false;
+    }
+    const uint8_t* events = (const uint8_t*)f.events;
+    for (size_t i = 0; i < sizeof(f.events); i++) {
+        if (events[i] != (uint8_t)(stamp * 7 + 1)) return false;
+    }
+    return true;
+}
+
+struct StressResult {
+    uint64_t published;
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t outOfOrder;
+};
+
+// Writer thread publishes as fast as it can (meshtastic callback task), reader
+// acquires and checks the frame (GUI task) until the time is up
+static StressResult stressTripleBuffer(int ms) {
+    static TripleBuffer<VenueFrame> buffer;
+    std::atomic<bool> stop{false};
+    StressResult r = {};
+
+    std::thread writer([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            fillVenue(buffer.writeBuffer(), buffer.generation() + 1);
+            buffer.publish();
+            r.published++;
+        }
+    });
+
+    VenueFrame copy;
+    uint32_t last = 0, stamp;
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < end) {
+        if (!buffer.acquire()) continue;
+        r.reads++;
+        uint32_t gen = buffer.readGeneration();
+        memcpy(&copy, &buffer.readBuffer(), sizeof(copy));
+        if (!venueIntact(copy, stamp) || stamp != gen) r.torn++;
+        if (gen <= last) r.outOfOrder++;
+        last = gen;
+    }
+
+    stop = true;
+    writer.join();
+    return r;
+}
+
+// The two-slot swap TripleBuffer replaced: the writer fills 1 - active and flips
+// active, so a reader still copying the front slot can be overwritten two packets later
+static StressResult stressDoubleBuffer(int ms) {
+    static VenueFrame slots[2];
+    static std::atomic<int> active{0};
+    std::atomic<bool> stop{false};
+    StressResult r = {};
+
+    std::thread writer([&] {
+        uint32_t stamp = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            int back = 1 - active.load(std::memory_order_acquire);
+            fillVenue(slots[back], ++stamp);
+            active.store(back, std::memory_order_release);
+            r.published++;
+        }
+    });
+
+    VenueFrame copy;
+    uint32_t stamp;
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < end) {
+        memcpy(&copy, &slots[active.load(std::memory_order_acquire)], sizeof(copy));
+        r.reads++;
+        if (!venueIntact(copy, stamp)) r.torn++;
+    }
+
+    stop = true;
+    writer.join();
+    return r;
+}
+
+// The 30-item xQueue MeshRxPool replaced: every slot sized for the largest payload
+#define OLD_QUEUE_ITEMS 30
+#define OLD_QUEUE_ITEM_BYTES 252           // sizeof(meshtasticCallbackItem_t), 237-byte union included
+
+// Messages of these payload sizes (taken in turn) that fit in an empty pool
+static uint32_t poolCapacity(const std::vector<size_t>& sizes) {
+    static MeshRxPool pool;
+    while (pool.peek() != NULL) pool.release();
+    uint32_t n = 0;
+    MeshRxMessage header = {};
+    for (size_t i = 0; !sizes.empty(); i++) {
+        header.size = sizes[i % sizes.size()];
+        if (pool.reserve(header.size) == NULL) break;
+        pool.commit(header);
+        n++;
+    }
+    return n;
+}
+
+struct PoolStressResult {
+    uint64_t committed;
+    uint64_t received;
+    uint64_t abandoned;   // Reserved then not committed (duplicates, admin...)
+    uint64_t corrupt;
+    uint64_t outOfOrder;
+    MeshRxPool::Stats stats;
+};
+
+// Producer thread plays the decoder in meshtasticTask (mostly small payloads, now and then a
+// full one, some reservations abandoned), the consumer plays meshtasticCallbackTask
+static PoolStressResult stressRxPool(int ms) {
+    static MeshRxPool pool;
+    std::atomic<bool> stop{false};
+    PoolStressResult r = {};
+
+    std::thread producer([&] {
+        uint32_t seq = 0;
+        uint32_t rng = 12345;
+        while (!stop.load(std::memory_order_relaxed)) {
+            rng = rng * 1103515245 + 12345;
+            size_t size = (rng >> 16) % 8 == 0 ? MAX_MESHTASTIC_PAYLOAD - 1 : (rng >> 8) % 64;
+            uint8_t* room = pool.reserve(size);
+            if (room == NULL) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < size; i++) room[i] = (uint8_t)(seq + i);
+            room[size] = '\0';
+            if ((rng >> 20) % 10 == 0) {
+                r.abandoned++;
+                continue;
+            }
+            MeshRxMessage header = {};
+            header.from = seq++;
+            header.size = size;
+            pool.commit(header);
+            r.committed++;
+        }
+    });
+
+    uint32_t expect = 0;
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (true) {
+        const MeshRxMessage* m = pool.peek();
+        if (m == NULL) {
+            if (std::chrono::steady_clock::now() >= end) {
+                if (stop.load()) break;
+                stop = true;
+                producer.join();  // Then drain what it left
+            }
+            continue;
+        }
+        if (m->from != expect) r.outOfOrder++;
+        expect = m->from + 1;
+        bool intact = m->bytes()[m->size] == '\0';
+        for (size_t i = 0; i < m->size && intact; i++) intact = m->bytes()[i] == (uint8_t)(m->from + i);
+        if (!intact) r.corrupt++;
+        r.received++;
+        pool.release();
+    }
+    r.stats = pool.stats();
+    return r;
+}
+
+/*****************
+ *     MAIN      *
+ *****************/
+
+int main(int argc, char** argv) {
+    typedef std::chrono::steady_clock clk;
+
+    bool verbose = false;
+    bool dumpBinary = false;
+    long iterations = 200000;
+    unsigned seed = 1;
+    int stressMs = 1000;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "-x") == 0) {
+            dumpBinary = true;
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            iterations = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            stressMs = atoi(argv[++i]);
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        fprintf(stderr, "usage: %s [-v] [-x] [-n mutations] [-s seed] [-m ms] corpus.txt [...]\n", argv[0]);
+        return 1;
+    }
+
+    Serial.quiet = !verbose;
+    std::vector<CorpusEntry> corpus;
+    for (const char* path : files) {
+        if (!loadCorpus(path, corpus)) return 1;
+    }
+    if (corpus.empty()) {
+        fprintf(stderr, "empty corpus\n");
+        return 1;
+    }
+
+    // Corpus expectations
+    uint32_t failures = 0, validCount = 0;
+    WeatherFrame frame;
+    VenueFrame venue;
+    for (const CorpusEntry& entry : corpus) {
+        bool ok;
+        if (entry.venue) {
+            memset(&venue, 0, sizeof(venue));
+            ok = parseVenueFrame(entry.text.c_str(), venue);
+            ok = ok && venueSane(venue);
+        } else {
+            memset(&frame, 0, sizeof(frame));
+            ok = parseWeatherFrame(entry.text.c_str(), frame);
+            ok = ok && frameSane(frame);
+        }
+        if (ok != entry.expectValid) {
+            printf("FAIL corpus (%s expected): %s\n", entry.expectValid ? "accept" : "reject", entry.text.c_str());
+            failures++;
+        } else if (ok && entry.hasDisplay) {
+            std::string shown = entry.venue ? displayText(venue) : displayText(frame);
+            if (shown != entry.display) {
+                printf("FAIL corpus display \"%s\" (expected \"%s\"): %s\n", shown.c_str(), entry.display.c_str(),
+                       entry.text.c_str());
+                failures++;
+            }
+        }
+        if (entry.expectValid) validCount++;
+    }
+
+    // Mutation fuzzing
+    srand(seed);
+    uint32_t accepted = 0;
+    WeatherFrame sentinel, reparsed;  // Binary decodes, unlike text parses, leave a rejected frame untouched
+    VenueFrame venueSentinel;
+    memset(&sentinel, 0xA5, sizeof(sentinel));
+    memset(&venueSentinel, 0xA5, sizeof(venueSentinel));
+    for (long n = 0; n < iterations; n++) {
+        const CorpusEntry& entry = corpus[rand() % corpus.size()];
+        std::string text = entry.text;
+        mutate(text);
+
+        // Frames are reused unreset, as the TripleBuffer writer slots are
+        if (entry.venue) {
+            if (!parseVenueFrame(text.c_str(), venue)) continue;
+            if (!venueSane(venue)) {
+                printf("FAIL venue frame: %s\n", text.c_str());
+                failures++;
+            } else {
+                accepted++;
+            }
+            continue;
+        }
+
+        if (!parseWeatherFrame(text.c_str(), frame)) continue;
+
+        accepted++;
+        std::string again = serializeFrame(frame);
+        memset(&reparsed, 0, sizeof(reparsed));
+        if (!frameSane(frame) || !parseWeatherFrame(again.c_str(), reparsed) ||
+            memcmp(&frame, &reparsed, sizeof(frame)) != 0) {
+            printf("FAIL round trip: %s -> %s\n", text.c_str(), again.c_str());
+            failures++;
+        }
+        if (failures > 20) break;
+    }
+
+    // Binary form: every valid corpus packet the encoder accepts must decode to the same frame
+    std::vector<std::vector<uint8_t>> binaries;
+    std::vector<const char*> binaryTexts;
+    size_t textBytes = 0, binaryBytes = 0;
+    uint8_t bin[MAX_MESHTASTIC_PAYLOAD];
+    for (const CorpusEntry& entry : corpus) {
+        memset(&frame, 0, sizeof(frame));
+        if (!entry.expectValid || entry.venue || !parseWeatherFrame(entry.text.c_str(), frame)) continue;
+        size_t n = encodeWeatherBinary(frame, bin, sizeof(bin));
+        if (n == 0) continue;  // Hour or glyph only the text form can carry
+
+        memset(&reparsed, 0, sizeof(reparsed));
+        if (!decodeWeatherBinary(bin, n, reparsed) || memcmp(&frame, &reparsed, sizeof(frame)) != 0) {
+            printf("FAIL binary round trip: %s\n", entry.text.c_str());
+            failures++;
+        }
+        if (dumpBinary) {
+            printf("%-72s ", entry.text.c_str());
+            for (size_t i = 0; i < n; i++) printf("%02x", bin[i]);
+            printf("\n");
+        }
+        binaries.push_back(std::vector<uint8_t>(bin, bin + n));
+        binaryTexts.push_back(entry.text.c_str());
+        textBytes += entry.text.size();
+        binaryBytes += n;
+    }
+
+    // Binary mutation fuzzing, same rules as the text fuzz
+    uint32_t binaryAccepted = 0;
+    for (long n = 0; n < iterations && !binaries.empty(); n++) {
+        std::vector<uint8_t> b = binaries[rand() % binaries.size()];
+        mutateBinary(b);
+
+        frame = sentinel;
+        if (!decodeWeatherBinary(b.data(), b.size(), frame)) {
+            if (memcmp(&frame, &sentinel, sizeof(frame)) != 0) {
+                printf("FAIL rejected binary packet modified the frame\n");
+                failures++;
+            }
+            continue;
+        }
+
+        binaryAccepted++;
+        size_t len = encodeWeatherBinary(frame, bin, sizeof(bin));
+        memset(&reparsed, 0, sizeof(reparsed));
+        if (!frameSane(frame) || len == 0 || !decodeWeatherBinary(bin, len, reparsed) ||
+            memcmp(&frame, &reparsed, sizeof(frame)) != 0) {
+            printf("FAIL binary round trip after mutation\n");
+            failures++;
+        }
+        if (failures > 20) break;
+    }
+
+    // Binary venue frames, and the rows the venue delta stream draws on
+    std::vector<std::vector<uint8_t>> venueBinaries;
+    VenueFrame venueStart;
+    memset(&venueStart, 0, sizeof(venueStart));
+    for (const CorpusEntry& entry : corpus) {
+        memset(&venue, 0, sizeof(venue));
+        if (!entry.expectValid || !entry.venue || !parseVenueFrame(entry.text.c_str(), venue)) continue;
+        size_t n = encodeVenueBinary(venue, bin, sizeof(bin));
+        if (n == 0) continue;  // Too big for one packet
+
+        VenueFrame decoded;
+        memset(&decoded, 0, sizeof(decoded));
+        if (!decodeVenueBinary(bin, n, decoded) || memcmp(&venue, &decoded, sizeof(venue)) != 0) {
+            printf("FAIL binary venue round trip: %s\n", entry.text.c_str());
+            failures++;
+        }
+        venueBinaries.push_back(std::vector<uint8_t>(bin, bin + n));
+        for (int i = 0; i < venue.count; i++) {
+            if (strlen(venue.events[i].venue) + strlen(venue.events[i].event) <= 30) venuePool.push_back(venue.events[i]);
+        }
+        if (venueStart.count == 0 && venue.count > 0 && venue.count <= 6) venueStart = venue;
+    }
+
+    uint32_t venueBinaryAccepted = 0;
+    for (long n = 0; n < iterations && !venueBinaries.empty(); n++) {
+        std::vector<uint8_t> b = venueBinaries[rand() % venueBinaries.size()];
+        mutateBinary(b);
+
+        venue = venueSentinel;
+        if (!decodeVenueBinary(b.data(), b.size(), venue)) {
+            if (memcmp(&venue, &venueSentinel, sizeof(venue)) != 0) {
+                printf("FAIL rejected binary venue packet modified the frame\n");
+                failures++;
+            }
+            continue;
+        }
+        venueBinaryAccepted++;
+        if (!venueSane(venue, false)) {
+            printf("FAIL binary venue frame after mutation\n");
+            failures++;
+        }
+        if (failures > 20) break;
+    }
+
+    // Delta streams
+    DeltaStats weatherDeltas = {}, venueDeltas = {};
+    if (!binaries.empty()) {
+        WeatherFrame start;
+        memset(&start, 0, sizeof(start));
+        decodeWeatherBinary(binaries[0].data(), binaries[0].size(), start);
+        const DeltaCodec<WeatherFrame> codec = {"weather", evolveWeather, weatherSaneSeq, weatherTextSize,
+                                                encodeWeatherBinary, decodeWeatherBinary, encodeWeatherDelta,
+                                                applyWeatherDelta};
+        weatherDeltas = runDeltaStream(codec, start, iterations, failures);
+    }
+    if (venueStart.count > 0 && !venuePool.empty()) {
+        const DeltaCodec<VenueFrame> codec = {"venue", evolveVenue, venueSaneSeq, venueTextSize,
+                                              encodeVenueBinary, decodeVenueBinary, encodeVenueDelta,
+                                              applyVenueDelta};
+        venueDeltas = runDeltaStream(codec, venueStart, iterations, failures);
+    }
+
+    // Parse time over the valid corpus entries
+    std::vector<const char*> valid;
+    for (const CorpusEntry& entry : corpus) {
+        if (entry.expectValid && !entry.venue) valid.push_back(entry.text.c_str());
+    }
+    const int passes = valid.empty() ? 0 : std::max<int>(1, 200000 / valid.size());
+    double frameNs = 0.0, legacyNs = 0.0;
+    uint64_t frameAllocs = 0, legacyAllocs = 0;
+    if (passes > 0) {
+        uint64_t packets = (uint64_t)passes * valid.size();
+
+        benchAllocs = 0;
+        benchCountAllocs = true;
+        clk::time_point t0 = clk::now();
+        for (int pass = 0; pass < passes; pass++) {
+            for (const char* text : valid) parseWeatherFrame(text, frame);
+        }
+        frameNs = std::chrono::duration<double, std::nano>(clk::now() - t0).count() / packets;
+        benchCountAllocs = false;
+        frameAllocs = benchAllocs;
+
+        benchAllocs = 0;
+        benchCountAllocs = true;
+        t0 = clk::now();
+        for (int pass = 0; pass < passes; pass++) {
+            for (const char* text : valid) legacyParse(text);
+        }
+        legacyNs = std::chrono::duration<double, std::nano>(clk::now() - t0).count() / packets;
+        benchCountAllocs = false;
+        legacyAllocs = benchAllocs;
+
+        frameAllocs /= packets;
+        legacyAllocs /= packets;
+    }
+
+    // Text parse vs binary decode over the packets that have both forms
+    double textNs = 0.0, binaryNs = 0.0;
+    if (!binaries.empty()) {
+        const int binPasses = std::max<int>(1, 200000 / binaries.size());
+        uint64_t packets = (uint64_t)binPasses * binaries.size();
+
+        clk::time_point t0 = clk::now();
+        for (int pass = 0; pass < binPasses; pass++) {
+            for (const char* text : binaryTexts) parseWeatherFrame(text, frame);
+        }
+        textNs = std::chrono::duration<double, std::nano>(clk::now() - t0).count() / packets;
+
+        t0 = clk::now();
+        for (int pass = 0; pass < binPasses; pass++) {
+            for (const std::vector<uint8_t>& b : binaries) decodeWeatherBinary(b.data(), b.size(), frame);
+        }
+        binaryNs = std::chrono::duration<double, std::nano>(clk::now() - t0).count() / packets;
+    }
+
+    // Rebroadcast suppression
+    PacketDedup dedup;
+    if (!checkDedup(dedup)) {
+        printf("FAIL duplicate cache: %u hits, %u misses\n", dedup.hits(), dedup.misses());
+        failures++;
+    }
+
+    // Received packet pool: capacity against the old queue, then cross-thread
+    std::vector<size_t> binarySizes, textSizes;
+    for (const std::vector<uint8_t>& b : binaries) binarySizes.push_back(b.size());
+    for (const std::vector<uint8_t>& b : venueBinaries) binarySizes.push_back(b.size());
+    for (const CorpusEntry& entry : corpus) {
+        if (entry.expectValid) textSizes.push_back(std::min<size_t>(entry.text.size(), MAX_MESHTASTIC_PAYLOAD - 1));
+    }
+    uint32_t poolBinary = poolCapacity(binarySizes);
+    uint32_t poolText = poolCapacity(textSizes);
+    uint32_t poolShort = poolCapacity(std::vector<size_t>{24});
+    if (!binarySizes.empty() && poolBinary <= OLD_QUEUE_ITEMS) {
+        printf("FAIL MeshRxPool: holds %u binary hot packets, the old queue %d\n", poolBinary, OLD_QUEUE_ITEMS);
+        failures++;
+    }
+    PoolStressResult poolStress = {};
+
+    // Cross-thread publication
+    StressResult triple = {}, twoSlot = {};
+    if (stressMs > 0) {
+        poolStress = stressRxPool(stressMs);
+        if (poolStress.corrupt > 0 || poolStress.outOfOrder > 0 || poolStress.received != poolStress.committed ||
+            poolStress.received == 0) {
+            printf("FAIL MeshRxPool: %llu committed, %llu received, %llu corrupt, %llu out of order\n",
+                   (unsigned long long)poolStress.committed, (unsigned long long)poolStress.received,
+                   (unsigned long long)poolStress.corrupt, (unsigned long long)poolStress.outOfOrder);
+            failures++;
+        }
+        triple = stressTripleBuffer(stressMs);
+        twoSlot = stressDoubleBuffer(stressMs);
+        if (triple.torn > 0 || triple.outOfOrder > 0 || triple.reads == 0) {
+            printf("FAIL TripleBuffer: %llu torn, %llu out of order, %llu reads\n", (unsigned long long)triple.torn,
+                   (unsigned long long)triple.outOfOrder, (unsigned long long)triple.reads);
+            failures++;
+        }
+    }
+
+    printf("\n=== Hot packet bench ===\n");
+    printf("Corpus:       %zu packets (%u valid) from %zu file(s)\n", corpus.size(), validCount, files.size());
+    printf("Fuzz:         %ld mutations (seed %u), %u accepted\n", iterations, seed, accepted);
+    printf("Parse:        WeatherFrame %.0f ns/packet, %llu allocs  |  String parser %.0f ns/packet, %llu allocs\n",
+           frameNs, (unsigned long long)frameAllocs, legacyNs, (unsigned long long)legacyAllocs);
+    if (!binaries.empty()) {
+        printf("Binary:       %zu of %zu valid weather packets encodable, %.1f bytes vs %.1f as text (%.0f%%), "
+               "decode %.0f ns vs parse %.0f ns\n",
+               binaries.size(), valid.size(), (double)binaryBytes / binaries.size(), (double)textBytes / binaries.size(),
+               100.0 * binaryBytes / textBytes, binaryNs, textNs);
+        printf("Binary fuzz:  %ld mutations, %u accepted\n", iterations, binaryAccepted);
+    }
+    printf("Binary venue: %zu valid venue packets round tripped, fuzz %u accepted\n", venueBinaries.size(),
+           venueBinaryAccepted);
+    printDeltaStats("Delta wx:", weatherDeltas);
+    printDeltaStats("Delta venue:", venueDeltas);
+    printf("Dedup:        %u hits, %u misses over the rebroadcast/new id/eviction/wrap cases\n", dedup.hits(),
+           dedup.misses());
+    printf("Frame:        %zu bytes (x3 slots)\n", sizeof(WeatherFrame));
+    if (stressMs > 0) {
+        printf("Stress:       TripleBuffer %llu published, %llu acquired, %llu torn, %llu out of order  |  "
+               "two-slot swap %llu torn of %llu reads (%d ms each)\n",
+               (unsigned long long)triple.published, (unsigned long long)triple.reads, (unsigned long long)triple.torn,
+               (unsigned long long)triple.outOfOrder, (unsigned long long)twoSlot.torn,
+               (unsigned long long)twoSlot.reads, stressMs);
+    }
+    printf("RX pool:      %d bytes hold %u binary hot packets, %u corpus text packets, %u 24-byte texts  |  "
+           "old queue %d bytes, %d of any size\n",
+           MESH_RX_POOL_BYTES, poolBinary, poolText, poolShort, OLD_QUEUE_ITEMS * OLD_QUEUE_ITEM_BYTES, OLD_QUEUE_ITEMS);
+    if (stressMs > 0) {
+        printf("Stress:       MeshRxPool %llu committed, %llu received, %llu abandoned, %llu corrupt, %llu out of order, "
+               "%u reserves refused, high water %u bytes / %u messages\n",
+               (unsigned long long)poolStress.committed, (unsigned long long)poolStress.received,
+               (unsigned long long)poolStress.abandoned, (unsigned long long)poolStress.corrupt,
+               (unsigned long long)poolStress.outOfOrder, poolStress.stats.dropped, poolStress.stats.highWaterBytes,
+               poolStress.stats.highWaterCount);
+    }
+    printf("Result:       %s (%u failures)\n", failures ? "FAIL" : "PASS", failures);
+
+    return failures ? 1 : 0;
+}
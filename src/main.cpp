@@ -27,6 +27,7 @@
 
 // Storage
 #include "storage/preferences_manager.h"
+#include "storage/geofence_storage.h"
 
 // Communication
 #include "Meshtastic.h"
@@ -69,6 +70,7 @@ void setup() {
 
     // Disable Serial RX to prevent conflicts
     Serial.end();
+    Serial.setRxBufferSize(GPS_RX_BUFFER_SIZE);  // Must be set before begin()
     Serial.begin(GPS_BAUD, SERIAL_8N1, 3, 1);
     
     // Print version
@@ -84,6 +86,9 @@ void setup() {
     initPreferences();
     loadPreferences();
 
+    // Geofence tables live in LittleFS, not NVS
+    loadGeofences();
+
     // Initialize display
     initDisplay();
 
@@ -113,14 +118,11 @@ void setup() {
     lv_refr_now(NULL);  // Force immediate refresh
 
     // Initialize display strings
-    cur_date = String("NO GPS");
-    cur_temp = String("--");
-    wx_rcv_time = String("        NO DATA YET");
-    np_rcv_time = String("        NO DATA YET");
+    strlcpy(cur_date, "NO GPS", sizeof(cur_date));
     espnow_status = "Not initialized";
     espnow_last_received = "";
 #ifdef DEMO_MODE
-    heading = String("DEMO");
+    strlcpy(heading, "DEMO", sizeof(heading));
 #endif
 
     // Initialize UI from EEZ Studio
@@ -129,9 +131,9 @@ void setup() {
     // Initialize Meshtastic
     mt_serial_init(MT_SERIAL_RX_PIN, MT_SERIAL_TX_PIN, MT_DEV_BAUD_RATE);
     randomSeed(micros());
+    mt_set_fast_handshake(MT_FAST_HANDSHAKE);
     mt_request_node_report(connected_callback);
-    set_text_message_callback(text_message_callback);
-    set_portnum_callback(admin_portnum_callback);
+    set_packet_sink(mesh_payload_reserve, mesh_packet_deliver);  // Text, binary hot packets, admin_portnum_callback
     
     // Initialize application variables
     manual_reboot = false;
@@ -144,11 +146,10 @@ void setup() {
     gpsMutex = xSemaphoreCreateMutex();
     eepromMutex = xSemaphoreCreateMutex();
     displayMutex = xSemaphoreCreateMutex();
-    hotPacketMutex = xSemaphoreCreateMutex();  // Protects weather and venue/event data
     eepromWriteQueue = xQueueCreate(10, sizeof(eepromWriteItem_t));
-    meshtasticCallbackQueue = xQueueCreate(30, sizeof(meshtasticCallbackItem_t));  // Matches radio's ~30 packet buffer
     espnowRecvQueue = xQueueCreate(ESPNOW_QUEUE_SIZE, sizeof(espnow_recv_item_t));
     gpsConfigCallbackQueue = xQueueCreate(2, sizeof(gpsConfigCallbackItem_t));
+    trackPageQueue = xQueueCreate(TRACK_QUEUE_PAGES, sizeof(trackPage_t));
     
     // Create all FreeRTOS tasks (including ESP-NOW)
     createAllTasks();
@@ -0,0 +1,764 @@
+/********************************************************************************************
+*    GCD Meshtastic Codec Bench - host-side (Linux) test of the streaming packet codec      *
+*                                                                                           *
+*    Checks mt_decode_from_radio() and mt_encode_to_radio_packet()                          *
+*    (lib/meshtastic-arduino_src/mt_packet_codec.cpp, the firmware source) against nanopb's *
+*    pb_decode()/pb_encode() of the generated structs they replaced, then times both and    *
+*    measures how much stack the old and new receive and send paths touch.                  *
+*                                                                                           *
+*    Usage:                                                                                 *
+*    1. pio run -e native_mtcodec                                                           *
+*    2. .pio/build/native_mtcodec/program [-n N] [-s seed]                                  *
+*         -n  packets per check (default 20000), -s random seed (default 1)                 *
+*       For memory errors, add -fsanitize=address,undefined to the env's build_flags        *
+*       (the stack figures are meaningless then).                                           *
+*                                                                                           *
+*    Checks: random FromRadio packets (decoded and encrypted, with fields the codec skips)  *
+*    decode to the same header and payload as pb_decode() finds, NUL-terminated, or to no   *
+*    payload when the reserve callback declines it; other FromRadio variants decode to the  *
+*    same struct; random outgoing packets, want_config and heartbeat encode byte-for-byte   *
+*    as pb_encode() does; and every mutated frame pb_decode() accepts is accepted. The      *
+*    legacy paths mirror the old handle_packet() / text_message_callback() / mt_send_text() *
+*    / sendAdminMessage() locals. Exits 1 on any failure.                                   *
+*                                                                                           *
+********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <chrono>
+#include <vector>
+
+#include "bench_check.h"
+#include "mt_packet_codec.h"
+#include "meshtastic/admin.pb.h"
+#include "utils/mesh_rx_pool.h"
+
+#define MAX_FRAME 512
+#define STACK_PROBE_SIZE (64 * 1024)
+#define STACK_PAINT 0xA5
+
+typedef std::vector<uint8_t> Frame;
+
+static uint32_t rnd32() {
+    return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+/*****************************
+ *      RESERVE / SINK        *
+ *****************************/
+
+static uint8_t payloadBuf[sizeof(meshtastic_MeshPacket_encrypted_t().bytes) + 1];
+static bool reserveDeclines = false;
+
+static uint8_t* reservePayload(meshtastic_PortNum port, size_t size) {
+    (void)port;
+    return (reserveDeclines || size >= sizeof(payloadBuf)) ? NULL : payloadBuf;
+}
+
+// The fixed-size item the old callback queue held
+typedef struct {
+    uint32_t from;
+    uint32_t to;
+    uint8_t channel;
+    uint16_t port;
+    uint16_t size;
+    union {
+        char text[MAX_MESHTASTIC_PAYLOAD];
+        uint8_t bytes[MAX_MESHTASTIC_PAYLOAD];
+    };
+} meshtasticCallbackItem_t;
+
+// Stands in for xQueueSend(), which copies the item
+static meshtasticCallbackItem_t queueSlots[4];
+static uint32_t queued = 0;
+
+__attribute__((noinline)) static void queueSend(const meshtasticCallbackItem_t* item) {
+    memcpy(&queueSlots[queued++ & 3], item, sizeof(*item));
+}
+
+static pb_byte_t txBuf[MAX_FRAME];
+static size_t txLen = 0;
+
+/*****************************
+ *       FRAME BUILDERS       *
+ *****************************/
+
+static Frame encodeFromRadio(const meshtastic_FromRadio& msg) {
+    Frame f(MAX_FRAME);
+    pb_ostream_t out = pb_ostream_from_buffer(f.data(), f.size());
+    if (!pb_encode(&out, meshtastic_FromRadio_fields, &msg)) {
+        f.clear();
+        return f;
+    }
+    f.resize(out.bytes_written);
+    return f;
+}
+
+static meshtastic_FromRadio randomPacketMsg() {
+    meshtastic_FromRadio msg = meshtastic_FromRadio_init_zero;
+    msg.id = (rand() % 2) ? rnd32() : 0;
+    msg.which_payload_variant = meshtastic_FromRadio_packet_tag;
+    meshtastic_MeshPacket& p = msg.packet;
+    p.from = rnd32();
+    p.to = (rand() % 4) ? rnd32() : 0xFFFFFFFF;
+    p.channel = rand() % 8;
+    p.id = rnd32();
+    p.want_ack = rand() % 2;
+    // Fields the codec skips
+    p.rx_time = rnd32();
+    p.rx_snr = (float)(rand() % 200 - 100) / 4.0f;
+    p.rx_rssi = -(rand() % 130);
+    p.hop_limit = rand() % 8;
+    p.hop_start = rand() % 8;
+    p.via_mqtt = rand() % 2;
+    if (rand() % 4 == 0) {
+        p.public_key.size = 32;
+        for (int i = 0; i < 32; i++) p.public_key.bytes[i] = rand();
+        p.pki_encrypted = true;
+    }
+
+    if (rand() % 8 == 0) {
+        p.which_payload_variant = meshtastic_MeshPacket_encrypted_tag;
+        p.encrypted.size = rand() % (sizeof(p.encrypted.bytes) + 1);
+        for (pb_size_t i = 0; i < p.encrypted.size; i++) p.encrypted.bytes[i] = rand();
+    } else {
+        static const meshtastic_PortNum ports[] = {
+            meshtastic_PortNum_TEXT_MESSAGE_APP, meshtastic_PortNum_PRIVATE_APP, meshtastic_PortNum_ADMIN_APP,
+            meshtastic_PortNum_ROUTING_APP, meshtastic_PortNum_POSITION_APP, meshtastic_PortNum_NODEINFO_APP};
+        p.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
+        meshtastic_Data& d = p.decoded;
+        d.portnum = ports[rand() % (sizeof(ports) / sizeof(ports[0]))];
+        d.payload.size = (rand() % 8 == 0) ? 0 : rand() % (sizeof(d.payload.bytes) + 1);
+        for (pb_size_t i = 0; i < d.payload.size; i++) d.payload.bytes[i] = rand();
+        d.request_id = (rand() % 3 == 0) ? rnd32() : 0;
+        d.want_response = rand() % 2;
+        d.reply_id = (rand() % 4 == 0) ? rnd32() : 0;
+        d.emoji = (rand() % 8 == 0) ? 1 : 0;
+        d.has_bitfield = rand() % 2;
+        d.bitfield = rand();
+    }
+    return msg;
+}
+
+// Everything but packets, as they arrive during a node report
+static meshtastic_FromRadio randomOtherMsg(uint32_t i) {
+    meshtastic_FromRadio msg = meshtastic_FromRadio_init_zero;
+    msg.id = rnd32();
+    switch (i % 6) {
+        case 0:
+            msg.which_payload_variant = meshtastic_FromRadio_my_info_tag;
+            msg.my_info.my_node_num = rnd32();
+            msg.my_info.reboot_count = rand() % 100;
+            msg.my_info.min_app_version = 30200;
+            snprintf(msg.my_info.pio_env, sizeof(msg.my_info.pio_env), "heltec-v3-%u", (unsigned)(rand() % 1000));
+            break;
+        case 1:
+            msg.which_payload_variant = meshtastic_FromRadio_node_info_tag;
+            msg.node_info.num = rnd32();
+            msg.node_info.has_user = true;
+            snprintf(msg.node_info.user.long_name, sizeof(msg.node_info.user.long_name), "Cart %u", (unsigned)(rand() % 500));
+            snprintf(msg.node_info.user.short_name, sizeof(msg.node_info.user.short_name), "C%u", (unsigned)(rand() % 99));
+            msg.node_info.has_position = rand() % 2;
+            msg.node_info.position.has_latitude_i = true;
+            msg.node_info.position.latitude_i = 289000000 + rand() % 100000;
+            msg.node_info.position.has_longitude_i = true;
+            msg.node_info.position.longitude_i = -819000000 - rand() % 100000;
+            msg.node_info.snr = (float)(rand() % 40) / 4.0f;
+            msg.node_info.last_heard = rnd32();
+            break;
+        case 2:
+            msg.which_payload_variant = meshtastic_FromRadio_config_complete_id_tag;
+            msg.config_complete_id = rnd32();
+            break;
+        case 3:
+            msg.which_payload_variant = meshtastic_FromRadio_rebooted_tag;
+            msg.rebooted = true;
+            break;
+        case 4:
+            msg.which_payload_variant = meshtastic_FromRadio_queueStatus_tag;
+            msg.queueStatus.free = rand() % 16;
+            msg.queueStatus.maxlen = 16;
+            msg.queueStatus.mesh_packet_id = rnd32();
+            break;
+        default:
+            msg.which_payload_variant = meshtastic_FromRadio_channel_tag;
+            msg.channel.index = rand() % 8;
+            msg.channel.has_settings = true;
+            snprintf(msg.channel.settings.name, sizeof(msg.channel.settings.name), "ch%u", (unsigned)(rand() % 100));
+            msg.channel.settings.psk.size = 16;
+            for (int k = 0; k < 16; k++) msg.channel.settings.psk.bytes[k] = rand();
+            msg.channel.role = meshtastic_Channel_Role_SECONDARY;
+            break;
+    }
+    return msg;
+}
+
+static bool streamDecode(const Frame& f, meshtastic_FromRadio* msg, mt_packet_t* packet, uint8_t** payload) {
+    pb_istream_t in = pb_istream_from_buffer(f.data(), f.size());
+    return mt_decode_from_radio(&in, msg, packet, reservePayload, payload);
+}
+
+static bool referenceDecode(const Frame& f, meshtastic_FromRadio* msg) {
+    pb_istream_t in = pb_istream_from_buffer(f.data(), f.size());
+    return pb_decode(&in, meshtastic_FromRadio_fields, msg);
+}
+
+/*****************************
+ *       DECODE CHECKS        *
+ *****************************/
+
+static void checkPacketDecode(uint32_t n) {
+    static meshtastic_FromRadio ref, msg;
+    for (uint32_t i = 0; i < n; i++) {
+        ref = randomPacketMsg();
+        Frame f = encodeFromRadio(ref);
+        memset(&ref, 0, sizeof(ref));
+        if (f.empty() || !referenceDecode(f, &ref)) {
+            fail("reference round trip", i);
+            continue;
+        }
+
+        reserveDeclines = (i % 5 == 4);
+        memset(payloadBuf, 0xEE, sizeof(payloadBuf));
+        mt_packet_t packet;
+        uint8_t* payload;
+        if (!streamDecode(f, &msg, &packet, &payload)) {
+            fail("packet did not decode", i);
+            continue;
+        }
+
+        const meshtastic_MeshPacket& p = ref.packet;
+        bool enc = p.which_payload_variant == meshtastic_MeshPacket_encrypted_tag;
+        const pb_byte_t* refBytes = enc ? p.encrypted.bytes : p.decoded.payload.bytes;
+        pb_size_t refSize = enc ? p.encrypted.size : p.decoded.payload.size;
+
+        if (msg.which_payload_variant != meshtastic_FromRadio_packet_tag || msg.id != ref.id ||
+            packet.from != p.from || packet.to != p.to || packet.id != p.id || packet.channel != p.channel ||
+            packet.want_ack != p.want_ack || packet.encrypted != enc ||
+            packet.port != (enc ? (meshtastic_PortNum)0 : p.decoded.portnum) ||
+            packet.request_id != (enc ? 0 : p.decoded.request_id) || packet.public_key.size != p.public_key.size ||
+            memcmp(packet.public_key.bytes, p.public_key.bytes, p.public_key.size) != 0) {
+            fail("packet header differs from pb_decode()", i);
+            continue;
+        }
+
+        // proto3 leaves an empty Data.payload out, but an empty encrypted oneof member is written
+        bool expectPayload = !reserveDeclines && (enc || refSize > 0);
+        if (!expectPayload) {
+            if (payload != NULL || packet.size != 0) fail("payload reserved when it should be skipped", i);
+        } else if (payload != payloadBuf || packet.size != refSize || memcmp(payload, refBytes, refSize) != 0) {
+            fail("payload differs from pb_decode()", i);
+        } else if (payloadBuf[refSize] != '\0') {
+            fail("payload not NUL terminated", i);
+        }
+    }
+    reserveDeclines = false;
+}
+
+static void checkOtherDecode(uint32_t n) {
+    static meshtastic_FromRadio ref, msg;
+    for (uint32_t i = 0; i < n; i++) {
+        ref = randomOtherMsg(i);
+        Frame f = encodeFromRadio(ref);
+        memset(&ref, 0, sizeof(ref));
+        if (f.empty() || !referenceDecode(f, &ref)) {
+            fail("reference round trip", i);
+            continue;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        mt_packet_t packet;
+        uint8_t* payload;
+        if (!streamDecode(f, &msg, &packet, &payload)) {
+            fail("variant did not decode", i);
+        } else if (memcmp(&msg, &ref, sizeof(msg)) != 0) {
+            fail("variant differs from pb_decode()", i);
+        }
+    }
+}
+
+// Every mutated frame pb_decode() accepts must be accepted (the codec is more lenient
+// about wire types on fields it skips), and a payload must stay in bounds
+static void checkFuzz(uint32_t n, uint32_t& bothAccepted, uint32_t& streamOnly) {
+    static meshtastic_FromRadio ref, msg;
+    bothAccepted = streamOnly = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        meshtastic_FromRadio src = (i % 4) ? randomPacketMsg() : randomOtherMsg(i);
+        Frame f = encodeFromRadio(src);
+        int edits = 1 + rand() % 3;
+        for (int e = 0; e < edits && !f.empty(); e++) {
+            size_t pos = rand() % f.size();
+            switch (rand() % 4) {
+                case 0: f[pos] ^= (uint8_t)(1 << (rand() % 8)); break;
+                case 1: f[pos] = rand(); break;
+                case 2: f.resize(pos); break;
+                default: f.insert(f.begin() + pos, (uint8_t)rand()); break;
+            }
+        }
+
+        memset(&ref, 0, sizeof(ref));
+        bool refOk = referenceDecode(f, &ref);
+        mt_packet_t packet;
+        uint8_t* payload;
+        bool ok = streamDecode(f, &msg, &packet, &payload);
+        if (refOk && !ok) fail("mutated frame pb_decode() accepts was rejected", i);
+        if (ok && payload != NULL && (payload != payloadBuf || packet.size >= sizeof(payloadBuf) ||
+                                      payloadBuf[packet.size] != '\0')) {
+            fail("mutated frame payload out of bounds", i);
+        }
+        if (refOk && ok) bothAccepted++;
+        if (!refOk && ok) streamOnly++;
+    }
+}
+
+/*****************************
+ *       ENCODE CHECKS        *
+ *****************************/
+
+static Frame encodeToRadio(const meshtastic_ToRadio& msg) {
+    Frame f(MAX_FRAME);
+    pb_ostream_t out = pb_ostream_from_buffer(f.data(), f.size());
+    if (!pb_encode(&out, meshtastic_ToRadio_fields, &msg)) {
+        f.clear();
+        return f;
+    }
+    f.resize(out.bytes_written);
+    return f;
+}
+
+static Frame codecEncode(bool (*encode)(pb_ostream_t*, const void*), const void* arg) {
+    Frame f(MAX_FRAME);
+    pb_ostream_t out = pb_ostream_from_buffer(f.data(), f.size());
+    if (!encode(&out, arg)) {
+        f.clear();
+        return f;
+    }
+    f.resize(out.bytes_written);
+    return f;
+}
+
+struct PacketArg {
+    const mt_packet_t* packet;
+    const uint8_t* payload;
+};
+
+static bool encodePacketArg(pb_ostream_t* out, const void* arg) {
+    const PacketArg* a = (const PacketArg*)arg;
+    return mt_encode_to_radio_packet(out, a->packet, a->payload);
+}
+
+static bool encodeWantConfigArg(pb_ostream_t* out, const void* arg) {
+    return mt_encode_to_radio_want_config(out, *(const uint32_t*)arg);
+}
+
+static bool encodeHeartbeatArg(pb_ostream_t* out, const void* arg) {
+    (void)arg;
+    return mt_encode_to_radio_heartbeat(out);
+}
+
+static void checkEncode(uint32_t n) {
+    static meshtastic_ToRadio ref;
+    uint8_t payload[sizeof(meshtastic_Data_payload_t().bytes)];
+    for (uint32_t i = 0; i < n; i++) {
+        mt_packet_t packet = {};
+        packet.from = rnd32();  // Ignored: the radio fills it in
+        packet.encrypted = (i % 7 == 0);
+        packet.to = (rand() % 4) ? rnd32() : 0;
+        packet.channel = rand() % 8;
+        packet.id = (rand() % 8) ? rnd32() : 0;
+        packet.want_ack = rand() % 2;
+        packet.port = (meshtastic_PortNum)((rand() % 8) ? rand() % 300 : 0);
+        packet.request_id = (rand() % 3 == 0) ? rnd32() : 0;
+        packet.size = (rand() % 8 == 0) ? 0 : rand() % (sizeof(payload) + 1);
+        for (pb_size_t k = 0; k < packet.size; k++) payload[k] = rand();
+
+        memset(&ref, 0, sizeof(ref));
+        ref.which_payload_variant = meshtastic_ToRadio_packet_tag;
+        ref.packet.to = packet.to;
+        ref.packet.channel = packet.channel;
+        ref.packet.id = packet.id;
+        ref.packet.want_ack = packet.want_ack;
+        ref.packet.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
+        ref.packet.decoded.portnum = packet.port;
+        ref.packet.decoded.payload.size = packet.size;
+        memcpy(ref.packet.decoded.payload.bytes, payload, packet.size);
+        ref.packet.decoded.request_id = packet.request_id;
+
+        PacketArg arg = {&packet, payload};
+        Frame expect = encodeToRadio(ref);
+        Frame got = codecEncode(encodePacketArg, &arg);
+        if (expect.empty() || got != expect) fail("packet encoding differs from pb_encode()", i);
+
+        uint32_t wantConfig = (i % 16) ? rnd32() : 0;
+        memset(&ref, 0, sizeof(ref));
+        ref.which_payload_variant = meshtastic_ToRadio_want_config_id_tag;
+        ref.want_config_id = wantConfig;
+        if (codecEncode(encodeWantConfigArg, &wantConfig) != encodeToRadio(ref)) {
+            fail("want_config encoding differs from pb_encode()", i);
+        }
+    }
+
+    memset(&ref, 0, sizeof(ref));
+    ref.which_payload_variant = meshtastic_ToRadio_heartbeat_tag;
+    if (codecEncode(encodeHeartbeatArg, NULL) != encodeToRadio(ref)) fail("heartbeat encoding differs from pb_encode()", 0);
+
+    mt_packet_t tooBig = {};
+    tooBig.size = sizeof(payload) + 1;
+    PacketArg arg = {&tooBig, payload};
+    if (!codecEncode(encodePacketArg, &arg).empty()) fail("oversized payload was encoded", 0);
+}
+
+/*****************************
+ *   OLD AND NEW FIRMWARE     *
+ *****************************/
+
+#define SPECIAL_NONCE 69420
+#define SEND_ID 0x1234567
+
+// As _mt_send_toRadio() took it: by value
+__attribute__((noinline)) static bool legacySendToRadio(meshtastic_ToRadio toRadio) {
+    pb_ostream_t out = pb_ostream_from_buffer(txBuf, sizeof(txBuf));
+    bool ok = pb_encode(&out, meshtastic_ToRadio_fields, &toRadio);
+    txLen = out.bytes_written;
+    return ok;
+}
+
+__attribute__((noinline)) static void legacyTextCallback(uint32_t from, uint32_t to, uint8_t channel, const char* text) {
+    meshtasticCallbackItem_t item;
+    item.from = from;
+    item.to = to;
+    item.channel = channel;
+    item.port = meshtastic_PortNum_TEXT_MESSAGE_APP;
+    item.size = 0;
+    strncpy(item.text, text, MAX_MESHTASTIC_PAYLOAD - 1);
+    item.text[MAX_MESHTASTIC_PAYLOAD - 1] = '\0';
+    queueSend(&item);
+}
+
+__attribute__((noinline)) static void legacyPortnumCallback(uint32_t from, uint32_t to, uint8_t channel,
+                                                            meshtastic_PortNum port, meshtastic_Data_payload_t* payload) {
+    if (port != meshtastic_PortNum_PRIVATE_APP || payload->size == 0 || payload->size > MAX_MESHTASTIC_PAYLOAD) {
+        return;
+    }
+    meshtasticCallbackItem_t item;
+    item.from = from;
+    item.to = to;
+    item.channel = channel;
+    item.port = port;
+    item.size = payload->size;
+    memcpy(item.bytes, payload->bytes, payload->size);
+    queueSend(&item);
+}
+
+// The old handle_packet(): FromRadio and a ToRadio on the stack
+__attribute__((noinline)) static bool legacyReceive(const Frame& f) {
+    meshtastic_FromRadio fromRadio = meshtastic_FromRadio_init_zero;
+    pb_istream_t in = pb_istream_from_buffer(f.data(), f.size());
+    bool status = pb_decode(&in, meshtastic_FromRadio_fields, &fromRadio);
+
+    meshtastic_ToRadio toRadio = meshtastic_ToRadio_init_default;
+    toRadio.which_payload_variant = meshtastic_ToRadio_want_config_id_tag;
+    toRadio.want_config_id = SPECIAL_NONCE;
+
+    if (!status) return false;
+
+    switch (fromRadio.which_payload_variant) {
+        case meshtastic_FromRadio_packet_tag: {
+            meshtastic_MeshPacket* p = &fromRadio.packet;
+            if (p->which_payload_variant != meshtastic_MeshPacket_decoded_tag) return true;
+            if (p->decoded.portnum == meshtastic_PortNum_TEXT_MESSAGE_APP) {
+                legacyTextCallback(p->from, p->to, p->channel, (const char*)p->decoded.payload.bytes);
+            } else {
+                legacyPortnumCallback(p->from, p->to, p->channel, p->decoded.portnum, &p->decoded.payload);
+            }
+            return true;
+        }
+        case meshtastic_FromRadio_rebooted_tag:
+            return legacySendToRadio(toRadio);
+        default:
+            return true;
+    }
+}
+
+__attribute__((noinline)) static bool legacySendText(const char* text, uint32_t dest, uint8_t channel) {
+    meshtastic_MeshPacket meshPacket = meshtastic_MeshPacket_init_default;
+    meshPacket.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
+    meshPacket.id = SEND_ID;
+    meshPacket.decoded.portnum = meshtastic_PortNum_TEXT_MESSAGE_APP;
+    meshPacket.to = dest;
+    meshPacket.channel = channel;
+    meshPacket.want_ack = true;
+    meshPacket.decoded.payload.size = strlen(text);
+    memcpy(meshPacket.decoded.payload.bytes, text, meshPacket.decoded.payload.size);
+
+    meshtastic_ToRadio toRadio = meshtastic_ToRadio_init_default;
+    toRadio.which_payload_variant = meshtastic_ToRadio_packet_tag;
+    toRadio.packet = meshPacket;
+    return legacySendToRadio(toRadio);
+}
+
+__attribute__((noinline)) static bool legacySendAdmin(meshtastic_AdminMessage* adminMsg, uint32_t myNode) {
+    pb_byte_t admin_buf[256];
+    pb_ostream_t admin_stream = pb_ostream_from_buffer(admin_buf, sizeof(admin_buf));
+    if (!pb_encode(&admin_stream, meshtastic_AdminMessage_fields, adminMsg)) return false;
+
+    meshtastic_MeshPacket meshPacket = meshtastic_MeshPacket_init_default;
+    meshPacket.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
+    meshPacket.id = SEND_ID;
+    meshPacket.decoded.portnum = meshtastic_PortNum_ADMIN_APP;
+    meshPacket.to = myNode;
+    meshPacket.channel = 0;
+    meshPacket.decoded.payload.size = admin_stream.bytes_written;
+    memcpy(meshPacket.decoded.payload.bytes, admin_buf, admin_stream.bytes_written);
+
+    meshtastic_ToRadio toRadio = meshtastic_ToRadio_init_default;
+    toRadio.which_payload_variant = meshtastic_ToRadio_packet_tag;
+    toRadio.packet = meshPacket;
+    return legacySendToRadio(toRadio);
+}
+
+// The new handle_packet() and meshtastic_callback_task.cpp sink: static decode targets,
+// payload read straight into a MeshRxPool record (released at once, as if consumed)
+static meshtastic_FromRadio rxMsg;
+static mt_packet_t rxPacket;
+static MeshRxPool rxPool;
+static uint8_t rxScratch[MAX_MESHTASTIC_PAYLOAD];
+
+static uint8_t* sinkReserve(meshtastic_PortNum port, size_t size) {
+    if (size >= MAX_MESHTASTIC_PAYLOAD) return NULL;
+    if (port == meshtastic_PortNum_TEXT_MESSAGE_APP || port == meshtastic_PortNum_PRIVATE_APP) {
+        return rxPool.reserve(size);
+    }
+    return port == meshtastic_PortNum_ADMIN_APP ? rxScratch : NULL;
+}
+
+__attribute__((noinline)) static void sinkDeliver(const mt_packet_t* packet, uint8_t* payload) {
+    if (packet->encrypted || packet->port == meshtastic_PortNum_ADMIN_APP) return;
+    if (payload == NULL) {
+        if (packet->port != meshtastic_PortNum_TEXT_MESSAGE_APP || packet->size != 0) return;
+        payload = rxPool.reserve(0);
+        if (payload == NULL) return;
+        payload[0] = '\0';
+    }
+    if (packet->port != meshtastic_PortNum_TEXT_MESSAGE_APP && packet->size == 0) return;
+    MeshRxMessage item = {};
+    item.from = packet->from;
+    item.to = packet->to;
+    item.channel = packet->channel;
+    item.port = packet->port;
+    item.size = packet->size;
+    rxPool.commit(item);
+    if (rxPool.peek() != NULL) {
+        queued++;
+        rxPool.release();
+    }
+}
+
+__attribute__((noinline)) static bool sendPacket(mt_packet_t* packet, const uint8_t* payload) {
+    pb_ostream_t out = pb_ostream_from_buffer(txBuf, sizeof(txBuf));
+    bool ok = mt_encode_to_radio_packet(&out, packet, payload);
+    txLen = out.bytes_written;
+    return ok;
+}
+
+__attribute__((noinline)) static bool sendWantConfig(uint32_t id) {
+    pb_ostream_t out = pb_ostream_from_buffer(txBuf, sizeof(txBuf));
+    bool ok = mt_encode_to_radio_want_config(&out, id);
+    txLen = out.bytes_written;
+    return ok;
+}
+
+__attribute__((noinline)) static bool streamReceive(const Frame& f) {
+    uint8_t* payload;
+    pb_istream_t in = pb_istream_from_buffer(f.data(), f.size());
+    if (!mt_decode_from_radio(&in, &rxMsg, &rxPacket, sinkReserve, &payload)) return false;
+
+    switch (rxMsg.which_payload_variant) {
+        case meshtastic_FromRadio_packet_tag:
+            sinkDeliver(&rxPacket, payload);
+            return true;
+        case meshtastic_FromRadio_rebooted_tag:
+            return sendWantConfig(SPECIAL_NONCE);
+        default:
+            return true;
+    }
+}
+
+__attribute__((noinline)) static bool streamSendText(const char* text, uint32_t dest, uint8_t channel) {
+    size_t len = strlen(text);
+    if (len > sizeof(meshtastic_Data_payload_t().bytes)) return false;
+    mt_packet_t packet = {};
+    packet.to = dest;
+    packet.channel = channel;
+    packet.want_ack = true;
+    packet.port = meshtastic_PortNum_TEXT_MESSAGE_APP;
+    packet.size = len;
+    packet.id = SEND_ID;
+    return sendPacket(&packet, (const uint8_t*)text);
+}
+
+__attribute__((noinline)) static bool streamSendAdmin(meshtastic_AdminMessage* adminMsg, uint32_t myNode) {
+    pb_byte_t admin_buf[sizeof(meshtastic_Data_payload_t().bytes)];
+    pb_ostream_t admin_stream = pb_ostream_from_buffer(admin_buf, sizeof(admin_buf));
+    if (!pb_encode(&admin_stream, meshtastic_AdminMessage_fields, adminMsg)) return false;
+
+    mt_packet_t packet = {};
+    packet.to = myNode;
+    packet.port = meshtastic_PortNum_ADMIN_APP;
+    packet.size = admin_stream.bytes_written;
+    packet.id = SEND_ID;
+    return sendPacket(&packet, admin_buf);
+}
+
+// mt_send_admin_reboot(): the AdminMessage is the caller's local in both versions
+__attribute__((noinline)) static bool adminReboot(bool legacy) {
+    meshtastic_AdminMessage adminMsg = meshtastic_AdminMessage_init_default;
+    adminMsg.which_payload_variant = meshtastic_AdminMessage_reboot_seconds_tag;
+    adminMsg.reboot_seconds = 5;
+    return legacy ? legacySendAdmin(&adminMsg, 0x1122) : streamSendAdmin(&adminMsg, 0x1122);
+}
+
+static const char* SAMPLE_TEXT = "WAKE|cart 12 back online, battery 87%, next event 18:30 at the square";
+
+static void checkOldAgainstNew(const std::vector<Frame>& pool) {
+    uint32_t before = queued;
+    for (const Frame& f : pool) legacyReceive(f);
+    uint32_t legacyQueued = queued - before;
+    before = queued;
+    for (const Frame& f : pool) streamReceive(f);
+    if (queued - before != legacyQueued) fail("old and new receive paths queued different counts", 0);
+
+    Frame legacy, stream;
+    legacySendText(SAMPLE_TEXT, 0xFFFFFFFF, 1);
+    legacy.assign(txBuf, txBuf + txLen);
+    streamSendText(SAMPLE_TEXT, 0xFFFFFFFF, 1);
+    stream.assign(txBuf, txBuf + txLen);
+    if (legacy != stream) fail("old and new mt_send_text() differ", 0);
+
+    adminReboot(true);
+    legacy.assign(txBuf, txBuf + txLen);
+    adminReboot(false);
+    stream.assign(txBuf, txBuf + txLen);
+    if (legacy != stream) fail("old and new sendAdminMessage() differ", 0);
+}
+
+/*****************************
+ *       TIMING / STACK       *
+ *****************************/
+
+static double nsPerFrame(bool (*receive)(const Frame&), const std::vector<Frame>& pool, uint32_t reps) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < reps; r++) {
+        for (const Frame& f : pool) receive(f);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ((double)reps * pool.size());
+}
+
+static double nsPerSend(bool (*send)(const char*, uint32_t, uint8_t), uint32_t reps) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < reps; r++) send(SAMPLE_TEXT, r, r & 7);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / reps;
+}
+
+// Runs a function on a painted stack and reports how deep it wrote
+static ucontext_t probeCaller, probeContext;
+static void (*probeFn)();
+static std::vector<uint8_t> probeStack(STACK_PROBE_SIZE);
+static const std::vector<Frame>* probeFrames;
+
+static void probeEntry() {
+    probeFn();
+}
+
+static size_t stackUsed(void (*fn)()) {
+    memset(probeStack.data(), STACK_PAINT, probeStack.size());
+    getcontext(&probeContext);
+    probeContext.uc_stack.ss_sp = probeStack.data();
+    probeContext.uc_stack.ss_size = probeStack.size();
+    probeContext.uc_link = &probeCaller;
+    probeFn = fn;
+    makecontext(&probeContext, probeEntry, 0);
+    swapcontext(&probeCaller, &probeContext);
+
+    size_t untouched = 0;
+    while (untouched < probeStack.size() && probeStack[untouched] == STACK_PAINT) untouched++;
+    return probeStack.size() - untouched;
+}
+
+static void probeNothing() {}
+static void probeLegacyReceive() { for (const Frame& f : *probeFrames) legacyReceive(f); }
+static void probeStreamReceive() { for (const Frame& f : *probeFrames) streamReceive(f); }
+static void probeLegacyText() { legacySendText(SAMPLE_TEXT, 0xFFFFFFFF, 1); }
+static void probeStreamText() { streamSendText(SAMPLE_TEXT, 0xFFFFFFFF, 1); }
+static void probeLegacyAdmin() { adminReboot(true); }
+static void probeStreamAdmin() { adminReboot(false); }
+
+int main(int argc, char** argv) {
+    uint32_t n = 20000;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            n = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n N] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (n == 0) {
+        fprintf(stderr, "need at least one packet\n");
+        return 1;
+    }
+
+    srand(seed);
+    printf("\n=== Meshtastic codec bench (seed %u) ===\n", seed);
+
+    checkPacketDecode(n);
+    checkOtherDecode(n / 4 + 6);
+    printf("Decode:    %u packets, %u other variants checked against pb_decode()\n", n, n / 4 + 6);
+    checkEncode(n);
+    printf("Encode:    %u packets and want_configs checked against pb_encode()\n", n);
+    uint32_t bothAccepted, streamOnly;
+    checkFuzz(n * 5, bothAccepted, streamOnly);
+    printf("Fuzz:      %u mutations, %u accepted by both, %u by the codec only\n", n * 5, bothAccepted, streamOnly);
+
+    // A node report burst as the task sees it: mostly packets, some text and hot packets
+    std::vector<Frame> pool;
+    for (uint32_t i = 0; i < 1024; i++) {
+        meshtastic_FromRadio msg = (i % 5 == 0) ? randomOtherMsg(i) : randomPacketMsg();
+        if (msg.which_payload_variant == meshtastic_FromRadio_packet_tag &&
+            msg.packet.which_payload_variant == meshtastic_MeshPacket_decoded_tag &&
+            msg.packet.decoded.portnum == meshtastic_PortNum_TEXT_MESSAGE_APP) {
+            meshtastic_Data_payload_t& text = msg.packet.decoded.payload;
+            for (pb_size_t k = 0; k < text.size; k++) text.bytes[k] = 'a' + rand() % 26;
+        }
+        pool.push_back(encodeFromRadio(msg));
+    }
+    checkOldAgainstNew(pool);
+
+    uint32_t reps = n / 1000 + 1;
+    double legacyRx = nsPerFrame(legacyReceive, pool, reps);
+    double streamRx = nsPerFrame(streamReceive, pool, reps);
+    double legacyTx = nsPerSend(legacySendText, n);
+    double streamTx = nsPerSend(streamSendText, n);
+    printf("Receive:   %.0f ns/frame with pb_decode(), %.0f ns/frame streamed\n", legacyRx, streamRx);
+    printf("Send text: %.0f ns with pb_encode(), %.0f ns streamed\n", legacyTx, streamTx);
+
+    std::vector<Frame> probe;
+    probe.push_back(encodeFromRadio(randomOtherMsg(3)));  // rebooted: sends want_config
+    for (uint32_t i = 0; i < 64; i++) probe.push_back(pool[i]);
+    probeFrames = &probe;
+    size_t base = stackUsed(probeNothing);
+    printf("Stack:     receive %zu -> %zu bytes, send text %zu -> %zu, admin %zu -> %zu\n",
+           stackUsed(probeLegacyReceive) - base, stackUsed(probeStreamReceive) - base,
+           stackUsed(probeLegacyText) - base, stackUsed(probeStreamText) - base,
+           stackUsed(probeLegacyAdmin) - base, stackUsed(probeStreamAdmin) - base);
+
+    return benchResult();
+}
@@ -0,0 +1,357 @@
+/********************************************************************************************
+*    GCD Meshtastic Framer Bench - host-side (Linux) test of the serial stream framer       *
+*                                                                                           *
+*    Feeds MtFramer (lib/meshtastic-arduino_src/mt_framer.h, the firmware source) streams   *
+*    of frames in random fragments at 9600 baud timing, clean and then with corruption,     *
+*    and runs the same bytes through a model of the linear-buffer framing it replaced       *
+*    (one frame per 100 ms loop, delay(25) on a partial frame, buffer wiped on bad magic).  *
+*                                                                                           *
+*    Usage:                                                                                 *
+*    1. pio run -e native_mtframe                                                           *
+*    2. .pio/build/native_mtframe/program [-n frames] [-s seed] [-c percent]                *
+*         -n  frames per stream (default 20000), -s random seed (default 1)                 *
+*         -c  percent of frames corrupted in the second stream (default 10)                 *
+*                                                                                           *
+*    Corruptions: garbage before the frame (which may hold stray magic bytes), a bad        *
+*    magic, a bad length, a truncated frame and a flipped payload bit. Payloads carry a     *
+*    checksum standing in for protobuf decoding. Checks: every intact frame is recovered,   *
+*    in order, with nothing extra, and payloads read through payloadStream() (which wraps   *
+*    the end of the ring) match. Reports frames recovered, garbage skipped and the latency  *
+*    from a frame's last byte to its decode. Exits 1 on any failure.                        *
+*                                                                                           *
+********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include "mt_framer.h"
+
+#define BAUD_MS_PER_BYTE (10.0 / 9.6)  // 10 bits per byte at 9600 baud
+#define UART_WAKE_BYTES 120              // RX FIFO threshold that raises onReceive()
+#define UART_RX_BUFFER 256               // HardwareSerial RX ring (core default)
+#define LEGACY_BUFSIZE 512
+#define LEGACY_LOOP_MS 100               // meshtasticTask vTaskDelay
+#define LEGACY_NO_NEWS_PAUSE 25          // delay() in the old mt_protocol_check_packet
+#define LEGACY_HEARTBEAT_MS 60000        // Every send cleared the shared buffer
+
+typedef enum {
+    CORRUPT_NONE,
+    CORRUPT_GARBAGE,    // Garbage in front, frame itself intact
+    CORRUPT_MAGIC,
+    CORRUPT_LENGTH,
+    CORRUPT_TRUNCATED,
+    CORRUPT_PAYLOAD,
+    CORRUPT_KINDS
+} corruption_t;
+
+static const char* CORRUPT_NAMES[CORRUPT_KINDS] = {"none", "garbage", "magic", "length", "truncated", "payload"};
+
+struct Stream {
+    std::vector<uint8_t> bytes;
+    std::vector<double> arrivalMs;       // When each byte reaches the UART
+    std::vector<uint32_t> intact;        // Frame ids that must be recovered, in order
+    std::vector<size_t> lastByte;        // Per frame id: index of its last byte
+    uint32_t corrupted[CORRUPT_KINDS];
+};
+
+struct Result {
+    uint32_t recovered;
+    uint32_t missing;
+    uint32_t unexpected;
+    double latencySumMs;
+    double latencyMaxMs;
+    double cpuNs;
+    MtFramer::Stats stats;
+};
+
+/*****************************
+ *      STREAM BUILDER        *
+ *****************************/
+
+static uint32_t checksum(const uint8_t* p, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Payload: id (4 bytes), random filler, FNV-1a of the rest (4 bytes)
+static std::vector<uint8_t> makePayload(uint32_t id) {
+    // Mostly short packets like the real link, now and then a large one
+    size_t len = (rand() % 10 == 0) ? 8 + rand() % (MT_MAX_PAYLOAD - 7) : 8 + rand() % 120;
+    std::vector<uint8_t> p(len);
+    memcpy(&p[0], &id, 4);
+    for (size_t i = 4; i < len - 4; i++) p[i] = (rand() % 16 == 0) ? MT_MAGIC_0 : (uint8_t)rand();
+    uint32_t sum = checksum(&p[0], len - 4);
+    memcpy(&p[len - 4], &sum, 4);
+    return p;
+}
+
+// The stand-in for pb_decode(): a payload is valid when its checksum matches
+static bool payloadValid(const std::vector<uint8_t>& p, uint32_t& id) {
+    if (p.size() < 8) return false;
+    uint32_t sum;
+    memcpy(&sum, &p[p.size() - 4], 4);
+    if (checksum(&p[0], p.size() - 4) != sum) return false;
+    memcpy(&id, &p[0], 4);
+    return true;
+}
+
+static Stream buildStream(uint32_t frames, int corruptPercent) {
+    Stream s = {};
+    double t = 0.0;
+    for (uint32_t id = 0; id < frames; id++) {
+        corruption_t kind = CORRUPT_NONE;
+        if (rand() % 100 < corruptPercent) kind = (corruption_t)(1 + rand() % (CORRUPT_KINDS - 1));
+        s.corrupted[kind]++;
+
+        if (kind == CORRUPT_GARBAGE) {
+            int n = 1 + rand() % 40;
+            for (int i = 0; i < n; i++) {
+                int r = rand() % 8;
+                s.bytes.push_back(r == 0 ? MT_MAGIC_0 : (r == 1 ? MT_MAGIC_1 : (uint8_t)rand()));
+            }
+        }
+
+        std::vector<uint8_t> payload = makePayload(id);
+        uint8_t header[MT_HEADER_SIZE] = {MT_MAGIC_0, MT_MAGIC_1, (uint8_t)(payload.size() >> 8),
+                                          (uint8_t)payload.size()};
+        switch (kind) {
+            case CORRUPT_MAGIC: header[rand() % 2] ^= (uint8_t)(1 + rand() % 255); break;
+            case CORRUPT_LENGTH: header[3] ^= (uint8_t)(1 + rand() % 255); break;
+            case CORRUPT_TRUNCATED:
+                // At least the 4 checksum bytes, or the next header's magic could complete it by chance
+                payload.resize(rand() % (payload.size() - 3));
+                break;
+            case CORRUPT_PAYLOAD: payload[rand() % payload.size()] ^= (uint8_t)(1 << (rand() % 8)); break;
+            default: break;
+        }
+
+        s.bytes.insert(s.bytes.end(), header, header + MT_HEADER_SIZE);
+        s.bytes.insert(s.bytes.end(), payload.begin(), payload.end());
+        s.lastByte.push_back(s.bytes.size() - 1);
+        if (kind == CORRUPT_NONE || kind == CORRUPT_GARBAGE) s.intact.push_back(id);
+    }
+
+    // Bursts of back-to-back bytes separated by idle gaps
+    size_t i = 0;
+    while (i < s.bytes.size()) {
+        size_t burst = 1 + rand() % 300;
+        for (size_t j = 0; j < burst && i < s.bytes.size(); j++, i++) {
+            t += BAUD_MS_PER_BYTE;
+            s.arrivalMs.push_back(t);
+        }
+        t += (rand() % 4 == 0) ? rand() % 200 : rand() % 5;
+    }
+    return s;
+}
+
+/*****************************
+ *         RUNNERS            *
+ *****************************/
+
+static void checkFrame(const Stream& s, Result& r, size_t& expectIdx, uint32_t id, double nowMs) {
+    // Skip intact frames that never showed up
+    while (expectIdx < s.intact.size() && s.intact[expectIdx] < id) {
+        r.missing++;
+        expectIdx++;
+    }
+    if (expectIdx < s.intact.size() && s.intact[expectIdx] == id) {
+        r.recovered++;
+        expectIdx++;
+        double latency = nowMs - s.arrivalMs[s.lastByte[id]];
+        r.latencySumMs += latency;
+        if (latency > r.latencyMaxMs) r.latencyMaxMs = latency;
+    } else {
+        r.unexpected++;
+    }
+}
+
+// Hand out every complete frame, reading each the way nanopb does: small pieces through the stream callback
+static void drainFrames(MtFramer& framer, const Stream& s, Result& r, size_t& expectIdx, double nowMs,
+                        double& cpuNs) {
+    typedef std::chrono::steady_clock clk;
+    std::vector<uint8_t> payload;
+    clk::time_point t0 = clk::now();
+    size_t len;
+    while (framer.next((uint32_t)nowMs, len)) {
+        pb_istream_t stream = framer.payloadStream();
+        payload.resize(len);
+        size_t got = 0;
+        while (got < len) {
+            size_t piece = 1 + rand() % 8;
+            if (piece > len - got) piece = len - got;
+            if (!stream.callback(&stream, &payload[got], piece)) break;
+            got += piece;
+        }
+        uint32_t id;
+        bool decoded = got == len && payloadValid(payload, id);
+        framer.consume(decoded);
+        cpuNs += std::chrono::duration<double, std::nano>(clk::now() - t0).count();
+        if (decoded) checkFrame(s, r, expectIdx, id, nowMs);
+        t0 = clk::now();
+    }
+    cpuNs += std::chrono::duration<double, std::nano>(clk::now() - t0).count();
+}
+
+// Event-driven ring framer: wakes every UART_WAKE_BYTES and when the line goes idle
+static Result runFramer(const Stream& s) {
+    static MtFramer framer;
+    framer = MtFramer();
+    Result r = {};
+    size_t expectIdx = 0;
+    size_t fed = 0;
+    double cpuNs = 0.0;
+
+    while (fed < s.bytes.size()) {
+        // Bytes up to the next wake-up
+        size_t end = fed;
+        do {
+            end++;
+        } while (end < s.bytes.size() && end - fed < UART_WAKE_BYTES &&
+                 s.arrivalMs[end] - s.arrivalMs[end - 1] < 2 * BAUD_MS_PER_BYTE);
+        double nowMs = s.arrivalMs[end - 1];
+
+        fed += framer.write(&s.bytes[fed], end - fed);  // Never full: frames are handled every wake-up
+        drainFrames(framer, s, r, expectIdx, nowMs, cpuNs);
+    }
+
+    // Line goes quiet: headers still waiting time out one after another, freeing any frame behind them
+    double nowMs = s.arrivalMs.back();
+    size_t before;
+    do {
+        before = framer.available();
+        nowMs += MT_PARTIAL_FRAME_TIMEOUT_MS;
+        drainFrames(framer, s, r, expectIdx, nowMs, cpuNs);
+    } while (framer.available() != before);
+    if (framer.available() >= MT_HEADER_SIZE) r.unexpected++;  // Stuck on a header despite the timeout
+
+    r.missing += s.intact.size() - expectIdx;
+    r.cpuNs = r.recovered ? cpuNs / r.recovered : 0.0;
+    r.stats = framer.statistics();
+    return r;
+}
+
+// The replaced code: UART ring, 512-byte linear buffer, one frame per loop
+static Result runLegacy(const Stream& s) {
+    Result r = {};
+    size_t expectIdx = 0;
+    std::deque<uint8_t> uart;
+    uint8_t buf[LEGACY_BUFSIZE + 4];
+    size_t size = 0;
+    size_t next = 0;
+    double nowMs = 0.0;
+    double heartbeatMs = LEGACY_HEARTBEAT_MS;
+
+    while (next < s.bytes.size() || !uart.empty() || size >= MT_HEADER_SIZE) {
+        if (nowMs >= heartbeatMs) {
+            // The heartbeat's pb_size = 0 was the only way out of a stuck header
+            size = 0;
+            heartbeatMs += LEGACY_HEARTBEAT_MS;
+        }
+
+        // Bytes that reached the UART since the last pass (lost when its ring is full)
+        for (; next < s.bytes.size() && s.arrivalMs[next] <= nowMs; next++) {
+            if (uart.size() < UART_RX_BUFFER) uart.push_back(s.bytes[next]);
+        }
+        while (!uart.empty() && size < LEGACY_BUFSIZE) {
+            buf[size++] = uart.front();
+            uart.pop_front();
+        }
+
+        bool paused = false;
+        if (size < MT_HEADER_SIZE) {
+            paused = true;
+        } else if (buf[0] != MT_MAGIC_0 || buf[1] != MT_MAGIC_1) {
+            memset(buf, 0, LEGACY_BUFSIZE);
+            size = 0;
+        } else {
+            uint16_t len = buf[2] << 8 | buf[3];
+            if (len > LEGACY_BUFSIZE) {
+                // Stuck until the next heartbeat
+            } else if ((size_t)(len + 4) > size) {
+                paused = true;  // As stuck when the frame is too long to fit
+            } else {
+                std::vector<uint8_t> payload(buf + 4, buf + 4 + len);
+                memmove(buf, buf + 4 + len, LEGACY_BUFSIZE - 4 - len);
+                size -= 4 + len;
+                uint32_t id;
+                if (payloadValid(payload, id)) checkFrame(s, r, expectIdx, id, nowMs);
+            }
+        }
+        nowMs += LEGACY_LOOP_MS + (paused ? LEGACY_NO_NEWS_PAUSE : 0);
+        if (next >= s.bytes.size() && uart.empty() && paused) break;
+    }
+
+    r.missing += s.intact.size() - expectIdx;
+    return r;
+}
+
+static void printResult(const char* label, const Stream& s, const Result& ring, const Result& legacy) {
+    printf("%-9s %zu intact of %zu frames (%zu bytes, corrupted:", label, s.intact.size(), s.lastByte.size(),
+           s.bytes.size());
+    for (int k = 1; k < CORRUPT_KINDS; k++) printf(" %s %u", CORRUPT_NAMES[k], s.corrupted[k]);
+    printf(")\n");
+    printf("  ring:   recovered %u, missing %u, unexpected %u, latency mean %.1f ms / max %.1f ms, %.0f ns CPU per frame\n",
+           ring.recovered, ring.missing, ring.unexpected, ring.recovered ? ring.latencySumMs / ring.recovered : 0.0,
+           ring.latencyMaxMs, ring.cpuNs);
+    printf("          %u frames, %u decode errors, %u bytes skipped, %u bad lengths, %u timeouts\n",
+           ring.stats.frames, ring.stats.decodeErrors, ring.stats.skippedBytes, ring.stats.badLengths,
+           ring.stats.timeouts);
+    printf("  legacy: recovered %u, missing %u, latency mean %.1f ms / max %.1f ms\n", legacy.recovered,
+           legacy.missing, legacy.recovered ? legacy.latencySumMs / legacy.recovered : 0.0, legacy.latencyMaxMs);
+}
+
+/*****************
+ *     MAIN      *
+ *****************/
+
+int main(int argc, char** argv) {
+    uint32_t frames = 20000;
+    unsigned seed = 1;
+    int corruptPercent = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            frames = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            corruptPercent = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "usage: %s [-n frames] [-s seed] [-c percent]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (frames == 0) {
+        fprintf(stderr, "need at least one frame\n");
+        return 1;
+    }
+
+    srand(seed);
+    uint32_t failures = 0;
+
+    printf("\n=== Meshtastic framer bench (seed %u) ===\n", seed);
+    const int percents[2] = {0, corruptPercent};
+    const char* labels[2] = {"Clean:", "Corrupt:"};
+    for (int run = 0; run < 2; run++) {
+        Stream s = buildStream(frames, percents[run]);
+        Result ring = runFramer(s);
+        Result legacy = runLegacy(s);
+        printResult(labels[run], s, ring, legacy);
+
+        if (ring.recovered != s.intact.size() || ring.missing || ring.unexpected) {
+            printf("FAIL %s stream: ring framer lost or invented frames\n", labels[run]);
+            failures++;
+        }
+    }
+
+    printf("Result:    %s (%u failures)\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,580 @@
+/********************************************************************************************
+*    GCD Meshtastic Handshake Bench - host-side (Linux) boot-to-traffic measurement         *
+*                                                                                           *
+*    Runs the library's own connection handshake (mt_protocol.cpp, mt_packet_codec.cpp      *
+*    and the MtFramer ring, as patched) against a simulated radio on a 9600 baud line,      *
+*    on the virtual millis() clock. The radio answers want_config_id as the firmware does:  *
+*    my_info, its own node, metadata, channels, config, module config, the rest of its      *
+*    node database and its file list, then config_complete_id - or, for SPECIAL_NONCE,      *
+*    everything but the other nodes, and for the nodes-only nonce just my_info and the      *
+*    nodes. Meanwhile it hears a POSITION packet from one of                                *
+*    those nodes every MESH_PACKET_EVERY_MS and, like the firmware's PhoneAPI, holds them   *
+*    until a dump's config_complete_id. Each handshake runs twice: upstream (every variant  *
+*    decoded, nodes in the dump) and with mt_set_fast_handshake().                          *
+*                                                                                           *
+*    Usage:                                                                                 *
+*    1. pio run -e native_mthandshake                                                       *
+*    2. .pio/build/native_mthandshake/program [-n nodes] [-s seed]                          *
+*         -n  nodes in the radio's database besides its own (default 40), -s random seed    *
+*                                                                                           *
+*    Measures from mt_request_node_report(): when the application's connected flag flips   *
+*    (connected_callback's first call), when the radio starts forwarding packets            *
+*    (handshake_ms) and when the first one is delivered (first_packet_ms).                  *
+*                                                                                           *
+*    Checks: both handshakes report the radio's node number and MT_NR_DONE once; upstream  *
+*    reports every node, the fast one only the radio's own before MT_NR_DONE and the rest   *
+*    from its nodes-only dump after packets flow; no packet is delivered before             *
+*    config_complete_id and every held one arrives, in order; the fast one parses none of   *
+*    the skipped variants (metadata never reaches the application) and counts each; a link  *
+*    probe afterwards is answered without ending the report again; and with 10 or more     *
+*    nodes the fast handshake delivers the first packet in at most half the upstream time.  *
+*    Also reports wire bytes, how many nodes are known some seconds in and the host CPU     *
+*    time decoding each dump. Sweeps the database size for the table. Exits 1 on failure.   *
+*                                                                                           *
+********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <set>
+#include <vector>
+
+#include "bench_check.h"
+#include "Meshtastic.h"
+#include "mt_internals.h"
+#include "mt_framer.h"
+#include "mt_packet_codec.h"
+
+#define BAUD_BYTES_PER_MS 0.96           // 9600 baud, 10 bits per byte
+#define RADIO_RESPONSE_MS 30             // want_config_id to the first byte of the reply
+#define RADIO_FRAME_GAP_MS 2             // The radio's StreamAPI writes one FromRadio per loop
+#define RADIO_NODE_NUM 0xDA0C0FFE
+#define PROBE_NONCE 69420                // SPECIAL_NONCE in mt_protocol.cpp
+#define NODES_ONLY_NONCE 69421           // NODES_ONLY_NONCE in mt_protocol.cpp
+#define MESH_PACKET_EVERY_MS 500         // Traffic the radio hears from the other nodes
+#define KNOWN_AFTER_MS 15000             // When to count the nodes the application knows
+#define DEADLINE_MS 120000
+
+HardwareSerial Serial;
+
+/*****************************
+ *   APPLICATION CALLBACKS    *
+ *****************************/
+
+// What the application saw (meshtastic_admin.cpp, connected_callback and mesh_packet_deliver
+// in the firmware); times are millis()
+static struct {
+    uint32_t myNodeNum;
+    uint32_t metadataCalls;
+    uint32_t doneCalls;
+    uint32_t nodesAtDone;        // Nodes reported when MT_NR_DONE came
+    uint32_t invalidCalls;
+    std::set<uint32_t> nodes;    // From the node report
+    std::set<uint32_t> heard;    // From forwarded packets (meshNodePacket)
+    uint32_t connectedAt;        // connected_callback's first call: not_yet_connected cleared
+    uint32_t firstPacketAt;
+    uint32_t packets;
+    uint32_t lastPacketId;
+    uint32_t outOfOrder;
+} app;
+
+void handleMyNodeInfo(meshtastic_MyNodeInfo* info) {
+    app.myNodeNum = info->my_node_num;
+}
+void handleDeviceMetadata(meshtastic_DeviceMetadata*) {
+    app.metadataCalls++;
+}
+void handlePositionConfigResponse(meshtastic_Config_PositionConfig*) {}
+void handleGcmRebooted() {}
+
+static void nodeReport(mt_node_t* node, mt_nr_progress_t progress) {
+    if (app.connectedAt == 0) app.connectedAt = millis();
+    if (progress == MT_NR_IN_PROGRESS && node != NULL) {
+        app.nodes.insert(node->node_num);
+    } else if (progress == MT_NR_DONE) {
+        if (app.doneCalls++ == 0) app.nodesAtDone = app.nodes.size();
+    } else if (progress == MT_NR_INVALID) {
+        app.invalidCalls++;
+    }
+}
+
+static uint8_t* payloadReserve(meshtastic_PortNum, size_t size) {
+    static uint8_t buf[MT_MAX_PAYLOAD + 1];
+    return size < sizeof(buf) ? buf : NULL;
+}
+
+static void packetDeliver(const mt_packet_t* packet, uint8_t*) {
+    if (app.firstPacketAt == 0) app.firstPacketAt = millis();
+    if (packet->id != app.lastPacketId + 1) app.outOfOrder++;
+    app.lastPacketId = packet->id;
+    app.packets++;
+    app.heard.insert(packet->from);
+}
+
+/*****************************
+ *       SIMULATED RADIO      *
+ *****************************/
+
+struct Dump {
+    std::vector<std::vector<uint8_t>> myInfo, ownNode, config, otherNodes, files;
+    uint32_t skippable;          // Frames in config + files that MT_FAST_HANDSHAKE_SKIP covers
+    std::vector<uint32_t> otherNums;
+};
+
+static struct {
+    Dump dump;
+    std::vector<uint8_t> bytes;  // Everything the radio ever sent
+    std::vector<double> arrival; // When each byte is in the UART
+    size_t readPos;
+    double lineFreeAt;
+    MtFramer rx;                 // Frames from the GCD
+    uint32_t wantConfigs;
+    double holdUntil;            // Packets are held until the last dump's config_complete_id is out
+    bool configured;             // A dump has been answered since the GCD booted
+    std::vector<std::vector<uint8_t>> held;
+    uint32_t nextPacketAt;
+    uint32_t packetId;           // Mesh packets heard so far (ids 1, 2, ...)
+    bool quiet;                  // No more traffic (draining at the end of a run)
+} radio;
+
+static std::vector<uint8_t> frameOf(const meshtastic_FromRadio& msg) {
+    std::vector<uint8_t> f(MT_HEADER_SIZE + MT_MAX_PAYLOAD);
+    pb_ostream_t stream = pb_ostream_from_buffer(&f[MT_HEADER_SIZE], MT_MAX_PAYLOAD);
+    if (!pb_encode(&stream, meshtastic_FromRadio_fields, &msg)) fail("radio could not encode", msg.which_payload_variant);
+    f[0] = MT_MAGIC_0;
+    f[1] = MT_MAGIC_1;
+    f[2] = stream.bytes_written >> 8;
+    f[3] = stream.bytes_written & 0xFF;
+    f.resize(MT_HEADER_SIZE + stream.bytes_written);
+    return f;
+}
+
+static meshtastic_FromRadio nodeInfo(uint32_t num, uint32_t i) {
+    meshtastic_FromRadio msg = meshtastic_FromRadio_init_zero;
+    msg.which_payload_variant = meshtastic_FromRadio_node_info_tag;
+    meshtastic_NodeInfo& n = msg.node_info;
+    n.num = num;
+    n.has_user = true;
+    snprintf(n.user.id, sizeof(n.user.id), "!%08x", num);
+    snprintf(n.user.long_name, sizeof(n.user.long_name), "Golf Cart %u Meshtastic", i);
+    snprintf(n.user.short_name, sizeof(n.user.short_name), "C%u", i % 1000);
+    n.user.hw_model = meshtastic_HardwareModel_HELTEC_V3;
+    n.user.public_key.size = 32;
+    for (int b = 0; b < 32; b++) n.user.public_key.bytes[b] = rand();
+    n.has_position = true;
+    n.position.latitude_i = 289300000 + rand() % 60000 - 30000;
+    n.position.longitude_i = -819700000 + rand() % 60000 - 30000;
+    n.position.altitude = 20 + rand() % 30;
+    n.position.time = 1760000000 + rand() % 86400;
+    n.has_device_metrics = true;
+    n.device_metrics.battery_level = 1 + rand() % 101;
+    n.device_metrics.voltage = 3.3f + (rand() % 90) / 100.0f;
+    n.device_metrics.channel_utilization = (rand() % 400) / 10.0f;
+    n.device_metrics.air_util_tx = (rand() % 50) / 10.0f;
+    n.device_metrics.uptime_seconds = rand() % 864000;
+    n.snr = (rand() % 200) / 10.0f - 5.0f;
+    n.last_heard = 1760000000 + rand() % 86400;
+    n.has_hops_away = true;
+    n.hops_away = rand() % 3;
+    return msg;
+}
+
+static void buildDump(uint32_t otherNodes) {
+    Dump& d = radio.dump;
+    d = Dump();
+    meshtastic_FromRadio msg = meshtastic_FromRadio_init_zero;
+
+    msg.which_payload_variant = meshtastic_FromRadio_my_info_tag;
+    msg.my_info.my_node_num = RADIO_NODE_NUM;
+    msg.my_info.reboot_count = 42;
+    msg.my_info.min_app_version = 30200;
+    msg.my_info.device_id.size = 16;
+    strcpy(msg.my_info.pio_env, "heltec-v3");
+    d.myInfo.push_back(frameOf(msg));
+    d.ownNode.push_back(frameOf(nodeInfo(RADIO_NODE_NUM, 0)));
+
+    // Settings: nothing in the application reads these
+    msg = meshtastic_FromRadio_init_zero;
+    msg.which_payload_variant = meshtastic_FromRadio_metadata_tag;
+    strcpy(msg.metadata.firmware_version, "2.6.11.60ec05e");
+    msg.metadata.device_state_version = 24;
+    msg.metadata.hasBluetooth = true;
+    msg.metadata.hasPKC = true;
+    msg.metadata.hw_model = meshtastic_HardwareModel_HELTEC_V3;
+    d.config.push_back(frameOf(msg));
+    for (int i = 0; i < 8; i++) {
+        msg = meshtastic_FromRadio_init_zero;
+        msg.which_payload_variant = meshtastic_FromRadio_channel_tag;
+        msg.channel.index = i;
+        if (i < 2) {
+            msg.channel.role = i == 0 ? meshtastic_Channel_Role_PRIMARY : meshtastic_Channel_Role_SECONDARY;
+            msg.channel.has_settings = true;
+            msg.channel.settings.psk.size = 16;
+            for (int b = 0; b < 16; b++) msg.channel.settings.psk.bytes[b] = rand();
+            strcpy(msg.channel.settings.name, i == 0 ? "" : "GolfCarts");
+        }
+        d.config.push_back(frameOf(msg));
+    }
+    for (pb_size_t tag = meshtastic_Config_device_tag; tag <= meshtastic_Config_device_ui_tag; tag++) {
+        msg = meshtastic_FromRadio_init_zero;
+        msg.which_payload_variant = meshtastic_FromRadio_config_tag;
+        meshtastic_Config& c = msg.config;
+        c.which_payload_variant = tag;
+        if (tag == meshtastic_Config_device_tag) {
+            c.payload_variant.device.serial_enabled = true;
+            c.payload_variant.device.node_info_broadcast_secs = 10800;
+            strcpy(c.payload_variant.device.tzdef, "EST5EDT,M3.2.0,M11.1.0");
+        } else if (tag == meshtastic_Config_position_tag) {
+            c.payload_variant.position.position_broadcast_secs = 900;
+            c.payload_variant.position.gps_update_interval = 120;
+            c.payload_variant.position.position_flags = 811;
+            c.payload_variant.position.broadcast_smart_minimum_distance = 100;
+            c.payload_variant.position.broadcast_smart_minimum_interval_secs = 30;
+        } else if (tag == meshtastic_Config_power_tag) {
+            c.payload_variant.power.wait_bluetooth_secs = 60;
+            c.payload_variant.power.ls_secs = 300;
+            c.payload_variant.power.min_wake_secs = 10;
+        } else if (tag == meshtastic_Config_network_tag) {
+            strcpy(c.payload_variant.network.ntp_server, "meshtastic.pool.ntp.org");
+        } else if (tag == meshtastic_Config_display_tag) {
+            c.payload_variant.display.screen_on_secs = 600;
+        } else if (tag == meshtastic_Config_lora_tag) {
+            c.payload_variant.lora.use_preset = true;
+            c.payload_variant.lora.region = meshtastic_Config_LoRaConfig_RegionCode_US;
+            c.payload_variant.lora.hop_limit = 3;
+            c.payload_variant.lora.tx_enabled = true;
+            c.payload_variant.lora.tx_power = 30;
+            c.payload_variant.lora.sx126x_rx_boosted_gain = true;
+        } else if (tag == meshtastic_Config_bluetooth_tag) {
+            c.payload_variant.bluetooth.enabled = true;
+            c.payload_variant.bluetooth.fixed_pin = 123456;
+        } else if (tag == meshtastic_Config_security_tag) {
+            c.payload_variant.security.public_key.size = 32;
+            c.payload_variant.security.private_key.size = 32;
+            for (int b = 0; b < 32; b++) {
+                c.payload_variant.security.public_key.bytes[b] = rand();
+                c.payload_variant.security.private_key.bytes[b] = rand();
+            }
+            c.payload_variant.security.serial_enabled = true;
+        }
+        d.config.push_back(frameOf(msg));
+    }
+    for (pb_size_t tag = meshtastic_ModuleConfig_mqtt_tag; tag <= meshtastic_ModuleConfig_paxcounter_tag; tag++) {
+        msg = meshtastic_FromRadio_init_zero;
+        msg.which_payload_variant = meshtastic_FromRadio_moduleConfig_tag;
+        meshtastic_ModuleConfig& m = msg.moduleConfig;
+        m.which_payload_variant = tag;
+        if (tag == meshtastic_ModuleConfig_mqtt_tag) {
+            strcpy(m.payload_variant.mqtt.address, "mqtt.meshtastic.org");
+            strcpy(m.payload_variant.mqtt.username, "meshdev");
+            strcpy(m.payload_variant.mqtt.password, "large4cats");
+            strcpy(m.payload_variant.mqtt.root, "msh/US");
+            m.payload_variant.mqtt.encryption_enabled = true;
+        } else if (tag == meshtastic_ModuleConfig_telemetry_tag) {
+            m.payload_variant.telemetry.device_update_interval = 1800;
+        } else if (tag == meshtastic_ModuleConfig_neighbor_info_tag) {
+            m.payload_variant.neighbor_info.update_interval = 14400;
+        }
+        d.config.push_back(frameOf(msg));
+    }
+
+    for (uint32_t i = 0; i < otherNodes; i++) {
+        d.otherNums.push_back(0xDA000000u | (uint32_t)(rand() & 0xFFFFFF));
+        d.otherNodes.push_back(frameOf(nodeInfo(d.otherNums.back(), i + 1)));
+    }
+
+    static const char* FILES[] = {"/prefs/config.proto", "/prefs/module.proto", "/prefs/channels.proto",
+                                  "/prefs/db.proto", "/prefs/uiconfig.proto", "/static/www/index.html",
+                                  "/static/www/assets/index.js.gz", "/oem/oem.proto"};
+    for (const char* name : FILES) {
+        msg = meshtastic_FromRadio_init_zero;
+        msg.which_payload_variant = meshtastic_FromRadio_fileInfo_tag;
+        strcpy(msg.fileInfo.file_name, name);
+        msg.fileInfo.size_bytes = 200 + rand() % 40000;
+        d.files.push_back(frameOf(msg));
+    }
+    d.skippable = d.config.size() + d.files.size();
+}
+
+static void send(const std::vector<uint8_t>& frame, double& at) {
+    for (uint8_t b : frame) {
+        at += 1.0 / BAUD_BYTES_PER_MS;
+        radio.bytes.push_back(b);
+        radio.arrival.push_back(at);
+    }
+    at += RADIO_FRAME_GAP_MS;
+}
+
+static void sendAll(const std::vector<std::vector<uint8_t>>& frames, double& at) {
+    for (const std::vector<uint8_t>& f : frames) send(f, at);
+}
+
+// The firmware's PhoneAPI order, without the other nodes for SPECIAL_NONCE and with
+// only the nodes for the nodes-only nonce
+static void answerWantConfig(uint32_t id, uint32_t now) {
+    radio.wantConfigs++;
+    double at = now + RADIO_RESPONSE_MS;
+    if (radio.lineFreeAt > at) at = radio.lineFreeAt;
+    sendAll(radio.dump.myInfo, at);
+    sendAll(radio.dump.ownNode, at);
+    if (id != NODES_ONLY_NONCE) sendAll(radio.dump.config, at);
+    if (id != PROBE_NONCE) sendAll(radio.dump.otherNodes, at);
+    if (id != NODES_ONLY_NONCE) sendAll(radio.dump.files, at);
+    meshtastic_FromRadio msg = meshtastic_FromRadio_init_zero;
+    msg.which_payload_variant = meshtastic_FromRadio_config_complete_id_tag;
+    msg.config_complete_id = id;
+    send(frameOf(msg), at);
+    radio.lineFreeAt = at;
+    radio.holdUntil = at;
+    radio.configured = true;
+}
+
+// A POSITION broadcast from one of the other nodes (or one the radio has not stored yet)
+static std::vector<uint8_t> meshPacket(uint32_t id) {
+    meshtastic_FromRadio msg = meshtastic_FromRadio_init_zero;
+    msg.which_payload_variant = meshtastic_FromRadio_packet_tag;
+    meshtastic_MeshPacket& p = msg.packet;
+    p.from = radio.dump.otherNums.empty() ? RADIO_NODE_NUM + 1
+                                          : radio.dump.otherNums[rand() % radio.dump.otherNums.size()];
+    p.to = 0xFFFFFFFF;
+    p.id = id;
+    p.hop_limit = 3;
+    p.which_payload_variant = meshtastic_MeshPacket_decoded_tag;
+    p.decoded.portnum = meshtastic_PortNum_POSITION_APP;
+    meshtastic_Position pos = meshtastic_Position_init_zero;
+    pos.has_latitude_i = pos.has_longitude_i = true;
+    pos.latitude_i = 289300000 + rand() % 60000 - 30000;
+    pos.longitude_i = -819700000 + rand() % 60000 - 30000;
+    pos.time = 1760000000 + id;
+    pb_ostream_t stream = pb_ostream_from_buffer(p.decoded.payload.bytes, sizeof(p.decoded.payload.bytes));
+    if (!pb_encode(&stream, meshtastic_Position_fields, &pos)) fail("radio could not encode a position", id);
+    p.decoded.payload.size = stream.bytes_written;
+    return frameOf(msg);
+}
+
+// Mesh traffic up to now: forwarded once configured and no dump is going out, held before
+static void radioTick(uint32_t now) {
+    while (!radio.quiet && radio.nextPacketAt <= now) {
+        radio.held.push_back(meshPacket(++radio.packetId));
+        radio.nextPacketAt += MESH_PACKET_EVERY_MS;
+    }
+    if (!radio.configured || now < radio.holdUntil || radio.held.empty()) return;
+    double at = radio.lineFreeAt > now ? radio.lineFreeAt : now;
+    sendAll(radio.held, at);
+    radio.held.clear();
+    radio.lineFreeAt = at;
+}
+
+// Transport the library links against (mt_serial_esp32.cpp on the GCD)
+bool mt_serial_loop() {
+    return true;
+}
+
+bool mt_serial_send_radio(const char* buf, size_t len) {
+    radio.rx.write((const uint8_t*)buf, len);
+    size_t payloadLen;
+    while (radio.rx.next(millis(), payloadLen)) {
+        pb_istream_t stream = radio.rx.payloadStream();
+        meshtastic_ToRadio msg = meshtastic_ToRadio_init_zero;
+        bool ok = pb_decode(&stream, meshtastic_ToRadio_fields, &msg);
+        radio.rx.consume(ok);
+        if (ok && msg.which_payload_variant == meshtastic_ToRadio_want_config_id_tag) {
+            answerWantConfig(msg.want_config_id, millis());
+        }
+    }
+    return true;
+}
+
+size_t mt_serial_check_radio(char* buf, size_t space) {
+    size_t n = 0;
+    double now = millis();
+    while (n < space && radio.readPos < radio.bytes.size() && radio.arrival[radio.readPos] <= now) {
+        buf[n++] = radio.bytes[radio.readPos++];
+    }
+    return n;
+}
+
+/*****************************
+ *         HANDSHAKE          *
+ *****************************/
+
+struct Result {
+    uint32_t connectedFlagMs;    // connected_callback's first call
+    uint32_t flowMs;             // mt_rx_stats_t handshake_ms: the radio forwards packets from here
+    uint32_t firstPacketMs;      // mt_rx_stats_t first_packet_ms
+    uint32_t nodeDbMs;           // mt_rx_stats_t node_db_ms: the fast handshake's nodes are in
+    uint32_t knownNodes;         // Reported or heard by KNOWN_AFTER_MS
+    uint32_t wireBytes;
+    uint32_t skipped;
+};
+
+static void runUntil(uint32_t& clock, uint32_t end) {
+    while (clock < end) {
+        hostSetMillis(++clock);
+        radioTick(clock);
+        mt_loop(clock);
+    }
+}
+
+// One meshtasticTask life from mt_request_node_report() (at boot) with the mesh talking
+static Result handshake(bool fast, uint32_t& clock) {
+    app.myNodeNum = 0;
+    app.metadataCalls = app.doneCalls = app.nodesAtDone = app.invalidCalls = 0;
+    app.nodes.clear();
+    app.heard.clear();
+    app.connectedAt = app.firstPacketAt = app.packets = app.outOfOrder = 0;
+    size_t bytesBefore = radio.bytes.size();
+    uint32_t wantConfigsBefore = radio.wantConfigs;
+    mt_rx_stats_t before;
+    mt_get_rx_stats(&before);
+
+    // The radio has been up; it holds its traffic for a client that has not asked yet
+    uint32_t start = clock;
+    radio.configured = radio.quiet = false;
+    radio.held.clear();
+    radio.nextPacketAt = start + MESH_PACKET_EVERY_MS;
+    app.lastPacketId = radio.packetId;
+
+    hostSetMillis(clock);
+    mt_set_fast_handshake(fast);
+    if (!mt_request_node_report(nodeReport)) fail("request not sent", fast);
+
+    Result r = {};
+    mt_rx_stats_t after = {};
+    while (clock - start < DEADLINE_MS &&
+           (app.doneCalls == 0 || clock - start < KNOWN_AFTER_MS || (fast && after.node_db_ms == 0))) {
+        runUntil(clock, clock + 1);
+        mt_get_rx_stats(&after);
+        if (clock - start == KNOWN_AFTER_MS) {
+            std::set<uint32_t> known = app.nodes;
+            known.insert(app.heard.begin(), app.heard.end());
+            r.knownNodes = known.size();
+        }
+    }
+    r.connectedFlagMs = app.connectedAt - start;
+    r.flowMs = after.handshake_ms;
+    r.firstPacketMs = after.first_packet_ms;
+    r.nodeDbMs = after.node_db_ms;
+    r.skipped = after.skipped_variants - before.skipped_variants;
+    r.wireBytes = radio.bytes.size() - bytesBefore;
+
+    if (app.doneCalls != 1) fail("MT_NR_DONE not seen exactly once", app.doneCalls);
+    if (app.invalidCalls != 0) fail("MT_NR_INVALID reported", app.invalidCalls);
+    if (app.myNodeNum != RADIO_NODE_NUM) fail("radio's node number not captured", app.myNodeNum);
+    if (app.nodes.count(RADIO_NODE_NUM) == 0) fail("radio's own node not reported", app.nodes.size());
+    if (app.nodes.size() != radio.dump.otherNodes.size() + 1) fail("node report incomplete", app.nodes.size());
+    if (app.connectedAt == 0 || r.connectedFlagMs > r.flowMs) fail("connected flag not set by the dump", fast);
+    if (r.flowMs == 0 || r.firstPacketMs < r.flowMs) fail("packet delivered before config_complete_id", r.firstPacketMs);
+    if (app.firstPacketAt == 0 || app.firstPacketAt - start != r.firstPacketMs) {
+        fail("first_packet_ms differs from the first delivery", r.firstPacketMs);
+    }
+    if (fast) {
+        if (app.nodesAtDone != 1) fail("fast handshake reported other nodes before MT_NR_DONE", app.nodesAtDone);
+        if (r.nodeDbMs <= r.firstPacketMs) fail("node db asked for before packets flowed", r.nodeDbMs);
+        if (radio.wantConfigs != wantConfigsBefore + 2) fail("node db not asked for once", radio.wantConfigs);
+        if (app.metadataCalls != 0) fail("skipped variant reached the application", app.metadataCalls);
+        if (r.skipped != radio.dump.skippable) fail("skipped variants miscounted", r.skipped);
+    } else {
+        if (r.nodeDbMs != 0) fail("upstream handshake asked for the node db again", r.nodeDbMs);
+        if (app.metadataCalls != 1) fail("metadata not handled upstream", app.metadataCalls);
+        if (r.skipped != 0) fail("upstream handshake skipped variants", r.skipped);
+    }
+
+    // A link probe once connected (GcmLinkMonitor): answered, and no second MT_NR_DONE.
+    // The radio holds traffic during its dump too; then the mesh goes quiet to drain.
+    mt_rx_stats_t beforeProbe;
+    mt_get_rx_stats(&beforeProbe);
+    if (!mt_send_config_probe()) fail("probe not sent", 0);
+    runUntil(clock, clock + 3000);
+    radio.quiet = true;
+    runUntil(clock, clock + 3000);
+    mt_rx_stats_t afterProbe;
+    mt_get_rx_stats(&afterProbe);
+    if (afterProbe.config_completes != beforeProbe.config_completes + 1) fail("probe unanswered", fast);
+    if (app.doneCalls != 1) fail("probe reply ended the report again", app.doneCalls);
+    if (app.lastPacketId != radio.packetId || app.outOfOrder != 0) fail("held packets lost or reordered", app.packets);
+    clock += 1000;
+    return r;
+}
+
+// Host CPU to decode one dump's frames, with and without the skip mask
+static double decodeUs(uint32_t skip) {
+    static meshtastic_FromRadio msg;
+    static mt_packet_t packet;
+    std::vector<const std::vector<uint8_t>*> frames;
+    for (const auto* list : {&radio.dump.myInfo, &radio.dump.ownNode, &radio.dump.config, &radio.dump.otherNodes,
+                             &radio.dump.files}) {
+        for (const std::vector<uint8_t>& f : *list) frames.push_back(&f);
+    }
+    const int reps = 200;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < reps; rep++) {
+        for (const std::vector<uint8_t>* f : frames) {
+            uint8_t* payload;
+            pb_istream_t stream = pb_istream_from_buffer(f->data() + MT_HEADER_SIZE, f->size() - MT_HEADER_SIZE);
+            if (!mt_decode_from_radio(&stream, &msg, &packet, NULL, &payload, skip)) fail("dump frame undecodable", 0);
+        }
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+}
+
+int main(int argc, char** argv) {
+    uint32_t nodes = 40;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            nodes = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n nodes] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    srand(seed);
+    Serial.quiet = true;
+    mt_serial_mode = true;  // As mt_serial_init() leaves it
+    set_packet_sink(payloadReserve, packetDeliver);
+    uint32_t clock = 1000;
+
+    printf("\n=== Meshtastic handshake bench (radio with %u other nodes, 9600 baud, seed %u) ===\n", nodes, seed);
+    buildDump(nodes);
+    Result full = handshake(false, clock);
+    Result fast = handshake(true, clock);
+
+    size_t configBytes = 0;
+    for (const std::vector<uint8_t>& f : radio.dump.config) configBytes += f.size();
+    size_t nodeBytes = 0;
+    for (const std::vector<uint8_t>& f : radio.dump.otherNodes) nodeBytes += f.size();
+    printf("Dump:      %zu settings frames (%zu bytes), %u other nodes (%zu bytes), a packet every %d ms\n",
+           radio.dump.config.size(), configBytes, nodes, nodeBytes, MESH_PACKET_EVERY_MS);
+    printf("Upstream:  connected flag at %u ms, packets flow at %u ms, first delivered at %u ms, "
+           "%u nodes known at %d s, %u wire bytes\n",
+           full.connectedFlagMs, full.flowMs, full.firstPacketMs, full.knownNodes, KNOWN_AFTER_MS / 1000, full.wireBytes);
+    printf("Fast:      connected flag at %u ms, packets flow at %u ms, first delivered at %u ms, node db in at %u ms, "
+           "%u nodes known at %d s, %u wire bytes, %u variants skipped\n",
+           fast.connectedFlagMs, fast.flowMs, fast.firstPacketMs, fast.nodeDbMs, fast.knownNodes,
+           KNOWN_AFTER_MS / 1000, fast.wireBytes, fast.skipped);
+    printf("Speedup:   %.1fx to the first packet (connected flag %+d ms)\n",
+           fast.firstPacketMs ? (double)full.firstPacketMs / fast.firstPacketMs : 0,
+           (int)fast.connectedFlagMs - (int)full.connectedFlagMs);
+    printf("Decode:    %.1f us per dump upstream, %.1f us skipping (host CPU)\n", decodeUs(0),
+           decodeUs(MT_FAST_HANDSHAKE_SKIP));
+    if (nodes >= 10 && fast.firstPacketMs * 2 > full.firstPacketMs) {
+        fail("fast handshake not twice as fast to the first packet", fast.firstPacketMs);
+    }
+
+    printf("\nOther nodes  first packet ms (upstream / fast)  nodes known at %d s (upstream / fast)\n",
+           KNOWN_AFTER_MS / 1000);
+    for (uint32_t n : {0u, 10u, 20u, 40u, 80u}) {
+        buildDump(n);
+        Result a = handshake(false, clock);
+        Result b = handshake(true, clock);
+        printf("%11u  %15u / %u  %26u / %u\n", n, a.firstPacketMs, b.firstPacketMs, a.knownNodes, b.knownNodes);
+    }
+
+    return benchResult();
+}
@@ -0,0 +1,260 @@
+/********************************************************************************************
+*    GCD Node Table Bench - host-side (Linux) test of the bounded mesh node table           *
+*                                                                                           *
+*    500 simulated nodes (a few dozen busy carts, the rest rarely heard) report positions,  *
+*    device metrics and node info within a few kilometres of a course, on a simulated       *
+*    millisecond clock, into NodeTable (utils/node_table.cpp, the firmware source). A plain *
+*    std::map of every node is kept alongside as the reference.                             *
+*                                                                                           *
+*    Usage:                                                                                 *
+*    1. pio run -e native_nodetable                                                         *
+*    2. .pio/build/native_nodetable/program [-n N] [-u updates] [-s seed]                   *
+*         -n  simulated nodes (default 500), -u updates (default 200000),                   *
+*         -s  random seed (default 1)                                                       *
+*                                                                                           *
+*    Checks: the table never holds more than NODE_TABLE_MAX_NODES and always holds exactly  *
+*    the most recently heard ones, with the latest position, battery and airtime of each    *
+*    (so evictions and run shifts never lose an entry); nearest() returns the same nodes,   *
+*    in the same order, as a brute-force sort of the reference; and no update or query      *
+*    allocates. Reports update and query times and the longest probe. Exits 1 on failure.   *
+*                                                                                           *
+********************************************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include "bench_check.h"
+#include "utils/node_table.h"
+
+#define BUSY_NODES 40                    // Carts heard every few seconds
+#define BUSY_SHARE 80                    // Percent of updates from busy nodes
+#define COURSE_LAT 289300000             // Degrees * 1e7
+#define COURSE_LON -819700000
+#define COURSE_SPREAD 300000             // About 3 km either way
+#define CHECK_EVERY 97                   // Updates between full reference checks
+#define QUERY_N 5
+
+struct RefNode {
+    uint32_t lastHeardMs;
+    int32_t lat, lon;
+    bool hasPosition;
+    uint8_t battery;
+    float chUtil, airUtil;
+};
+
+struct Sim {
+    std::vector<uint32_t> nums;
+    std::vector<int32_t> lat, lon;
+    std::map<uint32_t, RefNode> ref;   // Every node heard; fields of evicted ones are stale
+    std::vector<uint32_t> kept;        // What the table should hold, least recently heard first
+};
+
+// Reference LRU: num was just heard
+static RefNode& heardRef(Sim& sim, uint32_t num, uint32_t now) {
+    auto it = std::find(sim.kept.begin(), sim.kept.end(), num);
+    if (it != sim.kept.end()) {
+        sim.kept.erase(it);
+    } else {
+        if (sim.kept.size() == NODE_TABLE_MAX_NODES) sim.kept.erase(sim.kept.begin());
+        RefNode fresh = {};
+        fresh.chUtil = fresh.airUtil = NAN;  // Re-added after an eviction: starts empty
+        sim.ref[num] = fresh;
+    }
+    sim.kept.push_back(num);
+    RefNode& r = sim.ref[num];
+    r.lastHeardMs = now;
+    return r;
+}
+
+static uint32_t pick(const Sim& sim) {
+    size_t busy = std::min<size_t>(BUSY_NODES, sim.nums.size());
+    if ((size_t)(rand() % 100) < BUSY_SHARE && busy > 0) return rand() % busy;
+    return rand() % sim.nums.size();
+}
+
+static bool sameFloat(float a, float b) {
+    return (isnan(a) && isnan(b)) || a == b;
+}
+
+static void checkContents(const NodeTable& table, const Sim& sim, uint32_t step) {
+    if (table.size() != sim.kept.size()) fail("table size differs from the reference", step);
+    for (uint32_t num : sim.kept) {
+        NodeTable::Node n;
+        if (!table.get(num, n)) {
+            fail("recently heard node missing", num);
+            continue;
+        }
+        const RefNode& r = sim.ref.at(num);
+        if (n.lastHeardMs != r.lastHeardMs || n.hasPosition != r.hasPosition || n.batteryLevel != r.battery ||
+            !sameFloat(n.channelUtilization, r.chUtil) || !sameFloat(n.airUtilTx, r.airUtil) ||
+            (r.hasPosition && (n.latitudeI != r.lat || n.longitudeI != r.lon))) {
+            fail("node fields differ from the reference", num);
+        }
+    }
+}
+
+static void checkNearest(const NodeTable& table, const Sim& sim, uint32_t now, int32_t lat, int32_t lon,
+                         uint32_t maxAgeMs, uint32_t exclude) {
+    NodeTable::Nearby got[QUERY_N];
+    size_t n = table.nearest(lat, lon, now, maxAgeMs, exclude, got, QUERY_N);
+
+    std::vector<std::pair<uint32_t, uint32_t>> want;  // (distance, num)
+    for (uint32_t num : sim.kept) {
+        const RefNode& r = sim.ref.at(num);
+        if (!r.hasPosition || num == exclude || now - r.lastHeardMs > maxAgeMs) continue;
+        want.push_back({NodeTable::distanceM(lat, lon, r.lat, r.lon), num});
+    }
+    std::sort(want.begin(), want.end());
+    if (n != std::min<size_t>(QUERY_N, want.size())) {
+        fail("nearest() returned the wrong count", n);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        // Nodes at the same (whole metre) distance may come in either order
+        bool eligible = std::find(want.begin(), want.end(), std::make_pair(got[i].distanceM, got[i].num)) != want.end();
+        if (got[i].distanceM != want[i].first || !eligible) {
+            fail("nearest() order differs from brute force", got[i].num);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t nodes = 500;
+    uint32_t updates = 200000;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            nodes = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+            updates = strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [-n nodes] [-u updates] [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (nodes == 0) {
+        fprintf(stderr, "need at least one node\n");
+        return 1;
+    }
+
+    srand(seed);
+    printf("\n=== Node table bench (%u nodes, %u slots, %u kept, seed %u) ===\n", nodes, NODE_TABLE_SLOTS,
+           NODE_TABLE_MAX_NODES, seed);
+
+    Sim sim;
+    for (uint32_t i = 0; i < nodes; i++) {
+        // Node numbers as radios make them: mostly a shared prefix, low bytes from the MAC
+        sim.nums.push_back(0xDA000000u | (uint32_t)(rand() & 0xFFFFFF));
+        sim.lat.push_back(COURSE_LAT + rand() % (2 * COURSE_SPREAD) - COURSE_SPREAD);
+        sim.lon.push_back(COURSE_LON + rand() % (2 * COURSE_SPREAD) - COURSE_SPREAD);
+    }
+    std::sort(sim.nums.begin(), sim.nums.end());
+    sim.nums.erase(std::unique(sim.nums.begin(), sim.nums.end()), sim.nums.end());
+    std::random_shuffle(sim.nums.begin(), sim.nums.end());
+
+    static NodeTable table;
+    typedef std::chrono::steady_clock clk;
+    double updateNs = 0;
+    double queryNs = 0;
+    uint32_t queries = 0;
+    size_t heapDuringTable = 0;  // Heap use inside the timed sections would show up here
+    uint32_t now = 1000;
+    benchCountAllocs = true;
+
+    for (uint32_t u = 0; u < updates; u++) {
+        now += 1 + rand() % 200;
+        uint32_t i = pick(sim);
+        uint32_t num = sim.nums[i];
+        RefNode& r = heardRef(sim, num, now);  // May allocate: outside the timed section
+
+        // Carts wander a few metres per report
+        sim.lat[i] += rand() % 201 - 100;
+        sim.lon[i] += rand() % 201 - 100;
+        int kind = rand() % 4;
+        uint8_t battery = 1 + rand() % 101;
+        float chUtil = (rand() % 1000) / 10.0f;
+        float airUtil = (rand() % 100) / 10.0f;
+
+        size_t before = benchAllocs;
+        clk::time_point t0 = clk::now();
+        if (kind == 0) {
+            table.heard(num, now);
+        } else if (kind == 1) {
+            table.metrics(num, battery, chUtil, airUtil, now);
+        } else {
+            table.position(num, sim.lat[i], sim.lon[i], now);
+        }
+        updateNs += std::chrono::duration<double, std::nano>(clk::now() - t0).count();
+        heapDuringTable += benchAllocs - before;
+
+        if (kind == 1) {
+            r.battery = battery;
+            r.chUtil = chUtil;
+            r.airUtil = airUtil;
+        } else if (kind != 0) {
+            r.hasPosition = true;
+            r.lat = sim.lat[i];
+            r.lon = sim.lon[i];
+        }
+        if (table.size() > NODE_TABLE_MAX_NODES) fail("table over capacity", u);
+
+        if (u % CHECK_EVERY == 0) {
+            checkContents(table, sim, u);
+            uint32_t self = sim.nums[rand() % sim.nums.size()];
+            int32_t lat = COURSE_LAT + rand() % (2 * COURSE_SPREAD) - COURSE_SPREAD;
+            int32_t lon = COURSE_LON + rand() % (2 * COURSE_SPREAD) - COURSE_SPREAD;
+            uint32_t maxAge = (u & 1) ? NODE_NEAREST_MAX_AGE_MS : 20000;
+
+            NodeTable::Nearby out[QUERY_N];
+            before = benchAllocs;
+            t0 = clk::now();
+            table.nearest(lat, lon, now, maxAge, self, out, QUERY_N);
+            queryNs += std::chrono::duration<double, std::nano>(clk::now() - t0).count();
+            heapDuringTable += benchAllocs - before;
+            queries++;
+            checkNearest(table, sim, now, lat, lon, maxAge, self);
+        }
+    }
+    checkContents(table, sim, updates);
+    if (heapDuringTable != 0) fail("table allocated", heapDuringTable);
+
+    // Node reports: an old last_heard must not make a node look fresh, nor one without GPS time
+    NodeTable reports;
+    const uint32_t reportMs = 5000000, utc = 1800000000;
+    NodeTable::Node node;
+    reports.reported(101, utc - 3600, utc, reportMs);
+    reports.position(101, COURSE_LAT, COURSE_LON, reportMs, false);
+    if (!reports.get(101, node) || reportMs - node.lastHeardMs != 3600000) fail("report age not from last_heard", 101);
+    reports.reported(102, utc - 60, 0, reportMs);
+    reports.metrics(102, 80, NAN, NAN, reportMs, false);
+    if (!reports.get(102, node) || reportMs - node.lastHeardMs != NODE_REPORT_MAX_AGE_MS) {
+        fail("report without GPS time marked heard", 102);
+    }
+    reports.heard(103, reportMs - 1000);
+    reports.reported(103, utc - 3600, utc, reportMs);
+    if (!reports.get(103, node) || reportMs - node.lastHeardMs != 1000) fail("stale report refreshed a heard node", 103);
+    NodeTable::Nearby near[NODE_NEAREST_MAX];
+    if (reports.nearest(COURSE_LAT, COURSE_LON, reportMs, NODE_NEAREST_MAX_AGE_MS, 0, near, NODE_NEAREST_MAX) != 0) {
+        fail("node from an hour-old report is nearby", 101);
+    }
+
+    // Distance sanity: 0.01 degree of latitude is about 1112 m
+    uint32_t d = NodeTable::distanceM(COURSE_LAT, COURSE_LON, COURSE_LAT + 100000, COURSE_LON);
+    if (d < 1105 || d > 1118) fail("distance scale wrong", d);
+
+    printf("Updates:   %u (%zu distinct nodes heard), avg %.0f ns\n", updates, sim.ref.size(), updateNs / updates);
+    printf("Queries:   %u nearest(%d), avg %.0f ns\n", queries, QUERY_N, queries ? queryNs / queries : 0);
+    printf("Table:     %zu nodes, %u evicted, longest probe %u, %zu bytes\n", table.size(), table.evicted(),
+           table.longestProbe(), sizeof(NodeTable));
+    printf("Heap:      %zu allocations inside the table\n", heapDuringTable);
+    return benchResult();
+}
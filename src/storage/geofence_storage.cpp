@@ -0,0 +1,115 @@
+#include "geofence_storage.h"
+#include <LittleFS.h>
+#include "utils/geofence.h"
+
+#define GEOFENCE_FILE "/geofences.bin"
+#define GEOFENCE_FILE_MAGIC 0x47464E43UL  // "GFNC"
+#define GEOFENCE_FILE_VERSION 1
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t fenceCount;
+    uint16_t vertexCount;
+    uint16_t recordSize;    // sizeof(geofence_t), guards against layout changes
+} geofenceFileHeader_t;
+
+static bool mountFs() {
+    static bool mounted = false;
+    if (!mounted) {
+        // Format on first use - the partition has never held a filesystem
+        mounted = LittleFS.begin(true);
+        if (!mounted) {
+            Serial.println("Geofence: LittleFS mount failed");
+        }
+    }
+    return mounted;
+}
+
+bool loadGeofences() {
+    if (!mountFs()) return false;
+
+    if (!LittleFS.exists(GEOFENCE_FILE)) {
+        Serial.println("> No geofences stored");
+        return true;
+    }
+
+    File file = LittleFS.open(GEOFENCE_FILE, "r");
+    if (!file) {
+        Serial.println("Geofence: cannot open " GEOFENCE_FILE);
+        return false;
+    }
+
+    geofenceFileHeader_t header;
+    bool ok = file.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              header.magic == GEOFENCE_FILE_MAGIC &&
+              header.version == GEOFENCE_FILE_VERSION &&
+              header.recordSize == sizeof(geofence_t) &&
+              header.fenceCount <= GEOFENCE_MAX_FENCES &&
+              header.vertexCount <= GEOFENCE_MAX_VERTICES;
+
+    // Size the tables for exactly what is stored; adding fences later grows them
+    if (ok) {
+        ok = geofences.reserve(header.fenceCount, header.vertexCount);
+    }
+
+    if (ok) {
+        size_t vertexBytes = header.vertexCount * sizeof(geoPoint_t);
+        size_t fenceBytes = header.fenceCount * sizeof(geofence_t);
+        ok = file.read((uint8_t*)geofences.vertexPool(), vertexBytes) == vertexBytes &&
+             file.read((uint8_t*)geofences.fenceTable(), fenceBytes) == fenceBytes;
+    }
+    file.close();
+
+    // restored() validates every record and clears the table if any is bad
+    if (!ok || !geofences.restored(header.fenceCount, header.vertexCount)) {
+        Serial.println("Geofence: stored table invalid, ignoring");
+        geofences.clear();
+        return false;
+    }
+
+    Serial.print("> geofences read from flash = ");
+    Serial.println(geofences.count());
+    return true;
+}
+
+bool saveGeofences() {
+    if (!mountFs()) return false;
+
+    geofenceFileHeader_t header;
+    header.magic = GEOFENCE_FILE_MAGIC;
+    header.version = GEOFENCE_FILE_VERSION;
+    header.fenceCount = geofences.count();
+    header.vertexCount = geofences.vertexCount();
+    header.recordSize = sizeof(geofence_t);
+
+    // Write to a temp file and rename so a reset mid-write keeps the old table
+    File file = LittleFS.open(GEOFENCE_FILE ".tmp", "w");
+    if (!file) {
+        Serial.println("Geofence: cannot create " GEOFENCE_FILE);
+        return false;
+    }
+
+    size_t vertexBytes = header.vertexCount * sizeof(geoPoint_t);
+    size_t fenceBytes = header.fenceCount * sizeof(geofence_t);
+    bool ok = file.write((const uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+              file.write((const uint8_t*)geofences.vertexPool(), vertexBytes) == vertexBytes &&
+              file.write((const uint8_t*)geofences.fenceTable(), fenceBytes) == fenceBytes;
+    file.close();
+
+    if (!ok) {
+        Serial.println("Geofence: write failed");
+        LittleFS.remove(GEOFENCE_FILE ".tmp");
+        return false;
+    }
+
+    LittleFS.remove(GEOFENCE_FILE);
+    if (!LittleFS.rename(GEOFENCE_FILE ".tmp", GEOFENCE_FILE)) {
+        Serial.println("Geofence: rename failed");
+        return false;
+    }
+
+    Serial.print("Geofences saved: ");
+    Serial.println(header.fenceCount);
+    return true;
+}
@@ -0,0 +1,19 @@
+#ifndef GEOFENCE_STORAGE_H
+#define GEOFENCE_STORAGE_H
+
+#include <Arduino.h>
+
+/**
+ * Geofence persistence - the engine's tables are written as one binary file
+ * (GEOFENCE_FILE) on the LittleFS "spiffs" partition, which is otherwise unused
+ * by huge_app.csv. NVS is not used: a full table is far larger than its
+ * per-entry limit.
+ */
+
+// Read the stored table into the engine, allocating only what it holds (boot)
+bool loadGeofences();
+
+// Write the engine's table; called after a geofence hot packet changes it
+bool saveGeofences();
+
+#endif // GEOFENCE_STORAGE_H
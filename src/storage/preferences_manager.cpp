@@ -2,6 +2,7 @@
 #include "config.h"
 #include "globals.h"
 #include "types.h"
+#include "utils/odometer.h"
 
 void initPreferences() {
     prefs.begin("eeprom", false);
@@ -41,13 +42,22 @@ void loadPreferences() {
     set_var_speaker_volume(speaker_volume);
     old_speaker_volume = speaker_volume;
 
-    accum_distance = prefs.getFloat("accumDistance", 0.0);
+    // Distance totals are kept in millimetres; older firmware saved float miles
+    uint64_t savedTotalMm = prefs.getULong64("accumDistMm", UINT64_MAX);
+    if (savedTotalMm == UINT64_MAX) {
+        savedTotalMm = odometerMilesToMm(prefs.getFloat("accumDistance", 0.0));
+    }
+    uint64_t savedTripMm = prefs.getULong64("tripDistMm", UINT64_MAX);
+    if (savedTripMm == UINT64_MAX) {
+        savedTripMm = odometerMilesToMm(prefs.getFloat("tripDistance", 0.0));
+    }
+    odometerRestore(savedTotalMm, savedTripMm);  // Sets accum_distance and trip_distance
+
     Serial.print("> accum_distance read from eeprom = ");
     Serial.println(accum_distance, 3);
     odometer = String(accum_distance, 1);
     set_var_odometer(odometer.c_str());
 
-    trip_distance = prefs.getFloat("tripDistance", 0.0);
     Serial.print("> trip_distance read from eeprom = ");
     Serial.println(trip_distance, 3);
     trip_odometer = String(trip_distance, 1);
@@ -147,6 +157,14 @@ void queuePreferenceWrite(const char* key, bool value) {
     xQueueSend(eepromWriteQueue, &item, 0);
 }
 
+void queuePreferenceWrite(const char* key, uint64_t value) {
+    eepromWriteItem_t item;
+    item.type = EEPROM_U64;
+    strcpy(item.key, key);
+    item.value.u64Val = value;
+    xQueueSend(eepromWriteQueue, &item, 0);
+}
+
 void clearAllPreferences() {
     Serial.println("Clearing all EEPROM preferences...");
     prefs.clear();
@@ -10,5 +10,6 @@ void queuePreferenceWrite(const char* key, float value);
 void queuePreferenceWrite(const char* key, int value);
 void queuePreferenceWrite(const char* key, const String& value);
 void queuePreferenceWrite(const char* key, bool value);
+void queuePreferenceWrite(const char* key, uint64_t value);
 
 #endif // PREFERENCES_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "track_log.h"
+#include <esp_partition.h>
+#include "config.h"
+
+#define TRACK_PARTITION_LABEL "track"
+#define TRACK_SECTOR_SIZE 4096          // SPI flash erase unit
+#define TRACK_PAGES_PER_SECTOR (TRACK_SECTOR_SIZE / TRACK_PAGE_SIZE)
+#define TRACK_SEQ_ERASED 0xFFFFFFFFUL
+
+static const esp_partition_t* trackPartition = NULL;
+static uint32_t pageCount = 0;
+static uint32_t nextPage = 0;       // Page index the next write goes to
+static uint32_t nextSequence = 1;
+static uint32_t pagesWritten = 0;
+static uint32_t sectorsErased = 0;
+
+static uint32_t readSequence(uint32_t pageIndex) {
+    uint32_t seq = TRACK_SEQ_ERASED;
+    esp_partition_read(trackPartition, pageIndex * TRACK_PAGE_SIZE, &seq, sizeof(seq));
+    return seq;
+}
+
+bool initTrackLog() {
+    trackPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                              (esp_partition_subtype_t)TRACK_PARTITION_SUBTYPE,
+                                              TRACK_PARTITION_LABEL);
+    if (trackPartition == NULL) {
+        Serial.println("Track: no \"track\" partition - recording disabled");
+        return false;
+    }
+    pageCount = trackPartition->size / TRACK_PAGE_SIZE;
+
+    // Resume after the newest page
+    bool found = false;
+    uint32_t newestSeq = 0;
+    uint32_t newestPage = 0;
+    uint32_t usedPages = 0;
+    for (uint32_t i = 0; i < pageCount; i++) {
+        uint32_t seq = readSequence(i);
+        if (seq == TRACK_SEQ_ERASED) continue;
+        usedPages++;
+        if (!found || seq > newestSeq) {
+            newestSeq = seq;
+            newestPage = i;
+            found = true;
+        }
+    }
+    nextPage = found ? (newestPage + 1) % pageCount : 0;
+    nextSequence = found ? newestSeq + 1 : 1;
+
+    Serial.print("> Track log: ");
+    Serial.print(usedPages);
+    Serial.print("/");
+    Serial.print(pageCount);
+    Serial.println(" pages used");
+    return true;
+}
+
+bool writeTrackPage(const trackPage_t& page) {
+    if (trackPartition == NULL || page.length > TRACK_PAGE_PAYLOAD) return false;
+
+    // A page left programmed mid-sector (power lost during an erase) - move on to the next sector
+    if (nextPage % TRACK_PAGES_PER_SECTOR != 0 && readSequence(nextPage) != TRACK_SEQ_ERASED) {
+        nextPage = (nextPage / TRACK_PAGES_PER_SECTOR + 1) * TRACK_PAGES_PER_SECTOR % pageCount;
+    }
+
+    uint32_t offset = nextPage * TRACK_PAGE_SIZE;
+    if (nextPage % TRACK_PAGES_PER_SECTOR == 0) {
+        if (esp_partition_erase_range(trackPartition, offset, TRACK_SECTOR_SIZE) != ESP_OK) {
+            Serial.println("Track: sector erase failed");
+            return false;
+        }
+        sectorsErased++;
+    }
+
+    // Only the used bytes are programmed; the rest of the page stays erased (0xFF ends the payload)
+    uint8_t buf[TRACK_PAGE_SIZE];
+    memcpy(buf, &nextSequence, TRACK_PAGE_HEADER_SIZE);
+    memcpy(buf + TRACK_PAGE_HEADER_SIZE, page.payload, page.length);
+    if (esp_partition_write(trackPartition, offset, buf, TRACK_PAGE_HEADER_SIZE + page.length) != ESP_OK) {
+        Serial.println("Track: page write failed");
+        return false;
+    }
+
+    nextPage = (nextPage + 1) % pageCount;
+    nextSequence++;
+    pagesWritten++;
+    return true;
+}
+
+void exportTrackLog() {
+    if (trackPartition == NULL) {
+        Serial.println("TRK,END");
+        return;
+    }
+
+    uint32_t stored = 0;
+    for (uint32_t i = 0; i < pageCount; i++) {
+        if (readSequence(i) != TRACK_SEQ_ERASED) stored++;
+    }
+    Serial.print("TRK,BEGIN,");
+    Serial.println(stored);
+
+    // Oldest page follows the write position
+    uint8_t buf[TRACK_PAGE_SIZE];
+    char hex[3];
+    for (uint32_t n = 0; n < pageCount; n++) {
+        uint32_t idx = (nextPage + n) % pageCount;
+        if (esp_partition_read(trackPartition, idx * TRACK_PAGE_SIZE, buf, sizeof(buf)) != ESP_OK) continue;
+
+        uint32_t seq;
+        memcpy(&seq, buf, sizeof(seq));
+        if (seq == TRACK_SEQ_ERASED) continue;
+
+        // Trim the erased tail
+        uint16_t len = TRACK_PAGE_SIZE;
+        while (len > TRACK_PAGE_HEADER_SIZE && buf[len - 1] == 0xFF) len--;
+
+        Serial.print("TRK,");
+        Serial.print(seq);
+        Serial.print(",");
+        for (uint16_t i = TRACK_PAGE_HEADER_SIZE; i < len; i++) {
+            snprintf(hex, sizeof(hex), "%02X", buf[i]);
+            Serial.print(hex);
+        }
+        Serial.println();
+    }
+    Serial.println("TRK,END");
+}
+
+uint32_t getTrackPagesWritten() {
+    return pagesWritten;
+}
+
+uint32_t getTrackSectorsErased() {
+    return sectorsErased;
+}
@@ -0,0 +1,36 @@
+#ifndef TRACK_LOG_H
+#define TRACK_LOG_H
+
+#include <Arduino.h>
+#include "utils/track_codec.h"
+
+/**
+ * Breadcrumb track log on the raw "track" flash partition
+ *
+ * The partition is a circular log of TRACK_PAGE_SIZE pages, each a uint32_t
+ * sequence number followed by a track_codec payload. Writing moves forward
+ * one page at a time and erases the next 4 KB sector just before entering
+ * it, so every sector is erased once per lap of the partition (even wear)
+ * and the oldest track is the first to go. At boot the page with the
+ * highest sequence number marks where writing resumes.
+ *
+ * Only the track task calls these (flash writes and erases stall the
+ * caller, never gpsTask).
+ */
+
+// Locate the partition and the write position; false disables recording
+bool initTrackLog();
+
+// Append one page (erasing the next sector when the write crosses into it)
+bool writeTrackPage(const trackPage_t& page);
+
+// Stream every stored page, oldest first, to the debug port as
+//   TRK,BEGIN,<pages>   TRK,<sequence>,<payload hex>   TRK,END
+// gps_replay -d decodes a capture of this into CSV
+void exportTrackLog();
+
+// Pages written / sectors erased since boot
+uint32_t getTrackPagesWritten();
+uint32_t getTrackSectorsErased();
+
+#endif // TRACK_LOG_H
@@ -60,6 +60,12 @@ void eepromTask(void *parameter) {
                         Serial.print(" saved to eeprom: ");
                         Serial.println(item.value.boolVal ? "true" : "false");
                         break;
+
+                    case EEPROM_U64:
+                        prefs.putULong64(item.key, item.value.u64Val);
+                        Serial.printf("> %s saved to eeprom: %llu\n", item.key,
+                                      (unsigned long long)item.value.u64Val);
+                        break;
                 }
                 xSemaphoreGive(eepromMutex);
             }
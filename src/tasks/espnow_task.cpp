@@ -170,26 +170,31 @@ void espnowTask(void *parameter) {
             
             // Send GPS data periodically if available
             if (now - lastGPSSend > ESPNOW_GPS_SEND_INTERVAL) {
-                if (xSemaphoreTake(gpsMutex, pdMS_TO_TICKS(100))) {
-                    if (latitude.length() > 0 && longitude.length() > 0) {
-                        lastGPSSend = now;
-
-                        // Pack GPS data as JSON-like string
-                        String gpsData = "{\"lat\":\"" + latitude +
-                                       "\",\"lon\":\"" + longitude +
-                                       "\",\"alt\":\"" + altitude +
-                                       "\",\"spd\":" + String(avg_speed_calc) +  // Use float version for accuracy
-                                       ",\"hdg\":\"" + heading +
-                                       "\",\"sats\":\"" + sats_hdop + "\"}";
-
-                        espNow.broadcast(ESPNOW_MSG_GPS_DATA,
-                                       (uint8_t*)gpsData.c_str(), gpsData.length());
-
-                        #if DEBUG_ESPNOW == 1
-                        Serial.println("ESP-NOW: GPS data sent");
-                        #endif
+                GpsSnapshot snap;
+                gpsSnapshot.read(snap);
+                if (snap.locationValid) {
+                    lastGPSSend = now;
+
+                    char alt[16] = "";
+                    if (snap.altitudeValid) {
+                        snprintf(alt, sizeof(alt), "%.2f", snap.altitude_cm / 100.0);
                     }
-                    xSemaphoreGive(gpsMutex);
+
+                    // Pack GPS data as JSON-like string (same fields/format as the display strings)
+                    char gpsData[160];
+                    int len = snprintf(gpsData, sizeof(gpsData),
+                                       "{\"lat\":\"%.6f\",\"lon\":\"%.6f\",\"alt\":\"%s\",\"spd\":%.2f,"
+                                       "\"hdg\":\"%s\",\"sats\":\"%u/%.2f\"}",
+                                       snap.lat / 1e7, snap.lon / 1e7,
+                                       alt,
+                                       snap.speed_cmph / 100.0, snap.headingValid ? snap.compass : "",
+                                       (unsigned)snap.satellites, snap.hdop_x100 / 100.0);
+
+                    espNow.broadcast(ESPNOW_MSG_GPS_DATA, (uint8_t*)gpsData, len);
+
+                    #if DEBUG_ESPNOW == 1
+                    Serial.println("ESP-NOW: GPS data sent");
+                    #endif
                 }
             }
         }
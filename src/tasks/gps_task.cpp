@@ -2,7 +2,13 @@
 #include "config.h"
 #include "globals.h"
 #include "utils/time_utils.h"
+#include "utils/format_utils.h"
+#include "utils/odometer.h"
+#include "utils/speed_filter.h"
+#include "utils/geofence.h"
+#include "utils/gps_health.h"
 #include "hardware/display.h"
+#include "hardware/gps_transport.h"
 #include "storage/preferences_manager.h"
 #include <TimeLib.h>
 
@@ -20,25 +26,8 @@ static const char* headingToCompass(float degrees) {
     return COMPASS_DIRECTIONS[index];
 }
 
-// Previous speed for stop detection
-static float previousSpeed = 0.0;
-
-// Previous location for position-based distance calculation
-static NeoGPS::Location_t lastLocation;
-static bool hasLastLocation = false;
-
-// Distance tracking for periodic EEPROM saves
-static float lastSavedAccumDistance = 0.0;
-static float lastSavedTripDistance = 0.0;
-static const float SAVE_INTERVAL_MILES = 0.5;  // Save every 0.5 miles
-
-// Hour tracking for service reminder (hybrid GPS/millis() with fallback)
-static time_t lastMovementGpsTime = 0;      // GPS time_t of last movement (UTC seconds since epoch)
-static unsigned long lastMovementMillis = 0; // millis() backup when GPS unavailable
-static bool hoursTrackingInitialized = false;  // Flag to initialize from hrs_since_svc on first use
-static int32_t lastSavedHrsSinceSvc = 0;
-static const int32_t SAVE_INTERVAL_HOURS = 1;  // Save every 1 hour
-static int32_t remainderSeconds = 0;  // Accumulator for sub-tenth hour precision
+// Fused speed estimator / stationary detector
+static SpeedFilter speedFilter;
 
 // Satellite count persistence - filter brief dropouts
 static uint8_t lastValidSatCount = 0;
@@ -48,37 +37,30 @@ static const uint8_t ZERO_SAT_THRESHOLD = 3;  // Require 3 consecutive zero read
 // Track at_home state changes
 static bool old_at_home = false;
 
-/**
- * Update speed from GPS fix
- * When speed is valid, use it (with dither filtering).
- * When speed is invalid but location is valid, assume stationary (speed = 0).
- * Uses aggressive zero-out when speed is low and decreasing to improve stop response.
- */
-static void updateSpeed(const gps_fix& fix) {
-    if (fix.valid.speed) {
-        float speedMph = fix.speed_mph();
+// Today's sunrise/sunset (local time), recalculated when the day changes
+static time_t sunrise_t = 0;
+static time_t sunset_t = 0;
 
-        // Filter out GPS dither when stationary
-        if (speedMph < MIN_SPEED_FILTER_MPH) {
-            speedMph = 0.0;
-        }
-        // Aggressive stop detection: if speed is low (<4 mph) and decreasing, zero out
-        else if (speedMph < 4.0 && speedMph < previousSpeed) {
-            speedMph = 0.0;
-        }
+// Last values written to the display buffers - fields are only reformatted when these change
+static int32_t shownDateKey = -1;       // localYear * 10000 + localMonth * 100 + localDay
+static int32_t shownMinuteKey = -1;     // localHour * 60 + localMinute
+static int32_t shownSecond = -1;
+static int32_t shownLat = INT32_MIN;    // Degrees * 1e6 (display precision)
+static int32_t shownLon = INT32_MIN;
+static int32_t shownAltitudeCm = INT32_MIN;
+static int32_t shownSatsHdop = -1;      // satellites * 100000 + hdop * 100
 
-        previousSpeed = fix.speed_mph();  // Store raw GPS speed for comparison
-        avg_speed_calc = speedMph;
-        avg_speed = (int32_t)avg_speed_calc;
-    }
-    // If speed invalid but we were stopped or slowing down - can assume still stopped/stopping
-    else if (fix.valid.location && avg_speed_calc < 5.0) {
-        // Only zero speed if we were already slow - retain speed if cruising
-        avg_speed_calc = 0.0;
-        avg_speed = 0;
-        previousSpeed = 0.0;
-    }
-    // Otherwise retain last known speed when invalid (e.g., cruising at 5+ mph)
+// Working copy of the published snapshot (keeps last known values between fixes)
+static GpsSnapshot snapshot = {};
+
+/**
+ * Update speed from GPS fix through the fused Doppler/position filter
+ * The filter shows 0 mph while stationary and holds the last estimate
+ * through up to SPEED_HOLD_MS of fixes with neither speed nor location.
+ */
+static void updateSpeed(const gps_fix& fix, uint32_t intervalMs) {
+    avg_speed_calc = speedFilter.update(fix, intervalMs);
+    avg_speed = (int32_t)avg_speed_calc;
 }
 
 /**
@@ -89,7 +71,10 @@ static void updateHeading(const gps_fix& fix) {
     if (!fix.valid.heading) return;
 
     float degrees = fix.heading_cd() / 100.0;
-    heading = String(headingToCompass(degrees));
+    const char* compass = headingToCompass(degrees);
+    if (strcmp(heading, compass) != 0) {
+        fmtStr(heading, compass);
+    }
 }
 
 /**
@@ -114,12 +99,31 @@ static void updateTimeDisplay(const gps_fix& fix) {
     localSecond = second(localTime);
     localDayOfWeek = weekday(localTime);
 
-    // Update display strings
-    cur_date = String(getDayAbbr(localDayOfWeek)) + ", " + String(getMonthAbbr(localMonth)) + " " + String(localDay);
-    hhmm_str = String(make12hr(localHour)) + ":" + String(prefix_zero(localMinute));
-    hhmmss_str = String(make12hr(localHour)) + ":" +
-                 String(prefix_zero(localMinute)) + String(prefix_zero(localSecond));
-    am_pm_str = am_pm(localHour);
+    // Update display strings in place, only the parts that changed
+    int32_t dateKey = localYear * 10000 + localMonth * 100 + localDay;
+    if (dateKey != shownDateKey) {
+        char* p = fmtStr(cur_date, getDayAbbr(localDayOfWeek));
+        p = fmtStr(p, ", ");
+        p = fmtStr(p, getMonthAbbr(localMonth));
+        p = fmtStr(p, " ");
+        fmtUint(p, localDay);
+        shownDateKey = dateKey;
+    }
+
+    int32_t minuteKey = localHour * 60 + localMinute;
+    if (minuteKey != shownMinuteKey) {
+        char* p = fmtUint(hhmm_str, make12hr(localHour));
+        *p++ = ':';
+        fmtUint(p, localMinute, 2);
+        fmtStr(am_pm_str, (localHour >= 12) ? "PM" : "AM");
+        shownMinuteKey = minuteKey;
+        shownSecond = -1;
+    }
+
+    if (localSecond != shownSecond) {
+        fmtUint(fmtStr(hhmmss_str, hhmm_str), localSecond, 2);  // "h:mmss" (no colon before seconds)
+        shownSecond = localSecond;
+    }
 
     lastGpsTimeUpdate = millis();
 }
@@ -143,10 +147,31 @@ static void updateHdop(const gps_fix& fix) {
     }
 }
 
+/**
+ * Write "sats/hdop" (e.g. "7/1.50") if either value changed
+ */
+static void updateSatsHdop(uint8_t sats) {
+    int32_t hdopX100 = (int32_t)(hdop * 100.0 + 0.5);
+    int32_t key = sats * 100000 + hdopX100;
+    if (key == shownSatsHdop) return;
+
+    char* p = fmtUint(sats_hdop, sats);
+    *p++ = '/';
+    fmtFixed(p, hdopX100, 2);
+    shownSatsHdop = key;
+}
+
+/**
+ * Round NeoGPS 1e-7 degree units to the 6 decimals shown on screen
+ */
+static int32_t toMicroDegrees(int32_t deg_e7) {
+    return (deg_e7 >= 0) ? (deg_e7 + 5) / 10 : (deg_e7 - 5) / 10;
+}
+
 /**
  * Update backlight based on sunrise/sunset times
  */
-static void updateBacklight(time_t& sunrise_t, time_t& sunset_t) {
+static void updateBacklight() {
     // Recalculate sunrise/sunset when day changes
     if (localDay != old_localDay) {
         sun.calculate(localTime, tcr->offset, sunrise_t, sunset_t);
@@ -193,6 +218,15 @@ static void updateHomeLocation(const gps_fix& fix) {
         set_home_loc = false;
     }
 
+    // A stored fence named GEOFENCE_HOME_NAME takes over from the home radius
+    // (its state was updated by updateGeofences() for this fix)
+    int homeFence = geofences.find(GEOFENCE_HOME_NAME);
+    if (homeFence >= 0) {
+        at_home = geofences.isInside(homeFence);
+        old_at_home = at_home;  // Enter/exit already reported by the engine
+        return;
+    }
+
     // Calculate if we're at home
     if (homeLocationSet) {
         // Create a location object for home coordinates
@@ -227,20 +261,48 @@ static void updateHomeLocation(const gps_fix& fix) {
     }
 }
 
+/**
+ * Geofence enter/exit (gpsMutex held) - handed to the GUI, which shows it briefly
+ */
+static void onGeofenceEvent(const geofence_t& fence, bool entered) {
+    GeofenceEvent& event = geofenceEvents.writeBuffer();
+    strlcpy(event.name, fence.name, sizeof(event.name));
+    event.entered = entered;
+    geofenceEvents.publish();
+}
+
+/**
+ * Test the fix against the stored geofences (enter/exit events fire from here)
+ */
+static void updateGeofences(const gps_fix& fix) {
+    if (!fix.valid.location) return;
+
+    geofences.update(fix.location);
+}
+
 /**
  * Update location-related data from GPS fix
  */
-static void updateLocation(const gps_fix& fix, time_t& sunrise_t, time_t& sunset_t) {
+static void updateLocation(const gps_fix& fix, uint32_t intervalMs) {
     if (!fix.valid.location) return;
 
-    // Update both old and new coordinate variables
-    latitude = String(fix.latitude(), 6);
-    longitude = String(fix.longitude(), 6);
-    cur_lat = latitude;
-    cur_long = longitude;
+    // Update both old and new coordinate variables (only when the displayed digits change)
+    int32_t lat = toMicroDegrees(fix.location.lat());
+    int32_t lon = toMicroDegrees(fix.location.lon());
+    if (lat != shownLat) {
+        fmtFixed(latitude, lat, 6);
+        fmtStr(cur_lat, latitude);
+        shownLat = lat;
+    }
+    if (lon != shownLon) {
+        fmtFixed(longitude, lon, 6);
+        fmtStr(cur_long, longitude);
+        shownLon = lon;
+    }
 
-    if (fix.valid.altitude) {
-        altitude = String(fix.altitude(), 2);
+    if (fix.valid.altitude && fix.altitude_cm() != shownAltitudeCm) {
+        fmtFixed(altitude, fix.altitude_cm(), 2);
+        shownAltitudeCm = fix.altitude_cm();
     }
 
     updateHdop(fix);
@@ -251,210 +313,197 @@ static void updateLocation(const gps_fix& fix, time_t& sunrise_t, time_t& sunset
             // Valid non-zero count - update display and reset dropout counter
             lastValidSatCount = fix.satellites;
             zeroSatConsecutiveCount = 0;
-            sats_hdop = String(fix.satellites) + "/" + String(hdop, 2);
+            updateSatsHdop(fix.satellites);
         } else {
             // Zero satellites reported - only update display after consecutive zeros
             zeroSatConsecutiveCount++;
             if (zeroSatConsecutiveCount >= ZERO_SAT_THRESHOLD) {
                 lastValidSatCount = 0;
-                sats_hdop = "0/" + String(hdop, 2);
+                updateSatsHdop(0);
             }
             // Otherwise keep showing lastValidSatCount (display unchanged)
         }
     }
 
-    updateBacklight(sunrise_t, sunset_t);
-
-    // Accumulate distance traveled using hybrid position-based calculation
-    if (hasLastLocation) {
-        float posDistance = fix.location.DistanceMiles(lastLocation);
-        float posSpeed = posDistance * 3600.0;  // Convert to mph (assumes ~1Hz)
-
-        bool shouldAccumulate = false;
-
-        // Use GPS Doppler speed as primary gate
-        if (fix.valid.speed) {
-            float dopplerSpeed = fix.speed_mph();
-
-            // Only accumulate when GPS confirms we're moving
-            if (dopplerSpeed > MIN_SPEED_FILTER_MPH) {
-                // Position speed must be reasonable
-                if (posSpeed < 30.0 && posDistance > 0.0005) {  // >2.6 feet minimum
-                    shouldAccumulate = true;
-                }
-            }
-            // If Doppler says stopped, don't accumulate (filters jitter)
-        } else {
-            // No Doppler speed available - use distance threshold only
-            if (posDistance > 0.002 && posSpeed < 30.0) {  // >10 feet minimum
-                shouldAccumulate = true;
-            }
-        }
-
-        if (shouldAccumulate) {
-            accum_distance += posDistance;
-            trip_distance += posDistance;
+    updateBacklight();
 
-            // Rollover at 100,000 miles (display limit is 99999.9)
-            if (accum_distance >= 100000.0) {
-                accum_distance = 0.0;
-                lastSavedAccumDistance = 0.0;
-            }
-            if (trip_distance >= 100000.0) {
-                trip_distance = 0.0;
-                lastSavedTripDistance = 0.0;
-            }
-
-            /**
-             * Accumulate driving hours (only when moving, same as distance)
-             *
-             * Hybrid time tracking system:
-             * - PRIMARY: GPS time (atomic clock accurate, no drift)
-             * - FALLBACK: millis() when GPS signal unavailable (slight drift acceptable)
-             *
-             * Storage format: hrs_since_svc is ALWAYS stored as tenths of hours
-             * Conversion: 360 seconds = 0.1 hours (1 tenth)
-             *
-             * Example: 45 minutes = 2700 seconds = 7.5 tenths = stored as 7 in hrs_since_svc
-             */
-
-            // Initialize hours tracking on first movement
-            if (!hoursTrackingInitialized) {
-                lastSavedHrsSinceSvc = hrs_since_svc;
-                hoursTrackingInitialized = true;
-            }
+    // Distance and driving hours (integer engine, owns the EEPROM save thresholds)
+    odometerUpdate(fix, intervalMs);
 
-            int32_t elapsedSeconds = 0;
-            bool timeValid = false;
+#if DEBUG_GPS == 1
+    Serial.print("\nLAT: ");
+    Serial.println(latitude);
+    Serial.print("LONG: ");
+    Serial.println(longitude);
+    Serial.print("AVG_SPEED (mph) = ");
+    Serial.println(avg_speed);
+    Serial.print("DIRECTION = ");
+    Serial.println(heading);
+    Serial.print("Sats/HDOP = ");
+    Serial.println(sats_hdop);
+    Serial.print("Accum distance (mi) = ");
+    Serial.println(accum_distance, 3);
+#endif
+}
 
-            // Attempt to use GPS time first (preferred for accuracy)
-            if (fix.valid.date && fix.valid.time) {
-                time_t currentGpsTime = now();  // GPS-synced UTC time from TimeLib
+/**
+ * Copy the freshly processed fix into gpsSnapshot for lock-free readers
+ * Fields that are invalid in this fix keep their last known values
+ */
+static void publishGpsSnapshot(const gps_fix& fix) {
+    if (fix.valid.location) {
+        snapshot.lat = fix.location.lat();
+        snapshot.lon = fix.location.lon();
+        snapshot.satellites = lastValidSatCount;
+        snapshot.hdop_x100 = (uint16_t)(hdop * 100.0 + 0.5);
+        snapshot.locationValid = true;
+    }
 
-                if (lastMovementGpsTime > 0) {
-                    elapsedSeconds = currentGpsTime - lastMovementGpsTime;
+    if (fix.valid.altitude) {
+        snapshot.altitude_cm = fix.altitude_cm();
+        snapshot.altitudeValid = true;
+    }
 
-                    // Safety check: only accept reasonable time deltas (0-10 seconds)
-                    // Filters GPS glitches, device reboots, or long signal loss
-                    if (elapsedSeconds > 0 && elapsedSeconds <= 10) {
-                        timeValid = true;
-                    }
-                }
+    if (fix.valid.heading) {
+        snapshot.heading_cd = fix.heading_cd();
+        strncpy(snapshot.compass, headingToCompass(fix.heading_cd() / 100.0), sizeof(snapshot.compass) - 1);
+        snapshot.headingValid = true;
+    }
 
-                // Update GPS time reference for next iteration
-                lastMovementGpsTime = currentGpsTime;
-                lastMovementMillis = millis();  // Sync millis backup with GPS time
-            }
-            // Fallback to millis() if GPS time unavailable (tunnel, parking garage, etc.)
-            else if (lastMovementMillis > 0) {
-                unsigned long currentMillis = millis();
-                unsigned long elapsedMillis = currentMillis - lastMovementMillis;
-
-                // Convert millis to seconds
-                elapsedSeconds = elapsedMillis / 1000;
-
-                // Safety check: only accept reasonable time deltas (0-10 seconds)
-                // Protects against millis() rollover (every 49.7 days)
-                if (elapsedSeconds > 0 && elapsedSeconds <= 10) {
-                    timeValid = true;
-                }
+    if (fix.valid.date && fix.valid.time) {
+        snapshot.localYear = localYear;
+        snapshot.localMonth = localMonth;
+        snapshot.localDay = localDay;
+        snapshot.localHour = localHour;
+        snapshot.localMinute = localMinute;
+        snapshot.localSecond = localSecond;
+        snapshot.localDayOfWeek = localDayOfWeek;
+        snapshot.timeMillis = lastGpsTimeUpdate;
+        snapshot.utcEpoch = (uint32_t)utcTime;
+        snapshot.timeValid = true;
+    }
 
-                // Update millis reference for next iteration
-                lastMovementMillis = currentMillis;
-            }
-            // First movement detected - initialize time references
-            else {
-                lastMovementMillis = millis();
-                // GPS time will be set on next iteration when available
-            }
+    snapshot.speed_cmph = (uint16_t)(avg_speed_calc * 100.0 + 0.5);
+    snapshot.publishMillis = millis();
 
-            // Accumulate elapsed time if valid
-            if (timeValid && elapsedSeconds > 0) {
-                remainderSeconds += elapsedSeconds;
+    gpsSnapshot.write(snapshot);
+}
 
-                // When we've accumulated 360 seconds (1 tenth hour), increment hrs_since_svc
-                int32_t tenthsToAdd = remainderSeconds / 360;
-                if (tenthsToAdd > 0) {
-                    hrs_since_svc += tenthsToAdd;
-                    remainderSeconds -= (tenthsToAdd * 360);
-                }
+/**
+ * Blank the clock and show "NO GPS" when GPS time has not updated for
+ * MAX_GPS_TIME_STALENESS_SECS. Runs in gpsTask (which owns these strings)
+ * on every wakeup, at least once per GPS_RX_WAIT_TIMEOUT_MS.
+ */
+static void checkGpsTimeStale() {
+    static bool timeWasStale = false;
+    const unsigned long GPS_TIME_TIMEOUT = MAX_GPS_TIME_STALENESS_SECS * 1000UL;  // Convert seconds to milliseconds
+
+    // lastGpsTimeUpdate is 0 at boot until first GPS time is received
+    bool timeIsStale = (lastGpsTimeUpdate == 0) || ((millis() - lastGpsTimeUpdate) > GPS_TIME_TIMEOUT);
+
+    // Only update display if staleness state changed
+    if (timeIsStale != timeWasStale) {
+        if (timeIsStale) {
+            fmtStr(cur_date, "NO GPS");
+            hhmm_str[0] = '\0';
+            hhmmss_str[0] = '\0';
+            am_pm_str[0] = '\0';
+
+            // Force a full rewrite when GPS time returns
+            shownDateKey = -1;
+            shownMinuteKey = -1;
+            shownSecond = -1;
+        }
+        // Note: When GPS time becomes valid again, updateTimeDisplay() rewrites these strings
+        timeWasStale = timeIsStale;
+    }
+}
 
-                // Save to EEPROM every 1.0 hours of driving (10 tenths)
-                if (hrs_since_svc - lastSavedHrsSinceSvc >= (SAVE_INTERVAL_HOURS * 10)) {
-                    queuePreferenceWrite("hrs_since_svc", hrs_since_svc);
-                    lastSavedHrsSinceSvc = hrs_since_svc;
-                }
-            }
+/**
+ * Offer the fix to the breadcrumb track recorder
+ * Encoding only touches a RAM page; full pages are queued for the track task.
+ */
+static void updateTrack(const gps_fix& fix) {
+    trackRecorder.addFix(fix, avg_speed_calc);
+}
 
-            // Update display strings with 1 decimal place precision
-            odometer = String(accum_distance, 1);
-            trip_odometer = String(trip_distance, 1);
+/**
+ * Run one merged fix through the full update pipeline
+ * intervalMs is the measured time since the previous fix (FixAssembler::intervalMs()).
+ * Caller must hold gpsMutex. Also driven directly by the host replay harness.
+ */
+void processGpsFix(const gps_fix& fix, uint32_t intervalMs) {
+    updateSpeed(fix, intervalMs);
+    updateHeading(fix);
+    updateTimeDisplay(fix);
+    updateLocation(fix, intervalMs);
+    updateGeofences(fix);
+    updateHomeLocation(fix);
+    updateTrack(fix);
+    publishGpsSnapshot(fix);
+}
 
-            // Save to EEPROM periodically (every 0.5 miles)
-            if (accum_distance - lastSavedAccumDistance >= SAVE_INTERVAL_MILES) {
-                queuePreferenceWrite("accumDistance", accum_distance);
-                lastSavedAccumDistance = accum_distance;
-            }
+/**
+ * Format a snapshot's local time as the hot packet receive timestamp,
+ * e.g. "Mon, Jan 5  3:07PM". Gives "NO GPS" when GPS time is missing or stale.
+ */
+uint32_t gpsUtcNow(const GpsSnapshot& snap) {
+    uint32_t sinceFix = millis() - snap.timeMillis;
+    if (!snap.timeValid || sinceFix > MAX_GPS_TIME_STALENESS_SECS * 1000UL) return 0;
+    return snap.utcEpoch + sinceFix / 1000;
+}
 
-            if (trip_distance - lastSavedTripDistance >= SAVE_INTERVAL_MILES) {
-                queuePreferenceWrite("tripDistance", trip_distance);
-                lastSavedTripDistance = trip_distance;
-            }
-        }
+void formatGpsTimestamp(const GpsSnapshot& snap, char* buf, size_t len) {
+    bool stale = !snap.timeValid || (millis() - snap.timeMillis) > MAX_GPS_TIME_STALENESS_SECS * 1000UL;
+    if (stale) {
+        snprintf(buf, len, "NO GPS");
+        return;
     }
 
-    // Update last location for next iteration
-    lastLocation = fix.location;
-    hasLastLocation = true;
-
-#if DEBUG_GPS == 1
-    Serial.print("\nLAT: ");
-    Serial.println(latitude);
-    Serial.print("LONG: ");
-    Serial.println(longitude);
-    Serial.print("AVG_SPEED (mph) = ");
-    Serial.println(avg_speed);
-    Serial.print("DIRECTION = ");
-    Serial.println(heading);
-    Serial.print("Sats/HDOP = ");
-    Serial.println(sats_hdop);
-    if (hasLastLocation) {
-        Serial.print("Pos distance (mi) = ");
-        Serial.println(fix.location.DistanceMiles(lastLocation), 6);
-        Serial.print("Accum distance (mi) = ");
-        Serial.println(accum_distance, 3);
-    }
-#endif
+    snprintf(buf, len, "%s, %s %d  %d:%02d%s",
+             getDayAbbr(snap.localDayOfWeek), getMonthAbbr(snap.localMonth), snap.localDay,
+             make12hr(snap.localHour), snap.localMinute, snap.localHour >= 12 ? "PM" : "AM");
 }
 
 /**
  * GPS Task - processes NMEA data and updates global GPS variables
  *
- * Uses NeoGPS library with EXPLICIT_MERGING mode. The gps.available() function
- * returns true after LAST_SENTENCE_IN_INTERVAL (RMC) arrives, providing a
- * complete merged fix with data from all sentences in the update interval.
+ * NeoGPS delivers one fix per sentence (NO_MERGING); gpsAssembler merges them
+ * into one fix per receiver update interval, at any fix rate, and learns
+ * which sentence ends the interval so the fix is processed as soon as that
+ * sentence lands.
+ *
+ * The task sleeps in gpsTransport.waitForData() until the UART reports new
+ * bytes.
  */
 void gpsTask(void *parameter) {
-    time_t sunrise_t, sunset_t;
-
     Serial.println("GPS Task started");
 
-    while (true) {
-        if (xSemaphoreTake(gpsMutex, portMAX_DELAY)) {
+    gpsTransport.begin();
+    geofences.setEventCallback(onGeofenceEvent);
 
-            // Process all available merged fixes
-            while (gps.available(gpsSerial)) {
-                fix = gps.read();
+    while (true) {
+        bool haveData = gpsTransport.waitForData(GPS_RX_WAIT_TIMEOUT_MS);
 
-                updateSpeed(fix);
-                updateHeading(fix);
-                updateTimeDisplay(fix);
-                updateLocation(fix, sunrise_t, sunset_t);
-                updateHomeLocation(fix);
+        uint32_t waitStart = millis();
+        if (xSemaphoreTake(gpsMutex, portMAX_DELAY)) {
+            gpsHealthOnMutexWait(millis() - waitStart);
+
+            // Merge every parsed sentence, processing each completed interval
+            if (haveData) {
+                while (gps.available(gpsTransport.stream())) {
+                    if (gpsAssembler.add(gps.read(), gps.nmeaMessage)) {
+                        fix = gpsAssembler.fix();
+                        processGpsFix(fix, gpsAssembler.intervalMs());
+                        gpsHealthOnFix(fix);
+                    }
+                }
             }
 
+            checkGpsTimeStale();
+            gpsHealthUpdate();
+
             xSemaphoreGive(gpsMutex);
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
     }
 }
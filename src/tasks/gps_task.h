@@ -1,6 +1,19 @@
 #ifndef GPS_TASK_H
 #define GPS_TASK_H
 
+#include <NMEAGPS.h>
+#include "types.h"
+
 void gpsTask(void *parameter);
 
-#endif // GPS_TASK_H
\ No newline at end of file
+// Apply one merged fix to the global GPS/time/odometer state (caller holds gpsMutex)
+// intervalMs: measured time since the previous fix, 0 if unknown (first fix or after a gap)
+void processGpsFix(const gps_fix& fix, uint32_t intervalMs);
+
+// UTC seconds now from a gpsSnapshot copy, 0 when GPS time is missing or stale
+uint32_t gpsUtcNow(const GpsSnapshot& snap);
+
+// Hot packet receive timestamp ("Mon, Jan 5  3:07PM" or "NO GPS") from a gpsSnapshot copy
+void formatGpsTimestamp(const GpsSnapshot& snap, char* buf, size_t len);
+
+#endif // GPS_TASK_H
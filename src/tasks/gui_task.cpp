@@ -6,6 +6,7 @@
 #include "ui_eez/screens.h"
 #include "ui_eez/styles.h"
 #include "ui/venue_event_display.h"
+#include "ui/geofence_display.h"
 #include "get_set_vars.h"
 
 void updateEspnowIndicatorColor() {
@@ -74,40 +75,18 @@ void updateEspnowGciMacColor() {
     }
 }
 
-void checkGpsTimeStale() {
-    static bool timeWasStale = false;
-    const unsigned long GPS_TIME_TIMEOUT = MAX_GPS_TIME_STALENESS_SECS * 1000UL;  // Convert seconds to milliseconds
-
-    // Check if GPS time is stale (no update for more than MAX_GPS_TIME_STALENESS_SECS seconds)
-    // lastGpsTimeUpdate is 0 at boot until first GPS time is received
-    bool timeIsStale = (lastGpsTimeUpdate == 0) || ((millis() - lastGpsTimeUpdate) > GPS_TIME_TIMEOUT);
-
-    // Only update display if staleness state changed
-    if (timeIsStale != timeWasStale) {
-        if (xSemaphoreTake(gpsMutex, portMAX_DELAY)) {
-            if (timeIsStale) {
-                // GPS time is stale - show blank clock and "NO GPS"
-                cur_date = String("NO GPS");
-                hhmm_str = String("");
-                hhmmss_str = String("");
-                am_pm_str = String("");
-            }
-            // Note: When GPS time becomes valid again, gps_task will update these strings
-            xSemaphoreGive(gpsMutex);
-        }
-        timeWasStale = timeIsStale;
-    }
-}
-
 void guiTask(void *parameter) {
     static uint32_t last_flag_set_time = 0;
     static uint32_t last_inactivity_check = 0;
-    static uint32_t last_gps_time_check = 0;
     static lv_obj_t* previous_screen = nullptr;
 
     while (true) {
         uint32_t now = millis();
 
+        // Pick up hot packets published since the last pass; getters read these frames until the next pass
+        hotPacketWeather.acquire();
+        hotPacketVenue.acquire();
+
         lv_tick_inc(now - lastTick);
         lastTick = now;
         lv_timer_handler();
@@ -119,12 +98,6 @@ void guiTask(void *parameter) {
         // Update espnow GCI MAC address color on Settings2 screen
         updateEspnowGciMacColor();
 
-        // Check GPS time staleness (every 1 second)
-        if ((now - last_gps_time_check) >= 1000) {
-            checkGpsTimeStale();
-            last_gps_time_check = now;
-        }
-
         // Check for screen changes and reset countdown if screen changed
         lv_obj_t* current_screen = lv_scr_act();
         if (current_screen != previous_screen) {
@@ -140,16 +113,19 @@ void guiTask(void *parameter) {
             }
         }
 
-        // Check if Now Playing screen needs updating when new data flag is set
+        // Redraw the Now Playing table when a newer venue/event frame was acquired
+        checkAndUpdateNowPlayingScreen();
+
+        // Briefly show the latest geofence enter/exit
+        checkGeofenceEvents();
+
+        // Auto-reset the new data indicator
         if (new_rx_data_flag) {
             // Record when flag was set (if this is the first time we see it)
             if (last_flag_set_time == 0) {
                 last_flag_set_time = now;
             }
 
-            // Check for Now Playing screen updates
-            checkAndUpdateNowPlayingScreen();
-
             // Auto-reset flag after configured time
             if ((now - last_flag_set_time) >= NEW_RX_DATA_FLAG_RESET_TIME) {
                 new_rx_data_flag = false;
@@ -7,6 +7,5 @@ void guiTask(void *parameter);
 void handleInactivityCountdown(uint32_t now);
 void updateEspnowIndicatorColor();
 void updateEspnowGciMacColor();
-void checkGpsTimeStale();
 
 #endif // GUI_TASK_H
\ No newline at end of file
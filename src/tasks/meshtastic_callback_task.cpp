@@ -3,34 +3,43 @@
 #include "globals.h"
 #include "types.h"
 #include "communication/hot_packet_parser.h"
+#include "communication/meshtastic_admin.h"
+#include "communication/meshtastic_tx.h"
+#include "communication/meshtastic_nodes.h"
 #include "Meshtastic.h"
 
 void meshtasticCallbackTask(void *parameter) {
-    meshtasticCallbackItem_t item;
-    
     while (true) {
-        if (xQueueReceive(meshtasticCallbackQueue, &item, portMAX_DELAY)) {
+        // mesh_packet_deliver() notifies after each message it queues
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Messages are used where they lie in the pool, then released
+        const MeshRxMessage *item;
+        while ((item = meshRxPool.peek()) != NULL) {
             // Serial.print("Received a text message on channel: ");
-            // Serial.print(item.channel);
+            // Serial.print(item->channel);
             // Serial.print(" from: ");
-            // Serial.print(item.from);
+            // Serial.print(item->from);
             // Serial.print(" to: ");
-            // Serial.print(item.to);
+            // Serial.print(item->to);
             // Serial.print(" message: ");
-            // Serial.println(item.text);
+            // Serial.println(item->text());
             
-            if (item.to == 0xFFFFFFFF) {
+            if (item->to == 0xFFFFFFFF) {
                 Serial.println("This is a BROADCAST message.");
-            } else if (item.to == my_node_num) {
+            } else if (item->to == my_node_num) {
                 Serial.println("This is a DM to me!");
             } else {
                 Serial.println("This is a DM to someone else.");
             }
             
             // Check for HoT packet
-            if (isHotPacket(item.text)) {
-                processHotPacket(item.text);
+            if (item->port == meshtastic_PortNum_PRIVATE_APP) {
+                processBinaryHotPacket(item->bytes(), item->size);
+            } else if (isHotPacket(item->text())) {
+                processHotPacket(item->text());
             }
+            meshRxPool.release();
         }
     }
 }
@@ -41,25 +50,100 @@ void connected_callback(mt_node_t *node, mt_nr_progress_t progress) {
         not_yet_connected = false;
         // GPS config init will be handled by system task polling
     }
+    if (node != NULL && progress == MT_NR_IN_PROGRESS) {
+        meshNodeReport(node, millis());
+    }
+}
+
+// Drop a rebroadcast copy before it takes a queue slot and is parsed again
+static bool isDuplicate(uint32_t from, uint32_t id) {
+    if (!meshPacketDedup.seen(from, id, millis())) {
+        return false;
+    }
+    Serial.printf("Duplicate packet %lu from %lu dropped (%lu hits, %lu misses)\n",
+                  id, from, meshPacketDedup.hits(), meshPacketDedup.misses());
+    return true;
+}
+
+// Payloads handled here in meshtasticTask (admin, routing, node info) are decoded into this;
+// text and binary hot packets go straight into a meshRxPool reservation
+static uint8_t rxScratch[MAX_MESHTASTIC_PAYLOAD];
+
+static void warnPoolFull(meshtastic_PortNum port) {
+    Serial.println(port == meshtastic_PortNum_TEXT_MESSAGE_APP
+                       ? "Warning: Meshtastic RX pool full, message dropped"
+                       : "Warning: Meshtastic RX pool full, binary packet dropped");
+}
+
+uint8_t* mesh_payload_reserve(meshtastic_PortNum port, size_t size) {
+    // Room for size bytes plus the NUL the decoder appends
+    if (size >= MAX_MESHTASTIC_PAYLOAD) {
+        return NULL;
+    }
+    if (port == meshtastic_PortNum_TEXT_MESSAGE_APP || port == meshtastic_PortNum_PRIVATE_APP) {
+        uint8_t* room = meshRxPool.reserve(size);
+        if (room == NULL) {
+            warnPoolFull(port);
+        }
+        return room;
+    }
+    if (port != meshtastic_PortNum_ADMIN_APP && port != meshtastic_PortNum_ROUTING_APP &&
+        port != meshtastic_PortNum_NODEINFO_APP && port != meshtastic_PortNum_POSITION_APP &&
+        port != meshtastic_PortNum_TELEMETRY_APP) {
+        return NULL;  // Not used - skipped without being copied anywhere
+    }
+    return rxScratch;
 }
 
-void text_message_callback(uint32_t from, uint32_t to, uint8_t channel, const char *text) {
-    Serial.printf("MESSAGE CALLBACK: from=%lu, to=%lu, channel=%d, text='%s'\n",
-                 from, to, channel, text ? text : "NULL");
+void mesh_packet_deliver(const mt_packet_t* packet, uint8_t* payload) {
+    if (packet->encrypted) {
+        return;
+    }
+    if (payload == NULL) {
+        if (packet->port != meshtastic_PortNum_TEXT_MESSAGE_APP || packet->size != 0) {
+            return;  // Nothing we reserved room for
+        }
+        // Empty text has no payload field at all, but is still a message
+        payload = meshRxPool.reserve(0);
+        if (payload == NULL) {
+            warnPoolFull(meshtastic_PortNum_TEXT_MESSAGE_APP);
+            return;
+        }
+        payload[0] = '\0';
+    }
 
-    meshtasticCallbackItem_t item;
-    item.from = from;
-    item.to = to;
-    item.channel = channel;
-    
-    if (text != NULL) {
-        strncpy(item.text, text, MAX_MESHTASTIC_PAYLOAD - 1);
-        item.text[MAX_MESHTASTIC_PAYLOAD - 1] = '\0';
-    } else {
-        item.text[0] = '\0';
+    if (packet->port == meshtastic_PortNum_ADMIN_APP) {
+        admin_portnum_callback(packet->from, packet->to, packet->channel, packet->port, payload, packet->size);
+        return;
+    }
+    if (packet->port == meshtastic_PortNum_ROUTING_APP) {
+        if (packet->request_id != 0) {
+            meshAckRouted(packet->request_id, payload, packet->size, millis());  // Ack/nak of one of ours
+        }
+        return;
     }
-    
-    if (xQueueSend(meshtasticCallbackQueue, &item, 0) != pdTRUE) {
-        Serial.println("Warning: Meshtastic callback queue full, message dropped");
+    if (meshNodePacket(packet, payload, millis())) {
+        return;  // Node table only, nothing for meshtasticCallbackTask
     }
-}
\ No newline at end of file
+
+    if (packet->port == meshtastic_PortNum_TEXT_MESSAGE_APP) {
+        Serial.printf("MESSAGE CALLBACK: from=%lu, to=%lu, channel=%d, text='%s'\n",
+                      packet->from, packet->to, packet->channel, (const char*)payload);
+    } else if (packet->size == 0) {
+        return;
+    }
+    if (isDuplicate(packet->from, packet->id)) {
+        return;  // Left uncommitted; the next reserve() reuses the room
+    }
+
+    MeshRxMessage item = {};
+    item.from = packet->from;
+    item.to = packet->to;
+    item.channel = packet->channel;
+    item.port = packet->port;
+    item.size = packet->size;  // Text is NUL terminated as well
+    meshRxPool.commit(item);
+    if (meshtasticCallbackTaskHandle != NULL) {
+        xTaskNotifyGive(meshtasticCallbackTaskHandle);
+    }
+}
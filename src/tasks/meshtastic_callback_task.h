@@ -2,9 +2,18 @@
 #define CALLBACK_TASK_H
 
 #include <Arduino.h>
+#include "meshtastic/mesh.pb.h"
+#include "meshtastic/portnums.pb.h"
+#include "mt_packet_codec.h"
 
 void meshtasticCallbackTask(void *parameter);
 //void connected_callback(mt_node_t *node, mt_nr_progress_t progress);
-void text_message_callback(uint32_t from, uint32_t to, uint8_t channel, const char *text);
+
+// Packet sink for set_packet_sink(), run by the decoder in meshtasticTask. Text and PRIVATE_APP
+// (binary hot packets) are read straight into a meshRxPool reservation and committed for
+// meshtasticCallbackTask; ADMIN_APP goes to admin_portnum_callback, ROUTING_APP to the ack
+// tracker and NODEINFO/POSITION/TELEMETRY to the node table; other ports are skipped.
+uint8_t* mesh_payload_reserve(meshtastic_PortNum port, size_t size);
+void mesh_packet_deliver(const mt_packet_t* packet, uint8_t* payload);
 
 #endif // CALLBACK_TASK_H
\ No newline at end of file
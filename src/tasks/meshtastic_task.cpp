@@ -3,8 +3,27 @@
 #include "globals.h"
 #include "Meshtastic.h"
 #include "communication/meshtastic_admin.h"
+#include "communication/meshtastic_tx.h"
 #include "get_set_vars.h"
 
+// Feed the link monitor this loop's receive counters and send the probe it asks for
+static void gcmLinkService(uint32_t now) {
+    static GcmLinkState reported = GCM_LINK_UP;
+    mt_rx_stats_t rx;
+    mt_get_rx_stats(&rx);
+    if (gcmLink.poll(now, {rx.bytes, rx.frames, rx.config_completes})) {
+        mt_send_config_probe();  // A failed send simply goes unanswered
+        gcmLink.probeSent(now);
+    }
+    GcmLinkState state = gcmLink.state();
+    if (state != reported) {
+        const GcmLinkMonitor::Stats &link = gcmLink.stats();
+        Serial.printf("GCM link %s (last frame %lu s ago, probe RTT last %lu ms)\n", GcmLinkMonitor::stateName(state),
+                      (now - link.lastFrameMs) / 1000, link.rttLastMs);
+        reported = state;
+    }
+}
+
 void meshtasticTask(void *parameter) {
     static bool old_reboot_meshtastic = false;
 
@@ -16,6 +35,7 @@ void meshtasticTask(void *parameter) {
               old_mesh_serial_enabled = mesh_serial_enabled;
               if (mesh_serial_enabled == false) {
                   mt_serial_end();
+                  gcmLink.reset();
                   Serial.println("Meshtastic serial disabled");
               } else {
                   mt_serial_init(MT_SERIAL_RX_PIN, MT_SERIAL_TX_PIN, MT_DEV_BAUD_RATE);
@@ -28,9 +48,9 @@ void meshtasticTask(void *parameter) {
               Serial.println("\n=== Meshtastic Reboot Triggered ===");
               if (mesh_serial_enabled) {
                   if (mt_send_admin_reboot(0)) {  // 0 = immediate reboot
-                      Serial.println("Reboot command sent successfully");
+                      Serial.println("Reboot command queued");
                   } else {
-                      Serial.println("Failed to send reboot command");
+                      Serial.println("Failed to queue reboot command");
                   }
               } else {
                   Serial.println("Cannot reboot: Meshtastic serial is disabled");
@@ -44,6 +64,7 @@ void meshtasticTask(void *parameter) {
           bool can_send = false;
           if (mesh_serial_enabled) {
               can_send = mt_loop(now);
+              gcmLinkService(now);
           }
 
           // Send wake notification once when connection is ready AND GPS config has been attempted
@@ -51,7 +72,7 @@ void meshtasticTask(void *parameter) {
           if (can_send && !wakeNotificationSent && gpsConfigAttempted) {
               const char *wakeMessage = "~#01#GC#AWAKE#";
 
-              if (mt_send_text(wakeMessage, BROADCAST_ADDR, 0)) {
+              if (meshQueueText(wakeMessage, BROADCAST_ADDR, 0, MESH_TX_HOT_PACKET, MESH_ACK_RETRIES)) {
                 //   Serial.print("Wake notification sent: ");
                 //   Serial.println(wakeMessage);
                   wakeNotificationSent = true;
@@ -62,20 +83,93 @@ void meshtasticTask(void *parameter) {
 
           // Send periodic test message
           if (can_send && now >= next_send_time) {
-              Serial.printf("Sending test message at: %s", hhmm_str.c_str());
+              Serial.printf("Sending test message at: %s", hhmm_str);
 
               uint32_t dest = BROADCAST_ADDR;
               uint8_t channel_index = 0;
 
-              bool success = mt_send_text("Hello, world from the GCD!",
-                                         dest, channel_index);
-              Serial.print("mt_send_text returned: ");
+              bool success = meshQueueText("Hello, world from the GCD!",
+                                           dest, channel_index, MESH_TX_CHATTER);
+              Serial.print("meshQueueText returned: ");
               Serial.println(success ? "SUCCESS" : "***** FAILED ****");
 
               next_send_time = now + SEND_PERIOD * 1000;
               Serial.printf("Next send time in: %d minutes\n", (SEND_PERIOD / 60));
           }
 
-          vTaskDelay(pdMS_TO_TICKS(100));
+          // Everything queued by this or any other task goes out here, in priority order
+          if (can_send) {
+              meshTxService(now);
+          }
+
+#if DEBUG_MESHTASTIC_STATS
+          // Decode cost and how close the two meshtastic tasks come to their stack sizes
+          static uint32_t next_stats_time = 0;
+          if (now >= next_stats_time) {
+              next_stats_time = now + MESHTASTIC_STATS_INTERVAL_MS;
+              mt_rx_stats_t rx;
+              mt_get_rx_stats(&rx);
+              Serial.printf("Meshtastic RX: %lu frames, %lu decode errors, %lu bytes skipped, decode avg %lu us / max %lu us\n",
+                            rx.frames, rx.decode_errors, rx.skipped_bytes,
+                            rx.frames ? rx.decode_us_total / rx.frames : 0, rx.decode_us_max);
+              Serial.printf("Meshtastic handshake: packets flowing in %lu ms, first at %lu ms, node db at %lu ms, %lu settings frames skipped\n",
+                            rx.handshake_ms, rx.first_packet_ms, rx.node_db_ms, rx.skipped_variants);
+              MeshRxPool::Stats pool = meshRxPool.stats();
+              Serial.printf("Meshtastic RX pool: %lu queued, %lu dropped, high water %lu of %d bytes / %lu messages\n",
+                            pool.committed, pool.dropped, pool.highWaterBytes, MESH_RX_POOL_BYTES, pool.highWaterCount);
+              Serial.printf("Stack free (min): meshtasticTask %u of %u, meshtasticCallbackTask %u of %u bytes\n",
+                            (unsigned)uxTaskGetStackHighWaterMark(NULL), MESHTASTIC_TASK_STACK_SIZE,
+                            (unsigned)uxTaskGetStackHighWaterMark(meshtasticCallbackTaskHandle),
+                            MESHTASTIC_CALLBACK_TASK_STACK_SIZE);
+              static const char *laneNames[MESH_TX_PRIORITIES] = {"admin", "hot", "chatter"};
+              for (uint8_t p = 0; p < MESH_TX_PRIORITIES; p++) {
+                  MeshTxQueue::LaneStats tx = meshTxQueue.stats((MeshTxPriority)p);
+                  Serial.printf("Meshtastic TX %s: %lu queued, %lu sent, %lu refused, high water %lu\n",
+                                laneNames[p], tx.queued, tx.sent, tx.refused, tx.highWater);
+              }
+              Serial.printf("Meshtastic TX rate limited %lu times\n", meshTxQueue.rateLimited());
+              for (size_t i = 0; i < MESH_ACK_DESTINATIONS; i++) {
+                  const MeshAckTracker::DestStats *d = meshAckTracker.destination(i);
+                  if (d == NULL) {
+                      continue;
+                  }
+                  Serial.printf("Meshtastic ACK to %lu: %lu sent, %lu acked, %lu nakked, %lu timed out, %lu resent, RTT avg %lu ms / max %lu ms\n",
+                                d->node, d->sent, d->acked, d->nakked, d->timedOut, d->retried,
+                                d->acked ? d->rttTotalMs / d->acked : 0, d->rttMaxMs);
+                  Serial.printf("  RTT histogram (<%d ms, doubling):", MESH_ACK_RTT_FIRST_MS);
+                  for (size_t b = 0; b < MESH_ACK_RTT_BUCKETS; b++) {
+                      Serial.printf(" %lu", d->rttBuckets[b]);
+                  }
+                  Serial.println();
+              }
+              Serial.printf("Meshtastic ACK: %u waiting, %lu evicted, %lu unmatched replies\n",
+                            (unsigned)meshAckTracker.pending(), meshAckTracker.evicted(), meshAckTracker.unmatched());
+              const GcmLinkMonitor::Stats &link = gcmLink.stats();
+              Serial.printf("GCM link %s for %lu s: %lu bytes, %lu probes, %lu answered (%lu slow), %lu unanswered, down %lu times, RTT avg %lu / min %lu / max %lu ms\n",
+                            GcmLinkMonitor::stateName(gcmLink.state()), (now - link.stateSinceMs) / 1000, rx.bytes,
+                            link.probes, link.answered, link.slow, link.timedOut, link.downs,
+                            link.answered ? link.rttTotalMs / link.answered : 0, link.rttMinMs, link.rttMaxMs);
+              Serial.printf("Mesh nodes: %u of %d, %lu evicted, longest probe %lu\n", (unsigned)meshNodes.size(),
+                            NODE_TABLE_MAX_NODES, meshNodes.evicted(), meshNodes.longestProbe());
+              GpsSnapshot snap;
+              gpsSnapshot.read(snap);
+              if (snap.locationValid) {
+                  NodeTable::Nearby nearby[3];
+                  size_t found = meshNodes.nearest(snap.lat, snap.lon, now, NODE_NEAREST_MAX_AGE_MS, my_node_num, nearby, 3);
+                  for (size_t i = 0; i < found; i++) {
+                      Serial.printf("  Nearby node %lu: %lu m, heard %lu s ago\n", nearby[i].num, nearby[i].distanceM,
+                                    nearby[i].ageMs / 1000);
+                  }
+              }
+          }
+#endif
+
+          // Sleep until the radio sends something (frames are handled as soon as they
+          // arrive) or MT_RX_WAIT_MS passes for the timers and UI flags above
+          if (mesh_serial_enabled) {
+              mt_serial_wait_for_data(MT_RX_WAIT_MS);
+          } else {
+              vTaskDelay(pdMS_TO_TICKS(MT_RX_WAIT_MS));
+          }
       }
   }
\ No newline at end of file
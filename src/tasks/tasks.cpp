@@ -63,6 +63,16 @@ void createAllTasks() {
         1
     );
     
+    xTaskCreatePinnedToCore(
+        trackTask,
+        "Track Task",
+        TRACK_TASK_STACK_SIZE,
+        NULL,
+        TRACK_TASK_PRIORITY,
+        &trackTaskHandle,
+        1
+    );
+    
     xTaskCreatePinnedToCore(
         systemTask,
         "System Task",
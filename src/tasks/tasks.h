@@ -9,6 +9,7 @@
 #include "tasks/espnow_task.h"
 #include "tasks/eeprom_task.h"
 #include "tasks/system_task.h"
+#include "tasks/track_task.h"
 
 // Task creation helper
 void createAllTasks();
@@ -0,0 +1,54 @@
+#include "track_task.h"
+#include "config.h"
+#include "globals.h"
+#include "storage/track_log.h"
+
+static volatile bool exportRequested = false;
+static volatile uint32_t pagesDropped = 0;
+
+void queueTrackPage(const trackPage_t& page) {
+    if (trackPageQueue == NULL || xQueueSend(trackPageQueue, &page, 0) != pdTRUE) {
+        pagesDropped++;
+    }
+}
+
+void requestTrackExport() {
+    if (xSemaphoreTake(gpsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        trackRecorder.flush();
+        xSemaphoreGive(gpsMutex);
+    }
+    exportRequested = true;
+}
+
+uint32_t getTrackPagesDropped() {
+    return pagesDropped;
+}
+
+/**
+ * Track Task - writes encoded track pages to flash
+ *
+ * gpsTask only encodes points into a RAM page; full pages arrive here through
+ * trackPageQueue, so page programs and sector erases never hold up the fix
+ * loop. Runs at low priority; an export streams at the debug port's pace.
+ */
+void trackTask(void *parameter) {
+    Serial.println("Track Task started");
+
+    bool enabled = initTrackLog();
+    trackPage_t page;
+
+    while (true) {
+        if (xQueueReceive(trackPageQueue, &page, pdMS_TO_TICKS(1000)) == pdTRUE) {
+            if (enabled) writeTrackPage(page);
+        }
+
+        if (exportRequested) {
+            exportRequested = false;
+            // Include everything recorded up to the request
+            while (xQueueReceive(trackPageQueue, &page, 0) == pdTRUE) {
+                if (enabled) writeTrackPage(page);
+            }
+            exportTrackLog();
+        }
+    }
+}
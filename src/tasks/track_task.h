@@ -0,0 +1,17 @@
+#ifndef TRACK_TASK_H
+#define TRACK_TASK_H
+
+#include "utils/track_codec.h"
+
+void trackTask(void *parameter);
+
+// TrackRecorder page sink - queues a full page for the track task without blocking (gpsTask)
+void queueTrackPage(const trackPage_t& page);
+
+// Flush the partly filled page and stream the whole log to the debug port (any task but gpsTask)
+void requestTrackExport();
+
+// Pages lost because the queue was full
+uint32_t getTrackPagesDropped();
+
+#endif // TRACK_TASK_H
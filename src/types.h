@@ -10,7 +10,8 @@ typedef enum {
     EEPROM_FLOAT,
     EEPROM_INT,
     EEPROM_STRING,
-    EEPROM_BOOL
+    EEPROM_BOOL,
+    EEPROM_U64
 } eepromType_t;
 
 typedef struct {
@@ -21,26 +22,100 @@ typedef struct {
         int intVal;
         char stringVal[64];
         bool boolVal;
+        uint64_t u64Val;
     } value;
 } eepromWriteItem_t;
 
-// Meshtastic callback item
-typedef struct {
-    uint32_t from;
-    uint32_t to;
-    uint8_t channel;
-    char text[MAX_MESHTASTIC_PAYLOAD];
-} meshtasticCallbackItem_t;
-
 // GPS Config callback item (for position config responses)
 typedef struct {
     meshtastic_Config_PositionConfig config;
 } gpsConfigCallbackItem_t;
 
+// Snapshot of the last processed GPS fix, published by gpsTask through gpsSnapshot (SeqLock)
+// Plain integers/chars only so readers on either core can copy it without locking
+typedef struct {
+    uint32_t publishMillis;     // millis() when published
+    uint32_t timeMillis;        // millis() of last valid GPS time (0 = none since boot)
+    uint32_t utcEpoch;          // UTC seconds (Unix) at timeMillis, valid with timeValid
+    int32_t lat;                // Degrees * 1e7
+    int32_t lon;                // Degrees * 1e7
+    int32_t altitude_cm;
+    uint16_t speed_cmph;        // Filtered speed (avg_speed_calc) in 0.01 mph
+    uint16_t heading_cd;        // Course over ground in 0.01 degrees
+    char compass[4];            // Same text as the heading display, e.g. "NNE"
+    uint8_t satellites;         // Displayed count (brief zero dropouts filtered)
+    uint16_t hdop_x100;
+    uint16_t localYear;
+    uint8_t localMonth;
+    uint8_t localDay;
+    uint8_t localHour;          // 0-23
+    uint8_t localMinute;
+    uint8_t localSecond;
+    uint8_t localDayOfWeek;     // 1 = Sunday (TimeLib weekday())
+    bool locationValid;
+    bool altitudeValid;
+    bool headingValid;
+    bool timeValid;
+} GpsSnapshot;
+
+// One forecast hour of a weather hot packet
+typedef struct {
+    char hour[WX_HOUR_STR_SIZE];    // e.g. "10am"
+    char glyph[WX_GLYPH_STR_SIZE];  // Weather icon code
+    int16_t temp;                   // Whole degrees, clamped to -99..999
+    uint16_t precip;                // Hundredths (packet units); 0 is shown blank
+} WeatherForecastHour;
+
+// Parsed weather hot packet - fixed size, no heap, parsed in place in hotPacketWeather (TripleBuffer)
+typedef struct {
+    char rcvTime[HOT_PKT_RCV_TIME_STR_SIZE];  // Receive timestamp (formatGpsTimestamp)
+    bool valid;                               // false until the first packet is accepted
+    uint16_t seq;                             // Binary sequence number, 0 = unsequenced (deltas need a match)
+    int16_t curTemp;                          // Tenths of a degree, clamped to -99.0..999.0
+    bool curTempDecimal;                      // Sent with a decimal point ("100.0"), shown with one
+    WeatherForecastHour hours[WX_FORECAST_HOURS];
+} WeatherFrame;
+
+// One row of the Now Playing table
+typedef struct {
+    char venue[VENUE_NAME_STR_SIZE];
+    char event[VENUE_EVENT_STR_SIZE];
+} VenueEvent;
+
+// Parsed venue/event hot packet - parsed once in the callback task, in hotPacketVenue (TripleBuffer)
+typedef struct {
+    char rcvTime[HOT_PKT_RCV_TIME_STR_SIZE];  // Receive timestamp (formatGpsTimestamp)
+    uint32_t hash;                            // FNV-1a of the events - equal hash, same table
+    uint16_t seq;                             // Binary sequence number, 0 = unsequenced (deltas need a match)
+    uint8_t count;
+    VenueEvent events[VENUE_MAX_EVENTS];
+} VenueFrame;
+
+// One vertex of a geofence hot packet, as sent (decimal degrees)
+typedef struct {
+    char lat[GEOFENCE_COORD_STR_SIZE];
+    char lon[GEOFENCE_COORD_STR_SIZE];
+} GeofencePacketPoint;
+
+// Parsed geofence hot packet - applied to the geofence table, not kept
+typedef struct {
+    char name[GEOFENCE_NAME_LEN];
+    uint32_t radius_m;                                   // Circle radius; 0 for a polygon or a delete
+    uint8_t count;
+    GeofencePacketPoint points[GEOFENCE_PACKET_MAX_POINTS];
+} GeofenceFrame;
+
+// Latest geofence boundary crossing - published by gpsTask in geofenceEvents, shown by the GUI
+typedef struct {
+    char name[GEOFENCE_NAME_LEN];
+    bool entered;
+} GeofenceEvent;
+
 // Hot Packet Types
 enum HotPacketType {
     HOT_PACKET_WEATHER = 1,
-    HOT_PACKET_VENUE_EVENT = 2
+    HOT_PACKET_VENUE_EVENT = 2,
+    HOT_PACKET_GEOFENCE = 3
 };
 
 // ESP-NOW message types
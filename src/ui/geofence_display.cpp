@@ -0,0 +1,42 @@
+#include "geofence_display.h"
+#include <Arduino.h>
+#include "config.h"
+#include "globals.h"
+
+static uint32_t shown_generation = 0;   // Last geofenceEvents generation shown
+static lv_obj_t* toast = nullptr;
+static lv_timer_t* toast_timer = nullptr;
+
+static void toast_expired_cb(lv_timer_t* timer) {
+    lv_obj_del(toast);
+    toast = nullptr;
+    toast_timer = nullptr;  // One-shot timers delete themselves
+}
+
+static void showGeofenceToast(const GeofenceEvent& event) {
+    char text[GEOFENCE_NAME_LEN + 16];
+    snprintf(text, sizeof(text), "%s %s", event.entered ? "Entered" : "Left", event.name);
+
+    // A newer event replaces the one on screen and restarts its timer
+    if (toast == nullptr) {
+        toast = lv_label_create(lv_layer_top());
+        lv_obj_set_style_bg_color(toast, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(toast, LV_OPA_80, 0);
+        lv_obj_set_style_text_color(toast, lv_color_white(), 0);
+        lv_obj_set_style_pad_all(toast, 6, 0);
+        lv_obj_align(toast, LV_ALIGN_BOTTOM_MID, 0, -10);
+        toast_timer = lv_timer_create(toast_expired_cb, GEOFENCE_TOAST_MS, NULL);
+        lv_timer_set_repeat_count(toast_timer, 1);
+    } else {
+        lv_timer_reset(toast_timer);
+    }
+    lv_label_set_text(toast, text);
+}
+
+void checkGeofenceEvents() {
+    geofenceEvents.acquire();
+    if (geofenceEvents.readGeneration() == shown_generation) return;
+
+    shown_generation = geofenceEvents.readGeneration();
+    showGeofenceToast(geofenceEvents.readBuffer());
+}
@@ -0,0 +1,9 @@
+#ifndef GEOFENCE_DISPLAY_H
+#define GEOFENCE_DISPLAY_H
+
+#include <lvgl.h>
+
+// Show a geofence enter/exit published since the last call for GEOFENCE_TOAST_MS (cheap, call every GUI pass)
+void checkGeofenceEvents();
+
+#endif // GEOFENCE_DISPLAY_H
@@ -0,0 +1,99 @@
+#include "gps_health_display.h"
+#include <Arduino.h>
+#include "utils/gps_health.h"
+#include "tasks/track_task.h"
+
+static lv_obj_t* health_label = nullptr;
+static lv_timer_t* refresh_timer = nullptr;
+
+static void refreshHealthLabel(lv_timer_t* timer) {
+    if (!health_label) return;
+
+    GpsHealth h;
+    char text[256];
+    if (readGpsHealth(h)) {
+        formatGpsHealth(h, text, sizeof(text));
+    } else {
+        strlcpy(text, "Waiting for GPS task...", sizeof(text));
+    }
+    lv_label_set_text(health_label, text);
+}
+
+static void modal_delete_cb(lv_event_t* e) {
+    if (refresh_timer) {
+        lv_timer_delete(refresh_timer);
+        refresh_timer = nullptr;
+    }
+    health_label = nullptr;
+}
+
+static void close_btn_event_cb(lv_event_t* e) {
+    lv_obj_t* btn = (lv_obj_t*)lv_event_get_target(e);
+    lv_obj_del(lv_obj_get_parent(btn));
+}
+
+static void log_btn_event_cb(lv_event_t* e) {
+    printGpsHealth();
+}
+
+static void export_btn_event_cb(lv_event_t* e) {
+    requestTrackExport();
+}
+
+void showGpsHealthDialog() {
+    if (health_label) return;  // Already open
+
+    lv_obj_t* current_screen = lv_scr_act();
+
+    // Create modal window
+    lv_obj_t* modal = lv_obj_create(current_screen);
+    lv_obj_set_size(modal, 300, 220);
+    lv_obj_align(modal, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_add_event_cb(modal, modal_delete_cb, LV_EVENT_DELETE, NULL);
+
+    // Title
+    lv_obj_t* title = lv_label_create(modal);
+    lv_label_set_text(title, "GPS Health");
+    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 0);
+
+    // Counters
+    health_label = lv_label_create(modal);
+    lv_obj_align(health_label, LV_ALIGN_TOP_LEFT, 0, 20);
+    refreshHealthLabel(NULL);
+    refresh_timer = lv_timer_create(refreshHealthLabel, 1000, NULL);
+
+    // Log button - dumps the record to the debug port
+    lv_obj_t* log_btn = lv_btn_create(modal);
+    lv_obj_set_size(log_btn, 80, 30);
+    lv_obj_align(log_btn, LV_ALIGN_BOTTOM_LEFT, 20, 0);
+    lv_obj_t* log_label = lv_label_create(log_btn);
+    lv_label_set_text(log_label, "Log");
+    lv_obj_center(log_label);
+    lv_obj_add_event_cb(log_btn, log_btn_event_cb, LV_EVENT_CLICKED, NULL);
+
+    // Export button - streams the breadcrumb track log to the debug port
+    lv_obj_t* export_btn = lv_btn_create(modal);
+    lv_obj_set_size(export_btn, 80, 30);
+    lv_obj_align(export_btn, LV_ALIGN_BOTTOM_MID, 0, 0);
+    lv_obj_t* export_label = lv_label_create(export_btn);
+    lv_label_set_text(export_label, "Track");
+    lv_obj_center(export_label);
+    lv_obj_add_event_cb(export_btn, export_btn_event_cb, LV_EVENT_CLICKED, NULL);
+
+    // Close button
+    lv_obj_t* close_btn = lv_btn_create(modal);
+    lv_obj_set_size(close_btn, 80, 30);
+    lv_obj_align(close_btn, LV_ALIGN_BOTTOM_RIGHT, -20, 0);
+    lv_obj_t* close_label = lv_label_create(close_btn);
+    lv_label_set_text(close_label, "Close");
+    lv_obj_center(close_label);
+    lv_obj_add_event_cb(close_btn, close_btn_event_cb, LV_EVENT_CLICKED, NULL);
+}
+
+extern "C" void action_show_gps_health(lv_event_t *e) {
+    showGpsHealthDialog();
+}
+
+extern "C" void action_export_track(lv_event_t *e) {
+    requestTrackExport();
+}
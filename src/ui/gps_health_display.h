@@ -0,0 +1,13 @@
+#ifndef GPS_HEALTH_DISPLAY_H
+#define GPS_HEALTH_DISPLAY_H
+
+#include <lvgl.h>
+
+// Modal GPS diagnostics (parser, UART and fix-rate counters), refreshed once a second
+void showGpsHealthDialog();
+
+// EEZ Studio action handlers - bind to buttons on the settings/debug screen
+extern "C" void action_show_gps_health(lv_event_t *e);
+extern "C" void action_export_track(lv_event_t *e);
+
+#endif // GPS_HEALTH_DISPLAY_H
@@ -5,10 +5,25 @@
 
 // Static variables to track table state
 static lv_obj_t* current_venue_table_container = nullptr;
-static String last_displayed_data = "";
+static uint32_t displayed_generation = 0;  // Last hotPacketVenue generation checked
+static uint32_t displayed_hash = 0;        // VenueFrame::hash of the table on screen
 static bool is_now_playing_screen_active = false;
 
-void displayVenueEventTable(const char* dataString) {
+// Placeholder rows until the first venue/event packet arrives
+static const VenueFrame DEFAULT_VENUE_EVENTS = {
+    "", 0, 0, 5,
+    {{"Sawgrass", "NA"}, {"Spanish Springs", "NA"}, {"Lake Sumter", "NA"}, {"Brownwood", "NA"}, {"Sawgrass", "NA"}}
+};
+
+// The GUI task's venue/event frame, or the placeholders before the first packet
+static const VenueFrame& currentVenueEvents() {
+    if (hotPacketVenue.readGeneration() == 0) {
+        return DEFAULT_VENUE_EVENTS;
+    }
+    return hotPacketVenue.readBuffer();
+}
+
+void displayVenueEventTable(const VenueFrame& venues) {
     lv_obj_t * current_screen = lv_scr_act();
 
     // Clear existing table if it exists (for updates)
@@ -27,23 +42,7 @@ void displayVenueEventTable(const char* dataString) {
     // Disable container scrolling within the screen
     lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
     
-    // Count events
-    String dataStr = String(dataString);
-    int eventCount = 0;
-    int pos = 0;
-    
-    while (pos < dataStr.length()) {
-        int delimiterPos = dataStr.indexOf('#', pos);
-        if (delimiterPos == -1) break;
-        
-        String pair = dataStr.substring(pos, delimiterPos);
-        if (pair.indexOf(',') != -1) {
-            eventCount++;
-        }
-        pos = delimiterPos + 1;
-    }
-    
-    int maxEvents = min(eventCount, 12);
+    int maxEvents = venues.count;
     if (maxEvents == 0) maxEvents = 1;
     
     // Create table
@@ -76,31 +75,11 @@ void displayVenueEventTable(const char* dataString) {
     lv_obj_set_style_bg_color(table, lv_color_hex(0x9e9e9e), LV_PART_SCROLLBAR | LV_STATE_DEFAULT);
     lv_obj_set_style_radius(table, 8, LV_PART_SCROLLBAR | LV_STATE_DEFAULT);
     
-    // Parse and populate
+    // Populate from the rows parsed at receipt
     int row = 0;
-    int startPos = 0;
-    
-    while (startPos < dataStr.length() && row < maxEvents) {
-        int delimiterPos = dataStr.indexOf('#', startPos);
-        if (delimiterPos == -1) break;
-        
-        String pair = dataStr.substring(startPos, delimiterPos);
-        int commaPos = pair.indexOf(',');
-        
-        if (commaPos != -1) {
-            String venue = pair.substring(0, commaPos);
-            String event = pair.substring(commaPos + 1);
-            
-            venue.trim();
-            event.trim();
-            
-            lv_table_set_cell_value(table, row, 0, venue.c_str());
-            lv_table_set_cell_value(table, row, 1, event.c_str());
-            
-            row++;
-        }
-        
-        startPos = delimiterPos + 1;
+    for (; row < venues.count; row++) {
+        lv_table_set_cell_value(table, row, 0, venues.events[row].venue);
+        lv_table_set_cell_value(table, row, 1, venues.events[row].event);
     }
     
     if (row == 0) {
@@ -108,8 +87,7 @@ void displayVenueEventTable(const char* dataString) {
         lv_table_set_cell_value(table, 0, 1, "Available");
     }
     
-    // Store what we just displayed
-    last_displayed_data = String(dataString);
+    displayed_hash = venues.hash;
 
     Serial.printf("Table created with %d rows\n", maxEvents);
 }
@@ -118,28 +96,21 @@ extern "C" void action_display_now_playing(lv_event_t *e) {
     // Mark that we're now on the Now Playing screen
     is_now_playing_screen_active = true;
 
-    const char* dataToDisplay;
-
-    // Read from active buffer (no mutex needed - double buffering ensures lock-free reads)
-    int activeBuffer = hotPacketActiveBuffer;  // Snapshot current buffer
-    if (hotPacketBuffer_live_venue_event_data[activeBuffer].length() > 0) {
-        dataToDisplay = hotPacketBuffer_live_venue_event_data[activeBuffer].c_str();
+    // Stable until the GUI task's next acquire() - no copy or mutex needed
+    const VenueFrame& venues = currentVenueEvents();
+    displayed_generation = hotPacketVenue.readGeneration();
+    if (displayed_generation != 0) {
         Serial.println("Using live venue/event data from Meshtastic");
-    } else if (live_venue_event_data.length() > 0) {
-        // Fallback to legacy variable
-        dataToDisplay = live_venue_event_data.c_str();
-        Serial.println("Using legacy venue/event data from Meshtastic");
     } else {
-        dataToDisplay = "Sawgrass,NA#Spanish Springs,NA#Lake Sumter,NA#Brownwood,NA#Sawgrass,NA#";
         Serial.println("Using default data - no live Meshtastic data available");
     }
 
-    displayVenueEventTable(dataToDisplay);
+    displayVenueEventTable(venues);
 }
 
 void checkAndUpdateNowPlayingScreen() {
-    // Only check if we're on the Now Playing screen and have new data
-    if (!is_now_playing_screen_active || !new_rx_data_flag) {
+    // Only check if we're on the Now Playing screen and a newer packet has been acquired
+    if (!is_now_playing_screen_active || hotPacketVenue.readGeneration() == displayed_generation) {
         return;
     }
 
@@ -152,25 +123,15 @@ void checkAndUpdateNowPlayingScreen() {
         return;
     }
 
-    // Check if the data has actually changed
-    const char* currentData;
-
-    // Read from active buffer (no mutex needed - double buffering ensures lock-free reads)
-    int activeBuffer = hotPacketActiveBuffer;  // Snapshot current buffer
-    if (hotPacketBuffer_live_venue_event_data[activeBuffer].length() > 0) {
-        currentData = hotPacketBuffer_live_venue_event_data[activeBuffer].c_str();
-    } else if (live_venue_event_data.length() > 0) {
-        // Fallback to legacy variable
-        currentData = live_venue_event_data.c_str();
-    } else {
-        currentData = "Sawgrass,NA#Spanish Springs,NA#Lake Sumter,NA#Brownwood,NA#Sawgrass,NA#";
+    // A repeat of the lineup on screen only moves the generation on
+    displayed_generation = hotPacketVenue.readGeneration();
+    const VenueFrame& venues = currentVenueEvents();
+    if (venues.hash == displayed_hash) {
+        return;
     }
 
-    // Only refresh if data has changed
-    if (last_displayed_data != String(currentData)) {
-        Serial.println("Now Playing screen: Refreshing with new data");
-        displayVenueEventTable(currentData);
-    }
+    Serial.println("Now Playing screen: Refreshing with new data");
+    displayVenueEventTable(venues);
 }
 
 void onNowPlayingScreenExit() {
@@ -179,5 +140,6 @@ void onNowPlayingScreenExit() {
 
     // Clean up references
     current_venue_table_container = nullptr;
-    last_displayed_data = "";
+    displayed_generation = 0;
+    displayed_hash = 0;
 }
\ No newline at end of file
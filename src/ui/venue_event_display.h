@@ -2,10 +2,12 @@
 #define VENUE_EVENT_DISPLAY_H
 
 #include <lvgl.h>
+#include "types.h"
 
-void displayVenueEventTable(const char* dataString);
+// Build the Now Playing table from parsed venue/event rows
+void displayVenueEventTable(const VenueFrame& venues);
 
-// Check if the Now Playing screen needs updating and refresh if needed
+// Refresh the Now Playing screen if a newer, different venue/event packet has been acquired (cheap, call every GUI pass)
 void checkAndUpdateNowPlayingScreen();
 
 // Call when leaving the Now Playing screen
@@ -0,0 +1,113 @@
+#include "fix_assembler.h"
+#include <Arduino.h>
+#include "config.h"
+
+static const int32_t CS_PER_DAY = 24L * 60 * 60 * 100;
+
+static int32_t timeOfDayCs(const gps_fix& f) {
+    return ((f.dateTime.hours * 60L + f.dateTime.minutes) * 60L + f.dateTime.seconds) * 100L + f.dateTime_cs;
+}
+
+static const char* sentenceName(NMEAGPS::nmea_msg_t type) {
+    switch (type) {
+        case NMEAGPS::NMEA_GGA: return "GGA";
+        case NMEAGPS::NMEA_RMC: return "RMC";
+        case NMEAGPS::NMEA_VTG: return "VTG";
+        default: return "other";
+    }
+}
+
+/**
+ * Move the pending interval to ready() and measure its spacing from the last one
+ */
+void FixAssembler::complete() {
+    ready = pending;
+    pending.init();
+    pendingHasData = false;
+    completedThisInterval = true;
+
+    unsigned long nowMillis = millis();
+    uint32_t dtMs = 0;
+    if (intervalTimeCs >= 0 && readyTimeCs >= 0) {
+        int32_t dtCs = intervalTimeCs - readyTimeCs;
+        if (dtCs < 0) dtCs += CS_PER_DAY;  // Midnight UTC
+        dtMs = (uint32_t)dtCs * 10;
+    } else if (readyMillis != 0) {
+        dtMs = nowMillis - readyMillis;
+    }
+    readyIntervalMs = (dtMs <= GPS_MAX_FIX_GAP_MS) ? dtMs : 0;
+
+    readyTimeCs = intervalTimeCs;
+    readyMillis = nowMillis;
+}
+
+void FixAssembler::learnLastSentence(NMEAGPS::nmea_msg_t type) {
+    if (type == lastType || type == NMEAGPS::NMEA_UNKNOWN) {
+        candidateCount = 0;
+        return;
+    }
+
+    if (type == candidateType) {
+        candidateCount++;
+    } else {
+        candidateType = type;
+        candidateCount = 1;
+    }
+
+    if (candidateCount >= GPS_ORDER_LEARN_INTERVALS) {
+        lastType = type;
+        candidateCount = 0;
+        Serial.print("GPS: last sentence in interval is ");
+        Serial.println(sentenceName(type));
+    }
+}
+
+bool FixAssembler::add(const gps_fix& sentence, NMEAGPS::nmea_msg_t type) {
+    bool completed = false;
+
+    // Receiver has no time yet (GGA/RMC without it) - complete on every last sentence, as before
+    if (!sentence.valid.time && (type == NMEAGPS::NMEA_GGA || type == NMEAGPS::NMEA_RMC)) {
+        intervalTimeCs = -1;
+        completedThisInterval = false;
+    }
+
+    // A new time of day starts a new interval; the previous sentence ended the old one
+    if (sentence.valid.time) {
+        int32_t t = timeOfDayCs(sentence);
+        if (t != intervalTimeCs) {
+            if (intervalTimeCs >= 0) {
+                learnLastSentence(prevType);
+
+                if (pendingHasData) {
+                    if (completedThisInterval || type == lastType) {
+                        // Sentences after the guessed last one, or an interval that lost its
+                        // last sentence and would be reported together with this one - drop
+                        pending.init();
+                        pendingHasData = false;
+                        strays++;
+                    } else {
+                        complete();
+                        completed = true;
+                        late++;
+                    }
+                }
+            }
+            intervalTimeCs = t;
+            completedThisInterval = false;
+        }
+    }
+
+    if (pendingHasData) {
+        pending |= sentence;
+    } else {
+        pending = sentence;
+        pendingHasData = true;
+    }
+    prevType = type;
+
+    if (type == lastType && !completedThisInterval) {
+        complete();
+        return true;
+    }
+    return completed;
+}
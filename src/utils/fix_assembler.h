@@ -0,0 +1,61 @@
+#ifndef FIX_ASSEMBLER_H
+#define FIX_ASSEMBLER_H
+
+#include <NMEAGPS.h>
+
+/**
+ * Merges per-sentence NeoGPS fixes (NO_MERGING) into one fix per receiver
+ * update interval, at any fix rate and in any sentence order
+ *
+ * Interval boundaries come from the sentence timestamps: a GGA/RMC carrying
+ * a new time of day starts a new interval. The sentence type seen just before
+ * each boundary is learned as the interval's last sentence (after
+ * GPS_ORDER_LEARN_INTERVALS consistent intervals), and from then on the fix
+ * is completed as soon as that sentence arrives instead of waiting for the
+ * next interval. LAST_SENTENCE_IN_INTERVAL from NMEAGPS_cfg.h is only the
+ * starting guess.
+ *
+ * intervalMs() is the measured time between this fix and the previous one,
+ * from the fix timestamps (centisecond resolution, so exact at 5 or 10 Hz),
+ * or from millis() when a fix has no time. It is 0 for the first fix and
+ * after a gap longer than GPS_MAX_FIX_GAP_MS; consumers then fall back to the
+ * nominal 1 / GPS_FIX_RATE_HZ step or skip integrating across the gap.
+ */
+class FixAssembler {
+public:
+    // Feed one parsed sentence; returns true when fix() holds a completed interval
+    bool add(const gps_fix& sentence, NMEAGPS::nmea_msg_t type);
+
+    const gps_fix& fix() const { return ready; }
+    uint32_t intervalMs() const { return readyIntervalMs; }
+    NMEAGPS::nmea_msg_t lastSentence() const { return lastType; }
+
+    // Completed only when the next interval began (last sentence not yet learned)
+    uint32_t lateFixes() const { return late; }
+    // Sentences that arrived after their interval was completed and were dropped
+    uint32_t strayedSentences() const { return strays; }
+
+private:
+    void complete();
+    void learnLastSentence(NMEAGPS::nmea_msg_t type);
+
+    gps_fix pending;
+    gps_fix ready;
+    bool pendingHasData = false;
+    bool completedThisInterval = false;
+    int32_t intervalTimeCs = -1;     // Time of day of the interval being assembled, -1 if unknown
+
+    NMEAGPS::nmea_msg_t prevType = NMEAGPS::NMEA_UNKNOWN;
+    NMEAGPS::nmea_msg_t lastType = LAST_SENTENCE_IN_INTERVAL;
+    NMEAGPS::nmea_msg_t candidateType = NMEAGPS::NMEA_UNKNOWN;
+    uint8_t candidateCount = 0;
+
+    int32_t readyTimeCs = -1;        // Previous completed fix, for intervalMs()
+    unsigned long readyMillis = 0;
+    uint32_t readyIntervalMs = 0;
+
+    uint32_t late = 0;
+    uint32_t strays = 0;
+};
+
+#endif // FIX_ASSEMBLER_H
@@ -0,0 +1,47 @@
+#include "format_utils.h"
+
+char* fmtUint(char* dst, uint32_t value, uint8_t minDigits) {
+    char digits[10];
+    uint8_t n = 0;
+    do {
+        digits[n++] = '0' + (value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    while (minDigits > n) {
+        *dst++ = '0';
+        minDigits--;
+    }
+    while (n > 0) {
+        *dst++ = digits[--n];
+    }
+    *dst = '\0';
+    return dst;
+}
+
+char* fmtFixed(char* dst, int32_t value, uint8_t decimals) {
+    uint32_t magnitude = (value < 0) ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    if (value < 0) {
+        *dst++ = '-';
+    }
+
+    uint32_t scale = 1;
+    for (uint8_t i = 0; i < decimals; i++) {
+        scale *= 10;
+    }
+
+    dst = fmtUint(dst, magnitude / scale);
+    if (decimals > 0) {
+        *dst++ = '.';
+        dst = fmtUint(dst, magnitude % scale, decimals);
+    }
+    return dst;
+}
+
+char* fmtStr(char* dst, const char* src) {
+    while (*src) {
+        *dst++ = *src++;
+    }
+    *dst = '\0';
+    return dst;
+}
@@ -0,0 +1,23 @@
+#ifndef FORMAT_UTILS_H
+#define FORMAT_UTILS_H
+
+#include <stdint.h>
+
+/**
+ * Allocation-free number formatting for fixed-size display buffers
+ *
+ * Each function writes at dst, NUL-terminates, and returns a pointer to the
+ * terminator so calls can be chained. Callers size the buffers; the longest
+ * output is 12 chars for fmtFixed(INT32_MIN, ...).
+ */
+
+// Unsigned decimal, zero-padded to at least minDigits
+char* fmtUint(char* dst, uint32_t value, uint8_t minDigits = 1);
+
+// Signed fixed-point: value is scaled by 10^decimals, e.g. fmtFixed(buf, -81234567, 6) -> "-81.234567"
+char* fmtFixed(char* dst, int32_t value, uint8_t decimals);
+
+// Copy a C string (no length check - caller's buffer must fit)
+char* fmtStr(char* dst, const char* src);
+
+#endif // FORMAT_UTILS_H
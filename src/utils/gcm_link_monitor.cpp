@@ -0,0 +1,114 @@
+#include "gcm_link_monitor.h"
+
+const char* GcmLinkMonitor::stateName(GcmLinkState state) {
+    switch (state) {
+        case GCM_LINK_UP:
+            return "up";
+        case GCM_LINK_DEGRADED:
+            return "degraded";
+        case GCM_LINK_DOWN:
+            return "down";
+    }
+    return "?";
+}
+
+void GcmLinkMonitor::setState(GcmLinkState next, uint32_t nowMs) {
+    if (next == state()) {
+        return;
+    }
+    if (next == GCM_LINK_DOWN) {
+        counters.downs++;
+    }
+    counters.stateSinceMs = nowMs;
+    linkState.store(next, std::memory_order_relaxed);
+}
+
+void GcmLinkMonitor::answered(uint32_t nowMs) {
+    uint32_t rtt = nowMs - probeAtMs;
+    probing = false;
+    failures = 0;
+    counters.answered++;
+    counters.rttLastMs = rtt;
+    counters.rttTotalMs += rtt;
+    if (counters.answered == 1 || rtt < counters.rttMinMs) {
+        counters.rttMinMs = rtt;
+    }
+    if (rtt > counters.rttMaxMs) {
+        counters.rttMaxMs = rtt;
+    }
+    if (rtt > cfg.slowMs) {
+        counters.slow++;
+        setState(GCM_LINK_DEGRADED, nowMs);
+    } else {
+        setState(GCM_LINK_UP, nowMs);
+    }
+}
+
+void GcmLinkMonitor::timedOut(uint32_t nowMs) {
+    probing = false;
+    counters.timedOut++;
+    if (heardDuringProbe) {
+        // Something is there but didn't answer: busy radio or a garbled line
+        failures = 0;
+        setState(GCM_LINK_DEGRADED, nowMs);
+    } else if (++failures >= cfg.downAfter) {
+        setState(GCM_LINK_DOWN, nowMs);
+    } else {
+        setState(GCM_LINK_DEGRADED, nowMs);
+    }
+}
+
+bool GcmLinkMonitor::poll(uint32_t nowMs, const Activity& activity) {
+    if (!started) {
+        seen = activity;
+        started = true;
+        counters.lastFrameMs = nowMs;
+        counters.stateSinceMs = nowMs;
+        return false;
+    }
+    bool newBytes = activity.bytes != seen.bytes;
+    bool newFrames = activity.frames != seen.frames;
+    bool completed = activity.configCompletes != seen.configCompletes;
+    seen = activity;
+    if (newFrames) {
+        counters.lastFrameMs = nowMs;
+    }
+
+    if (probing) {
+        // The reply's frames count for nothing until its config_complete_id
+        heardDuringProbe |= newBytes;
+        if (completed) {
+            answered(nowMs);
+        } else if (nowMs - probeAtMs >= cfg.probeTimeoutMs) {
+            timedOut(nowMs);
+        }
+        return false;
+    }
+
+    if (newFrames) {
+        failures = 0;
+        setState(GCM_LINK_UP, nowMs);
+        return false;
+    }
+    if (state() == GCM_LINK_DOWN) {
+        return nowMs - probeAtMs >= cfg.downProbeMs;
+    }
+    if (failures > 0) {
+        return true;  // Retry straight after a timeout until down
+    }
+    return nowMs - counters.lastFrameMs >= cfg.silenceMs && nowMs - probeAtMs >= cfg.silenceMs;
+}
+
+void GcmLinkMonitor::probeSent(uint32_t nowMs) {
+    probing = true;
+    heardDuringProbe = false;
+    probeAtMs = nowMs;
+    counters.probes++;
+}
+
+void GcmLinkMonitor::reset() {
+    started = false;
+    probing = false;
+    failures = 0;
+    linkState.store(GCM_LINK_UP, std::memory_order_relaxed);
+}
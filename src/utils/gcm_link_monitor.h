@@ -0,0 +1,95 @@
+#ifndef GCM_LINK_MONITOR_H
+#define GCM_LINK_MONITOR_H
+
+#include <atomic>
+#include <stdint.h>
+#include "config.h"
+
+enum GcmLinkState : uint8_t {
+    GCM_LINK_UP,        // Frames arriving, or the last probe was answered in time
+    GCM_LINK_DEGRADED,  // Last probe answered slowly, or unanswered while something was still received
+    GCM_LINK_DOWN,      // downAfter probes in a row unanswered with nothing received at all
+};
+
+/**
+ * Liveness of the serial link to the GCM (the Meshtastic radio)
+ *
+ * The radio never answers the heartbeat, so silence alone can't tell a quiet
+ * mesh from a dead radio (see ANALYSIS_GCM_DISCONNECT_DETECTION.md). Any frame
+ * received shows the link up. After silenceMs without one the monitor asks
+ * for a probe - mt_send_config_probe(), a config-only want_config_id that the
+ * radio answers with config_complete_id - and times the reply.
+ *
+ * A reply slower than slowMs, or a probe that times out while bytes or frames
+ * still arrive (garbled line, radio busy), makes the link degraded. downAfter
+ * timeouts in a row with nothing received make it down; it is then probed
+ * every downProbeMs until it answers or frames arrive again.
+ *
+ * Fed the mt_get_rx_stats() counters, so the native_gcmlink fake radio test
+ * runs the same code. poll() and probeSent() are for the meshtastic task
+ * only; state() may be read from any task.
+ */
+class GcmLinkMonitor {
+public:
+    struct Config {
+        uint32_t silenceMs = GCM_LINK_SILENCE_MS;
+        uint32_t probeTimeoutMs = GCM_LINK_PROBE_TIMEOUT_MS;
+        uint32_t slowMs = GCM_LINK_SLOW_MS;
+        uint32_t downAfter = GCM_LINK_DOWN_AFTER;
+        uint32_t downProbeMs = GCM_LINK_DOWN_PROBE_MS;
+    };
+
+    // Receive counters since boot (mt_rx_stats_t bytes, frames, config_completes)
+    struct Activity {
+        uint32_t bytes;
+        uint32_t frames;
+        uint32_t configCompletes;
+    };
+
+    struct Stats {
+        uint32_t probes;          // Sent
+        uint32_t answered;        // ... with config_complete_id within probeTimeoutMs
+        uint32_t slow;            // ... of which took longer than slowMs
+        uint32_t timedOut;
+        uint32_t downs;           // Times the link went down
+        uint32_t rttLastMs;       // Probe round trips (answered ones)
+        uint32_t rttMinMs;
+        uint32_t rttMaxMs;
+        uint32_t rttTotalMs;      // Divide by answered
+        uint32_t lastFrameMs;     // When a frame last arrived
+        uint32_t stateSinceMs;    // When the current state began
+    };
+
+    GcmLinkMonitor() = default;
+    explicit GcmLinkMonitor(const Config& config) : cfg(config) {}
+
+    // Every meshtastic task loop with the current counters; true means send a probe now
+    // and call probeSent()
+    bool poll(uint32_t nowMs, const Activity& activity);
+    void probeSent(uint32_t nowMs);
+
+    // Serial link closed; the next poll() starts over with the link up
+    void reset();
+
+    GcmLinkState state() const { return (GcmLinkState)linkState.load(std::memory_order_relaxed); }
+    const Stats& stats() const { return counters; }
+
+    static const char* stateName(GcmLinkState state);
+
+private:
+    void setState(GcmLinkState next, uint32_t nowMs);
+    void answered(uint32_t nowMs);
+    void timedOut(uint32_t nowMs);
+
+    Config cfg;
+    Activity seen = {};
+    bool started = false;
+    bool probing = false;
+    bool heardDuringProbe = false;   // Bytes arrived while the probe was outstanding
+    uint32_t probeAtMs = 0;
+    uint32_t failures = 0;           // Probes in a row that timed out with nothing received
+    Stats counters = {};
+    std::atomic<uint8_t> linkState{GCM_LINK_UP};
+};
+
+#endif // GCM_LINK_MONITOR_H
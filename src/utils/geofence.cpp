@@ -0,0 +1,362 @@
+#include "geofence.h"
+#include "utils/odometer.h"
+
+// Mean Earth radius expressed as 1e-7 degrees of arc per metre (inverse of ~11.12 mm per 1e-7 degree)
+static const float DEG_E7_PER_M = 1e7 / (6371008.8 * M_PI / 180.0);
+
+GeofenceEngine geofences;
+
+GeofenceEngine::~GeofenceEngine() {
+    free(fences);
+    free(vertices);
+    free(insideBits);
+    free(bucketEntries);
+    free(largeFences);
+}
+
+/**
+ * Capacity to grow to for needed entries: doubles (from 8) so adding fences
+ * one at a time reallocates rarely, capped at limit
+ */
+static uint16_t grownCapacity(uint32_t needed, uint16_t current, uint16_t limit) {
+    if (needed <= current) return current;
+    uint32_t grown = max(max(needed, (uint32_t)current * 2), (uint32_t)8);
+    return (uint16_t)min(grown, (uint32_t)limit);  // Below needed when full; the caller rejects that
+}
+
+bool GeofenceEngine::reserve(uint16_t fenceCapacity, uint16_t vertexCapacity) {
+    if (fenceCapacity > maxFenceCount) {
+        uint16_t oldWords = (maxFenceCount + 31) / 32;
+        uint16_t newWords = (fenceCapacity + 31) / 32;
+        geofence_t* newFences = (geofence_t*)realloc(fences, fenceCapacity * sizeof(geofence_t));
+        if (newFences != NULL) fences = newFences;
+        uint32_t* newBits = (uint32_t*)realloc(insideBits, newWords * sizeof(uint32_t));
+        if (newBits != NULL) insideBits = newBits;
+        uint16_t* newLarge = (uint16_t*)realloc(largeFences, fenceCapacity * sizeof(uint16_t));
+        if (newLarge != NULL) largeFences = newLarge;
+
+        if (newFences == NULL || newBits == NULL || newLarge == NULL) {
+            // Whatever did grow is kept; the capacity stays at the old size
+            Serial.println("Geofence: out of memory");
+            return false;
+        }
+        memset(&insideBits[oldWords], 0, (newWords - oldWords) * sizeof(uint32_t));
+        maxFenceCount = fenceCapacity;
+    }
+
+    if (vertexCapacity > maxVertexCount) {
+        geoPoint_t* newVertices = (geoPoint_t*)realloc(vertices, vertexCapacity * sizeof(geoPoint_t));
+        if (newVertices == NULL) {
+            Serial.println("Geofence: out of memory");
+            return false;
+        }
+        vertices = newVertices;
+        maxVertexCount = vertexCapacity;
+    }
+    return true;
+}
+
+void GeofenceEngine::clear() {
+    fenceCount = 0;
+    vertexUsed = 0;
+    if (insideBits != NULL) {
+        memset(insideBits, 0, ((maxFenceCount + 31) / 32) * sizeof(uint32_t));
+    }
+    indexDirty = true;
+}
+
+/**
+ * Floor division onto the grid (works for negative coordinates)
+ */
+static int32_t cellOf(int32_t e7) {
+    int64_t v = e7;
+    return (int32_t)((v >= 0) ? v / GEOFENCE_CELL_E7 : -((-v + GEOFENCE_CELL_E7 - 1) / GEOFENCE_CELL_E7));
+}
+
+static uint16_t bucketOf(int32_t cellLat, int32_t cellLon) {
+    return (((uint32_t)cellLat * 73856093u) ^ ((uint32_t)cellLon * 19349663u)) & (GEOFENCE_HASH_BUCKETS - 1);
+}
+
+/**
+ * Even-odd ray test in raw lat/lon - containment is unaffected by the
+ * longitude scale, so no projection is needed
+ */
+static bool polygonContains(const geoPoint_t* v, uint8_t n, int32_t lat, int32_t lon) {
+    bool inside = false;
+    for (uint8_t i = 0, j = n - 1; i < n; j = i++) {
+        if ((v[i].lat > lat) != (v[j].lat > lat)) {
+            int64_t edgeLon = (int64_t)v[i].lon +
+                              ((int64_t)v[j].lon - v[i].lon) * ((int64_t)lat - v[i].lat) / ((int64_t)v[j].lat - v[i].lat);
+            if (lon < edgeLon) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+void GeofenceEngine::computeBounds(geofence_t& f) {
+    if (f.shape == GEOFENCE_CIRCLE) {
+        int32_t dLat = (int32_t)(f.radius_m * DEG_E7_PER_M) + 1;
+        float cosLat = cosf(f.lat * (float)(M_PI / 180.0 / 1e7));
+        int32_t dLon = (cosLat > 0.01) ? (int32_t)(dLat / cosLat) + 1 : INT32_MAX / 2;
+        f.minLat = f.lat - dLat;
+        f.maxLat = f.lat + dLat;
+        f.minLon = (f.lon > INT32_MIN / 2 + dLon) ? f.lon - dLon : INT32_MIN / 2;
+        f.maxLon = (f.lon < INT32_MAX / 2 - dLon) ? f.lon + dLon : INT32_MAX / 2;
+    } else {
+        const geoPoint_t* v = &vertices[f.firstVertex];
+        f.minLat = f.maxLat = v[0].lat;
+        f.minLon = f.maxLon = v[0].lon;
+        for (uint8_t i = 1; i < f.vertexCount; i++) {
+            f.minLat = min(f.minLat, v[i].lat);
+            f.maxLat = max(f.maxLat, v[i].lat);
+            f.minLon = min(f.minLon, v[i].lon);
+            f.maxLon = max(f.maxLon, v[i].lon);
+        }
+    }
+}
+
+int GeofenceEngine::addCircle(const char* name, int32_t lat, int32_t lon, uint32_t radius_m) {
+    if (radius_m == 0) return -1;
+    if (!reserve(grownCapacity(fenceCount + 1, maxFenceCount, GEOFENCE_MAX_FENCES), maxVertexCount)) return -1;
+    if (fenceCount >= maxFenceCount) return -1;
+
+    geofence_t& f = fences[fenceCount];
+    memset(&f, 0, sizeof(f));
+    strlcpy(f.name, name, sizeof(f.name));
+    f.shape = GEOFENCE_CIRCLE;
+    f.lat = lat;
+    f.lon = lon;
+    f.radius_m = radius_m;
+    computeBounds(f);
+
+    setInside(fenceCount, false);
+    indexDirty = true;
+    return fenceCount++;
+}
+
+int GeofenceEngine::addPolygon(const char* name, const geoPoint_t* points, uint8_t count) {
+    if (count < 3) return -1;
+    if (!reserve(grownCapacity(fenceCount + 1, maxFenceCount, GEOFENCE_MAX_FENCES),
+                 grownCapacity(vertexUsed + count, maxVertexCount, GEOFENCE_MAX_VERTICES))) {
+        return -1;
+    }
+    if (fenceCount >= maxFenceCount || vertexUsed + count > maxVertexCount) return -1;
+
+    geofence_t& f = fences[fenceCount];
+    memset(&f, 0, sizeof(f));
+    strlcpy(f.name, name, sizeof(f.name));
+    f.shape = GEOFENCE_POLYGON;
+    f.vertexCount = count;
+    f.firstVertex = vertexUsed;
+    memcpy(&vertices[vertexUsed], points, count * sizeof(geoPoint_t));
+    vertexUsed += count;
+    computeBounds(f);
+
+    setInside(fenceCount, false);
+    indexDirty = true;
+    return fenceCount++;
+}
+
+int GeofenceEngine::find(const char* name) const {
+    for (uint16_t i = 0; i < fenceCount; i++) {
+        if (strncmp(fences[i].name, name, GEOFENCE_NAME_LEN) == 0) return i;
+    }
+    return -1;
+}
+
+bool GeofenceEngine::remove(uint16_t index) {
+    if (index >= fenceCount) return false;
+
+    // Close the gap in the vertex pool and re-point the polygons above it
+    const geofence_t& f = fences[index];
+    if (f.shape == GEOFENCE_POLYGON) {
+        uint16_t first = f.firstVertex;
+        uint16_t n = f.vertexCount;
+        memmove(&vertices[first], &vertices[first + n], (vertexUsed - first - n) * sizeof(geoPoint_t));
+        vertexUsed -= n;
+        for (uint16_t i = 0; i < fenceCount; i++) {
+            if (fences[i].shape == GEOFENCE_POLYGON && fences[i].firstVertex > first) {
+                fences[i].firstVertex -= n;
+            }
+        }
+    }
+
+    for (uint16_t i = index; i + 1 < fenceCount; i++) {
+        fences[i] = fences[i + 1];
+        setInside(i, isInside(i + 1));
+    }
+    fenceCount--;
+    setInside(fenceCount, false);
+    indexDirty = true;
+    return true;
+}
+
+bool GeofenceEngine::restored(uint16_t newFenceCount, uint16_t newVertexCount) {
+    if (newFenceCount > maxFenceCount || newVertexCount > maxVertexCount) {
+        clear();
+        return false;
+    }
+
+    for (uint16_t i = 0; i < newFenceCount; i++) {
+        geofence_t& f = fences[i];
+        f.name[GEOFENCE_NAME_LEN - 1] = '\0';
+        bool valid = (f.shape == GEOFENCE_CIRCLE && f.radius_m > 0) ||
+                     (f.shape == GEOFENCE_POLYGON && f.vertexCount >= 3 &&
+                      f.firstVertex + f.vertexCount <= newVertexCount);
+        if (!valid) {
+            clear();
+            return false;
+        }
+    }
+
+    fenceCount = newFenceCount;
+    vertexUsed = newVertexCount;
+    for (uint16_t i = 0; i < fenceCount; i++) {
+        computeBounds(fences[i]);
+    }
+    memset(insideBits, 0, ((maxFenceCount + 31) / 32) * sizeof(uint32_t));
+    indexDirty = true;
+    return true;
+}
+
+/**
+ * Grid cells covered by a fence's bounding box; false if it covers more than
+ * GEOFENCE_MAX_CELLS_PER_FENCE (such fences are tested on every fix instead)
+ */
+bool GeofenceEngine::cellRange(const geofence_t& f, int32_t& y0, int32_t& y1, int32_t& x0, int32_t& x1) const {
+    y0 = cellOf(f.minLat);
+    y1 = cellOf(f.maxLat);
+    x0 = cellOf(f.minLon);
+    x1 = cellOf(f.maxLon);
+    int64_t cells = (int64_t)(y1 - y0 + 1) * (x1 - x0 + 1);
+    return cells <= GEOFENCE_MAX_CELLS_PER_FENCE;
+}
+
+void GeofenceEngine::rebuildIndex() {
+    int32_t y0, y1, x0, x1;
+
+    // Pass 1: count entries per bucket
+    memset(bucketStart, 0, sizeof(bucketStart));
+    largeCount = 0;
+    for (uint16_t i = 0; i < fenceCount; i++) {
+        if (!cellRange(fences[i], y0, y1, x0, x1)) {
+            largeFences[largeCount++] = i;
+            continue;
+        }
+        for (int32_t y = y0; y <= y1; y++) {
+            for (int32_t x = x0; x <= x1; x++) {
+                bucketStart[bucketOf(y, x)]++;
+            }
+        }
+    }
+
+    // Running totals: bucketStart[b] = end of bucket b
+    uint32_t total = 0;
+    for (uint16_t b = 0; b < GEOFENCE_HASH_BUCKETS; b++) {
+        total += bucketStart[b];
+        bucketStart[b] = total;
+    }
+    bucketStart[GEOFENCE_HASH_BUCKETS] = total;
+
+    free(bucketEntries);
+    bucketEntries = (uint16_t*)malloc(max(total, (uint32_t)1) * sizeof(uint16_t));
+    if (bucketEntries == NULL) {
+        Serial.println("Geofence: out of memory building index");
+        memset(bucketStart, 0, sizeof(bucketStart));
+        return;
+    }
+
+    // Pass 2: fill from the back so bucketStart[b] ends up at the start of bucket b
+    for (uint16_t i = 0; i < fenceCount; i++) {
+        if (!cellRange(fences[i], y0, y1, x0, x1)) continue;
+        for (int32_t y = y0; y <= y1; y++) {
+            for (int32_t x = x0; x <= x1; x++) {
+                bucketEntries[--bucketStart[bucketOf(y, x)]] = i;
+            }
+        }
+    }
+
+    indexDirty = false;
+}
+
+bool GeofenceEngine::isInside(uint16_t index) const {
+    return (insideBits[index >> 5] >> (index & 31)) & 1;
+}
+
+void GeofenceEngine::setInside(uint16_t index, bool inside) {
+    if (inside) {
+        insideBits[index >> 5] |= (1UL << (index & 31));
+    } else {
+        insideBits[index >> 5] &= ~(1UL << (index & 31));
+    }
+}
+
+bool GeofenceEngine::isInside(const NeoGPS::Location_t& location, uint16_t index) const {
+    const geofence_t& f = fences[index];
+    int32_t lat = location.lat();
+    int32_t lon = location.lon();
+
+    if (lat < f.minLat || lat > f.maxLat || lon < f.minLon || lon > f.maxLon) {
+        return false;
+    }
+
+    if (f.shape == GEOFENCE_CIRCLE) {
+        NeoGPS::Location_t centre(f.lat, f.lon);
+        return (uint64_t)segmentDistanceMm(location, centre) <= (uint64_t)f.radius_m * 1000;
+    }
+    return polygonContains(&vertices[f.firstVertex], f.vertexCount, lat, lon);
+}
+
+static void reportEvent(const geofence_t& f, bool entered, geofenceEventCallback_t cb) {
+    Serial.print(entered ? "*** ENTERED geo-fence '" : "*** LEFT geo-fence '");
+    Serial.print(f.name);
+    Serial.println("' ***");
+
+    if (cb != NULL) {
+        cb(f, entered);
+    }
+}
+
+void GeofenceEngine::testCandidate(uint16_t index, const NeoGPS::Location_t& location) {
+    if (isInside(index)) return;  // Already re-tested this fix
+
+    lastCandidates++;
+    if (isInside(location, index)) {
+        setInside(index, true);
+        reportEvent(fences[index], true, eventCallback);
+    }
+}
+
+void GeofenceEngine::update(const NeoGPS::Location_t& location) {
+    lastCandidates = 0;
+    if (fenceCount == 0) return;
+
+    if (indexDirty) {
+        rebuildIndex();
+    }
+
+    // Fences we were inside may be left from any cell, so re-test them first
+    for (uint16_t w = 0; w < (fenceCount + 31) / 32; w++) {
+        uint32_t bits = insideBits[w];
+        while (bits != 0) {
+            uint16_t index = w * 32 + __builtin_ctz(bits);
+            bits &= bits - 1;
+            lastCandidates++;
+            if (!isInside(location, index)) {
+                setInside(index, false);
+                reportEvent(fences[index], false, eventCallback);
+            }
+        }
+    }
+
+    // Then the fences registered in this fix's grid cell, plus the oversize ones
+    uint16_t b = bucketOf(cellOf(location.lat()), cellOf(location.lon()));
+    for (uint32_t k = bucketStart[b]; k < bucketStart[b + 1]; k++) {
+        testCandidate(bucketEntries[k], location);
+    }
+    for (uint16_t k = 0; k < largeCount; k++) {
+        testCandidate(largeFences[k], location);
+    }
+}
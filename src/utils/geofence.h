@@ -0,0 +1,117 @@
+#ifndef GEOFENCE_H
+#define GEOFENCE_H
+
+#include <Arduino.h>
+#include <NMEAGPS.h>
+#include "config.h"
+
+typedef enum {
+    GEOFENCE_CIRCLE = 0,
+    GEOFENCE_POLYGON = 1
+} geofenceShape_t;
+
+// Polygon vertex (1e-7 degrees, same units as NeoGPS::Location_t)
+typedef struct {
+    int32_t lat;
+    int32_t lon;
+} geoPoint_t;
+
+// Fence record - plain data, written to flash as-is by geofence_storage
+typedef struct {
+    char name[GEOFENCE_NAME_LEN];
+    uint8_t shape;                 // geofenceShape_t
+    uint8_t vertexCount;           // Polygon: number of vertices
+    uint16_t firstVertex;          // Polygon: index of first vertex in the shared pool
+    int32_t lat;                   // Circle: centre (1e-7 degrees)
+    int32_t lon;
+    uint32_t radius_m;             // Circle: radius
+    int32_t minLat, maxLat;        // Bounding box, computed by the engine
+    int32_t minLon, maxLon;
+} geofence_t;
+
+// Called from gpsTask when a fix crosses a fence boundary (gpsMutex held)
+typedef void (*geofenceEventCallback_t)(const geofence_t& fence, bool entered);
+
+/**
+ * Geofence engine - circles and polygons with a grid spatial hash
+ *
+ * Tables start empty and grow as fences are added, up to GEOFENCE_MAX_FENCES
+ * and GEOFENCE_MAX_VERTICES, so a unit with no fences costs no heap.
+ *
+ * Fence bounding boxes are rasterised onto a uniform lat/lon grid
+ * (GEOFENCE_CELL_E7) whose cells hash into GEOFENCE_HASH_BUCKETS lists, so
+ * each fix tests only the fences registered in its own cell plus the ones it
+ * is currently inside (to catch exits). Hash collisions only add candidates,
+ * which the bounding-box check rejects cheaply.
+ *
+ * Owned by gpsTask: add/clear fences before the task starts or with gpsMutex
+ * held. The index is rebuilt lazily on the next update() after a change.
+ */
+class GeofenceEngine {
+public:
+    ~GeofenceEngine();
+
+    // Grow the tables to hold at least this many fences/vertices (never shrinks)
+    bool reserve(uint16_t fenceCapacity, uint16_t vertexCapacity);
+
+    void clear();
+
+    // Return the new fence index, or -1 if full or invalid
+    int addCircle(const char* name, int32_t lat, int32_t lon, uint32_t radius_m);
+    int addPolygon(const char* name, const geoPoint_t* points, uint8_t count);
+
+    // Index of the fence with this name, or -1
+    int find(const char* name) const;
+
+    // Delete a fence; later fences move down one index (no exit event fires)
+    bool remove(uint16_t index);
+
+    // Test a fix against nearby fences and fire enter/exit events
+    void update(const NeoGPS::Location_t& location);
+
+    bool isInside(uint16_t index) const;
+    bool isInside(const NeoGPS::Location_t& location, uint16_t index) const;
+    uint16_t count() const { return fenceCount; }
+    const geofence_t& fence(uint16_t index) const { return fences[index]; }
+    void setEventCallback(geofenceEventCallback_t cb) { eventCallback = cb; }
+
+    // Candidates shape-tested by the last update() (for benchmarking)
+    uint16_t lastCandidateCount() const { return lastCandidates; }
+
+    // Raw table access for geofence_storage; reserve(), fill, then call restored()
+    geofence_t* fenceTable() { return fences; }
+    geoPoint_t* vertexPool() { return vertices; }
+    uint16_t vertexCount() const { return vertexUsed; }
+    uint16_t fenceCapacity() const { return maxFenceCount; }
+    uint16_t vertexCapacity() const { return maxVertexCount; }
+    bool restored(uint16_t fenceCount, uint16_t vertexCount);
+
+private:
+    void computeBounds(geofence_t& f);
+    void rebuildIndex();
+    bool cellRange(const geofence_t& f, int32_t& y0, int32_t& y1, int32_t& x0, int32_t& x1) const;
+    void testCandidate(uint16_t index, const NeoGPS::Location_t& location);
+    void setInside(uint16_t index, bool inside);
+
+    geofence_t* fences = NULL;
+    geoPoint_t* vertices = NULL;
+    uint32_t* insideBits = NULL;
+    uint16_t maxFenceCount = 0;
+    uint16_t maxVertexCount = 0;
+    uint16_t fenceCount = 0;
+    uint16_t vertexUsed = 0;
+
+    // Spatial hash: bucketStart[b]..bucketStart[b + 1] indexes bucketEntries
+    uint32_t bucketStart[GEOFENCE_HASH_BUCKETS + 1];
+    uint16_t* bucketEntries = NULL;
+    uint16_t* largeFences = NULL;   // Fences spanning too many cells, tested on every fix
+    uint16_t largeCount = 0;
+    bool indexDirty = true;
+
+    uint16_t lastCandidates = 0;
+    geofenceEventCallback_t eventCallback = NULL;
+};
+
+extern GeofenceEngine geofences;
+
+#endif // GEOFENCE_H
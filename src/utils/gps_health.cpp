@@ -0,0 +1,162 @@
+#include "gps_health.h"
+#include <Arduino.h>
+#include "config.h"
+#include "globals.h"
+#include "hardware/gps_transport.h"
+
+// Once-per-second samples of the totals; the oldest one is the start of the window
+typedef struct {
+    GpsHealthCounters counters;
+    uint32_t sampleMillis;
+    uint32_t maxMutexWaitMs;     // Longest wait during the second ending at this sample
+} healthSample_t;
+
+static healthSample_t history[GPS_HEALTH_WINDOW_SECS + 1];
+static uint16_t historyHead = 0;     // Next slot to write
+static uint16_t historyCount = 0;
+
+static uint32_t fixCount = 0;
+static uint32_t validFixCount = 0;
+static uint32_t parserOverrunCount = 0;
+static uint32_t lastValidFixMillis = 0;
+static bool haveValidFix = false;
+static uint32_t secondMaxWaitMs = 0;
+static uint32_t lastSampleMillis = 0;
+#if GPS_HEALTH_LOG_SECS > 0
+static uint32_t lastLogMillis = 0;
+#endif
+
+static SeqLock<GpsHealth> published;
+
+void gpsHealthOnFix(const gps_fix& fix) {
+    fixCount++;
+    if (fix.valid.location) {
+        validFixCount++;
+        lastValidFixMillis = millis();
+        haveValidFix = true;
+    }
+}
+
+void gpsHealthOnMutexWait(uint32_t waitMs) {
+    if (waitMs > secondMaxWaitMs) {
+        secondMaxWaitMs = waitMs;
+    }
+}
+
+static void readCounters(GpsHealthCounters& c) {
+    c.chars = gps.statistics.chars;
+    c.sentencesOk = gps.statistics.ok;
+    c.checksumErrors = gps.statistics.errors;
+    c.fixes = fixCount;
+    c.validFixes = validFixCount;
+    c.lateFixes = gpsAssembler.lateFixes();
+    c.strayedSentences = gpsAssembler.strayedSentences();
+    c.uartOverruns = gpsTransport.getOverrunCount();
+    c.parserOverruns = parserOverrunCount;
+}
+
+static void subtractCounters(const GpsHealthCounters& a, const GpsHealthCounters& b, GpsHealthCounters& out) {
+    out.chars = a.chars - b.chars;
+    out.sentencesOk = a.sentencesOk - b.sentencesOk;
+    out.checksumErrors = a.checksumErrors - b.checksumErrors;
+    out.fixes = a.fixes - b.fixes;
+    out.validFixes = a.validFixes - b.validFixes;
+    out.lateFixes = a.lateFixes - b.lateFixes;
+    out.strayedSentences = a.strayedSentences - b.strayedSentences;
+    out.uartOverruns = a.uartOverruns - b.uartOverruns;
+    out.parserOverruns = a.parserOverruns - b.parserOverruns;
+}
+
+void gpsHealthUpdate() {
+    // NeoGPS latches this when a fix is overwritten unread
+    if (gps.overrun()) {
+        parserOverrunCount++;
+        gps.overrun(false);
+    }
+
+    uint32_t now = millis();
+    if (historyCount > 0 && now - lastSampleMillis < 1000) return;
+    lastSampleMillis = now;
+
+    healthSample_t& sample = history[historyHead];
+    readCounters(sample.counters);
+    sample.sampleMillis = now;
+    sample.maxMutexWaitMs = secondMaxWaitMs;
+    secondMaxWaitMs = 0;
+
+    historyHead = (historyHead + 1) % (GPS_HEALTH_WINDOW_SECS + 1);
+    if (historyCount < GPS_HEALTH_WINDOW_SECS + 1) {
+        historyCount++;
+    }
+
+    // Window = newest sample minus the oldest one still held
+    uint16_t oldestIdx = (historyHead + GPS_HEALTH_WINDOW_SECS + 1 - historyCount) % (GPS_HEALTH_WINDOW_SECS + 1);
+    const healthSample_t& oldest = history[oldestIdx];
+
+    GpsHealth h;
+    h.total = sample.counters;
+    subtractCounters(sample.counters, oldest.counters, h.window);
+    uint32_t spanMs = now - oldest.sampleMillis;
+    h.windowSecs = (uint16_t)((spanMs + 500) / 1000);
+    h.fixesPerSec = (spanMs > 0) ? h.window.fixes * 1000.0 / spanMs : 0.0;
+    h.msSinceValidFix = haveValidFix ? now - lastValidFixMillis : UINT32_MAX;
+
+    h.maxMutexWaitMs = 0;
+    for (uint16_t i = 0; i < historyCount; i++) {
+        if (history[i].maxMutexWaitMs > h.maxMutexWaitMs) {
+            h.maxMutexWaitMs = history[i].maxMutexWaitMs;
+        }
+    }
+
+    published.write(h);
+
+#if GPS_HEALTH_LOG_SECS > 0
+    if (now - lastLogMillis >= GPS_HEALTH_LOG_SECS * 1000UL) {
+        lastLogMillis = now;
+        printGpsHealth();
+    }
+#endif
+}
+
+bool readGpsHealth(GpsHealth& out) {
+    return published.read(out);
+}
+
+void formatGpsHealth(const GpsHealth& h, char* buf, size_t len) {
+    char lastFix[16];
+    if (h.msSinceValidFix == UINT32_MAX) {
+        strlcpy(lastFix, "never", sizeof(lastFix));
+    } else {
+        snprintf(lastFix, sizeof(lastFix), "%lu.%lus ago", (unsigned long)(h.msSinceValidFix / 1000),
+                 (unsigned long)((h.msSinceValidFix % 1000) / 100));
+    }
+
+    snprintf(buf, len,
+             "Fixes/s: %.1f (last valid %s)\n"
+             "Last %us: %lu ok, %lu bad, %lu B\n"
+             "Overruns: UART %lu, parser %lu\n"
+             "Merge: %lu late, %lu stray\n"
+             "Mutex wait max: %lu ms\n"
+             "Total: %lu ok, %lu bad, %lu fixes",
+             h.fixesPerSec, lastFix,
+             (unsigned)h.windowSecs, (unsigned long)h.window.sentencesOk,
+             (unsigned long)h.window.checksumErrors, (unsigned long)h.window.chars,
+             (unsigned long)h.window.uartOverruns, (unsigned long)h.window.parserOverruns,
+             (unsigned long)h.window.lateFixes, (unsigned long)h.window.strayedSentences,
+             (unsigned long)h.maxMutexWaitMs,
+             (unsigned long)h.total.sentencesOk, (unsigned long)h.total.checksumErrors,
+             (unsigned long)h.total.fixes);
+}
+
+void printGpsHealth() {
+    GpsHealth h;
+    if (!readGpsHealth(h)) {
+        Serial.println("GPS health: no data yet");
+        return;
+    }
+
+    char text[256];
+    formatGpsHealth(h, text, sizeof(text));
+    Serial.println("--- GPS health ---");
+    Serial.println(text);
+}
@@ -0,0 +1,49 @@
+#ifndef GPS_HEALTH_H
+#define GPS_HEALTH_H
+
+#include <NMEAGPS.h>
+
+// Counters since boot (NeoGPS statistics, fix assembly and UART driver)
+typedef struct {
+    uint32_t chars;              // Bytes fed to the parser
+    uint32_t sentencesOk;
+    uint32_t checksumErrors;     // Sentences rejected by the parser (bad checksum or garbled)
+    uint32_t fixes;              // Merged fixes processed
+    uint32_t validFixes;         // ... of which had a valid location
+    uint32_t lateFixes;          // Completed a whole interval late (FixAssembler still learning)
+    uint32_t strayedSentences;   // Dropped by FixAssembler after their interval completed
+    uint32_t uartOverruns;       // UART FIFO / RX ring overflows
+    uint32_t parserOverruns;     // Fixes NeoGPS overwrote before gpsTask read them
+} GpsHealthCounters;
+
+/**
+ * Rolling GPS health record, published once per second by gpsTask
+ *
+ * 'window' holds the change in each counter over the last windowSecs
+ * (up to GPS_HEALTH_WINDOW_SECS), so a burst of errors stands out even
+ * after days of uptime.
+ */
+typedef struct {
+    GpsHealthCounters total;
+    GpsHealthCounters window;
+    uint16_t windowSecs;
+    float fixesPerSec;           // Over the window
+    uint32_t msSinceValidFix;    // UINT32_MAX until the first valid fix
+    uint32_t maxMutexWaitMs;     // Longest gpsTask wait for gpsMutex in the window
+} GpsHealth;
+
+// gpsTask side (caller holds gpsMutex)
+void gpsHealthOnFix(const gps_fix& fix);
+void gpsHealthOnMutexWait(uint32_t waitMs);
+void gpsHealthUpdate();  // Every gpsTask wakeup; samples and publishes once per second
+
+// Any task: copy of the last published record; false before the first one
+bool readGpsHealth(GpsHealth& out);
+
+// Multi-line text for the debug screen and serial dump
+void formatGpsHealth(const GpsHealth& h, char* buf, size_t len);
+
+// Print the current record to the debug port
+void printGpsHealth();
+
+#endif // GPS_HEALTH_H
@@ -0,0 +1,132 @@
+#include "mesh_ack_tracker.h"
+
+// error passed to finish() when no reply came
+static const uint32_t ERROR_TIMEOUT = 0xFFFFFFFF;
+
+size_t MeshAckTracker::rttBucket(uint32_t rttMs) {
+    uint32_t limit = MESH_ACK_RTT_FIRST_MS;
+    for (size_t i = 0; i < MESH_ACK_RTT_BUCKETS - 1; i++) {
+        if (rttMs < limit) {
+            return i;
+        }
+        limit *= 2;
+    }
+    return MESH_ACK_RTT_BUCKETS - 1;
+}
+
+MeshAckTracker::DestStats* MeshAckTracker::destFor(uint32_t node, uint32_t nowMs) {
+    DestStats* use = NULL;
+    for (DestStats& d : dests) {
+        if (d.node == node) {
+            use = &d;
+            break;
+        }
+        // Otherwise an unused entry, or the least recently used
+        if (use == NULL || (use->node != 0 && (d.node == 0 || nowMs - d.lastUsedMs > nowMs - use->lastUsedMs))) {
+            use = &d;
+        }
+    }
+    if (use->node != node) {
+        *use = DestStats();
+        use->node = node;
+    }
+    use->lastUsedMs = nowMs;
+    return use;
+}
+
+void MeshAckTracker::sent(const MeshTxItem& item, uint32_t nowMs) {
+    Pending* slot = NULL;
+    for (Pending& p : table) {
+        if (p.state == FREE) {
+            slot = &p;
+            break;
+        }
+        // Full: the one waiting longest makes room
+        if (slot == NULL || nowMs - p.sentMs > nowMs - slot->sentMs) {
+            slot = &p;
+        }
+    }
+    if (slot->state != FREE) {
+        evictedCount++;
+    }
+
+    slot->item = item;
+    slot->sentMs = nowMs;
+    slot->state = WAITING;
+    if (item.attempt == 0) {
+        destFor(item.packet.to, nowMs)->sent++;
+    }
+}
+
+void MeshAckTracker::finish(Pending& p, uint32_t error, uint32_t nowMs) {
+    DestStats* d = destFor(p.item.packet.to, nowMs);
+
+    if (error == 0) {
+        uint32_t rtt = nowMs - p.sentMs;
+        d->acked++;
+        d->rttBuckets[rttBucket(rtt)]++;
+        d->rttTotalMs += rtt;
+        if (rtt > d->rttMaxMs) {
+            d->rttMaxMs = rtt;
+        }
+        p.state = FREE;
+    } else if (p.item.retries > 0) {
+        p.state = RESEND;  // Handed back by due()
+    } else {
+        if (error == ERROR_TIMEOUT) {
+            d->timedOut++;
+        } else {
+            d->nakked++;
+        }
+        p.state = FREE;
+    }
+}
+
+bool MeshAckTracker::routed(uint32_t requestId, uint32_t error, uint32_t nowMs) {
+    for (Pending& p : table) {
+        if (p.state == WAITING && p.item.packet.id == requestId) {
+            finish(p, error, nowMs);
+            return true;
+        }
+    }
+    unmatchedCount++;
+    return false;
+}
+
+bool MeshAckTracker::due(uint32_t nowMs, MeshTxItem& resend) {
+    for (Pending& p : table) {
+        if (p.state == WAITING && nowMs - p.sentMs >= MESH_ACK_TIMEOUT_MS) {
+            finish(p, ERROR_TIMEOUT, nowMs);
+        }
+    }
+
+    for (Pending& p : table) {
+        if (p.state == RESEND) {
+            resend = p.item;
+            resend.packet.id = 0;  // A new id; the mesh drops repeats of one it has seen
+            resend.retries--;
+            resend.attempt++;
+            destFor(p.item.packet.to, nowMs)->retried++;
+            p.state = FREE;
+            return true;
+        }
+    }
+    return false;
+}
+
+const MeshAckTracker::DestStats* MeshAckTracker::destination(size_t index) const {
+    if (index >= MESH_ACK_DESTINATIONS || dests[index].node == 0) {
+        return NULL;
+    }
+    return &dests[index];
+}
+
+size_t MeshAckTracker::pending() const {
+    size_t n = 0;
+    for (const Pending& p : table) {
+        if (p.state != FREE) {
+            n++;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,80 @@
+#ifndef MESH_ACK_TRACKER_H
+#define MESH_ACK_TRACKER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+#include "utils/mesh_tx_queue.h"
+
+/**
+ * Delivery tracking for want_ack mesh packets
+ *
+ * Every want_ack packet written to the radio is remembered (id, destination,
+ * send time) in a table of MESH_ACK_PENDING entries, the oldest replaced when
+ * it is full. A ROUTING_APP reply whose request_id matches resolves it: error
+ * NONE is an ack (the destination's, or for a broadcast the radio hearing it
+ * rebroadcast), anything else a nak. No reply within MESH_ACK_TIMEOUT_MS is a
+ * timeout. A packet queued with retries left is handed back by due() after a
+ * nak or timeout, to be queued again under a new id.
+ *
+ * Per-destination counters and round-trip histograms (buckets doubling from
+ * MESH_ACK_RTT_FIRST_MS) are kept for MESH_ACK_DESTINATIONS destinations, the
+ * least recently used replaced. Broadcasts count as destination 0xFFFFFFFF.
+ *
+ * Meshtastic task only (sends and routing replies are both handled there).
+ * Host-compiled by the native_meshtx bench.
+ */
+class MeshAckTracker {
+public:
+    struct DestStats {
+        uint32_t node;                          // 0: unused entry
+        uint32_t sent;                          // First attempts (resends not included)
+        uint32_t acked;
+        uint32_t nakked;                        // Last attempt nakked, no retries left
+        uint32_t timedOut;                      // Last attempt timed out, no retries left
+        uint32_t retried;                       // Resends queued
+        uint32_t rttBuckets[MESH_ACK_RTT_BUCKETS];
+        uint32_t rttTotalMs;                    // Of acked attempts
+        uint32_t rttMaxMs;
+        uint32_t lastUsedMs;
+    };
+
+    // A want_ack packet was written to the radio; item.packet.id is its id
+    void sent(const MeshTxItem& item, uint32_t nowMs);
+
+    // A routing reply for requestId: error 0 is an ack. False if nothing was waiting for it.
+    bool routed(uint32_t requestId, uint32_t error, uint32_t nowMs);
+
+    // Expire packets that have waited too long; true with a packet to queue again (retries
+    // already counted down, id cleared) while there are any
+    bool due(uint32_t nowMs, MeshTxItem& resend);
+
+    // Destinations seen so far, in table order; NULL for an unused entry or past the end
+    const DestStats* destination(size_t index) const;
+
+    size_t pending() const;
+    uint32_t evicted() const { return evictedCount; }   // Still waiting when the table filled
+    uint32_t unmatched() const { return unmatchedCount; }  // Replies to nothing we were waiting for
+
+    // Bucket an RTT falls in
+    static size_t rttBucket(uint32_t rttMs);
+
+private:
+    enum State : uint8_t { FREE, WAITING, RESEND };
+
+    struct Pending {
+        MeshTxItem item;        // Kept for a resend
+        uint32_t sentMs;
+        State state;
+    };
+
+    DestStats* destFor(uint32_t node, uint32_t nowMs);
+    void finish(Pending& p, uint32_t error, uint32_t nowMs);
+
+    Pending table[MESH_ACK_PENDING] = {};
+    DestStats dests[MESH_ACK_DESTINATIONS] = {};
+    uint32_t evictedCount = 0;
+    uint32_t unmatchedCount = 0;
+};
+
+#endif // MESH_ACK_TRACKER_H
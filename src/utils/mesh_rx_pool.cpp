@@ -0,0 +1,94 @@
+#include "mesh_rx_pool.h"
+#include <string.h>
+
+static const uint32_t LENGTH_BYTES = sizeof(uint32_t);  // Length word before each record; 0 means "wrapped"
+
+size_t MeshRxPool::recordBytes(size_t size) {
+    return (LENGTH_BYTES + sizeof(MeshRxMessage) + size + 1 + 3) & ~(size_t)3;
+}
+
+uint32_t MeshRxPool::lengthAt(uint32_t pos) const {
+    uint32_t length;
+    memcpy(&length, &ring[pos & MASK], sizeof(length));
+    return length;
+}
+
+uint8_t* MeshRxPool::reserve(size_t size) {
+    reservedBytes = 0;
+    size_t need = recordBytes(size);
+    if (size > UINT16_MAX || need > MESH_RX_POOL_BYTES) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    uint32_t at = head.load(std::memory_order_relaxed);
+    uint32_t contiguous = MESH_RX_POOL_BYTES - (at & MASK);
+    if (need > contiguous) {
+        at += contiguous;  // Skip to the front; commit() marks the gap
+    }
+    if (at + need - tail.load(std::memory_order_acquire) > MESH_RX_POOL_BYTES) {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    reservedAt = at;
+    reservedBytes = need;
+    reservedSize = size;
+    return &ring[(at & MASK) + LENGTH_BYTES + sizeof(MeshRxMessage)];
+}
+
+bool MeshRxPool::commit(const MeshRxMessage& header) {
+    if (reservedBytes == 0 || header.size > reservedSize) {
+        return false;
+    }
+
+    uint32_t from = head.load(std::memory_order_relaxed);
+    if (reservedAt != from) {
+        uint32_t wrapped = 0;
+        memcpy(&ring[from & MASK], &wrapped, sizeof(wrapped));
+    }
+    uint8_t* record = &ring[reservedAt & MASK];
+    memcpy(record, &reservedBytes, sizeof(reservedBytes));
+    memcpy(record + LENGTH_BYTES, &header, sizeof(header));
+
+    uint32_t end = reservedAt + reservedBytes;
+    reservedBytes = 0;
+    head.store(end, std::memory_order_release);
+
+    uint32_t count = committedCount.fetch_add(1, std::memory_order_relaxed) + 1 -
+                     releasedCount.load(std::memory_order_relaxed);
+    uint32_t used = end - tail.load(std::memory_order_relaxed);
+    if (count > highWaterCount.load(std::memory_order_relaxed)) {
+        highWaterCount.store(count, std::memory_order_relaxed);
+    }
+    if (used > highWaterBytes.load(std::memory_order_relaxed)) {
+        highWaterBytes.store(used, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+const MeshRxMessage* MeshRxPool::peek() {
+    uint32_t at = tail.load(std::memory_order_relaxed);
+    while (at != head.load(std::memory_order_acquire)) {
+        if (lengthAt(at) != 0) {
+            return (const MeshRxMessage*)&ring[(at & MASK) + LENGTH_BYTES];
+        }
+        at += MESH_RX_POOL_BYTES - (at & MASK);  // Wrap marker
+        tail.store(at, std::memory_order_release);
+    }
+    return NULL;
+}
+
+void MeshRxPool::release() {
+    uint32_t at = tail.load(std::memory_order_relaxed);
+    if (at == head.load(std::memory_order_acquire)) {
+        return;
+    }
+    releasedCount.fetch_add(1, std::memory_order_relaxed);
+    tail.store(at + lengthAt(at), std::memory_order_release);
+}
+
+MeshRxPool::Stats MeshRxPool::stats() const {
+    return Stats{committedCount.load(std::memory_order_relaxed), droppedCount.load(std::memory_order_relaxed),
+                 highWaterBytes.load(std::memory_order_relaxed), highWaterCount.load(std::memory_order_relaxed)};
+}
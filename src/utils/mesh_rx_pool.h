@@ -0,0 +1,85 @@
+#ifndef MESH_RX_POOL_H
+#define MESH_RX_POOL_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+
+// A received packet waiting for meshtasticCallbackTask; its payload follows the header
+typedef struct {
+    uint32_t from;
+    uint32_t to;
+    uint16_t port;      // meshtastic_PortNum: TEXT_MESSAGE_APP or PRIVATE_APP (binary hot packet)
+    uint16_t size;      // Payload bytes, not counting the NUL after them
+    uint8_t channel;
+
+    const uint8_t* bytes() const { return (const uint8_t*)(this + 1); }
+    const char* text() const { return (const char*)(this + 1); }  // NUL terminated
+} MeshRxMessage;
+
+/**
+ * Variable-length message pool between the Meshtastic decoder and the callback task
+ *
+ * A byte ring of MESH_RX_POOL_BYTES holding each message as a length word,
+ * a MeshRxMessage header and just its own payload (+ NUL), 4-byte aligned.
+ * A record that would run past the end leaves a zero length word there and
+ * starts again at the front, so every payload is contiguous.
+ *
+ * The producer reserve()s room for a payload of known size - the decoder
+ * writes it straight in - then commit()s the header, or simply reserves
+ * again if the packet turned out to be unwanted. The consumer peek()s at the
+ * oldest message, uses it in place and release()s it. No copies either side.
+ *
+ * One producer (meshtasticTask) and one consumer (meshtasticCallbackTask);
+ * counters may be read from any task. Host-compiled by the hot packet bench.
+ */
+class MeshRxPool {
+public:
+    struct Stats {
+        uint32_t committed;       // Messages queued
+        uint32_t dropped;         // reserve() calls refused for lack of room
+        uint32_t highWaterBytes;  // Most ring bytes ever in use
+        uint32_t highWaterCount;  // Most messages ever waiting
+    };
+
+    // Producer: room for size payload bytes plus a NUL, or NULL if the pool is full
+    uint8_t* reserve(size_t size);
+
+    // Producer: queue the reserved payload with this header (header.size <= the reserved size)
+    bool commit(const MeshRxMessage& header);
+
+    // Consumer: the oldest message, valid until release(); NULL if none
+    const MeshRxMessage* peek();
+    void release();
+
+    Stats stats() const;
+
+    // Ring bytes one message of size payload bytes takes
+    static size_t recordBytes(size_t size);
+
+private:
+    static const uint32_t MASK = MESH_RX_POOL_BYTES - 1;
+    static_assert((MESH_RX_POOL_BYTES & MASK) == 0, "MESH_RX_POOL_BYTES must be a power of two");
+
+    uint32_t lengthAt(uint32_t pos) const;
+
+    alignas(4) uint8_t ring[MESH_RX_POOL_BYTES];
+
+    // Free-running byte positions; head is written by the producer, tail by the consumer
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+
+    // Producer's current reservation
+    uint32_t reservedAt = 0;      // Position of the record (after any wrap padding)
+    uint32_t reservedBytes = 0;   // 0: nothing reserved
+    uint16_t reservedSize = 0;
+
+    std::atomic<uint32_t> committedCount{0};
+    std::atomic<uint32_t> releasedCount{0};
+    std::atomic<uint32_t> droppedCount{0};
+    std::atomic<uint32_t> highWaterBytes{0};
+    std::atomic<uint32_t> highWaterCount{0};
+};
+
+#endif // MESH_RX_POOL_H
@@ -0,0 +1,117 @@
+#include "mesh_tx_queue.h"
+#include <string.h>
+
+MeshTxQueue::MeshTxQueue() {
+    for (Lane& lane : lanes) {
+        for (uint32_t i = 0; i < MESH_TX_QUEUE_DEPTH; i++) {
+            lane.slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        lane.enqueuePos.store(0, std::memory_order_relaxed);
+        lane.dequeuePos.store(0, std::memory_order_relaxed);
+        lane.queued.store(0, std::memory_order_relaxed);
+        lane.sent.store(0, std::memory_order_relaxed);
+        lane.refused.store(0, std::memory_order_relaxed);
+        lane.highWater.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool MeshTxQueue::push(MeshTxPriority priority, const mt_packet_t& packet, const uint8_t* payload,
+                       uint8_t retries, uint8_t attempt) {
+    if (priority >= MESH_TX_PRIORITIES || packet.size > sizeof(MeshTxItem().payload)) {
+        return false;
+    }
+    Lane& lane = lanes[priority];
+
+    // Claim a slot; several tasks may be racing for it
+    uint32_t pos = lane.enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &lane.slots[pos & MASK];
+        int32_t turn = (int32_t)(slot->sequence.load(std::memory_order_acquire) - pos);
+        if (turn == 0) {
+            if (lane.enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (turn < 0) {
+            lane.refused.fetch_add(1, std::memory_order_relaxed);
+            return false;  // Full: the meshtastic task hasn't taken this slot's last packet yet
+        } else {
+            pos = lane.enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->item.packet = packet;
+    slot->item.priority = priority;
+    slot->item.retries = retries;
+    slot->item.attempt = attempt;
+    if (packet.size > 0) {
+        memcpy(slot->item.payload, payload, packet.size);
+    }
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    lane.queued.fetch_add(1, std::memory_order_relaxed);
+    uint32_t waiting = pos + 1 - lane.dequeuePos.load(std::memory_order_relaxed);
+    uint32_t high = lane.highWater.load(std::memory_order_relaxed);
+    while (waiting > high && !lane.highWater.compare_exchange_weak(high, waiting, std::memory_order_relaxed)) {
+    }
+    return true;
+}
+
+bool MeshTxQueue::takeToken(uint32_t nowMs) {
+    if (!started) {
+        started = true;
+        refilledMs = nowMs;
+    }
+    // Unsigned difference is wrap-safe across the millis() rollover
+    uint32_t earned = (nowMs - refilledMs) / MESH_TX_INTERVAL_MS;
+    if (earned > 0) {
+        tokens = (tokens + earned > MESH_TX_BURST) ? MESH_TX_BURST : tokens + earned;
+        refilledMs += earned * MESH_TX_INTERVAL_MS;
+    }
+    if (tokens == MESH_TX_BURST) {
+        refilledMs = nowMs;  // A full bucket banks nothing more
+    }
+    if (tokens == 0) {
+        return false;
+    }
+    tokens--;
+    return true;
+}
+
+bool MeshTxQueue::pop(uint32_t nowMs, MeshTxItem& item) {
+    for (uint8_t p = 0; p < MESH_TX_PRIORITIES; p++) {
+        Lane& lane = lanes[p];
+        uint32_t pos = lane.dequeuePos.load(std::memory_order_relaxed);
+        Slot& slot = lane.slots[pos & MASK];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            continue;  // Empty (or the packet is still being copied in)
+        }
+
+        if (p != MESH_TX_ADMIN && !takeToken(nowMs)) {
+            rateLimitedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;  // Lower lanes wait too
+        }
+
+        item = slot.item;
+        slot.sequence.store(pos + MESH_TX_QUEUE_DEPTH, std::memory_order_release);
+        lane.dequeuePos.store(pos + 1, std::memory_order_release);
+        lane.sent.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+bool MeshTxQueue::empty() const {
+    for (const Lane& lane : lanes) {
+        if (lane.enqueuePos.load(std::memory_order_acquire) != lane.dequeuePos.load(std::memory_order_acquire)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+MeshTxQueue::LaneStats MeshTxQueue::stats(MeshTxPriority priority) const {
+    const Lane& lane = lanes[priority];
+    return LaneStats{lane.queued.load(std::memory_order_relaxed), lane.sent.load(std::memory_order_relaxed),
+                     lane.refused.load(std::memory_order_relaxed), lane.highWater.load(std::memory_order_relaxed)};
+}
@@ -0,0 +1,97 @@
+#ifndef MESH_TX_QUEUE_H
+#define MESH_TX_QUEUE_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+#include "mt_packet_codec.h"
+
+// Outbound lanes, highest priority first
+typedef enum : uint8_t {
+    MESH_TX_ADMIN = 0,      // Admin messages to the connected radio (never go over the air)
+    MESH_TX_HOT_PACKET,     // Hot packet protocol messages (AWAKE, replies to the gateway)
+    MESH_TX_CHATTER,        // Everything else (test messages)
+    MESH_TX_PRIORITIES
+} MeshTxPriority;
+
+typedef struct {
+    mt_packet_t packet;
+    MeshTxPriority priority;    // Lane it was queued in
+    uint8_t retries;            // Resends left if a want_ack packet is not acknowledged (MeshAckTracker)
+    uint8_t attempt;            // 0 for the first send, counted up by each resend
+    uint8_t payload[sizeof(meshtastic_Data_payload_t().bytes)];
+} MeshTxItem;
+
+/**
+ * Prioritized outbound packet queue for the Meshtastic link
+ *
+ * Any task may push() a packet into its priority's lane, a bounded lock-free
+ * ring of MESH_TX_QUEUE_DEPTH slots; a full lane refuses it (back-pressure:
+ * the caller retries later, as it did when a send failed). Only the
+ * meshtastic task pop()s, so it is the one writer of the TX encode buffer.
+ * pop() always takes the highest-priority lane with something waiting.
+ *
+ * Over-the-air lanes share a token bucket: one send per MESH_TX_INTERVAL_MS,
+ * with up to MESH_TX_BURST banked. While it is empty nothing below admin goes
+ * out, so a burst of chatter can't starve a hot packet reply queued after it.
+ *
+ * Host-compiled by the native_meshtx bench.
+ */
+class MeshTxQueue {
+public:
+    struct LaneStats {
+        uint32_t queued;      // Accepted by push()
+        uint32_t sent;        // Handed out by pop()
+        uint32_t refused;     // push() calls refused because the lane was full
+        uint32_t highWater;   // Most packets ever waiting at once
+    };
+
+    MeshTxQueue();
+
+    // Any task: copy a packet in (size <= 233 payload bytes); false if its lane is full
+    bool push(MeshTxPriority priority, const mt_packet_t& packet, const uint8_t* payload,
+              uint8_t retries = 0, uint8_t attempt = 0);
+
+    // Meshtastic task: the next packet allowed out at nowMs, highest priority first
+    bool pop(uint32_t nowMs, MeshTxItem& item);
+
+    // Any task: nothing is waiting in any lane
+    bool empty() const;
+
+    LaneStats stats(MeshTxPriority priority) const;
+    uint32_t rateLimited() const { return rateLimitedCount.load(std::memory_order_relaxed); }
+
+private:
+    static const uint32_t MASK = MESH_TX_QUEUE_DEPTH - 1;
+    static_assert((MESH_TX_QUEUE_DEPTH & MASK) == 0, "MESH_TX_QUEUE_DEPTH must be a power of two");
+
+    // Bounded MPSC ring: a slot's sequence says whose turn it is (producer at
+    // position p when it equals p, consumer when it equals p + 1)
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        MeshTxItem item;
+    };
+
+    struct Lane {
+        Slot slots[MESH_TX_QUEUE_DEPTH];
+        std::atomic<uint32_t> enqueuePos;
+        std::atomic<uint32_t> dequeuePos;   // Written by the meshtastic task only
+        std::atomic<uint32_t> queued;
+        std::atomic<uint32_t> sent;
+        std::atomic<uint32_t> refused;
+        std::atomic<uint32_t> highWater;
+    };
+
+    bool takeToken(uint32_t nowMs);
+
+    Lane lanes[MESH_TX_PRIORITIES];
+
+    // Token bucket, touched by pop() only
+    uint32_t tokens = MESH_TX_BURST;
+    uint32_t refilledMs = 0;
+    bool started = false;
+    std::atomic<uint32_t> rateLimitedCount{0};
+};
+
+#endif // MESH_TX_QUEUE_H
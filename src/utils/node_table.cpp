@@ -0,0 +1,227 @@
+#include "node_table.h"
+#include <math.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static const uint8_t SPIN_LIMIT = 8;                 // Reader retries before yielding (as SeqLock)
+static const float METRES_PER_DEGREE = 111195.0f;    // Mean earth radius 6371 km
+
+uint32_t NodeTable::home(uint32_t num) {
+    // Node numbers are often sequential or share low bits (MAC derived); mix before masking
+    num ^= num >> 16;
+    num *= 0x45D9F3B;
+    num ^= num >> 16;
+    return num & MASK;
+}
+
+uint32_t NodeTable::distanceM(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2) {
+    float dLat = (float)((int64_t)lat2 - lat1) * 1e-7f;
+    float dLon = (float)((int64_t)lon2 - lon1) * 1e-7f;
+    if (dLon > 180.0f) {
+        dLon -= 360.0f;  // Across the antimeridian
+    } else if (dLon < -180.0f) {
+        dLon += 360.0f;
+    }
+    float meanLat = ((float)lat1 + (float)lat2) * 0.5e-7f * (float)M_PI / 180.0f;
+    float x = dLon * cosf(meanLat);
+    return (uint32_t)(sqrtf(x * x + dLat * dLat) * METRES_PER_DEGREE);
+}
+
+void NodeTable::beginWrite() {
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void NodeTable::endWrite() {
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+const NodeTable::Node* NodeTable::find(uint32_t num) const {
+    uint32_t i = home(num);
+    // Bounded even if a reader sees a half-shifted run
+    for (uint32_t probe = 0; probe < NODE_TABLE_SLOTS; probe++) {
+        if (slots[i].num == num) {
+            return &slots[i];
+        }
+        if (slots[i].num == 0) {
+            return NULL;
+        }
+        i = (i + 1) & MASK;
+    }
+    return NULL;
+}
+
+void NodeTable::remove(Node* node) {
+    uint32_t hole = node - slots;
+    uint32_t j = hole;
+    while (true) {
+        j = (j + 1) & MASK;
+        if (slots[j].num == 0) {
+            break;
+        }
+        // Move slots[j] into the hole unless its home lies cyclically in (hole, j]
+        uint32_t k = home(slots[j].num);
+        bool homeBetween = (hole <= j) ? (hole < k && k <= j) : (hole < k || k <= j);
+        if (!homeBetween) {
+            slots[hole] = slots[j];
+            hole = j;
+        }
+    }
+    slots[hole] = Node();
+    count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+NodeTable::Node* NodeTable::touch(uint32_t num, uint32_t nowMs, bool heard) {
+    if (num == 0 || num == 0xFFFFFFFF) {
+        return NULL;  // Not a node (unset / broadcast)
+    }
+    Node* found = const_cast<Node*>(find(num));
+    if (found == NULL) {
+        if (count.load(std::memory_order_relaxed) >= NODE_TABLE_MAX_NODES) {
+            // Full: the node heard from longest ago makes room
+            Node* oldest = NULL;
+            for (Node& n : slots) {
+                if (n.num != 0 && (oldest == NULL || nowMs - n.lastHeardMs > nowMs - oldest->lastHeardMs)) {
+                    oldest = &n;
+                }
+            }
+            remove(oldest);
+            evictedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint32_t i = home(num);
+        uint32_t probe = 0;
+        while (slots[i].num != 0) {
+            i = (i + 1) & MASK;
+            probe++;
+        }
+        if (probe > longestProbeLen.load(std::memory_order_relaxed)) {
+            longestProbeLen.store(probe, std::memory_order_relaxed);
+        }
+        found = &slots[i];
+        *found = Node();
+        found->num = num;
+        found->channelUtilization = NAN;
+        found->airUtilTx = NAN;
+        found->lastHeardMs = nowMs - NODE_REPORT_MAX_AGE_MS;  // Until heard, oldest to evict
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (heard) {
+        found->lastHeardMs = nowMs;
+    }
+    return found;
+}
+
+void NodeTable::heard(uint32_t num, uint32_t nowMs) {
+    beginWrite();
+    touch(num, nowMs);
+    endWrite();
+}
+
+void NodeTable::position(uint32_t num, int32_t latitudeI, int32_t longitudeI, uint32_t nowMs, bool heard) {
+    beginWrite();
+    Node* n = touch(num, nowMs, heard);
+    if (n != NULL) {
+        n->latitudeI = latitudeI;
+        n->longitudeI = longitudeI;
+        n->hasPosition = true;
+    }
+    endWrite();
+}
+
+void NodeTable::metrics(uint32_t num, uint8_t batteryLevel, float channelUtilization, float airUtilTx,
+                        uint32_t nowMs, bool heard) {
+    beginWrite();
+    Node* n = touch(num, nowMs, heard);
+    if (n != NULL) {
+        // 0 / NAN: not in this report, keep what we had
+        if (batteryLevel != 0) {
+            n->batteryLevel = batteryLevel;
+        }
+        if (!isnan(channelUtilization)) {
+            n->channelUtilization = channelUtilization;
+        }
+        if (!isnan(airUtilTx)) {
+            n->airUtilTx = airUtilTx;
+        }
+    }
+    endWrite();
+}
+
+void NodeTable::reported(uint32_t num, uint32_t epoch, uint32_t nowEpoch, uint32_t nowMs) {
+    beginWrite();
+    Node* n = touch(num, nowMs, false);
+    if (n != NULL && epoch != 0) {
+        n->lastHeardEpoch = epoch;
+        if (nowEpoch != 0) {
+            // A last_heard ahead of our clock counts as now; far back is capped like an unknown one
+            uint32_t ageS = (nowEpoch > epoch) ? nowEpoch - epoch : 0;
+            uint32_t ageMs = (ageS < NODE_REPORT_MAX_AGE_MS / 1000) ? ageS * 1000 : NODE_REPORT_MAX_AGE_MS;
+            uint32_t heardMs = nowMs - ageMs;
+            if ((int32_t)(heardMs - n->lastHeardMs) > 0) {
+                n->lastHeardMs = heardMs;
+            }
+        }
+    }
+    endWrite();
+}
+
+bool NodeTable::get(uint32_t num, Node& out) const {
+    uint8_t tries = 0;
+    while (true) {
+        uint32_t s1 = seq.load(std::memory_order_acquire);
+        if ((s1 & 1) == 0) {
+            const Node* n = find(num);
+            if (n != NULL) {
+                out = *n;
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == s1) {
+                return n != NULL;
+            }
+        }
+        if (++tries >= SPIN_LIMIT) {
+            vTaskDelay(1);
+            tries = 0;
+        }
+    }
+}
+
+size_t NodeTable::nearest(int32_t latitudeI, int32_t longitudeI, uint32_t nowMs, uint32_t maxAgeMs,
+                          uint32_t exclude, Nearby* out, size_t n) const {
+    if (n > NODE_NEAREST_MAX) {
+        n = NODE_NEAREST_MAX;
+    }
+    uint8_t tries = 0;
+    while (true) {
+        uint32_t s1 = seq.load(std::memory_order_acquire);
+        if ((s1 & 1) == 0) {
+            // Insertion into out[], kept sorted by distance: at most NODE_TABLE_SLOTS * n steps
+            size_t found = 0;
+            for (const Node& node : slots) {
+                if (node.num == 0 || !node.hasPosition || node.num == exclude ||
+                    nowMs - node.lastHeardMs > maxAgeMs) {
+                    continue;
+                }
+                uint32_t d = distanceM(latitudeI, longitudeI, node.latitudeI, node.longitudeI);
+                if (found == n && (n == 0 || d >= out[n - 1].distanceM)) {
+                    continue;
+                }
+                size_t i = (found < n) ? found++ : n - 1;
+                while (i > 0 && out[i - 1].distanceM > d) {
+                    out[i] = out[i - 1];
+                    i--;
+                }
+                out[i] = Nearby{node.num, d, nowMs - node.lastHeardMs};
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == s1) {
+                return found;
+            }
+        }
+        if (++tries >= SPIN_LIMIT) {
+            vTaskDelay(1);
+            tries = 0;
+        }
+    }
+}
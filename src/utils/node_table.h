@@ -0,0 +1,98 @@
+#ifndef NODE_TABLE_H
+#define NODE_TABLE_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Bounded table of the mesh nodes we have heard of
+ *
+ * Filled from the radio's node report and from NODEINFO_APP, POSITION_APP and
+ * TELEMETRY_APP packets (see meshtastic_nodes.h). Entries live in a fixed
+ * open-addressed array of NODE_TABLE_SLOTS keyed by node number (linear
+ * probing, deletions shift the run back so no tombstones build up). At most
+ * NODE_TABLE_MAX_NODES are kept so probes stay short; a new node past that
+ * replaces the least recently heard one. Nothing is ever allocated.
+ *
+ * Updates come from the meshtastic task only. Readers (get(), nearest()) may
+ * run in any task: like SeqLock, a sequence count is bumped around every
+ * update and a reader that overlapped one starts again.
+ *
+ * Host-compiled by the native_nodetable bench.
+ */
+class NodeTable {
+public:
+    struct Node {
+        uint32_t num;               // 0: empty slot
+        uint32_t lastHeardMs;       // millis() when it was last heard (from its last_heard for a node report)
+        uint32_t lastHeardEpoch;    // The radio's last_heard (node report), 0 if unknown
+        int32_t latitudeI;          // Degrees * 1e7, valid if hasPosition
+        int32_t longitudeI;
+        float channelUtilization;   // Percent, NAN if unknown
+        float airUtilTx;            // Percent, NAN if unknown
+        uint8_t batteryLevel;       // Percent (101: powered), 0 if unknown
+        bool hasPosition;
+    };
+
+    struct Nearby {
+        uint32_t num;
+        uint32_t distanceM;
+        uint32_t ageMs;             // Since lastHeardMs
+    };
+
+    // Updates (meshtastic task). Each marks the node heard at nowMs, adding it if new; with heard
+    // false (data relayed by the radio's node report) lastHeardMs is left alone.
+    void heard(uint32_t num, uint32_t nowMs);
+    void position(uint32_t num, int32_t latitudeI, int32_t longitudeI, uint32_t nowMs, bool heard = true);
+    void metrics(uint32_t num, uint8_t batteryLevel, float channelUtilization, float airUtilTx, uint32_t nowMs,
+                 bool heard = true);
+
+    // Node report: epoch is the radio's last_heard, nowEpoch our UTC (0 if either is unknown).
+    // lastHeardMs moves back by the age when both are known and it is newer; otherwise it is
+    // not refreshed. A node first seen this way without an age is NODE_REPORT_MAX_AGE_MS old.
+    void reported(uint32_t num, uint32_t epoch, uint32_t nowEpoch, uint32_t nowMs);
+
+    // Any task: copy of a node; false if it isn't in the table
+    bool get(uint32_t num, Node& out) const;
+
+    // Any task: up to n (at most NODE_NEAREST_MAX) nodes with a position heard within maxAgeMs,
+    // closest to (latitudeI, longitudeI) first, skipping exclude (our own node). Returns how
+    // many were written. One pass over the slots, no allocation.
+    size_t nearest(int32_t latitudeI, int32_t longitudeI, uint32_t nowMs, uint32_t maxAgeMs, uint32_t exclude,
+                   Nearby* out, size_t n) const;
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+    uint32_t evicted() const { return evictedCount.load(std::memory_order_relaxed); }
+    uint32_t longestProbe() const { return longestProbeLen.load(std::memory_order_relaxed); }
+
+    // Equirectangular distance in metres between two positions (degrees * 1e7)
+    static uint32_t distanceM(int32_t lat1, int32_t lon1, int32_t lat2, int32_t lon2);
+
+private:
+    static const uint32_t MASK = NODE_TABLE_SLOTS - 1;
+    static_assert((NODE_TABLE_SLOTS & MASK) == 0, "NODE_TABLE_SLOTS must be a power of two");
+    static_assert(NODE_TABLE_MAX_NODES < NODE_TABLE_SLOTS, "NODE_TABLE_MAX_NODES must leave a free slot");
+
+    static uint32_t home(uint32_t num);
+
+    // Slot holding num, or NULL
+    const Node* find(uint32_t num) const;
+
+    // Slot for num, added (evicting if full) if it wasn't there, marked heard at nowMs if heard;
+    // writer only, inside begin/end
+    Node* touch(uint32_t num, uint32_t nowMs, bool heard = true);
+    void remove(Node* node);
+
+    void beginWrite();
+    void endWrite();
+
+    Node slots[NODE_TABLE_SLOTS] = {};
+    std::atomic<uint32_t> seq{0};
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> evictedCount{0};
+    std::atomic<uint32_t> longestProbeLen{0};
+};
+
+#endif // NODE_TABLE_H
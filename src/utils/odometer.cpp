@@ -0,0 +1,240 @@
+#include "odometer.h"
+#include "config.h"
+#include "globals.h"
+#include "storage/preferences_manager.h"
+#include "utils/format_utils.h"
+
+static const uint64_t MM_PER_MILE = 1609344ULL;
+static const uint64_t ROLLOVER_MM = 100000ULL * MM_PER_MILE;  // Display limit is 99999.9
+
+// Mean Earth radius (6371.0088 km) expressed as mm per 1e-7 degree of arc
+static const float MM_PER_DEG_E7 = 6371008.8 * 1000.0 * (M_PI / 180.0) / 1e7;
+
+// EEPROM save thresholds
+static const float SAVE_INTERVAL_MILES = 0.5;  // Save every 0.5 miles
+static const uint64_t SAVE_INTERVAL_MM = (uint64_t)(SAVE_INTERVAL_MILES * MM_PER_MILE);
+static const int32_t SAVE_INTERVAL_HOURS = 1;  // Save every 1 hour
+
+// Distance totals (authoritative) and the float mirrors as last written by us
+static uint64_t totalMm = 0;
+static uint64_t tripMm = 0;
+static uint64_t lastSavedTotalMm = 0;
+static uint64_t lastSavedTripMm = 0;
+static float publishedTotal = -1.0;  // Forces adoption of accum_distance on the first fix
+static float publishedTrip = -1.0;
+static int32_t shownTotalTenths = -1;
+static int32_t shownTripTenths = -1;
+
+// Start of the current odometer segment (resampled to >= ODOMETER_SAMPLE_MS of fix time)
+static NeoGPS::Location_t lastLocation;
+static bool hasLastLocation = false;
+static uint32_t segmentMs = 0;
+
+// Hour tracking for service reminder, in fix time
+static uint32_t msSinceMovement = 0;        // Fix time since the last accepted segment
+static bool movementTimeValid = false;      // False after a gap of unknown length
+static bool hoursTrackingInitialized = false;  // Flag to initialize from hrs_since_svc on first use
+static int32_t lastSavedHrsSinceSvc = 0;
+static uint32_t remainderMs = 0;  // Accumulator for sub-tenth hour precision
+
+uint32_t segmentDistanceMm(const NeoGPS::Location_t& a, const NeoGPS::Location_t& b) {
+    float dLat = (float)((int64_t)b.lat() - a.lat());
+    float dLon = (float)((int64_t)b.lon() - a.lon());
+    float meanLatRad = (float)(((int64_t)a.lat() + b.lat()) / 2) * (float)(M_PI / 180.0 / 1e7);
+
+    float x = dLon * cosf(meanLatRad);
+    float mm = sqrtf(x * x + dLat * dLat) * MM_PER_DEG_E7;
+
+    return (mm < 4.0e9f) ? (uint32_t)(mm + 0.5f) : UINT32_MAX;
+}
+
+double odometerTotalMiles() {
+    return (double)totalMm / MM_PER_MILE;
+}
+
+uint64_t odometerMilesToMm(float miles) {
+    return (miles > 0.0) ? (uint64_t)((double)miles * MM_PER_MILE + 0.5) : 0;
+}
+
+/**
+ * Adopt accum_distance / trip_distance if someone else changed them
+ */
+static void syncFromMirrors() {
+    if (accum_distance != publishedTotal) {
+        totalMm = odometerMilesToMm(accum_distance);
+        lastSavedTotalMm = totalMm;
+        publishedTotal = accum_distance;
+        shownTotalTenths = -1;
+    }
+    if (trip_distance != publishedTrip) {
+        tripMm = odometerMilesToMm(trip_distance);
+        lastSavedTripMm = tripMm;
+        publishedTrip = trip_distance;
+        shownTripTenths = -1;
+    }
+}
+
+/**
+ * Write the float mirrors, and the 1-decimal display strings when the tenth changes
+ */
+static void publishTotals() {
+    accum_distance = publishedTotal = (float)((double)totalMm / MM_PER_MILE);
+    trip_distance = publishedTrip = (float)((double)tripMm / MM_PER_MILE);
+
+    char buf[16];
+    int32_t totalTenths = (int32_t)((totalMm * 10 + MM_PER_MILE / 2) / MM_PER_MILE);
+    if (totalTenths != shownTotalTenths) {
+        fmtFixed(buf, totalTenths, 1);
+        odometer = buf;
+        shownTotalTenths = totalTenths;
+    }
+
+    int32_t tripTenths = (int32_t)((tripMm * 10 + MM_PER_MILE / 2) / MM_PER_MILE);
+    if (tripTenths != shownTripTenths) {
+        fmtFixed(buf, tripTenths, 1);
+        trip_odometer = buf;
+        shownTripTenths = tripTenths;
+    }
+}
+
+void odometerRestore(uint64_t savedTotalMm, uint64_t savedTripMm) {
+    totalMm = lastSavedTotalMm = savedTotalMm % ROLLOVER_MM;
+    tripMm = lastSavedTripMm = savedTripMm % ROLLOVER_MM;
+    publishTotals();
+}
+
+void odometerSave() {
+    syncFromMirrors();
+    queuePreferenceWrite("accumDistMm", totalMm);
+    queuePreferenceWrite("tripDistMm", tripMm);
+    lastSavedTotalMm = totalMm;
+    lastSavedTripMm = tripMm;
+}
+
+/**
+ * Accumulate driving hours (only when moving, same as distance)
+ *
+ * Time comes from FixAssembler::intervalMs() - the spacing of the fix
+ * timestamps (GPS clock, no drift), or millis() for fixes without time - so
+ * it is correct at any fix rate. Stops of up to GPS_MAX_FIX_GAP_MS between
+ * moving segments count as driving; longer stops and signal gaps do not.
+ *
+ * Storage format: hrs_since_svc is ALWAYS stored as tenths of hours
+ * Conversion: 360 seconds = 0.1 hours (1 tenth)
+ *
+ * Example: 45 minutes = 2700 seconds = 7.5 tenths = stored as 7 in hrs_since_svc
+ */
+static void accumulateDrivingTime() {
+    // Initialize hours tracking on first movement
+    if (!hoursTrackingInitialized) {
+        lastSavedHrsSinceSvc = hrs_since_svc;
+        hoursTrackingInitialized = true;
+    }
+
+    bool timeValid = movementTimeValid && msSinceMovement > 0 && msSinceMovement <= GPS_MAX_FIX_GAP_MS;
+    uint32_t elapsedMs = msSinceMovement;
+    msSinceMovement = 0;
+    movementTimeValid = true;
+
+    // Accumulate elapsed time if valid
+    if (timeValid) {
+        remainderMs += elapsedMs;
+
+        // When we've accumulated 360 seconds (1 tenth hour), increment hrs_since_svc
+        int32_t tenthsToAdd = remainderMs / 360000UL;
+        if (tenthsToAdd > 0) {
+            hrs_since_svc += tenthsToAdd;
+            remainderMs -= (tenthsToAdd * 360000UL);
+        }
+
+        // Save to EEPROM every 1.0 hours of driving (10 tenths)
+        if (hrs_since_svc - lastSavedHrsSinceSvc >= (SAVE_INTERVAL_HOURS * 10)) {
+            queuePreferenceWrite("hrs_since_svc", hrs_since_svc);
+            lastSavedHrsSinceSvc = hrs_since_svc;
+        }
+    }
+}
+
+void odometerUpdate(const gps_fix& fix, uint32_t intervalMs) {
+    if (intervalMs == 0) {
+        movementTimeValid = false;  // Gap of unknown length - don't count it as driving
+        hasLastLocation = false;    // Restart the segment rather than integrate across it
+    } else if (msSinceMovement <= GPS_MAX_FIX_GAP_MS) {
+        msSinceMovement += intervalMs;  // Saturates just past the limit while parked
+    }
+
+    // Fixes without a location still take time, or posSpeed below would be overstated
+    if (hasLastLocation) {
+        segmentMs += intervalMs;
+    }
+
+    if (!fix.valid.location) return;
+
+    syncFromMirrors();
+
+    // At 5/10 Hz, extend the segment until it spans ODOMETER_SAMPLE_MS so the per-segment
+    // distance gates below see the same ~1 s segments they were tuned on
+    if (hasLastLocation && segmentMs < ODOMETER_SAMPLE_MS) return;
+
+    // Accumulate distance traveled using hybrid position-based calculation
+    if (hasLastLocation) {
+        uint32_t segmentMm = segmentDistanceMm(fix.location, lastLocation);
+        float posDistance = (float)segmentMm / MM_PER_MILE;  // miles
+        float posSpeed = posDistance * 3600000.0 / segmentMs;  // mph over the measured segment time
+
+        bool shouldAccumulate = false;
+
+        // Use GPS Doppler speed as primary gate
+        if (fix.valid.speed) {
+            float dopplerSpeed = fix.speed_mph();
+
+            // Only accumulate when GPS confirms we're moving
+            if (dopplerSpeed > MIN_SPEED_FILTER_MPH) {
+                // Position speed must be reasonable
+                if (posSpeed < 30.0 && posDistance > 0.0005) {  // >2.6 feet minimum
+                    shouldAccumulate = true;
+                }
+            }
+            // If Doppler says stopped, don't accumulate (filters jitter)
+        } else {
+            // No Doppler speed available - use distance threshold only
+            if (posDistance > 0.002 && posSpeed < 30.0) {  // >10 feet minimum
+                shouldAccumulate = true;
+            }
+        }
+
+        if (shouldAccumulate) {
+            totalMm += segmentMm;
+            tripMm += segmentMm;
+
+            // Rollover at 100,000 miles
+            if (totalMm >= ROLLOVER_MM) {
+                totalMm -= ROLLOVER_MM;
+                lastSavedTotalMm = 0;
+            }
+            if (tripMm >= ROLLOVER_MM) {
+                tripMm -= ROLLOVER_MM;
+                lastSavedTripMm = 0;
+            }
+
+            accumulateDrivingTime();
+            publishTotals();
+
+            // Save to EEPROM periodically (every SAVE_INTERVAL_MILES)
+            if (totalMm - lastSavedTotalMm >= SAVE_INTERVAL_MM) {
+                queuePreferenceWrite("accumDistMm", totalMm);
+                lastSavedTotalMm = totalMm;
+            }
+
+            if (tripMm - lastSavedTripMm >= SAVE_INTERVAL_MM) {
+                queuePreferenceWrite("tripDistMm", tripMm);
+                lastSavedTripMm = tripMm;
+            }
+        }
+    }
+
+    // Start the next segment here
+    lastLocation = fix.location;
+    hasLastLocation = true;
+    segmentMs = 0;
+}
@@ -0,0 +1,46 @@
+#ifndef ODOMETER_H
+#define ODOMETER_H
+
+#include <NMEAGPS.h>
+
+/**
+ * Odometer and hours-meter engine (called from gpsTask for each fix)
+ *
+ * Distance is accumulated in integer millimetres, so 0.001 mile increments
+ * are never lost no matter how high the odometer reads, and driving time in
+ * milliseconds of fix time. Fixes are grouped into segments of at least
+ * ODOMETER_SAMPLE_MS, so the distance gates behave the same at 1, 5 or 10 Hz.
+ * Totals are mirrored to accum_distance / trip_distance / hrs_since_svc and
+ * the odometer display strings, and EEPROM saves are queued every
+ * SAVE_INTERVAL_MILES of travel and SAVE_INTERVAL_HOURS of driving. The
+ * distance totals are saved as uint64 millimetres ("accumDistMm",
+ * "tripDistMm"), so no precision is lost across a reboot.
+ *
+ * Values written to the float mirrors elsewhere (EEPROM load, UI edit or trip
+ * reset) are adopted on the next fix. intervalMs is FixAssembler::intervalMs()
+ * (0 after a gap).
+ */
+void odometerUpdate(const gps_fix& fix, uint32_t intervalMs);
+
+// Adopt the totals saved in EEPROM (at boot, before the first fix); sets the float mirrors
+void odometerRestore(uint64_t savedTotalMm, uint64_t savedTripMm);
+
+// Queue an EEPROM save of both distance totals now (before deep sleep; caller holds gpsMutex)
+void odometerSave();
+
+// Miles to millimetres (float mirrors, and totals saved by older firmware)
+uint64_t odometerMilesToMm(float miles);
+
+// Exact odometer total in miles (accum_distance is a float and rounds to ~0.008 mi above 65,536 miles)
+double odometerTotalMiles();
+
+/**
+ * Equirectangular distance between two fixes in millimetres
+ *
+ * Uses the mean latitude for the longitude scale. For the sub-kilometre
+ * segments between fixes the error against haversine is below 1 ppm, well
+ * under the 1 mm rounding.
+ */
+uint32_t segmentDistanceMm(const NeoGPS::Location_t& a, const NeoGPS::Location_t& b);
+
+#endif // ODOMETER_H
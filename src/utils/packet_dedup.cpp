@@ -0,0 +1,24 @@
+#include "packet_dedup.h"
+
+static_assert(MESH_DEDUP_ENTRIES <= 255, "PacketDedup ring index is a uint8_t");
+
+bool PacketDedup::seen(uint32_t from, uint32_t id, uint32_t nowMs) {
+    if (id == 0) {
+        return false;  // Nothing to tell copies apart by
+    }
+
+    for (uint8_t i = 0; i < MESH_DEDUP_ENTRIES; i++) {
+        const Entry& e = entries[i];
+        // Unsigned difference is wrap-safe across the millis() rollover
+        if (e.used && e.id == id && e.from == from &&
+            nowMs - e.seenMs < MESH_DEDUP_WINDOW_MS) {
+            hitCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    entries[next] = Entry{from, id, nowMs, true};
+    next = (next + 1) % MESH_DEDUP_ENTRIES;
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
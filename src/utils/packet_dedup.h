@@ -0,0 +1,43 @@
+#ifndef PACKET_DEDUP_H
+#define PACKET_DEDUP_H
+
+#include <atomic>
+#include <stdint.h>
+#include "config.h"
+
+/**
+ * Duplicate suppression for mesh packets before they are queued
+ *
+ * Rebroadcasts can deliver the same packet several times, every copy with
+ * the sender's MeshPacket id. A packet is keyed on (from, id) and remembered
+ * for MESH_DEDUP_WINDOW_MS in a ring of MESH_DEDUP_ENTRIES (the oldest is
+ * replaced). A new packet gets a new id, so the same payload sent again - a
+ * repeated command, an unchanged weather refresh - is not a duplicate. A
+ * packet without an id (0) is never treated as one.
+ *
+ * seen() is called from the meshtastic task only; the counters may be read
+ * from any task. Host-compiled by the hot packet benchmark.
+ */
+class PacketDedup {
+public:
+    // True (a hit) if this packet was already seen within the window; otherwise remembers it
+    bool seen(uint32_t from, uint32_t id, uint32_t nowMs);
+
+    uint32_t hits() const { return hitCount.load(std::memory_order_relaxed); }
+    uint32_t misses() const { return missCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        uint32_t from;
+        uint32_t id;
+        uint32_t seenMs;
+        bool used;
+    };
+
+    Entry entries[MESH_DEDUP_ENTRIES] = {};
+    uint8_t next = 0;
+    std::atomic<uint32_t> hitCount{0};
+    std::atomic<uint32_t> missCount{0};
+};
+
+#endif // PACKET_DEDUP_H
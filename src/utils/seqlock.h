@@ -0,0 +1,65 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <type_traits>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * Single-writer sequence lock for small POD values shared across cores
+ *
+ * The writer bumps the sequence to odd, copies the value, then bumps it to
+ * even. Readers copy the value and retry if the sequence was odd or changed,
+ * so they never take a mutex and never return a torn copy. Only one task may
+ * call write().
+ *
+ * If a reader preempts the writer on the same core mid-copy it would spin
+ * forever, so after SEQLOCK_SPIN_LIMIT retries the reader sleeps one tick to
+ * let the writer finish.
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock value must be trivially copyable");
+
+public:
+    static const uint8_t SEQLOCK_SPIN_LIMIT = 8;
+
+    void write(const T& value) {
+        uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        data = value;
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    // Returns false if nothing has been published yet (out is still filled with zeros)
+    bool read(T& out) const {
+        uint8_t tries = 0;
+        while (true) {
+            uint32_t s1 = seq.load(std::memory_order_acquire);
+            if ((s1 & 1) == 0) {
+                out = data;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq.load(std::memory_order_relaxed) == s1) {
+                    return s1 != 0;
+                }
+            }
+            if (++tries >= SEQLOCK_SPIN_LIMIT) {
+                vTaskDelay(1);
+                tries = 0;
+            }
+        }
+    }
+
+    // Number of values published so far
+    uint32_t generation() const {
+        return seq.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    std::atomic<uint32_t> seq{0};
+    T data{};
+};
+
+#endif // SEQLOCK_H
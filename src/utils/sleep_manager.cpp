@@ -4,7 +4,9 @@
 #include "hardware/display.h"
 #include "get_set_vars.h"
 #include "communication/meshtastic_admin.h"
+#include "communication/meshtastic_tx.h"
 #include "storage/preferences_manager.h"
+#include "utils/odometer.h"
 #include "Meshtastic.h"
 #include <esp_sleep.h>
 #include <driver/rtc_io.h>
@@ -39,16 +41,24 @@ void enterDeepSleep() {
 
     // Save distance and hours values to EEPROM before sleeping
     Serial.println("Saving distance and hours to EEPROM...");
-    queuePreferenceWrite("accumDistance", accum_distance);
-    queuePreferenceWrite("tripDistance", trip_distance);
     queuePreferenceWrite("hrs_since_svc", hrs_since_svc);  // Saved as tenths of hours
-    delay(150);  // Give EEPROM task time to process the queue
+
+    // Odometer totals (gpsTask owns them) and the partly filled track page
+    if (xSemaphoreTake(gpsMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        odometerSave();
+        trackRecorder.flush();
+        xSemaphoreGive(gpsMutex);
+    }
+    delay(150);  // Give EEPROM and track tasks time to process their queues
 
     // Cleanly shutdown Meshtastic serial connection
     if (mesh_serial_enabled) {
         // Reset GPS update interval to default (2 minutes) to reduce radio power consumption
         // Must be done while serial is still active
         resetGpsIntervalBeforeSleep();
+        if (!meshTxFlush(MESH_TX_FLUSH_TIMEOUT_MS)) {  // meshtasticTask writes it to the radio
+            Serial.println("Meshtastic TX queue not drained before sleep");
+        }
 
         Serial.println("Shutting down Meshtastic serial connection...");
         mt_serial_end();  // Directly shutdown UART2 before sleep
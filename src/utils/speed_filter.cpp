@@ -0,0 +1,106 @@
+#include "speed_filter.h"
+#include <Arduino.h>
+#include "config.h"
+#include "utils/odometer.h"
+
+static const float MPH_PER_MPS = 2.236936;
+
+void SpeedFilter::reset() {
+    estimate = 0.0;
+    variance = 100.0;
+    stationary = true;
+    belowMs = 0;
+    aboveMs = 0;
+    noMeasurementMs = 0;
+    hasLastLocation = false;
+    locationAgeMs = 0;
+}
+
+void SpeedFilter::predict(float dtSecs) {
+    // Constant-speed model: uncertainty grows with unmodelled acceleration
+    variance += (SPEED_KF_ACCEL_MPHPS * SPEED_KF_ACCEL_MPHPS) * dtSecs * dtSecs;
+}
+
+void SpeedFilter::correct(float measurementMph, float noiseMph) {
+    float r = noiseMph * noiseMph;
+    float gain = variance / (variance + r);
+    estimate += gain * (measurementMph - estimate);
+    variance *= (1.0 - gain);
+    if (estimate < 0.0) {
+        estimate = 0.0;
+    }
+}
+
+float SpeedFilter::update(const gps_fix& fix, uint32_t intervalMs) {
+    // Measured fix spacing; first fix or a gap is treated as one nominal step
+    float dt = (intervalMs > 0) ? intervalMs / 1000.0 : 1.0 / GPS_FIX_RATE_HZ;
+    predict(dt);
+
+    // Position-delta speed over the fix time since the last location, which spans any
+    // fixes without one (noise scales with 1/span: two position errors over it)
+    if (intervalMs == 0) {
+        hasLastLocation = false;  // Not across a gap of unknown length
+    }
+    locationAgeMs += intervalMs;
+    bool havePosSpeed = false;
+    float posSpeed = 0.0;
+    float posSecs = locationAgeMs / 1000.0;
+    if (fix.valid.location) {
+        if (hasLastLocation && locationAgeMs > 0) {
+            posSpeed = segmentDistanceMm(fix.location, lastLocation) / 1000.0 / posSecs * MPH_PER_MPS;
+            havePosSpeed = true;
+        }
+        lastLocation = fix.location;
+        hasLastLocation = true;
+        locationAgeMs = 0;
+    }
+
+    // Measurement used by the stationary detector: Doppler when present, else position speed
+    bool haveMeasurement = true;
+    float measured = 0.0;
+    if (fix.valid.speed) {
+        measured = fix.speed_mph();
+        correct(measured, SPEED_KF_DOPPLER_MPH);
+    } else if (havePosSpeed) {
+        measured = posSpeed;
+    } else {
+        haveMeasurement = false;
+    }
+
+    if (havePosSpeed) {
+        correct(posSpeed, 1.414 * SPEED_KF_POSITION_M / posSecs * MPH_PER_MPS);
+    }
+
+    // Stationary detector with hysteresis, windows measured in fix time
+    uint32_t dtMs = (uint32_t)(dt * 1000.0 + 0.5);
+    if (haveMeasurement) {
+        noMeasurementMs = 0;
+        belowMs = (measured < STATIONARY_ENTER_MPH) ? belowMs + dtMs : 0;
+        aboveMs = (measured > STATIONARY_EXIT_MPH) ? aboveMs + dtMs : 0;
+
+        if (!stationary && belowMs >= STATIONARY_ENTER_MS) {
+            stationary = true;
+        } else if (stationary && aboveMs >= STATIONARY_EXIT_MS) {
+            stationary = false;
+        }
+
+        // Hold the estimate at rest while stopped so it restarts from 0 instead of position noise
+        if (stationary) {
+            estimate = 0.0;
+            variance = SPEED_KF_DOPPLER_MPH * SPEED_KF_DOPPLER_MPH;
+        }
+    } else {
+        // No measurement: keep the prediction through brief dropouts, but a lost fix
+        // (cart barn, tree cover) shows 0 after SPEED_HOLD_MS rather than the last speed
+        noMeasurementMs += dtMs;
+        if (noMeasurementMs >= SPEED_HOLD_MS) {
+            stationary = true;
+            estimate = 0.0;
+            variance = SPEED_KF_DOPPLER_MPH * SPEED_KF_DOPPLER_MPH;
+            belowMs = 0;
+            aboveMs = 0;
+        }
+    }
+
+    return speedMph();
+}
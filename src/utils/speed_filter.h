@@ -0,0 +1,49 @@
+#ifndef SPEED_FILTER_H
+#define SPEED_FILTER_H
+
+#include <NMEAGPS.h>
+
+/**
+ * Fused speed estimator with stationary detection
+ *
+ * A scalar Kalman filter tracks ground speed from two measurements per fix:
+ * Doppler speed (fix.speed) and position-delta speed (distance between fixes
+ * over the fix interval). Position noise is given in metres, so the
+ * position-delta measurement is automatically trusted less at higher fix
+ * rates where the interval is short.
+ *
+ * A hysteresis detector pins the output to 0 once the measured speed has
+ * stayed below STATIONARY_ENTER_MPH for STATIONARY_ENTER_MS, and releases it
+ * once it has stayed above STATIONARY_EXIT_MPH for STATIONARY_EXIT_MS. The
+ * windows are in milliseconds of fix time, so they behave the same at 1, 5
+ * or 10 Hz. Fixes with neither measurement keep the prediction for up to
+ * SPEED_HOLD_MS, then the output drops to 0 until the fix returns. All tuning
+ * lives in config.h.
+ */
+class SpeedFilter {
+public:
+    // Process one merged fix; intervalMs is FixAssembler::intervalMs() (0 = unknown, nominal step used)
+    // Returns the filtered speed in mph (0 when stationary)
+    float update(const gps_fix& fix, uint32_t intervalMs);
+
+    float speedMph() const { return stationary ? 0.0 : estimate; }
+    bool isStationary() const { return stationary; }
+    void reset();
+
+private:
+    void predict(float dtSecs);
+    void correct(float measurementMph, float noiseMph);
+
+    float estimate = 0.0;     // mph
+    float variance = 100.0;   // mph^2
+    bool stationary = true;
+    uint32_t belowMs = 0;     // Time measured speed has been under the enter threshold
+    uint32_t aboveMs = 0;     // Time measured speed has been over the exit threshold
+    uint32_t noMeasurementMs = 0;  // Time since a fix last had Doppler or position speed
+
+    NeoGPS::Location_t lastLocation;
+    bool hasLastLocation = false;
+    uint32_t locationAgeMs = 0;    // Fix time since lastLocation
+};
+
+#endif // SPEED_FILTER_H
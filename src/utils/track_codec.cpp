@@ -0,0 +1,200 @@
+#include "track_codec.h"
+
+// Worst case record: 10-byte header + 10-byte time + two 5-byte coordinates + 3-byte speed
+#define TRACK_MAX_RECORD 33
+
+#define TRACK_REC_DELTA 0
+#define TRACK_REC_KEYFRAME 1
+#define TRACK_REC_TRIP 2
+
+static uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static uint8_t putVarint(uint8_t* out, uint64_t v) {
+    uint8_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)v | 0x80;
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+/*****************************
+ *          ENCODER           *
+ *****************************/
+
+void TrackPageEncoder::begin(uint8_t* payload, uint16_t cap) {
+    buf = payload;
+    capacity = cap;
+    used = 0;
+}
+
+bool TrackPageEncoder::add(const TrackPoint& p, bool tripStart) {
+    uint8_t rec[TRACK_MAX_RECORD];
+    uint8_t n = 0;
+    int32_t lat = p.lat / TRACK_COORD_DIV;
+    int32_t lon = p.lon / TRACK_COORD_DIV;
+
+    if (used == 0 || tripStart) {
+        n += putVarint(rec + n, tripStart ? TRACK_REC_TRIP : TRACK_REC_KEYFRAME);
+        n += putVarint(rec + n, p.timeCs);
+        n += putVarint(rec + n, zigzag(lat));
+        n += putVarint(rec + n, zigzag(lon));
+        n += putVarint(rec + n, p.speed);
+    } else {
+        int32_t lastLat = last.lat / TRACK_COORD_DIV;
+        int32_t lastLon = last.lon / TRACK_COORD_DIV;
+        int64_t timeResidual = (int64_t)(p.timeCs - last.timeCs) - stepCs;
+        n += putVarint(rec + n, (zigzag(timeResidual) << 2) | TRACK_REC_DELTA);
+        n += putVarint(rec + n, zigzag((int64_t)lat - lastLat - stepLat));
+        n += putVarint(rec + n, zigzag((int64_t)lon - lastLon - stepLon));
+        n += putVarint(rec + n, zigzag((int64_t)p.speed - last.speed));
+    }
+
+    if (used + n > capacity) return false;
+    memcpy(buf + used, rec, n);
+
+    if (used == 0 || tripStart) {
+        // Predict the next point at the nominal interval, standing still
+        stepCs = TRACK_MIN_INTERVAL_MS / 10;
+        stepLat = 0;
+        stepLon = 0;
+    } else {
+        stepCs = (int64_t)(p.timeCs - last.timeCs);
+        stepLat = lat - last.lat / TRACK_COORD_DIV;
+        stepLon = lon - last.lon / TRACK_COORD_DIV;
+    }
+    used += n;
+    last = p;
+    return true;
+}
+
+/*****************************
+ *          DECODER           *
+ *****************************/
+
+void TrackPageDecoder::begin(const uint8_t* payload, uint16_t length) {
+    buf = payload;
+    len = length;
+    pos = 0;
+    started = false;
+}
+
+bool TrackPageDecoder::get(uint64_t& v) {
+    v = 0;
+    for (uint8_t shift = 0; shift < 64 && pos < len; shift += 7) {
+        uint8_t b = buf[pos++];
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;  // Truncated or overlong
+}
+
+bool TrackPageDecoder::next(TrackPoint& p, bool& tripStart) {
+    if (pos >= len || buf[pos] == 0xFF) return false;  // End of page / erased flash
+
+    uint64_t header, a, b, c;
+    if (!get(header)) return false;
+    uint8_t type = header & 3;
+
+    if (type == TRACK_REC_KEYFRAME || type == TRACK_REC_TRIP) {
+        uint64_t t;
+        if (!get(t) || !get(a) || !get(b) || !get(c)) return false;
+        p.timeCs = t;
+        p.lat = (int32_t)unzigzag(a) * TRACK_COORD_DIV;
+        p.lon = (int32_t)unzigzag(b) * TRACK_COORD_DIV;
+        p.speed = (uint16_t)c;
+        stepCs = TRACK_MIN_INTERVAL_MS / 10;
+        stepLat = 0;
+        stepLon = 0;
+        tripStart = (type == TRACK_REC_TRIP);
+        started = true;
+    } else if (type == TRACK_REC_DELTA && started) {
+        if (!get(a) || !get(b) || !get(c)) return false;
+        int64_t dt = stepCs + unzigzag(header >> 2);
+        int32_t dLat = stepLat + (int32_t)unzigzag(a);
+        int32_t dLon = stepLon + (int32_t)unzigzag(b);
+        p.timeCs = last.timeCs + dt;
+        p.lat = last.lat + dLat * TRACK_COORD_DIV;
+        p.lon = last.lon + dLon * TRACK_COORD_DIV;
+        p.speed = (uint16_t)(last.speed + unzigzag(c));
+        stepCs = dt;
+        stepLat = dLat;
+        stepLon = dLon;
+        tripStart = false;
+    } else {
+        return false;  // Reserved type, or a delta before any keyframe
+    }
+
+    last = p;
+    return true;
+}
+
+/*****************************
+ *          RECORDER          *
+ *****************************/
+
+// Round to the nearest multiple of TRACK_COORD_DIV
+static int32_t quantizeCoord(int32_t v) {
+    int32_t half = TRACK_COORD_DIV / 2;
+    int32_t q = (v >= 0 ? v + half : v - half) / TRACK_COORD_DIV;
+    return q * TRACK_COORD_DIV;
+}
+
+TrackRecorder::TrackRecorder(PageSink pageSink) : sink(pageSink) {
+    page.length = 0;
+    encoder.begin(page.payload, TRACK_PAGE_PAYLOAD);
+}
+
+bool TrackRecorder::addFix(const gps_fix& fix, float speedMph) {
+    if (!fix.valid.location || !fix.valid.date || !fix.valid.time) return false;
+
+    uint64_t timeCs = (uint64_t)(NeoGPS::clock_t)fix.dateTime * 100 + fix.dateTime_cs;
+    bool stopped = (speedMph <= 0.0);
+    bool newTrip = !haveLast;
+
+    if (haveLast) {
+        if (timeCs <= last.timeCs) return false;  // Repeated or out-of-order fix
+        uint64_t elapsedMs = (timeCs - last.timeCs) * 10;
+
+        if (elapsedMs > TRACK_TRIP_GAP_MS) {
+            newTrip = true;
+        } else {
+            if (elapsedMs < TRACK_MIN_INTERVAL_MS) return false;
+            if (stopped && lastStopped && elapsedMs < TRACK_IDLE_INTERVAL_MS) return false;
+        }
+    }
+
+    TrackPoint p;
+    p.timeCs = timeCs;
+    p.lat = quantizeCoord(fix.location.lat());
+    p.lon = quantizeCoord(fix.location.lon());
+    float tenths = speedMph * 10.0 + 0.5;
+    p.speed = tenths <= 0.0 ? 0 : (tenths >= 65535.0 ? 65535 : (uint16_t)tenths);
+
+    if (!encoder.add(p, newTrip)) {
+        flush();
+        encoder.add(p, newTrip);  // First record on an empty page always fits
+    }
+    page.length = encoder.size();
+
+    last = p;
+    haveLast = true;
+    lastStopped = stopped;
+    points++;
+    return true;
+}
+
+void TrackRecorder::flush() {
+    if (encoder.empty()) return;
+    page.length = encoder.size();
+    sink(page);
+    encoder.begin(page.payload, TRACK_PAGE_PAYLOAD);
+    page.length = 0;
+}
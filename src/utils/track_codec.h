@@ -0,0 +1,120 @@
+#ifndef TRACK_CODEC_H
+#define TRACK_CODEC_H
+
+#include <Arduino.h>
+#include <NMEAGPS.h>
+#include "config.h"
+
+/**
+ * Breadcrumb track encoding
+ *
+ * Points are packed into flash-page-sized blocks. Each page opens with a
+ * keyframe of absolute values; every following point is stored as the
+ * difference from a linear prediction (last point + last step), zigzag and
+ * varint coded. At a steady sampling rate and speed the residuals are near
+ * zero, so a typical point costs 4 bytes. Pages never reference each other,
+ * so each one still decodes after older pages have been overwritten.
+ *
+ * Record layout (LEB128 varints, signed values zigzag coded):
+ *   header    (timeResidualCs << 2) | type
+ *   type 0    latResidual, lonResidual, speedDelta
+ *   type 1/2  time (cs since 2000-01-01 UTC), lat, lon, speed   (keyframe; 2 = trip start)
+ * Lat/lon are stored in units of TRACK_COORD_DIV * 1e-7 degrees, speed in
+ * 0.1 mph. Type 3 is never written, so an 0xFF byte (erased flash) ends a page.
+ */
+
+#define TRACK_PAGE_HEADER_SIZE 4    // uint32_t page sequence number, written by the track task
+#define TRACK_PAGE_PAYLOAD (TRACK_PAGE_SIZE - TRACK_PAGE_HEADER_SIZE)
+
+typedef struct {
+    uint64_t timeCs;    // Centiseconds since 2000-01-01 00:00 UTC (NeoGPS epoch)
+    int32_t lat;        // 1e-7 degrees, a multiple of TRACK_COORD_DIV
+    int32_t lon;
+    uint16_t speed;     // 0.1 mph
+} TrackPoint;
+
+// One page of encoded points on its way from gpsTask to the track task
+typedef struct {
+    uint16_t length;                        // Payload bytes used
+    uint8_t payload[TRACK_PAGE_PAYLOAD];
+} trackPage_t;
+
+class TrackPageEncoder {
+public:
+    void begin(uint8_t* payload, uint16_t capacity);
+
+    // Append a point (keyframe if it is the page's first or tripStart is set)
+    // Returns false, leaving the page unchanged, if it does not fit
+    bool add(const TrackPoint& p, bool tripStart);
+
+    uint16_t size() const { return used; }
+    bool empty() const { return used == 0; }
+
+private:
+    uint8_t* buf = nullptr;
+    uint16_t capacity = 0;
+    uint16_t used = 0;
+
+    TrackPoint last;
+    int64_t stepCs = 0;     // Last time step, latitude/longitude step (prediction)
+    int32_t stepLat = 0;
+    int32_t stepLon = 0;
+};
+
+class TrackPageDecoder {
+public:
+    void begin(const uint8_t* payload, uint16_t len);
+
+    // Next point in the page; false at the end of the page or a malformed record
+    bool next(TrackPoint& p, bool& tripStart);
+
+private:
+    bool get(uint64_t& v);
+
+    const uint8_t* buf = nullptr;
+    uint16_t len = 0;
+    uint16_t pos = 0;
+    bool started = false;
+
+    TrackPoint last;
+    int64_t stepCs = 0;
+    int32_t stepLat = 0;
+    int32_t stepLon = 0;
+};
+
+/**
+ * Track recorder - decides which fixes become track points and fills pages
+ *
+ * Records at most one point per TRACK_MIN_INTERVAL_MS of fix time (at any
+ * fix rate), and while the cart is stopped only one per
+ * TRACK_IDLE_INTERVAL_MS. A gap of TRACK_TRIP_GAP_MS (or a reboot) starts a
+ * new trip. Completed pages go to the sink, which must not block - on the
+ * device it queues them for the track task, which does the flash writes.
+ */
+class TrackRecorder {
+public:
+    typedef void (*PageSink)(const trackPage_t& page);
+
+    explicit TrackRecorder(PageSink sink);
+
+    // Offer one merged fix with the filtered speed; returns true if it was recorded
+    bool addFix(const gps_fix& fix, float speedMph);
+
+    // Hand over the partly filled page (before sleep or an export)
+    void flush();
+
+    const TrackPoint& lastPoint() const { return last; }
+    uint32_t pointsRecorded() const { return points; }
+
+private:
+    PageSink sink;
+    trackPage_t page;
+    TrackPageEncoder encoder;
+
+    TrackPoint last;
+    bool haveLast = false;
+    bool lastStopped = false;
+    uint32_t points = 0;
+};
+
+#endif // TRACK_CODEC_H
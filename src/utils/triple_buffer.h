@@ -0,0 +1,96 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <stdint.h>
+#include <type_traits>
+
+/**
+ * Single-writer / single-reader triple buffer for frames shared across cores
+ *
+ * Three slots: the writer owns one (back), the reader owns one (front) and the
+ * third (middle) is handed between them with one atomic exchange. The writer
+ * fills writeBuffer() in place and publish()es it; the reader calls acquire()
+ * once per pass and then reads readBuffer() for as long as it likes. Neither
+ * side ever waits, copies a frame or sees a half-written one, and the reader's
+ * slot stays stable until its next acquire() (so pointers into it are safe for
+ * the whole pass). Frames published between two acquire() calls are skipped;
+ * only the latest is seen.
+ *
+ * Every publish() is stamped with a generation (1, 2, ...), so the reader can
+ * tell "new since I last drew" by comparing readGeneration() with the value it
+ * last used. Generation 0 means nothing has been published yet (the slot is
+ * zero-filled). Both sides only read a published frame, so the writer may
+ * also look at lastPublished() while the reader holds it.
+ *
+ * Use SeqLock instead for small values read from several tasks.
+ */
+template <typename T>
+class TripleBuffer {
+    static_assert(std::is_trivially_copyable<T>::value, "TripleBuffer frame must be trivially copyable");
+
+public:
+    // Writer: slot to fill for the next publish() (holds an old frame, not the latest)
+    T& writeBuffer() {
+        return slots[back].value;
+    }
+
+    // Writer: make writeBuffer() the latest frame and take a free slot for the next one
+    void publish() {
+        uint32_t gen = published.load(std::memory_order_relaxed) + 1;
+        slots[back].generation = gen;
+        latest = back;
+        uint8_t previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+        published.store(gen, std::memory_order_release);
+    }
+
+    // Writer: the frame it last published (zero-filled before the first), e.g. as
+    // the base for an update. Never writeBuffer(); the reader may be reading it too.
+    const T& lastPublished() const {
+        return slots[latest].value;
+    }
+
+    // Reader: switch to the latest published frame; returns false if there is none newer
+    bool acquire() {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Reader: frame picked up by the last acquire(); owned by the reader until the next one
+    const T& readBuffer() const {
+        return slots[front].value;
+    }
+
+    // Reader: generation of readBuffer() (0 = nothing received yet)
+    uint32_t readGeneration() const {
+        return slots[front].generation;
+    }
+
+    // Number of frames published so far (any task)
+    uint32_t generation() const {
+        return published.load(std::memory_order_acquire);
+    }
+
+private:
+    static const uint8_t FRESH = 0x80;      // middle holds a frame the reader has not taken
+    static const uint8_t INDEX_MASK = 0x03;
+
+    struct Slot {
+        T value;
+        uint32_t generation;
+    };
+
+    Slot slots[3] = {};
+    std::atomic<uint8_t> middle{1};
+    std::atomic<uint32_t> published{0};
+    uint8_t back = 0;   // Writer only
+    uint8_t latest = 1; // Writer only - starts on the zero-filled middle slot
+    uint8_t front = 2;  // Reader only
+};
+
+#endif // TRIPLE_BUFFER_H